@@ -0,0 +1,209 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2017  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+// C++ includes
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+
+// MAST includes
+#include "benchmarks/benchmark_report.h"
+
+// libMesh includes
+#include "libmesh/libmesh_common.h"
+
+
+
+namespace MAST {
+    
+    inline std::string
+    json_string(const std::string& s) {
+        
+        std::string rval("\"");
+        
+        for (unsigned int i=0; i<s.size(); i++) {
+            if (s[i] == '"' || s[i] == '\\')
+                rval += '\\';
+            rval += s[i];
+        }
+        
+        rval += '"';
+        return rval;
+    }
+}
+
+
+
+MAST::BenchmarkReport::Record::Record():
+jacobian(false),
+n_calls(0),
+total_time(0.),
+min_time(std::numeric_limits<Real>::max()) {
+    
+}
+
+
+
+void
+MAST::BenchmarkReport::Record::add_call(Real dt) {
+    
+    n_calls++;
+    total_time += dt;
+    min_time    = std::min(min_time, dt);
+}
+
+
+
+Real
+MAST::BenchmarkReport::Record::mean_time() const {
+    
+    return n_calls? total_time/n_calls : 0.;
+}
+
+
+
+MAST::BenchmarkReport::BenchmarkReport(const Real min_t,
+                                       const unsigned int min_c):
+min_time(min_t),
+min_calls(min_c) {
+    
+}
+
+
+
+MAST::BenchmarkReport::~BenchmarkReport() {
+    
+}
+
+
+
+Real
+MAST::BenchmarkReport::wall_time() {
+    
+    return std::chrono::duration<Real>
+    (std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+
+
+bool
+MAST::BenchmarkReport::if_continue(const MAST::BenchmarkReport::Record& r) const {
+    
+    return r.n_calls < min_calls || r.total_time < min_time;
+}
+
+
+
+bool
+MAST::BenchmarkReport::if_enabled(const MAST::BenchmarkReport::Record& r) const {
+    
+    return filter.empty() || name(r).find(filter) != std::string::npos;
+}
+
+
+
+std::string
+MAST::BenchmarkReport::name(const MAST::BenchmarkReport::Record& r) {
+    
+    return (r.group + "/" + r.element + "/" + r.strain + "/" + r.kernel +
+            (r.jacobian? "/jacobian" : "/residual"));
+}
+
+
+
+void
+MAST::BenchmarkReport::add(const MAST::BenchmarkReport::Record& r) {
+    
+    libmesh_assert_greater(r.n_calls, 0);
+    
+    _records.push_back(r);
+}
+
+
+
+void
+MAST::BenchmarkReport::write_table(std::ostream& out) const {
+    
+    out
+    << std::setw(60) << std::left << "benchmark"
+    << std::setw(10) << std::right << "calls"
+    << std::setw(16) << "mean (us)"
+    << std::setw(16) << "min (us)" << std::endl;
+    
+    for (unsigned int i=0; i<_records.size(); i++) {
+        
+        const MAST::BenchmarkReport::Record& r = _records[i];
+        
+        out
+        << std::setw(60) << std::left << name(r)
+        << std::setw(10) << std::right << r.n_calls
+        << std::setw(16) << std::fixed << std::setprecision(3) << 1.e6*r.mean_time()
+        << std::setw(16) << 1.e6*r.min_time << std::endl;
+    }
+}
+
+
+
+void
+MAST::BenchmarkReport::write_json(std::ostream& out) const {
+    
+    out << "{" << std::endl
+    << "  \"min_time\": " << min_time << "," << std::endl
+    << "  \"min_calls\": " << min_calls << "," << std::endl
+    << "  \"benchmarks\": [" << std::endl;
+    
+    out << std::scientific << std::setprecision(9);
+    
+    for (unsigned int i=0; i<_records.size(); i++) {
+        
+        const MAST::BenchmarkReport::Record& r = _records[i];
+        
+        out
+        << "    {"
+        << "\"name\": "              << json_string(name(r))             << ", "
+        << "\"group\": "             << json_string(r.group)             << ", "
+        << "\"element\": "           << json_string(r.element)           << ", "
+        << "\"strain\": "            << json_string(r.strain)            << ", "
+        << "\"kernel\": "            << json_string(r.kernel)            << ", "
+        << "\"jacobian\": "          << (r.jacobian? "true" : "false")   << ", "
+        << "\"calls\": "             << r.n_calls                        << ", "
+        << "\"total_seconds\": "     << r.total_time                     << ", "
+        << "\"mean_seconds\": "      << r.mean_time()                    << ", "
+        << "\"min_seconds\": "       << r.min_time
+        << "}" << (i+1 < _records.size()? "," : "") << std::endl;
+    }
+    
+    out << "  ]" << std::endl << "}" << std::endl;
+}
+
+
+
+void
+MAST::BenchmarkReport::write_json(const std::string& nm) const {
+    
+    std::ofstream out(nm.c_str());
+    
+    if (!out.good())
+        libmesh_error_msg("Unable to open benchmark output file: " << nm);
+    
+    this->write_json(out);
+}
+
@@ -0,0 +1,161 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2017  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#ifndef __mast_benchmark_report_h__
+#define __mast_benchmark_report_h__
+
+// C++ includes
+#include <string>
+#include <vector>
+#include <iostream>
+
+// MAST includes
+#include "base/mast_data_types.h"
+
+
+namespace MAST {
+    
+    /*!
+     *   Collects the timings of benchmarked kernels, and writes them
+     *   as a table and as a JSON file. Each kernel is called until both
+     *   the minimum number of calls and the minimum total time are
+     *   reached, and the mean and minimum time per call are reported.
+     */
+    class BenchmarkReport {
+        
+    public:
+        
+        /*!
+         *   timing of one kernel for one configuration
+         */
+        struct Record {
+            
+            Record();
+            
+            /*!
+             *   adds the time of one call to the record
+             */
+            void add_call(Real dt);
+            
+            /*!
+             *   @returns the mean time per call
+             */
+            Real mean_time() const;
+            
+            std::string   group;
+            std::string   element;
+            std::string   strain;
+            std::string   kernel;
+            bool          jacobian;
+            unsigned int  n_calls;
+            Real          total_time;
+            Real          min_time;
+        };
+        
+        
+        BenchmarkReport(const Real min_time,
+                        const unsigned int min_calls);
+        
+        
+        virtual ~BenchmarkReport();
+        
+        
+        /*!
+         *   @returns the wall clock time in seconds
+         */
+        static Real wall_time();
+        
+        
+        /*!
+         *   @returns true if more calls are needed for \p r
+         */
+        bool if_continue(const MAST::BenchmarkReport::Record& r) const;
+        
+        
+        /*!
+         *   @returns true if the benchmark identified by \p r should be run.
+         *   All benchmarks are run if the filter is empty. Otherwise, only
+         *   those with the filter string in their name.
+         */
+        bool if_enabled(const MAST::BenchmarkReport::Record& r) const;
+        
+        
+        /*!
+         *   @returns the name of the record, which is used for filtering
+         *   and in the table
+         */
+        static std::string name(const MAST::BenchmarkReport::Record& r);
+        
+        
+        /*!
+         *   adds a completed record
+         */
+        void add(const MAST::BenchmarkReport::Record& r);
+        
+        
+        /*!
+         *   @returns the records
+         */
+        const std::vector<MAST::BenchmarkReport::Record>& records() const {
+            return _records;
+        }
+        
+        
+        /*!
+         *   writes a table of the records to \p out
+         */
+        void write_table(std::ostream& out) const;
+        
+        
+        /*!
+         *   writes the records in JSON format to \p out
+         */
+        void write_json(std::ostream& out) const;
+        
+        
+        /*!
+         *   writes the records in JSON format to file \p nm
+         */
+        void write_json(const std::string& nm) const;
+        
+        
+        /*!
+         *   minimum total time in seconds for each benchmark
+         */
+        Real min_time;
+        
+        /*!
+         *   minimum number of calls for each benchmark
+         */
+        unsigned int min_calls;
+        
+        /*!
+         *   only benchmarks with this string in their name are run
+         */
+        std::string filter;
+        
+    protected:
+        
+        std::vector<MAST::BenchmarkReport::Record> _records;
+    };
+}
+
+
+#endif // __mast_benchmark_report_h__
@@ -0,0 +1,373 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2017  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+// C++ includes
+#include <map>
+#include <cmath>
+
+// MAST includes
+#include "benchmarks/element_kernel_benchmarks.h"
+#include "benchmarks/benchmark_report.h"
+#include "tests/structural/build_structural_elem_1D.h"
+#include "tests/structural/build_structural_elem_2D.h"
+#include "tests/structural/build_structural_elem_3D.h"
+#include "tests/fluid/build_conservative_fluid_elem.h"
+#include "elasticity/structural_system_initialization.h"
+#include "elasticity/structural_discipline.h"
+#include "elasticity/structural_element_base.h"
+#include "elasticity/piston_theory_boundary_condition.h"
+#include "property_cards/solid_1d_section_element_property_card.h"
+#include "property_cards/solid_2d_section_element_property_card.h"
+#include "property_cards/isotropic_element_property_card_3D.h"
+#include "property_cards/isotropic_material_property_card.h"
+#include "fluid/conservative_fluid_element_base.h"
+#include "fluid/conservative_fluid_discipline.h"
+#include "fluid/conservative_fluid_system_initialization.h"
+#include "base/parameter.h"
+#include "base/constant_field_function.h"
+#include "base/nonlinear_system.h"
+
+
+// libMesh includes
+#include "libmesh/dof_map.h"
+#include "libmesh/string_to_enum.h"
+
+
+namespace MAST {
+    
+    enum BenchmarkKernel {
+        INTERNAL_RESIDUAL,
+        INERTIAL_RESIDUAL,
+        THERMAL_RESIDUAL,
+        PISTON_THEORY_RESIDUAL,
+        FLUID_INTERNAL_RESIDUAL,
+        FLUID_VELOCITY_RESIDUAL,
+        FLUID_SIDE_EXTERNAL_RESIDUAL
+    };
+    
+    
+    inline const char*
+    benchmark_kernel_name(MAST::BenchmarkKernel k) {
+        
+        switch (k) {
+            case INTERNAL_RESIDUAL:             return "internal_residual";
+            case INERTIAL_RESIDUAL:             return "inertial_residual";
+            case THERMAL_RESIDUAL:              return "thermal_residual";
+            case PISTON_THEORY_RESIDUAL:        return "piston_theory_residual";
+            case FLUID_INTERNAL_RESIDUAL:       return "internal_residual";
+            case FLUID_VELOCITY_RESIDUAL:       return "velocity_residual";
+            case FLUID_SIDE_EXTERNAL_RESIDUAL:  return "side_external_residual";
+        }
+        
+        return "";
+    }
+    
+    
+    
+    /*!
+     *   times \p kernel of the structural element \p e and adds the
+     *   result to \p report.
+     */
+    void
+    benchmark_structural_kernel(MAST::BenchmarkReport& report,
+                                MAST::BenchmarkReport::Record& r,
+                                MAST::StructuralElementBase& e,
+                                MAST::BenchmarkKernel kernel,
+                                MAST::BoundaryConditionBase* thermal_load,
+                                MAST::BoundaryConditionBase* piston_theory) {
+        
+        if (!report.if_enabled(r))
+            return;
+        
+        const unsigned int n = (unsigned int)e.local_solution().size();
+        
+        RealVectorX
+        f       = RealVectorX::Zero(n);
+        
+        RealMatrixX
+        jac     = RealMatrixX::Zero(n, n),
+        jac_v   = RealMatrixX::Zero(n, n),
+        jac_a   = RealMatrixX::Zero(n, n);
+        
+        // the thermal and piston theory residuals are accessed through the
+        // volume load interface of the element
+        std::multimap<libMesh::subdomain_id_type, MAST::BoundaryConditionBase*>
+        loads;
+        if (kernel == THERMAL_RESIDUAL)
+            loads.insert(std::make_pair(e.elem().subdomain_id(), thermal_load));
+        else if (kernel == PISTON_THEORY_RESIDUAL)
+            loads.insert(std::make_pair(e.elem().subdomain_id(), piston_theory));
+        
+        // one call outside the timing loop to initialize any cached data
+        for (bool if_warmup = true; if_warmup || report.if_continue(r); if_warmup = false) {
+            
+            f.setZero();
+            if (r.jacobian) {
+                jac.setZero();
+                jac_v.setZero();
+                jac_a.setZero();
+            }
+            
+            const Real t0 = MAST::BenchmarkReport::wall_time();
+            
+            switch (kernel) {
+                    
+                case INTERNAL_RESIDUAL:
+                    e.internal_residual(r.jacobian, f, jac);
+                    break;
+                    
+                case INERTIAL_RESIDUAL:
+                    e.inertial_residual(r.jacobian, f, jac_a, jac_v, jac);
+                    break;
+                    
+                case THERMAL_RESIDUAL:
+                case PISTON_THEORY_RESIDUAL:
+                    e.volume_external_residual(r.jacobian, f, jac_v, jac, loads);
+                    break;
+                    
+                default:
+                    libmesh_error();
+            }
+            
+            const Real dt = MAST::BenchmarkReport::wall_time() - t0;
+            
+            if (!if_warmup)
+                r.add_call(dt);
+        }
+        
+        report.add(r);
+    }
+    
+    
+    
+    /*!
+     *   times all kernels of the element in the fixture \p v
+     */
+    template <typename ValType>
+    void
+    benchmark_structural_element(MAST::BenchmarkReport& report,
+                                 ValType& v,
+                                 const std::string& group,
+                                 libMesh::ElemType e_type,
+                                 bool if_nonlinear,
+                                 MAST::BoundaryConditionBase* piston_theory) {
+        
+        const libMesh::Elem& elem = **(v._mesh->local_elements_begin());
+        
+        std::auto_ptr<MAST::StructuralElementBase>
+        e(MAST::build_structural_element(*v._structural_sys,
+                                         elem,
+                                         *v._p_card).release());
+        
+        std::vector<libMesh::dof_id_type> dof_ids;
+        v._sys->get_dof_map().dof_indices(&elem, dof_ids);
+        
+        const unsigned int n = (unsigned int)dof_ids.size();
+        
+        // a small deformation, so that the nonlinear terms are nonzero
+        RealVectorX
+        x      = RealVectorX::Zero(n);
+        for (unsigned int i=0; i<n; i++)
+            x(i) = 1.e-3*sin(1.+i);
+        
+        e->set_solution(x);
+        e->set_velocity(x);
+        e->set_acceleration(x);
+        
+        const MAST::BenchmarkKernel
+        kernels[] = {INTERNAL_RESIDUAL,
+            INERTIAL_RESIDUAL,
+            THERMAL_RESIDUAL,
+            PISTON_THEORY_RESIDUAL};
+        
+        for (unsigned int i=0; i<4; i++) {
+            
+            if (kernels[i] == PISTON_THEORY_RESIDUAL && !piston_theory)
+                continue;
+            
+            for (unsigned int j=0; j<2; j++) {
+                
+                MAST::BenchmarkReport::Record r;
+                r.group    = group;
+                r.element  = libMesh::Utility::enum_to_string<libMesh::ElemType>(e_type);
+                r.strain   = if_nonlinear? "nonlinear" : "linear";
+                r.kernel   = benchmark_kernel_name(kernels[i]);
+                r.jacobian = (j == 1);
+                
+                benchmark_structural_kernel(report,
+                                            r,
+                                            *e,
+                                            kernels[i],
+                                            v._thermal_load,
+                                            piston_theory);
+            }
+        }
+    }
+    
+    
+    
+    void
+    benchmark_fluid_element(MAST::BenchmarkReport& report) {
+        
+        MAST::BuildConservativeFluidElem v;
+        
+        const libMesh::Elem& elem = **(v._mesh->local_elements_begin());
+        
+        std::auto_ptr<MAST::ConservativeFluidElementBase>
+        e(new MAST::ConservativeFluidElementBase(*v._fluid_sys, elem, *v._flight_cond));
+        
+        std::vector<libMesh::dof_id_type> dof_ids;
+        v._sys->get_dof_map().dof_indices(&elem, dof_ids);
+        
+        const unsigned int
+        n       = (unsigned int)dof_ids.size(),
+        n_vars  = (unsigned int)v._base_sol.size(),
+        n_nodes = n/n_vars;
+        
+        // uniform flow
+        RealVectorX
+        x      = RealVectorX::Zero(n);
+        for (unsigned int i=0; i<n_vars; i++)
+            for (unsigned int j=0; j<n_nodes; j++)
+                x(i*n_nodes+j) = v._base_sol(i);
+        
+        e->set_solution(x);
+        e->set_velocity(RealVectorX::Zero(n));
+        
+        const MAST::BenchmarkKernel
+        kernels[] = {FLUID_INTERNAL_RESIDUAL,
+            FLUID_VELOCITY_RESIDUAL,
+            FLUID_SIDE_EXTERNAL_RESIDUAL};
+        
+        for (unsigned int i=0; i<3; i++)
+            for (unsigned int j=0; j<2; j++) {
+                
+                MAST::BenchmarkReport::Record r;
+                r.group    = "fluid";
+                r.element  = libMesh::Utility::enum_to_string<libMesh::ElemType>(elem.type());
+                r.strain   = "none";
+                r.kernel   = benchmark_kernel_name(kernels[i]);
+                r.jacobian = (j == 1);
+                
+                if (!report.if_enabled(r))
+                    continue;
+                
+                RealVectorX
+                f       = RealVectorX::Zero(n);
+                
+                RealMatrixX
+                jac     = RealMatrixX::Zero(n, n),
+                jac_v   = RealMatrixX::Zero(n, n);
+                
+                for (bool if_warmup = true; if_warmup || report.if_continue(r); if_warmup = false) {
+                    
+                    f.setZero();
+                    if (r.jacobian) {
+                        jac.setZero();
+                        jac_v.setZero();
+                    }
+                    
+                    const Real t0 = MAST::BenchmarkReport::wall_time();
+                    
+                    switch (kernels[i]) {
+                            
+                        case FLUID_INTERNAL_RESIDUAL:
+                            e->internal_residual(r.jacobian, f, jac);
+                            break;
+                            
+                        case FLUID_VELOCITY_RESIDUAL:
+                            e->velocity_residual(r.jacobian, f, jac_v, jac);
+                            break;
+                            
+                        case FLUID_SIDE_EXTERNAL_RESIDUAL:
+                            e->side_external_residual(r.jacobian, f, jac,
+                                                      v._discipline->side_loads());
+                            break;
+                            
+                        default:
+                            libmesh_error();
+                    }
+                    
+                    const Real dt = MAST::BenchmarkReport::wall_time() - t0;
+                    
+                    if (!if_warmup)
+                        r.add_call(dt);
+                }
+                
+                report.add(r);
+            }
+    }
+}
+
+
+
+void
+MAST::run_element_kernel_benchmarks(MAST::BenchmarkReport& report) {
+    
+    // 1D elements
+    {
+        const libMesh::ElemType
+        e_types[] = {libMesh::EDGE2, libMesh::EDGE3};
+        
+        for (unsigned int i=0; i<2; i++)
+            for (unsigned int j=0; j<2; j++) {
+                
+                MAST::BuildStructural1DElem v;
+                v.init(false, j==1, e_types[i]);
+                MAST::benchmark_structural_element(report, v, "structural_1D",
+                                                   e_types[i], j==1, v._p_theory);
+            }
+    }
+    
+    // 2D elements
+    {
+        const libMesh::ElemType
+        e_types[] = {libMesh::TRI3, libMesh::TRI6,
+            libMesh::QUAD4, libMesh::QUAD8, libMesh::QUAD9};
+        
+        for (unsigned int i=0; i<5; i++)
+            for (unsigned int j=0; j<2; j++) {
+                
+                MAST::BuildStructural2DElem v;
+                v.init(false, j==1, e_types[i]);
+                MAST::benchmark_structural_element(report, v, "structural_2D",
+                                                   e_types[i], j==1, v._p_theory);
+            }
+    }
+    
+    // 3D elements. Piston theory is not applicable to these.
+    {
+        const libMesh::ElemType
+        e_types[] = {libMesh::HEX8, libMesh::HEX27};
+        
+        for (unsigned int i=0; i<2; i++)
+            for (unsigned int j=0; j<2; j++) {
+                
+                MAST::BuildStructural3DElem v;
+                v.init(j==1, e_types[i]);
+                MAST::benchmark_structural_element(report, v, "structural_3D",
+                                                   e_types[i], j==1, nullptr);
+            }
+    }
+    
+    // fluid element
+    MAST::benchmark_fluid_element(report);
+}
+
@@ -0,0 +1,40 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2017  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#ifndef __mast_element_kernel_benchmarks_h__
+#define __mast_element_kernel_benchmarks_h__
+
+
+namespace MAST {
+    
+    // Forward declerations
+    class BenchmarkReport;
+    
+    /*!
+     *   times the residual and Jacobian kernels of the structural elements
+     *   for EDGE2/3, TRI3/6, QUAD4/8/9 and HEX8/27 elements, with linear
+     *   and nonlinear strain, and of the conservative fluid element, and
+     *   adds the results to \p report.
+     */
+    void run_element_kernel_benchmarks(MAST::BenchmarkReport& report);
+}
+
+
+#endif // __mast_element_kernel_benchmarks_h__
@@ -0,0 +1,76 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2017  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+// C++ includes
+#include <iostream>
+
+// MAST includes
+#include "benchmarks/benchmark_report.h"
+#include "benchmarks/element_kernel_benchmarks.h"
+
+// libMesh includes
+#include "libmesh/libmesh.h"
+#include "libmesh/getpot.h"
+
+
+libMesh::LibMeshInit     *__init         = nullptr;
+
+
+/*!
+ *   Runs the element kernel benchmarks. Each kernel is called at least
+ *   \p min_calls times and until \p min_time seconds have been spent in it.
+ *   Command line options:
+ *     min_time=<seconds>   (default 0.2)
+ *     min_calls=<n>        (default 10)
+ *     filter=<substring>   runs only the benchmarks whose name contains
+ *                          the string, for example "structural_2D/QUAD4"
+ *     output=<file name>   JSON output (default mast_benchmarks.json)
+ */
+int main(int argc, char* const argv[]) {
+    
+    libMesh::LibMeshInit init(argc, argv);
+    __init  = &init;
+    
+    // use to get arguments from the command line
+    GetPot command_line(argc, argv);
+    
+    const Real
+    min_time     = command_line("min_time",          0.2);
+    
+    const unsigned int
+    min_calls    = command_line("min_calls",          10);
+    
+    const std::string
+    filter       = command_line("filter",             ""),
+    output       = command_line("output", "mast_benchmarks.json");
+    
+    MAST::BenchmarkReport report(min_time, min_calls);
+    report.filter = filter;
+    
+    MAST::run_element_kernel_benchmarks(report);
+    
+    report.write_table(libMesh::out);
+    
+    if (init.comm().rank() == 0)
+        report.write_json(output);
+    
+    return 0;
+}
+
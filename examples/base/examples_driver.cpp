@@ -17,6 +17,10 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
+// C++ includes
+#include <fstream>
+#include <sstream>
+
 // MAST includes
 #include "examples/structural/bar_extension/bar_extension.h"
 #include "examples/structural/beam_thermally_stressed_modal_analysis/beam_thermally_stressed_modal_analysis.h"
@@ -55,6 +59,9 @@
 #include "examples/structural/topology_optim_2D/topology_optim_2D.h"
 #include "optimization/npsol_optimization_interface.h"
 #include "optimization/dot_optimization_interface.h"
+#include "optimization/gcmma_optimization_interface.h"
+#include "optimization/mma_optimization_interface.h"
+#include "base/mast_config.h"
 #include "examples/fluid/panel_inviscid_analysis_2D/panel_inviscid_analysis_2d.h"
 #include "examples/fluid/ramp_laminar_analysis_2D/ramp_viscous_analysis_2d.h"
 #include "examples/fluid/panel_inviscid_analysis_3D_half_domain/panel_inviscid_analysis_3D_half_domain.h"
@@ -75,6 +82,9 @@
 //#include "examples/fsi/beam_aerothermoelastic_flutter_solution/beam_aerothermoelastic_flutter_solution.h"
 #include "examples/thermal/bar_transient/bar_transient.h"
 #include "examples/thermal/bar_steady_state/bar_steady_state.h"
+#include "examples/base/performance_suite.h"
+#include "base/performance_log.h"
+#include "base/memory_log.h"
 
 
 // libMesh includes
@@ -213,30 +223,87 @@ void optimization(const std::string& case_name,
     std::ofstream output;
     output.open("optimization_output.txt", std::ofstream::out);
     
-    MAST::GCMMAOptimizationInterface optimizer;
+    // the native MMA implementation is used if requested, or if MAST
+    // was configured without the GCMMA library
+    std::auto_ptr<MAST::OptimizationInterface> optimizer;
+#if MAST_ENABLE_GCMMA == 1
+    if (!libMesh::on_command_line("--native_mma"))
+        optimizer.reset(new MAST::GCMMAOptimizationInterface);
+    else
+#endif
+        optimizer.reset(new MAST::MMAOptimizationInterface);
+    
+    // for gradient verification the communicator can be split into groups
+    // that evaluate the perturbed designs concurrently. Each group creates
+    // its own function evaluation object.
+    unsigned int
+    n_groups = verify_grads?
+    libMesh::command_line_value("--verify_grads_groups", 1):1,
+    group_id = 0;
+    libMesh::Parallel::Communicator
+    group_comm;
+    if (n_groups > 1)
+        group_id = MAST::FunctionEvaluation::split_communicator(__init->comm(),
+                                                                n_groups,
+                                                                group_comm);
+    else
+        group_comm.duplicate(__init->comm());
     
     // create and attach sizing optimization object
-    ValType func_eval(__init->comm());
+    ValType func_eval(group_comm);
     if (__init->comm().rank() == 0)
         func_eval.set_output_file("optimization_output.txt");
     __my_func_eval = &func_eval;
     func_eval.init(infile, etype, nonlinear);
-    
+
+    // memoization of evaluations, and checkpoint/restart of the
+    // evaluation history
+    if (libMesh::on_command_line("--evaluation_cache"))
+        func_eval.set_evaluation_cache(true,
+                                       1.e-12,
+                                       libMesh::command_line_value("--evaluation_cache_size", 100));
+    if (libMesh::on_command_line("--restart_file"))
+        libMesh::out
+        << "Evaluations read from checkpoint: "
+        << func_eval.load_checkpoint(libMesh::command_line_value("--restart_file",
+                                                                 std::string()))
+        << std::endl;
+    if (libMesh::on_command_line("--checkpoint_file"))
+        func_eval.set_checkpoint_file(libMesh::command_line_value("--checkpoint_file",
+                                                                  std::string("optimization_checkpoint.bin")),
+                                      libMesh::command_line_value("--checkpoint_interval", 1));
+
     if (verify_grads) {
         std::vector<Real>
         dvals(func_eval.n_vars()),
         dummy(func_eval.n_vars());
         func_eval.init_dvar(dvals, dummy, dummy);
 
+        // the variables can be specified as a list, or a random subset
+        // can be selected
+        std::vector<unsigned int>
+        dv_ids;
+        if (libMesh::on_command_line("--verify_grads_vars"))
+            libMesh::command_line_vector("--verify_grads_vars", dv_ids);
+        else
+            dv_ids = MAST::FunctionEvaluation::random_variable_subset
+            (func_eval.n_vars(),
+             libMesh::command_line_value("--verify_grads_n_random", (int)func_eval.n_vars()),
+             libMesh::command_line_value("--verify_grads_seed", 0));
+
         libMesh::out << "******* Begin: Verifying gradients ***********" << std::endl;
-        func_eval.verify_gradients(dvals);
+        func_eval.verify_gradients(dvals,
+                                   dv_ids,
+                                   &__init->comm(),
+                                   group_id,
+                                   n_groups);
         libMesh::out << "******* End: Verifying gradients ***********" << std::endl;
     }
     else {
 
         // attach and optimize
-        optimizer.attach_function_evaluation_object(func_eval);
-        optimizer.optimize();
+        optimizer->attach_function_evaluation_object(func_eval);
+        optimizer->optimize();
     }
     
     output.close();
@@ -245,6 +312,239 @@ void optimization(const std::string& case_name,
 
 
 
+
+/*!
+ *   the following versions of the analysis functions are used by the
+ *   performance suite. The mesh is refined by 2^n_refine along each
+ *   coordinate, output is not written, and the sensitivity is computed
+ *   with respect to \p par_name.
+ */
+template <typename ValType>
+void performance_analysis(MAST::PerformanceSuite& suite,
+                          const std::string& case_name,
+                          const libMesh::ElemType etype,
+                          const unsigned int n_refine,
+                          const std::string& par_name)  {
+    
+    suite.begin_case(case_name, n_refine);
+    {
+        ValType run_case;
+        
+        suite.begin_phase("init");
+        run_case.init(etype, false, n_refine);
+        suite.end_phase();
+        
+        suite.begin_phase("solve");
+        run_case.solve(false);
+        suite.end_phase();
+        
+        MAST::Parameter* p = run_case.get_parameter(par_name);
+        if (p) {
+            suite.begin_phase("sensitivity");
+            run_case.sensitivity_solve(*p, false);
+            suite.end_phase();
+        }
+    }
+    suite.end_case();
+}
+
+
+
+template <typename ValType>
+void performance_eigenvalue_analysis(MAST::PerformanceSuite& suite,
+                                     const std::string& case_name,
+                                     const libMesh::ElemType etype,
+                                     const unsigned int n_refine,
+                                     const std::string& par_name)  {
+    
+    suite.begin_case(case_name, n_refine);
+    {
+        ValType run_case;
+        
+        suite.begin_phase("init");
+        run_case.init(etype, false, n_refine);
+        suite.end_phase();
+        
+        suite.begin_phase("solve");
+        run_case.solve(false);
+        suite.end_phase();
+        
+        MAST::Parameter* p = run_case.get_parameter(par_name);
+        if (p) {
+            std::vector<Real> eig;
+            suite.begin_phase("sensitivity");
+            run_case.sensitivity_solve(*p, eig);
+            suite.end_phase();
+        }
+    }
+    suite.end_case();
+}
+
+
+
+template <typename ValType>
+void performance_flutter_analysis(MAST::PerformanceSuite& suite,
+                                  const std::string& case_name,
+                                  const libMesh::ElemType etype,
+                                  const unsigned int n_refine,
+                                  const std::string& par_name)  {
+    
+    suite.begin_case(case_name, n_refine);
+    {
+        ValType run_case;
+        
+        suite.begin_phase("init");
+        run_case.init(etype, false, n_refine);
+        suite.end_phase();
+        
+        suite.begin_phase("solve");
+        run_case.solve(false);
+        suite.end_phase();
+        
+        MAST::Parameter* p = run_case.get_parameter(par_name);
+        if (p) {
+            suite.begin_phase("sensitivity");
+            run_case.sensitivity_solve(*p);
+            suite.end_phase();
+        }
+    }
+    suite.end_case();
+}
+
+
+
+template <typename ValType>
+void performance_fluid_analysis(MAST::PerformanceSuite& suite,
+                                const std::string& case_name,
+                                const unsigned int n_refine,
+                                const std::string& par_name)  {
+    
+    suite.begin_case(case_name, n_refine);
+    {
+        // the fsi cases are initialized in the constructor
+        suite.begin_phase("init");
+        std::auto_ptr<ValType> run_case(new ValType(0, n_refine));
+        suite.end_phase();
+        
+        suite.begin_phase("solve");
+        run_case->solve(false);
+        suite.end_phase();
+        
+        MAST::Parameter* p = run_case->get_parameter(par_name);
+        if (p) {
+            suite.begin_phase("sensitivity");
+            run_case->sensitivity_solve(*p);
+            suite.end_phase();
+        }
+    }
+    suite.end_case();
+}
+
+
+
+/*!
+ *   runs the curated set of cases at refinement levels 0 to
+ *   --perf_n_refine, writes the metrics to --perf_output and compares
+ *   them with --perf_baseline, if specified.
+ *   @returns the number of regressions.
+ */
+unsigned int performance_suite()  {
+    
+    const std::string
+    default_cases =
+    "beam_bending,"
+    "plate_bending,"
+    "beam_modal_analysis,"
+    "plate_modal_analysis,"
+    "beam_prestress_buckling_analysis,"
+    "beam_piston_theory_flutter_analysis,"
+    "plate_piston_theory_flutter_analysis,"
+    "beam_fsi_flutter_analysis";
+    
+    const std::string
+    cases_str  = libMesh::command_line_value("--perf_cases",    default_cases),
+    output     = libMesh::command_line_value("--perf_output",   std::string("performance_results.txt")),
+    baseline   = libMesh::command_line_value("--perf_baseline", std::string());
+    
+    const unsigned int
+    n_refine   = libMesh::command_line_value("--perf_n_refine", 1);
+    
+    MAST::PerformanceSuite suite(__init->comm());
+    suite.set_tolerances(libMesh::command_line_value("--perf_time_tol",    0.10),
+                         libMesh::command_line_value("--perf_memory_tol",  0.10),
+                         libMesh::command_line_value("--perf_min_time",    0.05));
+    suite.set_memory_report(libMesh::on_command_line("--mast_memory_log"));
+    
+    // comma separated list of cases
+    std::vector<std::string> cases;
+    {
+        std::istringstream s(cases_str);
+        std::string nm;
+        while (std::getline(s, nm, ','))
+            if (!nm.empty())
+                cases.push_back(nm);
+    }
+    
+    // the fsi case reads its mesh and flow parameters from input.in
+    const bool
+    has_input_file = std::ifstream("input.in").good();
+    
+    for (unsigned int r=0; r<=n_refine; r++)
+        for (unsigned int i=0; i<cases.size(); i++) {
+            
+            const std::string& nm = cases[i];
+            
+            if (nm == "beam_bending")
+                performance_analysis<MAST::BeamBending>
+                (suite, nm, libMesh::EDGE2, r, "thy");
+            else if (nm == "plate_bending")
+                performance_analysis<MAST::PlateBending>
+                (suite, nm, libMesh::QUAD4, r, "th");
+            else if (nm == "beam_modal_analysis")
+                performance_eigenvalue_analysis<MAST::BeamModalAnalysis>
+                (suite, nm, libMesh::EDGE2, r, "thy");
+            else if (nm == "plate_modal_analysis")
+                performance_eigenvalue_analysis<MAST::PlateModalAnalysis>
+                (suite, nm, libMesh::QUAD4, r, "th");
+            else if (nm == "beam_prestress_buckling_analysis")
+                performance_eigenvalue_analysis<MAST::BeamColumnBucklingAnalysis>
+                (suite, nm, libMesh::EDGE2, r, "thy");
+            else if (nm == "beam_piston_theory_flutter_analysis")
+                performance_flutter_analysis<MAST::BeamPistonTheoryFlutterAnalysis>
+                (suite, nm, libMesh::EDGE2, r, "thy");
+            else if (nm == "plate_piston_theory_flutter_analysis")
+                performance_flutter_analysis<MAST::PlatePistonTheoryFlutterAnalysis>
+                (suite, nm, libMesh::QUAD4, r, "th");
+            else if (nm == "beam_fsi_flutter_analysis") {
+                if (has_input_file)
+                    performance_fluid_analysis<MAST::BeamEulerFSIFlutterAnalysis>
+                    (suite, nm, r, "thy");
+                else
+                    libMesh::out
+                    << "Performance suite: skipping " << nm
+                    << " since input.in is not present in the working directory."
+                    << std::endl;
+            }
+            else
+                libmesh_error_msg("Case not available in performance suite: " << nm);
+        }
+    
+    suite.write(output);
+    
+    unsigned int n_regressions = 0;
+    if (!baseline.empty()) {
+        
+        // all ranks read the baseline, but only rank 0 reports
+        std::ostringstream report;
+        n_regressions = suite.compare(baseline, report);
+        if (__init->comm().rank() == 0)
+            libMesh::out << report.str();
+    }
+    
+    return n_regressions;
+}
+
+
 int main(int argc, char* const argv[]) {
     
     libMesh::LibMeshInit init(argc, argv);
@@ -262,6 +562,23 @@ int main(int argc, char* const argv[]) {
     if_nonlin    = command_line("nonlinear",           false),
     verify_grads = command_line("verify_grads",        false);
     
+    // the MAST performance log is enabled if a summary or a trace
+    // is requested
+    const std::string
+    trace_file   = libMesh::command_line_value("--mast_trace", std::string());
+    const bool
+    if_perf_log  = (libMesh::on_command_line("--mast_perf_log") ||
+                    !trace_file.empty());
+    
+    if (if_perf_log)
+        MAST::PerformanceLog::enable
+        (init.comm(),
+         !trace_file.empty(),
+         libMesh::command_line_value("--mast_trace_depth", 4));
+    
+    unsigned int
+    n_regressions = 0;
+    
     
     if (case_name == "bar_extension")
         analysis<MAST::BarExtension>(case_name,
@@ -534,6 +851,8 @@ int main(int argc, char* const argv[]) {
                                      if_nonlin,
                                      with_sens,
                                      par_name);
+    else if (case_name == "performance_suite")
+        n_regressions = performance_suite();
     else {
         libMesh::out
         << "Please run the driver with the name of example specified as: \n"
@@ -585,6 +904,11 @@ int main(int argc, char* const argv[]) {
         << "*  param is used to specify the parameter name for which sensitivity is desired.\n"
         << "*  nonlinear is used to turn on/off nonlinear stiffening in the problem.\n"
         << "*  verify_grads=true will verify the gradients of the optimization problem before calling the optimizer.\n"
+        << "*  --mast_perf_log prints the MAST performance log summary at the end of the run.\n"
+        << "*  --mast_trace <file> writes the MAST performance log events in Chrome trace format.\n"
+        << "*  --mast_trace_depth <n> limits the trace to scopes up to depth n, default 4.\n"
+        << "*  --mast_memory_log prints the memory held by each MAST subsystem at the end of the run,\n"
+        << "   and at the end of each phase of the performance suite.\n"
         << "\n\n\n"
         << "**********************************\n"
         << "***********   FLUID   ************\n"
@@ -603,6 +927,20 @@ int main(int argc, char* const argv[]) {
         << "  bar_transient_conduction \n"
         << "\n\n\n"
         << "**********************************\n"
+        << "*******   PERFORMANCE   **********\n"
+        << "**********************************\n"
+        << "  performance_suite \n"
+        << "     --perf_cases <comma separated list of cases>\n"
+        << "     --perf_n_refine <max refinement level, default 1>\n"
+        << "     --perf_output <results file, default performance_results.txt>\n"
+        << "     --perf_baseline <results file from a previous run>\n"
+        << "     --perf_time_tol <fraction, default 0.1>\n"
+        << "     --perf_memory_tol <fraction, default 0.1>\n"
+        << "     --perf_min_time <seconds, default 0.05>\n"
+        << "  beam_fsi_flutter_analysis requires input.in in the working directory.\n"
+        << "  With --mast_perf_log the log summary is for the last case only.\n"
+        << "\n\n\n"
+        << "**********************************\n"
         << "***********   FSI     ************\n"
         << "**********************************\n"
         << "  beam_fsi_analysis \n"
@@ -621,5 +959,16 @@ int main(int argc, char* const argv[]) {
         << std::endl;
     }
     
-    return 0;
+    if (if_perf_log) {
+        
+        MAST::PerformanceLog::print_summary(init.comm(), libMesh::out);
+        
+        if (!trace_file.empty())
+            MAST::PerformanceLog::write_chrome_trace(init.comm(), trace_file);
+    }
+    
+    if (libMesh::on_command_line("--mast_memory_log"))
+        MAST::MemoryLog::report(init.comm(), libMesh::out, "end of run");
+    
+    return (n_regressions > 0)? 1 : 0;
 }
@@ -0,0 +1,508 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2017  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+// C++ includes
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <sys/resource.h>
+
+// MAST includes
+#include "examples/base/performance_suite.h"
+#include "base/performance_log.h"
+#include "base/memory_log.h"
+
+// libMesh includes
+#include "libmesh/libmesh_logging.h"
+#include "libmesh/parallel.h"
+
+
+MAST::PerformanceSuite::
+PerformanceSuite(const libMesh::Parallel::Communicator& comm):
+libMesh::ParallelObject(comm),
+_time_tol(0.1),
+_memory_tol(0.1),
+_min_time(0.05),
+_in_case(false),
+_memory_report(false),
+_phase_start(0.),
+_case_start(0.) {
+    
+}
+
+
+
+MAST::PerformanceSuite::~PerformanceSuite() {
+    
+}
+
+
+
+void
+MAST::PerformanceSuite::set_tolerances(const Real time_tol,
+                                       const Real memory_tol,
+                                       const Real min_time) {
+    
+    libmesh_assert_greater_equal(time_tol,   0.);
+    libmesh_assert_greater_equal(memory_tol, 0.);
+    libmesh_assert_greater_equal(min_time,   0.);
+    
+    _time_tol   = time_tol;
+    _memory_tol = memory_tol;
+    _min_time   = min_time;
+}
+
+
+
+void
+MAST::PerformanceSuite::begin_case(const std::string& case_name,
+                                   const unsigned int n_refine) {
+    
+    libmesh_assert(!_in_case);
+    
+    _in_case            = true;
+    _current.name       = case_name;
+    _current.n_refine   = n_refine;
+    _current.metrics.clear();
+    
+    // the phase breakdown is obtained from the events logged during
+    // this case only
+    libMesh::perflog.clear();
+#if MAST_ENABLE_TIMERS == 1
+    // the trace settings are retained if the log was enabled by the caller
+    if (!MAST::PerformanceLog::enabled())
+        MAST::PerformanceLog::enable(this->comm());
+    MAST::PerformanceLog::clear();
+#endif
+    reset_peak_memory();
+    MAST::MemoryLog::reset_peaks();
+    
+    this->comm().barrier();
+    _case_start = wall_time();
+}
+
+
+
+void
+MAST::PerformanceSuite::begin_phase(const std::string& nm) {
+    
+    libmesh_assert(_in_case);
+    libmesh_assert(_phase.empty());
+    
+    _phase        = nm;
+    _phase_start  = wall_time();
+}
+
+
+
+void
+MAST::PerformanceSuite::end_phase() {
+    
+    libmesh_assert(_in_case);
+    libmesh_assert(!_phase.empty());
+    
+    _current.metrics["time." + _phase] += wall_time() - _phase_start;
+    
+    if (_memory_report)
+        MAST::MemoryLog::report(this->comm(),
+                                libMesh::out,
+                                _current.name + "/" + _phase);
+    
+    _phase.clear();
+}
+
+
+
+void
+MAST::PerformanceSuite::end_case() {
+    
+    libmesh_assert(_in_case);
+    libmesh_assert(_phase.empty());
+    
+    _current.metrics["time.total"]          = wall_time() - _case_start;
+    _current.metrics["memory.peak_rss_mb"]  = peak_memory();
+    
+    // peak of the memory accounted by each subsystem during this case
+    for (unsigned int i=0; i<MAST::N_MEMORY_SUBSYSTEMS; i++) {
+        
+        const MAST::MemorySubsystem
+        sub = MAST::MemorySubsystem(i);
+        
+        _current.metrics[std::string("memory.") +
+                         MAST::MemoryLog::subsystem_name(sub) + "_peak_mb"] =
+        MAST::MemoryLog::peak(sub)/1024./1024.;
+    }
+    
+    _current.metrics["memory.accounted_peak_mb"] =
+    MAST::MemoryLog::total_peak()/1024./1024.;
+    _add_perflog_metrics(_current);
+    
+    // the outer phases are called in the same sequence on all ranks, and
+    // the perflog phases are always added. Hence, the metrics have the
+    // same keys on all ranks and can be reduced in the order of the map.
+    std::vector<Real> vals;
+    vals.reserve(_current.metrics.size());
+    
+    std::map<std::string, Real>::iterator
+    it   = _current.metrics.begin(),
+    end  = _current.metrics.end();
+    
+    for ( ; it != end; it++)
+        vals.push_back(it->second);
+    
+    this->comm().max(vals);
+    
+    it = _current.metrics.begin();
+    for (unsigned int i=0; it != end; it++, i++)
+        it->second = vals[i];
+    
+    _cases.push_back(_current);
+    _in_case = false;
+    
+    libMesh::out
+    << "Performance suite: " << _current.name
+    << "  n_refine = " << _current.n_refine
+    << "  time = "     << _current.metrics["time.total"] << " s"
+    << "  peak RSS = " << _current.metrics["memory.peak_rss_mb"] << " MB"
+    << std::endl;
+}
+
+
+
+void
+MAST::PerformanceSuite::write(const std::string& nm) const {
+    
+    if (this->comm().rank() != 0)
+        return;
+    
+    std::ofstream out(nm.c_str());
+    if (!out.good())
+        libmesh_error_msg("Unable to open file for writing: " << nm);
+    
+    out
+    << "# case   n_refine   metric   value" << std::endl;
+    
+    for (unsigned int i=0; i<_cases.size(); i++) {
+        
+        std::map<std::string, Real>::const_iterator
+        it   = _cases[i].metrics.begin(),
+        end  = _cases[i].metrics.end();
+        
+        for ( ; it != end; it++)
+            out
+            << _cases[i].name     << " "
+            << _cases[i].n_refine << " "
+            << it->first          << " "
+            << std::setprecision(8) << it->second << std::endl;
+    }
+}
+
+
+
+unsigned int
+MAST::PerformanceSuite::compare(const std::string& nm,
+                                std::ostream& out) const {
+    
+    // read the baseline
+    std::map<std::string, Real> baseline;
+    
+    std::ifstream in(nm.c_str());
+    if (!in.good())
+        libmesh_error_msg("Unable to open baseline file: " << nm);
+    
+    std::string line, case_name, metric;
+    unsigned int n_refine = 0;
+    Real         val      = 0.;
+    
+    while (std::getline(in, line)) {
+        
+        if (line.empty() || line[0] == '#')
+            continue;
+        
+        std::istringstream s(line);
+        if (!(s >> case_name >> n_refine >> metric >> val))
+            libmesh_error_msg("Invalid line in baseline file " << nm << ": " << line);
+        
+        std::ostringstream key;
+        key << case_name << "/" << n_refine << "/" << metric;
+        baseline[key.str()] = val;
+    }
+    
+    
+    unsigned int
+    n_regressions = 0;
+    
+    std::vector<std::string>
+    regressions;
+    
+    out
+    << std::setw(40) << std::left << "case/n_refine/metric"
+    << std::setw(14) << std::right << "baseline"
+    << std::setw(14) << "current"
+    << std::setw(10) << "change%"
+    << "   status" << std::endl;
+    
+    for (unsigned int i=0; i<_cases.size(); i++) {
+        
+        std::map<std::string, Real>::const_iterator
+        it   = _cases[i].metrics.begin(),
+        end  = _cases[i].metrics.end();
+        
+        for ( ; it != end; it++) {
+            
+            std::ostringstream key;
+            key << _cases[i].name << "/" << _cases[i].n_refine << "/" << it->first;
+            
+            const Real
+            cur = it->second;
+            
+            std::map<std::string, Real>::const_iterator
+            b_it = baseline.find(key.str());
+            
+            out
+            << std::setw(40) << std::left << key.str() << std::right;
+            
+            if (b_it == baseline.end()) {
+                
+                out
+                << std::setw(14) << "-"
+                << std::setw(14) << cur
+                << std::setw(10) << "-"
+                << "   new" << std::endl;
+                continue;
+            }
+            
+            const Real
+            base   = b_it->second,
+            change = (base > 0.)? (cur-base)/base : 0.;
+            
+            bool
+            if_regression  = false,
+            if_improvement = false;
+            
+            if (it->first.compare(0, 6, "count.") == 0) {
+                
+                if_regression  = cur > base;
+                if_improvement = cur < base;
+            }
+            else if (it->first.compare(0, 7, "memory.") == 0) {
+                
+                if_regression  = cur > base*(1.+_memory_tol);
+                if_improvement = cur < base*(1.-_memory_tol);
+            }
+            else {
+                
+                // time and phase metrics
+                if_regression  = (cur > base*(1.+_time_tol) &&
+                                  cur - base > _min_time);
+                if_improvement = (cur < base*(1.-_time_tol) &&
+                                  base - cur > _min_time);
+            }
+            
+            out
+            << std::setw(14) << base
+            << std::setw(14) << cur
+            << std::setw(10) << std::setprecision(3) << change*100.
+            << std::setprecision(6);
+            
+            if (if_regression) {
+                
+                out << "   REGRESSION" << std::endl;
+                n_regressions++;
+                regressions.push_back(key.str());
+            }
+            else if (if_improvement)
+                out << "   improved" << std::endl;
+            else
+                out << "   ok" << std::endl;
+        }
+    }
+    
+    out
+    << std::endl
+    << "Performance suite: " << n_regressions
+    << " regression(s) relative to " << nm << std::endl;
+    for (unsigned int i=0; i<regressions.size(); i++)
+        out << "   " << regressions[i] << std::endl;
+    
+    return n_regressions;
+}
+
+
+
+Real
+MAST::PerformanceSuite::peak_memory() {
+    
+    // on Linux, the high-water mark is read from the process status
+    // so that it reflects the value since the last reset
+    std::ifstream status("/proc/self/status");
+    std::string   line;
+    
+    while (status.good() && std::getline(status, line))
+        if (line.compare(0, 6, "VmHWM:") == 0) {
+            
+            std::istringstream s(line.substr(6));
+            Real kb = 0.;
+            s >> kb;
+            return kb/1024.;
+        }
+    
+    // otherwise, this is the peak over the life of the process
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return usage.ru_maxrss/1024./1024.;
+#else
+    return usage.ru_maxrss/1024.;
+#endif
+}
+
+
+
+void
+MAST::PerformanceSuite::reset_peak_memory() {
+    
+    // writing 5 to clear_refs resets the VmHWM value (Linux 4.0 and later)
+    std::ofstream clear_refs("/proc/self/clear_refs");
+    if (clear_refs.good())
+        clear_refs << "5" << std::endl;
+}
+
+
+
+Real
+MAST::PerformanceSuite::wall_time() {
+    
+    return
+    std::chrono::duration<Real>
+    (std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+
+
+void
+MAST::PerformanceSuite::_add_perflog_metrics(MAST::PerformanceSuite::Case& c) const {
+    
+    // all phases are added so that the metrics are identical on all ranks
+    const char*
+    phases[] = {"assembly", "linear_solve", "nonlinear_solve",
+        "eigen_solve", "flutter", "sensitivity", "other"};
+    
+    for (unsigned int i=0; i<7; i++) {
+        
+        c.metrics[std::string("phase.") + phases[i]] = 0.;
+        c.metrics[std::string("count.") + phases[i]] = 0.;
+    }
+    
+#if MAST_ENABLE_TIMERS == 1
+    
+    // the counters are added with a fixed set of names for the same reason
+    const char*
+    counters[] = {"elements", "jacobians", "localizations",
+        "nonlinear_iterations", "ksp_iterations"};
+    
+    for (unsigned int i=0; i<5; i++)
+        c.metrics[std::string("count.") + counters[i]] =
+        MAST::PerformanceLog::counter(counters[i]);
+    
+    // the MAST scopes are labelled "Class::method" and nested scopes are
+    // stored with their path. Only the innermost scope is used for the
+    // classification, and the exclusive time is used so that nested scopes
+    // are not counted twice.
+    std::map<std::string, std::pair<Real, unsigned long> > scopes;
+    MAST::PerformanceLog::scope_data(scopes);
+    
+    std::map<std::string, std::pair<Real, unsigned long> >::const_iterator
+    it   = scopes.begin(),
+    end  = scopes.end();
+    
+    for ( ; it != end; it++) {
+        
+        const std::string
+        leaf   = it->first.substr(it->first.rfind('/') + 1);
+        
+        const std::string::size_type
+        sep    = leaf.find("::");
+        
+        const std::string
+        phase  = (sep == std::string::npos)?
+        _perflog_phase("", leaf) :
+        _perflog_phase(leaf.substr(0, sep), leaf.substr(sep+2));
+        
+        c.metrics["phase." + phase] += it->second.first;
+        c.metrics["count." + phase] += it->second.second;
+    }
+    
+#else
+    
+    if (!libMesh::perflog.logging_enabled())
+        return;
+    
+    // the exclusive time of each event is used so that nested events
+    // are not counted twice
+    const std::map<std::pair<std::string, std::string>, libMesh::PerfData>&
+    log = libMesh::perflog.get_log();
+    
+    std::map<std::pair<std::string, std::string>, libMesh::PerfData>::const_iterator
+    it   = log.begin(),
+    end  = log.end();
+    
+    for ( ; it != end; it++) {
+        
+        const std::string
+        phase = _perflog_phase(it->first.first, it->first.second);
+        
+        c.metrics["phase." + phase] += it->second.tot_time;
+        c.metrics["count." + phase] += it->second.count;
+    }
+    
+#endif // MAST_ENABLE_TIMERS
+}
+
+
+
+std::string
+MAST::PerformanceSuite::_perflog_phase(const std::string& header,
+                                       const std::string& label) {
+    
+    if (label.find("sensitivity") != std::string::npos)
+        return "sensitivity";
+    else if (header.find("Flutter") != std::string::npos)
+        return "flutter";
+    else if (label.find("eigen") != std::string::npos ||
+             header.find("EigenSolver") != std::string::npos)
+        return "eigen_solve";
+    else if (label == "KSPSolve" ||
+             header.find("LinearSolver") != std::string::npos)
+        return "linear_solve";
+    else if (label.find("residual") != std::string::npos ||
+             label.find("jacobian") != std::string::npos ||
+             label.find("assemble") != std::string::npos ||
+             header.find("Assembly") != std::string::npos)
+        return "assembly";
+    else if (label.find("solve") != std::string::npos ||
+             header.find("NonlinearSolver") != std::string::npos)
+        return "nonlinear_solve";
+    else
+        return "other";
+}
+
@@ -0,0 +1,225 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2017  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#ifndef __mast__performance_suite_h__
+#define __mast__performance_suite_h__
+
+// C++ includes
+#include <string>
+#include <vector>
+#include <map>
+#include <iostream>
+
+// MAST includes
+#include "base/mast_data_types.h"
+
+// libMesh includes
+#include "libmesh/parallel_object.h"
+
+
+namespace MAST {
+    
+    /*!
+     *   Collects wall time, phase breakdown, call counts and peak resident
+     *   memory for a sequence of example cases, and compares them against
+     *   a stored baseline.
+     *
+     *   The outer phases (\p init, \p solve, \p sensitivity) are timed by the
+     *   caller through begin_phase() and end_phase(). The breakdown into
+     *   assembly, linear solve, nonlinear solve, eigen-solve, flutter search
+     *   and sensitivity is obtained from MAST::PerformanceLog, which is
+     *   enabled for each case, along with the element, Jacobian, localization
+     *   and iteration counters. If MAST was built without timers, the libMesh
+     *   performance log is used instead, which requires libMesh to be
+     *   configured with the performance log enabled. The log is cleared at
+     *   the beginning of each case.
+     *
+     *   The peak memory of the process is supplemented by the peak of each
+     *   subsystem accounted by MAST::MemoryLog during the case.
+     *
+     *   All times and memory are the maximum over all ranks. The results
+     *   and baselines are stored as plain text, one metric per line:
+     *   \verbatim
+     *       case_name   n_refine   metric   value
+     *   \endverbatim
+     */
+    class PerformanceSuite:
+    public libMesh::ParallelObject {
+        
+    public:
+        
+        PerformanceSuite(const libMesh::Parallel::Communicator& comm);
+        
+        
+        virtual ~PerformanceSuite();
+        
+        
+        /*!
+         *   sets the tolerances used to identify regressions. A time metric
+         *   is flagged if it exceeds the baseline by more than the fraction
+         *   \p time_tol and by more than \p min_time seconds. The latter
+         *   keeps short phases from being flagged due to timer noise. Memory
+         *   is flagged if it exceeds the baseline by more than the fraction
+         *   \p memory_tol, and call counts are flagged on any increase.
+         */
+        void set_tolerances(const Real time_tol,
+                            const Real memory_tol,
+                            const Real min_time);
+        
+        
+        /*!
+         *   if \p f is true, the MAST::MemoryLog report is written to
+         *   libMesh::out at the end of each phase.
+         */
+        void set_memory_report(bool f) {
+            _memory_report = f;
+        }
+        
+        
+        /*!
+         *   begins the measurement of \p case_name at refinement level
+         *   \p n_refine.
+         */
+        void begin_case(const std::string& case_name,
+                        const unsigned int n_refine);
+        
+        
+        /*!
+         *   begins timing of the phase \p nm of the current case.
+         */
+        void begin_phase(const std::string& nm);
+        
+        
+        /*!
+         *   ends timing of the current phase.
+         */
+        void end_phase();
+        
+        
+        /*!
+         *   ends the current case and stores its metrics.
+         */
+        void end_case();
+        
+        
+        /*!
+         *   writes the metrics of all cases to \p nm. Only rank 0 writes.
+         */
+        void write(const std::string& nm) const;
+        
+        
+        /*!
+         *   compares the metrics with the baseline in \p nm and writes the
+         *   report to \p out.
+         *   @returns the number of regressions.
+         */
+        unsigned int compare(const std::string& nm,
+                             std::ostream& out) const;
+        
+        
+        /*!
+         *   @returns the peak resident set size of this process in MB
+         *   since the last call to reset_peak_memory(), or since the start
+         *   of the process if the peak cannot be reset on this platform.
+         */
+        static Real peak_memory();
+        
+        
+        /*!
+         *   resets the high-water mark of the resident set size. This is
+         *   supported on Linux only, and is a no-op elsewhere.
+         */
+        static void reset_peak_memory();
+        
+        
+        /*!
+         *   @returns the current wall clock time in seconds.
+         */
+        static Real wall_time();
+        
+        
+    protected:
+        
+        
+        /*!
+         *   metrics of a single case
+         */
+        struct Case {
+            
+            std::string                  name;
+            unsigned int                 n_refine;
+            std::map<std::string, Real>  metrics;
+        };
+        
+        
+        /*!
+         *   adds the time and call counts from the performance log to the
+         *   metrics of \p c.
+         */
+        void _add_perflog_metrics(MAST::PerformanceSuite::Case& c) const;
+        
+        
+        /*!
+         *   @returns the phase name that the performance log event
+         *   \p label with header \p header is accounted to.
+         */
+        static std::string _perflog_phase(const std::string& header,
+                                          const std::string& label);
+        
+        
+        /*!
+         *   tolerances for regressions
+         */
+        Real _time_tol, _memory_tol, _min_time;
+        
+        
+        /*!
+         *   true between begin_case() and end_case()
+         */
+        bool _in_case;
+        
+        
+        /*!
+         *   true if the memory report is written at the end of each phase
+         */
+        bool _memory_report;
+        
+        
+        /*!
+         *   current case
+         */
+        MAST::PerformanceSuite::Case _current;
+        
+        
+        /*!
+         *   current phase and its starting time
+         */
+        std::string _phase;
+        Real        _phase_start, _case_start;
+        
+        
+        /*!
+         *   completed cases
+         */
+        std::vector<MAST::PerformanceSuite::Case> _cases;
+    };
+}
+
+#endif // __mast__performance_suite_h__
@@ -297,6 +297,20 @@ MAST::PanelInviscidAnalysis2D::solve(bool if_write_output) {
                                           *_fluid_sys);
     
     MAST::NonlinearSystem&  nonlin_sys = _fluid_sys->system();
+    
+    // use the Jacobian-free Newton-Krylov solution if requested. The
+    // fluid elements compute the exact Jacobian-vector products without
+    // element Jacobians, and the cheaper frozen-coefficient Jacobian is
+    // used as preconditioner, which is stored in single precision with
+    // --single_precision_pc.
+    if (libMesh::on_command_line("--jfnk")) {
+        
+        nonlin_sys.set_jacobian_free_newton_krylov
+        (true, libMesh::command_line_value("--jfnk_pc_lag", -1), false);
+        nonlin_sys.set_single_precision_preconditioner
+        (libMesh::on_command_line("--single_precision_pc"));
+        assembly.set_frozen_coefficient_preconditioner(true);
+    }
 
     
     // file to write the solution for visualization
@@ -350,6 +350,10 @@ solve(bool if_write_output) {
     assembly.set_base_solution(base_sol);
     assembly.set_frequency_function(*_freq_function);
     
+    // the preconditioner may be stored in single precision
+    solver.set_single_precision_preconditioner
+    (libMesh::on_command_line("--single_precision_pc"));
+    
     solver.solve_block_matrix();
     
     if (if_write_output) {
@@ -468,6 +472,10 @@ sensitivity_solve(MAST::Parameter& p, bool if_write_output) {
     assembly.set_base_solution(base_sol);
     assembly.set_frequency_function(*_freq_function);
     
+    // the preconditioner may be stored in single precision
+    solver.set_single_precision_preconditioner
+    (libMesh::on_command_line("--single_precision_pc"));
+    
     solver.solve_block_matrix(&p);
     
     if (if_write_output) {
@@ -102,13 +102,13 @@ beam_euler_flutter_optim_obj(int*    mode,
         dvars[i] = x[i];
     
     
-    __my_func_eval->evaluate(dvars,
-                             obj,
-                             true,       // request the derivatives of obj
-                             obj_grad,
-                             fvals,
-                             eval_grads,
-                             grads);
+    __my_func_eval->cached_evaluate(dvars,
+                                    obj,
+                                    true,       // request the derivatives of obj
+                                    obj_grad,
+                                    fvals,
+                                    eval_grads,
+                                    grads);
     
     
     // now copy them back as necessary
@@ -163,13 +163,13 @@ beam_euler_flutter_optim_con(int*    mode,
         dvars[i] = x[i];
     
     
-    __my_func_eval->evaluate(dvars,
-                             obj,
-                             true,       // request the derivatives of obj
-                             obj_grad,
-                             fvals,
-                             eval_grads,
-                             grads);
+    __my_func_eval->cached_evaluate(dvars,
+                                    obj,
+                                    true,       // request the derivatives of obj
+                                    obj_grad,
+                                    fvals,
+                                    eval_grads,
+                                    grads);
     
     
     // now copy them back as necessary
@@ -285,7 +285,7 @@ MAST::BeamFSIFlutterSizingOptimization::init(GetPot &infile,
     //////////////////////////////////////////////////////////////////////
     
     // initialize the libMesh object
-    _fluid_mesh              = new libMesh::ParallelMesh(__init->comm());
+    _fluid_mesh              = new libMesh::ParallelMesh(this->comm());
     _fluid_eq_sys            = new libMesh::EquationSystems(*_fluid_mesh);
     
     
@@ -537,7 +537,7 @@ MAST::BeamFSIFlutterSizingOptimization::init(GetPot &infile,
     }
     
     // create the mesh
-    _structural_mesh       = new libMesh::SerialMesh(__init->comm());
+    _structural_mesh       = new libMesh::SerialMesh(this->comm());
     
     MeshInitializer().init(divs, *_structural_mesh, libMesh::EDGE2);
     
@@ -959,8 +959,8 @@ MAST::BeamFSIFlutterSizingOptimization::evaluate(const std::vector<Real>& dvars,
     _flutter_solver->clear();
     
     std::ostringstream oss;
-    oss << "flutter_output_" << __init->comm().rank() << ".txt";
-    if (__init->comm().rank() == 0)
+    oss << "flutter_output_" << this->comm().rank() << ".txt";
+    if (this->comm().rank() == 0)
         _flutter_solver->set_output_file(oss.str());
     
     _gaf_database->attach_discipline_and_system(*_structural_discipline,
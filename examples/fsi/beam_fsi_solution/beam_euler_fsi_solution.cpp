@@ -48,6 +48,7 @@
 #include "solver/first_order_newmark_transient_solver.h"
 #include "solver/second_order_newmark_transient_solver.h"
 #include "solver/multiphysics_nonlinear_solver.h"
+#include "solver/partitioned_multiphysics_solver.h"
 #include "solver/slepc_eigen_solver.h"
 #include "examples/base/augment_ghost_elem_send_list.h"
 
@@ -60,6 +61,8 @@
 #include "libmesh/getpot.h"
 #include "libmesh/string_to_enum.h"
 #include "libmesh/nonlinear_solver.h"
+#include "libmesh/dof_map.h"
+#include "libmesh/boundary_info.h"
 
 
 extern libMesh::LibMeshInit* __init;
@@ -760,6 +763,66 @@ MAST::BeamEulerFSIAnalysis::solve(bool if_write_output,
     fsi_solver.set_system_assembly(0,      fluid_assembly);
     fsi_solver.set_system_assembly(1, structural_assembly);
     
+    // the beam has few dofs, so the fluid-structure coupling block can be
+    // assembled once per Newton iteration instead of sweeping over the
+    // fluid mesh at each Krylov iteration. The fluid residual depends on
+    // the structural solution only through the slip-wall condition on the
+    // panel, so each fluid dof on an element adjacent to the panel is
+    // coupled to all structural dofs.
+    if (libMesh::on_command_line("--assemble_fsi_coupling")) {
+        
+        // boundary id of the panel, from init()
+        const libMesh::boundary_id_type
+        panel_bc_id = 10;
+        
+        const libMesh::DofMap
+        &fluid_dof_map = _fluid_sys->get_dof_map();
+        
+        const libMesh::dof_id_type
+        first          = fluid_dof_map.first_dof(),
+        last           = fluid_dof_map.end_dof();
+        
+        std::vector<libMesh::dof_id_type>
+        structural_dofs(_structural_sys->n_dofs()),
+        dof_indices;
+        
+        for (libMesh::dof_id_type k=0; k<structural_dofs.size(); k++)
+            structural_dofs[k] = k;
+        
+        std::vector<std::vector<libMesh::dof_id_type> >
+        sparsity(fluid_dof_map.n_local_dofs());
+        
+        libMesh::MeshBase::const_element_iterator
+        el     = _fluid_mesh->active_elements_begin();
+        const libMesh::MeshBase::const_element_iterator
+        end_el = _fluid_mesh->active_elements_end();
+        
+        for ( ; el != end_el; ++el)
+            for (unsigned short int s=0; s<(*el)->n_sides(); s++)
+                if (_fluid_mesh->get_boundary_info().has_boundary_id(*el, s, panel_bc_id)) {
+                    
+                    fluid_dof_map.dof_indices(*el, dof_indices);
+                    
+                    for (unsigned int r=0; r<dof_indices.size(); r++)
+                        if (first <= dof_indices[r] && dof_indices[r] < last)
+                            sparsity[dof_indices[r]-first] = structural_dofs;
+                    break;
+                }
+        
+        fsi_solver.set_assembled_coupling_block(0, 1, &sparsity);
+    }
+    
+    // the partitioned solver alternates between the fluid and structural
+    // solves, with the structural solution relaxed by IQN-ILS
+    const bool
+    if_partitioned = libMesh::on_command_line("--partitioned_fsi");
+    
+    MAST::PartitionedMultiphysicsSolver partitioned_solver(__init->comm(), "fsi", 2);
+    partitioned_solver.acceleration = MAST::IQN_ILS;
+    partitioned_solver.set_pre_residual_update_object(bc_updates);
+    partitioned_solver.set_system_assembly(0,      fluid_assembly);
+    partitioned_solver.set_system_assembly(1, structural_assembly);
+    
     while ((t_step <= _max_time_steps) && (vel_1  >=  1.e-8)) {
 
         // change dt if the iteration count has increased to threshold
@@ -797,7 +860,10 @@ MAST::BeamEulerFSIAnalysis::solve(bool if_write_output,
                                                 t_step+1,
                                                 _structural_sys->time);
 
-        fsi_solver.solve();
+        if (if_partitioned)
+            partitioned_solver.solve();
+        else
+            fsi_solver.solve();
 
         fluid_transient_solver.advance_time_step();
         structural_transient_solver.advance_time_step();
@@ -317,6 +317,13 @@ _augment_send_list_obj                 (nullptr) {
     
     _pressure_function->set_calculate_cp(true);
     _freq_domain_pressure_function->set_calculate_cp(true);
+    
+    // the structure only needs the pressure on the panel, so only the
+    // fluid dofs on that boundary are localized for the coupling
+    std::set<libMesh::boundary_id_type> panel_bids;
+    panel_bids.insert(panel_bc_id);
+    _pressure_function->use_boundary_trace(panel_bids);
+    _freq_domain_pressure_function->use_boundary_trace(panel_bids);
 
     _k_upper            = infile("k_upper",  0.75);
     _k_lower            = infile("k_lower",  0.05);
@@ -52,7 +52,9 @@ _initialized(false) {
 
 
 void
-MAST::BeamBending::init(libMesh::ElemType etype, bool if_nonlin) {
+MAST::BeamBending::init(libMesh::ElemType etype,
+                        bool if_nonlin,
+                        unsigned int n_refine) {
     
     
     libmesh_assert(!_initialized);
@@ -65,7 +67,7 @@ MAST::BeamBending::init(libMesh::ElemType etype, bool if_nonlin) {
     _mesh       = new libMesh::SerialMesh(__init->comm());
     
     // initialize the mesh with one element
-    libMesh::MeshTools::Generation::build_line(*_mesh, 5, 0, _length);
+    libMesh::MeshTools::Generation::build_line(*_mesh, 5*pow(2, n_refine), 0, _length);
     
     // create the equation system
     _eq_sys    = new  libMesh::EquationSystems(*_mesh);
@@ -133,7 +133,8 @@ _initialized(false) {
 
 void
 MAST::BeamColumnBucklingAnalysis::init(libMesh::ElemType etype,
-                                       bool if_nonlin) {
+                                       bool if_nonlin,
+                                       unsigned int n_refine) {
     
 
     libmesh_assert(!_initialized);
@@ -144,7 +145,7 @@ MAST::BeamColumnBucklingAnalysis::init(libMesh::ElemType etype,
     _length     = 10.;
     
     // initialize the mesh with one element
-    libMesh::MeshTools::Generation::build_line(*_mesh, 50, 0, _length, etype);
+    libMesh::MeshTools::Generation::build_line(*_mesh, 50*pow(2, n_refine), 0, _length, etype);
     
     // create the equation system
     _eq_sys    = new  libMesh::EquationSystems(*_mesh);
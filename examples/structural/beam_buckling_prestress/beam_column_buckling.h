@@ -63,9 +63,12 @@ namespace MAST {
         
         
         /*!
-         *   initializes the object for specified characteristics
+         *   initializes the object for specified characteristics. The number
+         *   of elements along each coordinate is scaled by 2^n_refine.
          */
-        void init(libMesh::ElemType etype, bool if_nonlin);
+        void init(libMesh::ElemType etype,
+                  bool if_nonlin,
+                  unsigned int n_refine = 0);
 
         
         /*!
@@ -51,7 +51,8 @@ _initialized(false) {
 
 void
 MAST::BeamModalAnalysis::init(libMesh::ElemType etype,
-                              bool if_nonlin) {
+                              bool if_nonlin,
+                              unsigned int n_refine) {
 
     libmesh_assert(!_initialized);
     libmesh_assert(!if_nonlin); // this case does not handle nonlinearity
@@ -62,7 +63,7 @@ MAST::BeamModalAnalysis::init(libMesh::ElemType etype,
     _length     = 10.;
     
     // initialize the mesh with one element
-    libMesh::MeshTools::Generation::build_line(*_mesh, 50, 0, _length, etype);
+    libMesh::MeshTools::Generation::build_line(*_mesh, 50*pow(2, n_refine), 0, _length, etype);
     
     // create the equation system
     _eq_sys    = new  libMesh::EquationSystems(*_mesh);
@@ -62,9 +62,12 @@ namespace MAST {
         
         
         /*!
-         *   initializes the object for specified characteristics
+         *   initializes the object for specified characteristics. The number
+         *   of elements along each coordinate is scaled by 2^n_refine.
          */
-        void init(libMesh::ElemType etype, bool if_nonlin);
+        void init(libMesh::ElemType etype,
+                  bool if_nonlin,
+                  unsigned int n_refine = 0);
         
         /*!
          *   @returns a pointer to the parameter of the specified name.
@@ -83,13 +83,13 @@ beam_optim_obj(int*    mode,
         dvars[i] = x[i];
     
     
-    __my_func_eval->evaluate(dvars,
-                             obj,
-                             true,       // request the derivatives of obj
-                             obj_grad,
-                             fvals,
-                             eval_grads,
-                             grads);
+    __my_func_eval->cached_evaluate(dvars,
+                                    obj,
+                                    true,       // request the derivatives of obj
+                                    obj_grad,
+                                    fvals,
+                                    eval_grads,
+                                    grads);
     
     
     // now copy them back as necessary
@@ -144,13 +144,13 @@ beam_optim_con(int*    mode,
         dvars[i] = x[i];
     
     
-    __my_func_eval->evaluate(dvars,
-                             obj,
-                             true,       // request the derivatives of obj
-                             obj_grad,
-                             fvals,
-                             eval_grads,
-                             grads);
+    __my_func_eval->cached_evaluate(dvars,
+                                    obj,
+                                    true,       // request the derivatives of obj
+                                    obj_grad,
+                                    fvals,
+                                    eval_grads,
+                                    grads);
     
     
     // now copy them back as necessary
@@ -205,7 +205,7 @@ MAST::BeamBendingSizingOptimization::init(GetPot &infile,
     _stress_limit  = infile("max_stress", 4.00e8);
     
     // create the mesh
-    _mesh          = new libMesh::SerialMesh(__init->comm());
+    _mesh          = new libMesh::SerialMesh(this->comm());
     
     // initialize the mesh with one element
     libMesh::MeshTools::Generation::build_line(*_mesh, _n_elems, 0, _length, etype);
@@ -57,7 +57,8 @@ _flutter_root(nullptr) { }
 
 void
 MAST::BeamPistonTheoryFlutterAnalysis::init(libMesh::ElemType etype,
-                                            bool if_nonlin) {
+                                            bool if_nonlin,
+                                            unsigned int n_refine) {
     
     libmesh_assert(!_initialized);
     
@@ -66,7 +67,7 @@ MAST::BeamPistonTheoryFlutterAnalysis::init(libMesh::ElemType etype,
     _length     = 10.;
     
     // initialize the mesh with one element
-    libMesh::MeshTools::Generation::build_line(*_mesh, 50, 0, _length);
+    libMesh::MeshTools::Generation::build_line(*_mesh, 50*pow(2, n_refine), 0, _length);
     
     // create the equation system
     _eq_sys    = new  libMesh::EquationSystems(*_mesh);
@@ -302,6 +303,9 @@ MAST::BeamPistonTheoryFlutterAnalysis::solve(bool if_write_output,
     std::string nm("flutter_output.txt");
     if (__init->comm().rank() == 0)
         _flutter_solver->set_output_file(nm);
+    // the structure is linearized about a velocity independent base
+    // state, so the piston theory matrices are assembled only once
+    _flutter_solver->set_velocity_affine_aerodynamics(true);
 
     
     // set the velocity of piston theory to zero for modal analysis
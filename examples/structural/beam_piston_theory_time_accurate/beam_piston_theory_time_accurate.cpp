@@ -380,13 +380,18 @@ MAST::BeamPistonTheoryTimeAccurateAnalysis::solve(bool if_write_output) {
     
     // time solver parameters
     Real
-    tval     = 0.;
+    tval     = 0.,
+    t_final  = 1.;
     
     unsigned int
-    t_step            = 0,
-    n_steps           = 1000;
+    t_step            = 0;
 
-    solver.dt         = 1.0e-3;
+    // the time step is adapted based on the local truncation error
+    // estimate, starting from the initial value specified here.
+    solver.dt              = 1.0e-3;
+    solver.min_dt          = 1.0e-5;
+    solver.max_dt          = 1.0e-2;
+    solver.error_tolerance = 1.0e-3;
     
     
     
@@ -400,7 +405,7 @@ MAST::BeamPistonTheoryTimeAccurateAnalysis::solve(bool if_write_output) {
     dof = out_n->dof_number(_sys->number(), 1, 0);
     
     // loop over time steps
-    while (t_step < n_steps) {
+    while (tval < t_final) {
         
         libMesh::out
         << "Time step: " << t_step
@@ -423,14 +428,15 @@ MAST::BeamPistonTheoryTimeAccurateAnalysis::solve(bool if_write_output) {
             << solver.velocity()(dof) << std::endl;
         }
         
-        solver.solve();
-        
-        solver.advance_time_step();
-        
-        tval  += solver.dt;
+        tval  += solver.solve_and_advance_adaptive_time_step();
         t_step++;
     }
     
+    libMesh::out
+    << "Number of time steps: " << t_step
+    << " :  rejected steps: " << solver.n_rejected_steps()
+    << std::endl;
+    
     assembly.clear_discipline_and_system();
     
     o.close();
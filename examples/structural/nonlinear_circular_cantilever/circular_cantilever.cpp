@@ -1,6 +1,8 @@
 
 // C++ includes
 #include <iostream>
+#include <iomanip>
+#include <vector>
 
 
 // MAST includes
@@ -14,6 +16,9 @@
 #include "property_cards/isotropic_material_property_card.h"
 #include "property_cards/isotropic_element_property_card_3D.h"
 #include "base/nonlinear_system.h"
+#include "solver/jacobian_lagging_policy.h"
+#include "base/performance_log.h"
+#include "base/memory_log.h"
 
 
 // libMesh includes
@@ -176,28 +181,129 @@ int main_1(int argc, const char * argv[]) {
     // create the nonlinear assembly object
     MAST::StructuralNonlinearAssembly   assembly;
 
+    // use the Jacobian-free Newton-Krylov solution if requested. The
+    // preconditioner is the linear stiffness matrix, assembled once for
+    // all load steps, unless --jfnk_pc_lag is specified, and is stored in
+    // single precision with --single_precision_pc. The Jacobian-vector
+    // product is computed from the elements, unless --jfnk_fd_product is
+    // specified. With --jfnk_compare the load steps are solved first
+    // with Newton's method and then with JFNK, and the iteration counts,
+    // assemblies and memory of the two are written at the end. The
+    // counts are obtained from the MAST performance log, which needs
+    // MAST_ENABLE_TIMERS.
+    const bool
+    if_compare = libMesh::on_command_line("--jfnk_compare");
+    
+#if MAST_ENABLE_TIMERS != 1
+    if (if_compare)
+        libmesh_error_msg("Error: --jfnk_compare needs MAST to be built with "
+                          "MAST_ENABLE_TIMERS.");
+#endif
+    
+    sys.set_single_precision_preconditioner
+    (libMesh::on_command_line("--single_precision_pc"));
+    
+    // the Jacobian changes slowly between iterations and load steps, so
+    // it can be reused if requested on the command line
+    MAST::JacobianLaggingPolicy lagging;
+    lagging.max_lagged_iterations = libMesh::command_line_value("--jacobian_lag", 0);
+    lagging.reuse_across_solves   = libMesh::on_command_line("--jacobian_reuse_across_load_steps");
+    sys.set_jacobian_lagging_policy(&lagging);
+    
+    // the counters are obtained from the MAST performance log
+#if MAST_ENABLE_TIMERS == 1
+    if (!MAST::PerformanceLog::enabled())
+        MAST::PerformanceLog::enable(init.comm());
+#endif
+    
+    const char*
+    counters[] = {"nonlinear_iterations", "ksp_iterations",
+        "residuals", "jacobians"};
+    
+    std::vector<std::vector<unsigned long> >
+    counts(2, std::vector<unsigned long>(4, 0));
+    std::vector<std::size_t>
+    mem(2, 0);
+    
     // write the solution for visualization
     libMesh::ExodusII_IO out(mesh);
 
-    // now solve the system
-    for (unsigned int i=0; i<n_load_steps; i++) {
-
-        p = 600.*(i+1)/n_load_steps;
+    for (unsigned int k=0; k<(if_compare?2:1); k++) {
+        
+        const bool
+        if_jfnk = if_compare? (k == 1) : libMesh::on_command_line("--jfnk");
         
-        assembly.attach_discipline_and_system(structural_discipline, structural_sys);
+        sys.set_jacobian_free_newton_krylov
+        (if_jfnk,
+         libMesh::command_line_value("--jfnk_pc_lag", 0),
+         libMesh::on_command_line("--jfnk_fd_product"));
         
-        MAST::NonlinearSystem&  nonlin_sys   =
-        assembly.system();
+        sys.solution->zero();
+        lagging.reset();
+#if MAST_ENABLE_TIMERS == 1
+        MAST::PerformanceLog::clear();
+#endif
+        MAST::MemoryLog::reset_peaks();
         
-        nonlin_sys.solve();
+        // now solve the system
+        for (unsigned int i=0; i<n_load_steps; i++) {
+            
+            p = 600.*(i+1)/n_load_steps;
+            
+            assembly.attach_discipline_and_system(structural_discipline, structural_sys);
+            
+            MAST::NonlinearSystem&  nonlin_sys   =
+            assembly.system();
+            
+            nonlin_sys.solve();
+            
+            assembly.clear_discipline_and_system();
+            
+            if (!if_compare) {
+                
+                sys.solution->print();
+                
+                out.write_timestep("out.exo", eq_sys, i, (i+1.)/n_load_steps);
+            }
+        }
         
-        assembly.clear_discipline_and_system();
+#if MAST_ENABLE_TIMERS == 1
+        for (unsigned int j=0; j<4; j++)
+            counts[k][j] = MAST::PerformanceLog::counter(counters[j]);
+#endif
         
-        sys.solution->print();
+        // the system matrix is allocated in both cases. The peak of the
+        // memory accounted by MAST includes the single precision
+        // preconditioner.
+        mem[k] = MAST::MemoryLog::bytes(*sys.matrix) + MAST::MemoryLog::total_peak();
         
-        out.write_timestep("out.exo", eq_sys, i, (i+1.)/n_load_steps);
+        libMesh::out
+        << "Jacobian assemblies: " << lagging.n_jacobian_assemblies()
+        << " , reuses: " << lagging.n_jacobian_reuses() << std::endl;
     }
     
+    if (if_compare) {
+        
+        libMesh::out
+        << std::endl
+        << std::setw(25) << " "
+        << std::setw(15) << "Newton"
+        << std::setw(15) << "JFNK" << std::endl;
+        
+        for (unsigned int j=0; j<4; j++)
+            libMesh::out
+            << std::setw(25) << counters[j]
+            << std::setw(15) << counts[0][j]
+            << std::setw(15) << counts[1][j] << std::endl;
+        
+        libMesh::out
+        << std::setw(25) << "memory (bytes)"
+        << std::setw(15) << mem[0]
+        << std::setw(15) << mem[1] << std::endl;
+    }
+    
+    sys.set_jacobian_lagging_policy(nullptr);
+    
     
     return 0;
 }
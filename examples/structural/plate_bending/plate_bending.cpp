@@ -58,7 +58,8 @@ _initialized(false) {
 
 void
 MAST::PlateBending::init(libMesh::ElemType e_type,
-                         bool if_vk) {
+                         bool if_vk,
+                         unsigned int n_refine) {
     
     
     libmesh_assert(!_initialized);
@@ -74,7 +75,7 @@ MAST::PlateBending::init(libMesh::ElemType e_type,
     
     // initialize the mesh with one element
     libMesh::MeshTools::Generation::build_square(*_mesh,
-                                                 16, 16,
+                                                 16*pow(2, n_refine), 16*pow(2, n_refine),
                                                  0, _length,
                                                  0, _width,
                                                  e_type);
@@ -27,6 +27,7 @@
 #include "optimization/function_evaluation.h"
 #include "elasticity/structural_nonlinear_assembly.h"
 #include "base/nonlinear_system.h"
+#include "solver/reduced_basis_static_surrogate.h"
 
 
 // libMesh includes
@@ -82,13 +83,13 @@ plate_optim_obj(int*    mode,
         dvars[i] = x[i];
     
     
-    __my_func_eval->evaluate(dvars,
-                             obj,
-                             true,       // request the derivatives of obj
-                             obj_grad,
-                             fvals,
-                             eval_grads,
-                             grads);
+    __my_func_eval->cached_evaluate(dvars,
+                                    obj,
+                                    true,       // request the derivatives of obj
+                                    obj_grad,
+                                    fvals,
+                                    eval_grads,
+                                    grads);
     
     
     // now copy them back as necessary
@@ -143,13 +144,13 @@ plate_optim_con(int*    mode,
         dvars[i] = x[i];
     
     
-    __my_func_eval->evaluate(dvars,
-                             obj,
-                             true,       // request the derivatives of obj
-                             obj_grad,
-                             fvals,
-                             eval_grads,
-                             grads);
+    __my_func_eval->cached_evaluate(dvars,
+                                    obj,
+                                    true,       // request the derivatives of obj
+                                    obj_grad,
+                                    fvals,
+                                    eval_grads,
+                                    grads);
     
     
     // now copy them back as necessary
@@ -176,7 +177,8 @@ _initialized(false),
 _n_divs_x(0),
 _n_divs_y(0),
 _n_elems(0),
-_n_stations_x(0) { }
+_n_stations_x(0),
+_rb_surrogate(nullptr) { }
 
 
 
@@ -216,7 +218,7 @@ MAST::PlateBendingSizingOptimization::init(GetPot& infile,
     _stress_limit  = infile("max_stress", 4.00e8);
     
     // create the mesh
-    _mesh          = new libMesh::SerialMesh(__init->comm());
+    _mesh          = new libMesh::SerialMesh(this->comm());
     
     // initialize the mesh with one element
     libMesh::MeshTools::Generation::build_square(*_mesh,
@@ -425,6 +427,21 @@ MAST::PlateBendingSizingOptimization::init(GetPot& infile,
     
     _assembly->attach_discipline_and_system(*_discipline, *_structural_sys);
     
+    // the linear solutions at the design iterates can be computed from a
+    // reduced basis of the previous solutions, with a fallback to the
+    // full-order model when the error estimate exceeds the tolerance.
+    if (!if_vk && libMesh::on_command_line("--reduced_basis")) {
+        
+        _rb_surrogate = new MAST::ReducedBasisStaticSurrogate(*_sys, *_assembly);
+        
+        for (unsigned int i=0; i<_n_vars; i++)
+            _rb_surrogate->add_parameter(*_th_station_parameters[i],
+                                         0.25*_dv_scaling[i]);
+        
+        _rb_surrogate->set_error_tolerance
+        (libMesh::command_line_value("--reduced_basis_tol", 1.e-4));
+    }
+    
     
     // create the function to calculate weight
     _weight = new MAST::PlateWeight(*_discipline);
@@ -464,6 +481,8 @@ MAST::PlateBendingSizingOptimization::~PlateBendingSizingOptimization() {
         
         delete _weight;
         
+        delete _rb_surrogate;
+        
         _assembly->clear_discipline_and_system();
         delete _assembly;
         
@@ -573,13 +592,55 @@ MAST::PlateBendingSizingOptimization::evaluate(const std::vector<Real>& dvars,
     Real
     p0      = (*_press)();
     
-    // now iterate over the load steps
-    for (unsigned int i=0; i<n_steps; i++) {
+    // check if the sensitivity of the constraint functions is requested
+    bool if_sens = false;
+    
+    for (unsigned int i=0; i<eval_grads.size(); i++)
+        if_sens = (if_sens || eval_grads[i]);
+    
+    // true if the reduced-basis solution and sensitivities are used
+    bool
+    if_reduced = false;
+    
+    if (_rb_surrogate) {
+        
+        // the basis and decomposition are updated after every few
+        // full-order solutions, which include the first evaluations
+        if (_rb_surrogate->n_new_snapshots() >=
+            (unsigned int)libMesh::command_line_value("--reduced_basis_update", 5))
+            _rb_surrogate->build();
+        
+        if_reduced = _rb_surrogate->solve();
+        
+        // the reduced solution is used with gradients only if the reduced
+        // sensitivities of all parameters are within the tolerance.
+        // Otherwise, the gradients are computed by the full-order
+        // sensitivity solve, which must be linearized about the
+        // full-order solution.
+        if (if_reduced && if_sens)
+            for (unsigned int i=0; i<_n_vars; i++)
+                if (!_rb_surrogate->sensitivity_solve(*_th_station_parameters[i],
+                                                      nullptr)) {
+                    
+                    if_reduced = _rb_surrogate->solve(true);
+                    break;
+                }
+        
         libMesh::out
-        << "Load step: " << i << std::endl;
+        << (if_reduced? "Reduced-basis solution, ": "Full-order solution, ")
+        << "error estimate: " << _rb_surrogate->error_estimate()
+        << ", basis size: "   << _rb_surrogate->n_basis() << std::endl;
+    }
+    else {
         
-        (*_press)()  =  p0*(i+1.)/(1.*n_steps);
-        _sys->solve();
+        // now iterate over the load steps
+        for (unsigned int i=0; i<n_steps; i++) {
+            libMesh::out
+            << "Load step: " << i << std::endl;
+            
+            (*_press)()  =  p0*(i+1.)/(1.*n_steps);
+            _sys->solve();
+        }
     }
 
     // calculate the stresses
@@ -620,12 +681,6 @@ MAST::PlateBendingSizingOptimization::evaluate(const std::vector<Real>& dvars,
     }
     
     
-    // now check if the sensitivity of objective function is requested
-    bool if_sens = false;
-    
-    for (unsigned int i=0; i<eval_grads.size(); i++)
-        if_sens = (if_sens || eval_grads[i]);
-    
     if (if_sens) {
         
         //////////////////////////////////////////////////////////////////
@@ -645,7 +700,16 @@ MAST::PlateBendingSizingOptimization::evaluate(const std::vector<Real>& dvars,
             this->clear_stresss();
             
             // sensitivity analysis
-            _sys->sensitivity_solve(params);
+            if (if_reduced) {
+                
+                // this was checked to be within the tolerance above
+                if (!_rb_surrogate->sensitivity_solve(*_th_station_parameters[i],
+                                                      &_sys->add_sensitivity_solution(0)))
+                    libmesh_error_msg("Error: reduced-basis sensitivity is not"
+                                      << " within the tolerance.");
+            }
+            else
+                _sys->sensitivity_solve(params);
             
             // evaluate sensitivity of the outputs
             _assembly->calculate_output_sensitivity(params,
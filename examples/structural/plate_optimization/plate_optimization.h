@@ -70,6 +70,7 @@ namespace MAST {
     class BoundaryConditionBase;
     class StressStrainOutputBase;
     class StructuralNonlinearAssembly;
+    class ReducedBasisStaticSurrogate;
     
     
     struct PlateBendingSizingOptimization:
@@ -233,6 +234,12 @@ namespace MAST {
         _dv_scaling,
         _dv_low,
         _dv_init;
+        
+        /*!
+         *   surrogate for the linear static solutions, used if the
+         *   analysis is run with \p --reduced_basis
+         */
+        MAST::ReducedBasisStaticSurrogate*              _rb_surrogate;
     };
 }
 
@@ -59,7 +59,8 @@ _initialized(false) {
 
 void
 MAST::PlatePistonTheoryFlutterAnalysis::init(libMesh::ElemType e_type,
-                                             bool if_vk) {
+                                             bool if_vk,
+                                             unsigned int n_refine) {
     
     
     libmesh_assert(!_initialized);
@@ -75,7 +76,7 @@ MAST::PlatePistonTheoryFlutterAnalysis::init(libMesh::ElemType e_type,
     
     // initialize the mesh with one element
     libMesh::MeshTools::Generation::build_square(*_mesh,
-                                                 32, 32,
+                                                 32*pow(2, n_refine), 32*pow(2, n_refine),
                                                  0, _length,
                                                  0, _width,
                                                  e_type);
@@ -316,6 +317,9 @@ MAST::PlatePistonTheoryFlutterAnalysis::solve(bool if_write_output,
     std::string nm("flutter_output.txt");
     if (__init->comm().rank() == 0)
         _flutter_solver->set_output_file(nm);
+    // the structure is linearized about a velocity independent base
+    // state, so the piston theory matrices are assembled only once
+    _flutter_solver->set_velocity_affine_aerodynamics(true);
     
     // set the velocity of piston theory to zero for modal analysis
     (*_velocity) = 0.;
@@ -66,9 +66,12 @@ namespace MAST {
         
         
         /*!
-         *   initializes the object for specified characteristics
+         *   initializes the object for specified characteristics. The number
+         *   of elements along each coordinate is scaled by 2^n_refine.
          */
-        void init(libMesh::ElemType e_type, bool if_vk);
+        void init(libMesh::ElemType e_type,
+                  bool if_vk,
+                  unsigned int n_refine = 0);
         
         
         /*!
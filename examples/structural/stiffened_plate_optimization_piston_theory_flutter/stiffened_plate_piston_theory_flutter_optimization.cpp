@@ -90,13 +90,13 @@ stiffened_plate_piston_theory_flutter_optim_obj(int*    mode,
         dvars[i] = x[i];
     
     
-    __my_func_eval->evaluate(dvars,
-                             obj,
-                             true,       // request the derivatives of obj
-                             obj_grad,
-                             fvals,
-                             eval_grads,
-                             grads);
+    __my_func_eval->cached_evaluate(dvars,
+                                    obj,
+                                    true,       // request the derivatives of obj
+                                    obj_grad,
+                                    fvals,
+                                    eval_grads,
+                                    grads);
     
     
     // now copy them back as necessary
@@ -151,13 +151,13 @@ stiffened_plate_piston_theory_flutter_optim_con(int*    mode,
         dvars[i] = x[i];
     
     
-    __my_func_eval->evaluate(dvars,
-                             obj,
-                             true,       // request the derivatives of obj
-                             obj_grad,
-                             fvals,
-                             eval_grads,
-                             grads);
+    __my_func_eval->cached_evaluate(dvars,
+                                    obj,
+                                    true,       // request the derivatives of obj
+                                    obj_grad,
+                                    fvals,
+                                    eval_grads,
+                                    grads);
     
     
     // now copy them back as necessary
@@ -239,7 +239,7 @@ init(GetPot& infile,
     _stress_limit  = infile("max_stress", 4.00e8);
     
     // create the mesh
-    _mesh          = new libMesh::SerialMesh(__init->comm());
+    _mesh          = new libMesh::SerialMesh(this->comm());
     
     // initialize the mesh with one element
     MAST::StiffenedPanelMesh panel_mesh;
@@ -443,8 +443,14 @@ init(GetPot& infile,
     // flutter solver
     _flutter_solver  = new MAST::TimeDomainFlutterSolver;
     std::string nm("flutter_output.txt");
-    if (__init->comm().rank() == 0)
+    if (this->comm().rank() == 0)
         _flutter_solver->set_output_file(nm);
+    // the structure is linearized about a velocity independent base
+    // state, so the piston theory matrices are assembled only once
+    _flutter_solver->set_velocity_affine_aerodynamics(true);
+    // the eigensolutions of the velocity scan can use the libMesh threads
+    _flutter_solver->set_threaded_eigensolution
+    (libMesh::on_command_line("--threaded_eigensolution"));
 
     
     // now add the property cards for each stiffener
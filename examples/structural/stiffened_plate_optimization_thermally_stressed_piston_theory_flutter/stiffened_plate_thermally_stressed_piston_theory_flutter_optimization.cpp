@@ -91,13 +91,13 @@ stiffened_plate_thermally_stressed_piston_theory_flutter_optim_obj(int*    mode,
         dvars[i] = x[i];
     
     
-    __my_func_eval->evaluate(dvars,
-                             obj,
-                             true,       // request the derivatives of obj
-                             obj_grad,
-                             fvals,
-                             eval_grads,
-                             grads);
+    __my_func_eval->cached_evaluate(dvars,
+                                    obj,
+                                    true,       // request the derivatives of obj
+                                    obj_grad,
+                                    fvals,
+                                    eval_grads,
+                                    grads);
     
     
     // now copy them back as necessary
@@ -152,13 +152,13 @@ stiffened_plate_thermally_stressed_piston_theory_flutter_optim_con(int*    mode,
         dvars[i] = x[i];
     
     
-    __my_func_eval->evaluate(dvars,
-                             obj,
-                             true,       // request the derivatives of obj
-                             obj_grad,
-                             fvals,
-                             eval_grads,
-                             grads);
+    __my_func_eval->cached_evaluate(dvars,
+                                    obj,
+                                    true,       // request the derivatives of obj
+                                    obj_grad,
+                                    fvals,
+                                    eval_grads,
+                                    grads);
     
     
     // now copy them back as necessary
@@ -286,7 +286,7 @@ init(GetPot& infile,
     _stress_limit  = infile("max_stress", 4.00e8);
     
     // create the mesh
-    _mesh          = new libMesh::SerialMesh(__init->comm());
+    _mesh          = new libMesh::SerialMesh(this->comm());
     
     // initialize the mesh with one element
     MAST::StiffenedPanelMesh panel_mesh;
@@ -666,7 +666,7 @@ init(GetPot& infile,
     // flutter solver
     _flutter_solver  = new MAST::TimeDomainFlutterSolver;
     std::string nm("flutter_output.txt");
-    if (__init->comm().rank() == 0)
+    if (this->comm().rank() == 0)
         _flutter_solver->set_output_file(nm);
     
     
@@ -1025,7 +1025,7 @@ evaluate(const std::vector<Real>& dvars,
     // same exact values.
     std::vector<Real>
     my_dvars(dvars.begin(), dvars.end());
-    __init->comm().broadcast(my_dvars);
+    this->comm().broadcast(my_dvars);
     
     
     // set the parameter values equal to the DV value
@@ -1268,16 +1268,16 @@ evaluate(const std::vector<Real>& dvars,
     // be mapped to unique spots by identifying the number of elements on each
     // subdomain
     std::vector<unsigned int>
-    beginning_elem_id(__init->comm().size(), 0);
-    for (unsigned int i=1; i<__init->comm().size(); i++)
+    beginning_elem_id(this->comm().size(), 0);
+    for (unsigned int i=1; i<this->comm().size(); i++)
         beginning_elem_id[i] = _mesh->n_elem_on_proc(i-1);
     
     // now use this info to identify the beginning elem id
-    for (unsigned int i=2; i<__init->comm().size(); i++)
+    for (unsigned int i=2; i<this->comm().size(); i++)
         beginning_elem_id[i] += beginning_elem_id[i-1];
 
     const unsigned int
-    my_id0 = beginning_elem_id[__init->comm().rank()];
+    my_id0 = beginning_elem_id[this->comm().rank()];
     
     // copy the element von Mises stress values as the functions
     for (unsigned int i=0; i<_outputs.size(); i++)
@@ -1470,7 +1470,7 @@ evaluate(const std::vector<Real>& dvars,
             // now, sum the sensitivity of the stress function gradients
             // so that all processors have the same values
             for (unsigned int j=0; j<_n_elems; j++)
-                __init->comm().sum(grads[(i*_n_ineq) + (j+_n_eig+1)]);
+                this->comm().sum(grads[(i*_n_ineq) + (j+_n_eig+1)]);
             
             
             // calculate the sensitivity of the eigenvalues
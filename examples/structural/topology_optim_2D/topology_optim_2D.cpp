@@ -25,6 +25,7 @@
 #include "elasticity/stress_output_base.h"
 #include "optimization/optimization_interface.h"
 #include "optimization/function_evaluation.h"
+#include "optimization/density_filter.h"
 #include "elasticity/structural_nonlinear_assembly.h"
 #include "base/real_output_function.h"
 #include "base/nonlinear_system.h"
@@ -84,13 +85,13 @@ topology_optim_2D_optim_obj(int*    mode,
         dvars[i] = x[i];
     
     
-    __my_func_eval->evaluate(dvars,
-                             obj,
-                             true,       // request the derivatives of obj
-                             obj_grad,
-                             fvals,
-                             eval_grads,
-                             grads);
+    __my_func_eval->cached_evaluate(dvars,
+                                    obj,
+                                    true,       // request the derivatives of obj
+                                    obj_grad,
+                                    fvals,
+                                    eval_grads,
+                                    grads);
     
     
     // now copy them back as necessary
@@ -145,13 +146,13 @@ topology_optim_2D_optim_con(int*    mode,
         dvars[i] = x[i];
     
     
-    __my_func_eval->evaluate(dvars,
-                             obj,
-                             true,       // request the derivatives of obj
-                             obj_grad,
-                             fvals,
-                             eval_grads,
-                             grads);
+    __my_func_eval->cached_evaluate(dvars,
+                                    obj,
+                                    true,       // request the derivatives of obj
+                                    obj_grad,
+                                    fvals,
+                                    eval_grads,
+                                    grads);
     
     
     // now copy them back as necessary
@@ -225,9 +226,11 @@ MAST::FunctionEvaluation(comm),
 _initialized(false),
 _penalty(0.),
 _volume_fraction(0.),
+_filter_radius(0.),
 _n_divs_x(0),
 _n_divs_y(0),
-_n_elems(0) { }
+_n_elems(0),
+_filter(nullptr) { }
 
 
 
@@ -262,9 +265,10 @@ MAST::TopologyOptimization2D::init(GetPot& infile,
     // topology optimization parameters
     _penalty          = infile(        "penalty",  3.);
     _volume_fraction  = infile("volume_fraction", 0.3);
+    _filter_radius    = infile(  "filter_radius",  0.);
     
     // create the mesh
-    _mesh          = new libMesh::SerialMesh(__init->comm());
+    _mesh          = new libMesh::SerialMesh(this->comm());
     
     // initialize the mesh with one element
     libMesh::MeshTools::Generation::build_square(*_mesh,
@@ -337,10 +341,12 @@ MAST::TopologyOptimization2D::init(GetPot& infile,
     // resize the elem vector
     _elems.resize(_n_elems);
 
-    // element iterators to define property cards
+    // element iterators to define property cards. All elements of the
+    // serial mesh are visited on all processors, so that the design
+    // variable of an element has the same index on all processors.
     libMesh::MeshBase::element_iterator
-    el_it  = _mesh->local_elements_begin(),
-    el_end = _mesh->local_elements_end();
+    el_it  = _mesh->elements_begin(),
+    el_end = _mesh->elements_end();
     
     unsigned int
     counter = 0;
@@ -437,6 +443,21 @@ MAST::TopologyOptimization2D::init(GetPot& infile,
     }
 
     
+    // create the density filter from the element centroids. Each
+    // processor provides the centroids of the elements that it owns.
+    if (_filter_radius > 0.) {
+        
+        std::map<unsigned int, libMesh::Point> centroids;
+        
+        for (unsigned int i=0; i<counter; i++)
+            if (_elems[i]->processor_id() == this->comm().rank())
+                centroids[i] = _elems[i]->centroid();
+        
+        _filter = new MAST::DensityFilter(this->comm(), _filter_radius);
+        _filter->init(_n_vars, centroids);
+    }
+    
+    
     // create the assembly object
     _assembly = new MAST::StructuralNonlinearAssembly;
     
@@ -481,6 +502,9 @@ MAST::TopologyOptimization2D::~TopologyOptimization2D() {
         
         delete _output;
         
+        if (_filter)
+            delete _filter;
+        
         // delete the element data
         {
             std::map<const libMesh::Elem*, MAST::Parameter*>::iterator
@@ -564,11 +588,16 @@ MAST::TopologyOptimization2D::evaluate(const std::vector<Real>& dvars,
     
     libmesh_assert_equal_to(dvars.size(), _n_vars);
     
-    // set the parameter values equal to the DV value
+    // the element densities are the filtered design variables
+    std::vector<Real> rho(dvars);
+    if (_filter)
+        _filter->filter(dvars, rho);
+    
+    // set the parameter values equal to the density value
     for (unsigned int i=0; i<_n_vars; i++) {
         const libMesh::Elem* el = _elems[i];
         MAST::Parameter* par = _elem_rho[el];
-        (*par)() = dvars[i];
+        (*par)() = rho[i];
     }
     
     // DO NOT zero out the gradient vector, since GCMMA needs it for the
@@ -611,7 +640,7 @@ MAST::TopologyOptimization2D::evaluate(const std::vector<Real>& dvars,
         // ignoring multiplying this with the section thickness since the
         // thickness is constant everywhere and it will not affect the design.
         vol = _elems[i]->volume();
-        fvals[0]  += dvars[i] * vol; // constraint:  xi vi - V <= 0
+        fvals[0]  += rho[i] * vol; // constraint:  xi vi - V <= 0
         total_vol += vol;
     }
     fvals[0] /= (total_vol * _volume_fraction);
@@ -646,6 +675,10 @@ MAST::TopologyOptimization2D::evaluate(const std::vector<Real>& dvars,
             
             obj_grad[i] = _output->get_sensitivity(f);
         }
+        
+        // map the sensitivity to the design variables
+        if (_filter)
+            _filter->filter_sensitivity(obj_grad, obj_grad);
     }
     
     // now check if the sensitivity of constraint function is requested
@@ -656,8 +689,16 @@ MAST::TopologyOptimization2D::evaluate(const std::vector<Real>& dvars,
         // grad_k = dfi/dxj  ,  where k = j*NFunc + i
         //////////////////////////////////////////////////////////////////
         
+        std::vector<Real> dvol(_n_elems, 0.);
+        
         for (unsigned int i=0; i<_n_elems; i++)
-            grads[i] = _elems[i]->volume()/(_volume_fraction * total_vol);
+            dvol[i] = _elems[i]->volume()/(_volume_fraction * total_vol);
+        
+        if (_filter)
+            _filter->filter_sensitivity(dvol, dvol);
+        
+        for (unsigned int i=0; i<_n_elems; i++)
+            grads[i] = dvol[i];
     }
     
     
@@ -679,10 +720,15 @@ MAST::TopologyOptimization2D::output(unsigned int iter,
     
     libmesh_assert_equal_to(x.size(), _n_vars);
     
+    // the filtered density is plotted, since this is what the analysis uses
+    std::vector<Real> rho(x);
+    if (_filter)
+        _filter->filter(x, rho);
+    
     // set the desity value in the auxiliary system for output
     for (unsigned int i=0; i<_n_vars; i++) {
         const libMesh::Elem* el = _elems[i];
-        _rho_sys->solution->set(el->dof_number(_rho_sys->number(), 0, 0), x[i]);
+        _rho_sys->solution->set(el->dof_number(_rho_sys->number(), 0, 0), rho[i]);
     }
     
     
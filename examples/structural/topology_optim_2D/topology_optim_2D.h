@@ -68,6 +68,7 @@ namespace MAST {
     class BoundaryConditionBase;
     class StructuralNonlinearAssembly;
     class RealOutputFunction;
+    class DensityFilter;
     
     
     /*!
@@ -176,6 +177,10 @@ namespace MAST {
         // volume fraction
         Real _volume_fraction;
         
+        // radius of the density filter. The filter is not used if this is zero,
+        // which is the default
+        Real _filter_radius;
+        
         
         // number of elements and number of stations at which DVs are defined
         unsigned int
@@ -249,6 +254,9 @@ namespace MAST {
         // output object
         MAST::RealOutputFunction*                       _output;
         
+        // density filter, or nullptr if the densities are not filtered
+        MAST::DensityFilter*                            _filter;
+        
     };
 }
 
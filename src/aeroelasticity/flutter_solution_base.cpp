@@ -45,3 +45,19 @@ MAST::FlutterSolutionBase::swap_root(MAST::FlutterSolutionBase& sol,
 }
 
 
+
+void
+MAST::FlutterSolutionBase::_update_memory(std::size_t matrix_bytes) {
+    
+    std::size_t
+    bytes = matrix_bytes;
+    
+    for (unsigned int i=0; i<_roots.size(); i++)
+        bytes +=
+        MAST::MemoryLog::bytes(_roots[i]->eig_vec_right) +
+        MAST::MemoryLog::bytes(_roots[i]->eig_vec_left) +
+        MAST::MemoryLog::bytes(_roots[i]->modal_participation);
+    
+    _memory.set(bytes);
+}
+
@@ -26,6 +26,7 @@
 
 // MAST includes
 #include "base/mast_data_types.h"
+#include "base/memory_log.h"
 
 
 namespace MAST {
@@ -39,7 +40,8 @@ namespace MAST {
         
     public:
         FlutterSolutionBase():
-        _ref_val(0.)
+        _ref_val(0.),
+        _memory(MAST::MEMORY_FLUTTER_SOLUTIONS)
         {}
         
         /*!
@@ -119,6 +121,18 @@ namespace MAST {
         Real _ref_val;
         
         std::vector<MAST::FlutterRootBase*> _roots;
+        
+        /*!
+         *   updates the memory account with the storage of the roots and
+         *   \p matrix_bytes for the matrices held by the inherited class.
+         *   This should be called once the roots are initialized.
+         */
+        void _update_memory(std::size_t matrix_bytes);
+        
+        /*!
+         *   memory held by this solution
+         */
+        MAST::MemoryAccount _memory;
     };
 
 }
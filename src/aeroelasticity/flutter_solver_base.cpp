@@ -34,7 +34,8 @@ MAST::FlutterSolverBase::FlutterSolverBase():
 _assembly(nullptr),
 _basis_vectors(nullptr),
 _output(nullptr),
-_steady_solver(nullptr) {
+_steady_solver(nullptr),
+_if_threaded_eigensolution(false) {
     
 }
 
@@ -131,6 +131,17 @@ namespace MAST {
         }
         
         
+        /*!
+         *   sets the flag to compute the eigensolutions of the initial scan
+         *   of the reference values concurrently with the libMesh threads.
+         *   The eigensolutions of the scan are always computed as one batch
+         *   after the assembly of all matrices. This is false by default.
+         */
+        void set_threaded_eigensolution(bool f) {
+            _if_threaded_eigensolution = f;
+        }
+        
+        
         /*!
          *   Prints the sorted roots to the \par output
          */
@@ -171,6 +182,12 @@ namespace MAST {
          */
         MAST::FlutterSolverBase::SteadySolver* _steady_solver;
         
+        
+        /*!
+         *    flag to compute the eigensolutions of the scan concurrently
+         */
+        bool _if_threaded_eigensolution;
+        
     };
 }
 
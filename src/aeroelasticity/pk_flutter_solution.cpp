@@ -33,6 +33,7 @@ MAST::PKFlutterSolution::init (const MAST::PKFlutterSolver& solver,
                                const Real v_ref,
                                const Real bref,
                                const RealMatrixX& kmat,
+                               const ComplexMatrixX& amat,
                                const LAPACK_ZGGEV& eig_sol) {
     
     // make sure that it hasn't already been initialized
@@ -43,7 +44,7 @@ MAST::PKFlutterSolution::init (const MAST::PKFlutterSolver& solver,
     _stiff_mat   = kmat;
 
     // iterate over the roots and initialize the vector
-    _Amat              = eig_sol.A();
+    _Amat              = amat;
     _Bmat              = eig_sol.B();
     
     const ComplexMatrixX
@@ -73,6 +74,10 @@ MAST::PKFlutterSolution::init (const MAST::PKFlutterSolver& solver,
         
         _roots[i] = root;
     }
+    
+    _update_memory(MAST::MemoryLog::bytes(_Amat) +
+                   MAST::MemoryLog::bytes(_Bmat) +
+                   MAST::MemoryLog::bytes(_stiff_mat));
 }
 
 
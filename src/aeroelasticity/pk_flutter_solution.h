@@ -48,13 +48,15 @@ namespace MAST {
         virtual ~PKFlutterSolution() {}
         
         /*!
-         *   initializes the flutter solution from an eigensolution
+         *   initializes the flutter solution from the eigensolution of
+         *   the pencil with matrix \p amat
          */
         virtual void init (const MAST::PKFlutterSolver& solver,
                            const Real k_red,
                            const Real v_ref,
                            const Real bref,
                            const RealMatrixX& kmat,
+                           const ComplexMatrixX& amat,
                            const MAST::LAPACK_ZGGEV& eig_sol);
 
         /*!
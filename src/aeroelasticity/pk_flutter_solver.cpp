@@ -26,6 +26,7 @@
 #include "elasticity/fsi_generalized_aero_force_assembly.h"
 #include "numerics/lapack_zggev_interface.h"
 #include "base/parameter.h"
+#include "base/performance_log.h"
 
 
 MAST::PKFlutterSolver::PKFlutterSolver():
@@ -839,6 +840,10 @@ std::auto_ptr<MAST::FlutterSolutionBase>
 MAST::PKFlutterSolver::_analyze(const Real k_red,
                                 const Real v_ref,
                                 const MAST::FlutterSolutionBase* prev_sol) {
+    
+    MAST_LOG_SCOPE("PKFlutterSolver::_analyze");
+    LOG_SCOPE("_analyze()", "PKFlutterSolver");
+    
     // solve the eigenproblem  L x = lambda R x
     ComplexMatrixX R, L;
     RealMatrixX stiff;
@@ -858,7 +863,7 @@ MAST::PKFlutterSolver::_analyze(const Real k_red,
     root->init(*this,
                k_red, v_ref,
                (*_bref_param)(),
-               stiff, ges);
+               stiff, L, ges);
     if (prev_sol)
         root->sort(*prev_sol);
     
@@ -877,6 +882,9 @@ void
 MAST::PKFlutterSolver::calculate_sensitivity(MAST::FlutterRootBase& root,
                                              const libMesh::ParameterVector& params,
                                              const unsigned int i) {
+    
+    MAST_LOG_SCOPE("PKFlutterSolver::calculate_sensitivity");
+    LOG_SCOPE("calculate_sensitivity()", "PKFlutterSolver");
 
     /*
     libMesh::out
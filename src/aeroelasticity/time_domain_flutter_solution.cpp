@@ -42,6 +42,7 @@ MAST::TimeDomainFlutterSolution::~TimeDomainFlutterSolution()
 void
 MAST::TimeDomainFlutterSolution::init (const MAST::TimeDomainFlutterSolver& solver,
                                        const Real v_ref,
+                                       const RealMatrixX& amat,
                                        const MAST::LAPACK_DGGEV& eig_sol) {
     
     // make sure that it hasn't already been initialized
@@ -50,7 +51,7 @@ MAST::TimeDomainFlutterSolution::init (const MAST::TimeDomainFlutterSolver& solv
     _ref_val           = v_ref;
     
     // iterate over the roots and initialize the vector
-    _Amat              = eig_sol.A();
+    _Amat              = amat;
     _Bmat              = eig_sol.B();
     const ComplexMatrixX
     &VR                = eig_sol.right_eigenvectors(),
@@ -77,6 +78,9 @@ MAST::TimeDomainFlutterSolution::init (const MAST::TimeDomainFlutterSolver& solv
         
         _roots[i] = root;
     }
+    
+    _update_memory(MAST::MemoryLog::bytes(_Amat) +
+                   MAST::MemoryLog::bytes(_Bmat));
 }
 
 
@@ -48,10 +48,12 @@ namespace MAST {
         
         
         /*!
-         *   initializes the root
+         *   initializes the root from the eigensolution of the pencil
+         *   with matrix \p amat
          */
         void init (const MAST::TimeDomainFlutterSolver& solver,
                    const Real v_ref,
+                   const RealMatrixX& amat,
                    const MAST::LAPACK_DGGEV& eig_sol);
         
         /*!
@@ -27,15 +27,19 @@
 #include "base/physics_discipline_base.h"
 #include "base/boundary_condition_base.h"
 #include "numerics/lapack_dggev_interface.h"
+#include "numerics/lapack_ggev_batch.h"
 #include "base/parameter.h"
 #include "base/nonlinear_system.h"
+#include "base/performance_log.h"
 
 
 MAST::TimeDomainFlutterSolver::TimeDomainFlutterSolver():
 MAST::FlutterSolverBase(),
 _velocity_param(nullptr),
 _V_range(),
-_n_V_divs(0.) {
+_n_V_divs(0.),
+_if_velocity_affine(false),
+_affine_matrices_initialized(false) {
     
 }
 
@@ -56,6 +60,7 @@ MAST::TimeDomainFlutterSolver::clear() {
     _velocity_param   = nullptr;
     _V_range          = std::pair<Real, Real>(0.,0.);
     _n_V_divs         = 0;
+    _affine_matrices_initialized = false;
     
     MAST::FlutterSolverBase::clear();
 }
@@ -75,6 +80,7 @@ initialize(MAST::Parameter&                             velocity_param,
     _V_range.first  = V_lower;
     _V_range.second = V_upper;
     _n_V_divs       = n_V_divs;
+    _affine_matrices_initialized = false;
     
     MAST::FlutterSolverBase::initialize(basis);
 }
@@ -82,6 +88,17 @@ initialize(MAST::Parameter&                             velocity_param,
 
 
 
+void
+MAST::TimeDomainFlutterSolver::clear_assembly_object() {
+    
+    _affine_matrices_initialized = false;
+    
+    MAST::FlutterSolverBase::clear_assembly_object();
+}
+
+
+
+
 void
 MAST::TimeDomainFlutterSolver::clear_solutions() {
     
@@ -424,6 +441,8 @@ analyze_and_find_critical_root_without_tracking(const Real g_tol,
 void
 MAST::TimeDomainFlutterSolver::scan_for_roots() {
     
+    MAST_LOG_SCOPE("TimeDomainFlutterSolver::scan_for_roots");
+    
     // if the initial scanning has not been done, then do it now
     if (!_flutter_solutions.size()) {
         // march from the upper limit to the lower to find the roots
@@ -437,11 +456,24 @@ MAST::TimeDomainFlutterSolver::scan_for_roots() {
         }
         V_vals[_n_V_divs] = _V_range.second; // to get around finite-precision arithmetic
         
+        // the matrices are assembled for all reference values, and the
+        // eigensolutions are computed together as one batch
+        std::vector<RealMatrixX>
+        A(_n_V_divs+1),
+        B(_n_V_divs+1);
+        
+        for (unsigned int i=0; i<_n_V_divs+1; i++)
+            _initialize_matrices(V_vals[i], A[i], B[i]);
+        
+        MAST::LAPACK_GGEV_Batch<MAST::LAPACK_DGGEV> ges;
+        ges.set_threaded(_if_threaded_eigensolution);
+        ges.compute(A, B);
+        
         MAST::FlutterSolutionBase* prev_sol = nullptr;
         for (unsigned int i=0; i<_n_V_divs+1; i++) {
             current_V = V_vals[i];
             std::auto_ptr<MAST::TimeDomainFlutterSolution>
-            sol = _analyze(current_V, prev_sol);
+            sol = _initialize_solution(current_V, A[i], ges.solver(i), prev_sol);
             
             prev_sol = sol.get();
             
@@ -640,6 +672,9 @@ std::auto_ptr<MAST::TimeDomainFlutterSolution>
 MAST::TimeDomainFlutterSolver::_analyze(const Real v_ref,
                                        const MAST::FlutterSolutionBase* prev_sol) {
     
+    MAST_LOG_SCOPE("TimeDomainFlutterSolver::_analyze");
+    LOG_SCOPE("_analyze()", "TimeDomainFlutterSolver");
+    
     libMesh::out
     << " ====================================================" << std::endl
     << "Eigensolution" << std::endl
@@ -656,16 +691,31 @@ MAST::TimeDomainFlutterSolver::_analyze(const Real v_ref,
     ges.compute(A, B);
     ges.scale_eigenvectors_to_identity_innerproduct();
     
-    MAST::TimeDomainFlutterSolution* root = new MAST::TimeDomainFlutterSolution;
-    root->init(*this, v_ref, ges);
-    if (prev_sol)
-        root->sort(*prev_sol);
+    std::auto_ptr<MAST::TimeDomainFlutterSolution>
+    root = _initialize_solution(v_ref, A, ges, prev_sol);
     
     libMesh::out
     << "Finished Eigensolution" << std::endl
     << " ====================================================" << std::endl;
     
     
+    return root;
+}
+
+
+
+
+std::auto_ptr<MAST::TimeDomainFlutterSolution>
+MAST::TimeDomainFlutterSolver::_initialize_solution(const Real v_ref,
+                                                    const RealMatrixX& A,
+                                                    const MAST::LAPACK_DGGEV& ges,
+                                                    const MAST::FlutterSolutionBase* prev_sol) {
+    
+    MAST::TimeDomainFlutterSolution* root = new MAST::TimeDomainFlutterSolution;
+    root->init(*this, v_ref, A, ges);
+    if (prev_sol)
+        root->sort(*prev_sol);
+    
     return std::auto_ptr<MAST::TimeDomainFlutterSolution> (root);
 }
 
@@ -696,21 +746,6 @@ MAST::TimeDomainFlutterSolver::_initialize_matrices(Real U_inf,
     //
 
     
-    // set the velocity value in the parameter that was provided
-    (*_velocity_param) = U_inf;
-    
-
-    // if the steady solver object is provided, then solve for the
-    // steady state using this velocity
-    if (_steady_solver) {
-        libMesh::out
-        << "***  Performing Steady State Solve ***" << std::endl;
-        
-        _steady_solver->solve();
-        _assembly->reattach_to_system();
-    }
-    
-    
     const unsigned int n = (unsigned int)_basis_vectors->size();
 
     RealMatrixX
@@ -718,17 +753,46 @@ MAST::TimeDomainFlutterSolver::_initialize_matrices(Real U_inf,
     c      =  RealMatrixX::Zero(n, n),
     k      =  RealMatrixX::Zero(n, n);
 
-    
-    // now prepare a map of the quantities and ask the assembly object to
-    // calculate the quantities of interest.
-    std::map<MAST::StructuralQuantityType, RealMatrixX*> qty_map;
-    qty_map[MAST::MASS]       = &m;
-    qty_map[MAST::DAMPING]    = &c;
-    qty_map[MAST::STIFFNESS]  = &k;
-    
-    
-    _assembly->assemble_reduced_order_quantity(*_basis_vectors,
-                                               qty_map);
+    if (_if_velocity_affine) {
+        
+        // the reduced order matrices are combined for this velocity
+        // without any assembly
+        if (!_affine_matrices_initialized)
+            _initialize_affine_matrices();
+        
+        (*_velocity_param) = U_inf;
+        
+        m  =  _affine_m;
+        c  =  _affine_c_s + U_inf * _affine_c_a;
+        k  =  _affine_k_s + (U_inf * U_inf) * _affine_k_a;
+    }
+    else {
+        
+        // set the velocity value in the parameter that was provided
+        (*_velocity_param) = U_inf;
+        
+        // if the steady solver object is provided, then solve for the
+        // steady state using this velocity
+        if (_steady_solver) {
+            libMesh::out
+            << "***  Performing Steady State Solve ***" << std::endl;
+            
+            _steady_solver->solve();
+            _assembly->reattach_to_system();
+        }
+        
+        
+        // now prepare a map of the quantities and ask the assembly object to
+        // calculate the quantities of interest.
+        std::map<MAST::StructuralQuantityType, RealMatrixX*> qty_map;
+        qty_map[MAST::MASS]       = &m;
+        qty_map[MAST::DAMPING]    = &c;
+        qty_map[MAST::STIFFNESS]  = &k;
+        
+        
+        _assembly->assemble_reduced_order_quantity(*_basis_vectors,
+                                                   qty_map);
+    }
     
     
     // put the matrices back in the system matrices
@@ -749,6 +813,41 @@ MAST::TimeDomainFlutterSolver::_initialize_matrices(Real U_inf,
 
 
 
+void
+MAST::TimeDomainFlutterSolver::_initialize_affine_matrices() {
+    
+    MAST_LOG_SCOPE("TimeDomainFlutterSolver::_initialize_affine_matrices");
+    
+    // the base solution is not recomputed for each velocity, which
+    // is necessary for the aerodynamic matrices to be affine in velocity
+    if (_steady_solver)
+        libmesh_error_msg("Velocity-affine aerodynamics cannot be used with a steady solver.");
+    
+    // the piston theory matrices are assembled at unit velocity, so that
+    // they can be scaled by V and V^2 for each velocity sample.
+    const Real
+    V0 = (*_velocity_param)();
+    (*_velocity_param) = 1.;
+    
+    std::map<MAST::StructuralQuantityType, RealMatrixX*> qty_map;
+    qty_map[MAST::MASS]                  = &_affine_m;
+    qty_map[MAST::STRUCTURAL_DAMPING]    = &_affine_c_s;
+    qty_map[MAST::STRUCTURAL_STIFFNESS]  = &_affine_k_s;
+    qty_map[MAST::AERODYNAMIC_DAMPING]   = &_affine_c_a;
+    qty_map[MAST::AERODYNAMIC_STIFFNESS] = &_affine_k_a;
+    
+    _assembly->assemble_reduced_order_quantity(*_basis_vectors,
+                                               qty_map);
+    
+    (*_velocity_param) = V0;
+    
+    _affine_matrices_initialized = true;
+}
+
+
+
+
+
 
 void
 MAST::TimeDomainFlutterSolver::
@@ -997,6 +1096,9 @@ calculate_sensitivity(MAST::FlutterRootBase& root,
                       libMesh::NumericVector<Real>* dXdp,
                       libMesh::NumericVector<Real>* dXdV) {
     
+    MAST_LOG_SCOPE("TimeDomainFlutterSolver::calculate_sensitivity");
+    LOG_SCOPE("calculate_sensitivity()", "TimeDomainFlutterSolver");
+    
     
     
     libMesh::out
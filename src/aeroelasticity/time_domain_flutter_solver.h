@@ -33,6 +33,7 @@ namespace MAST {
     
     // Forward declerations
     class TimeDomainFlutterSolution;
+    class LAPACK_DGGEV;
     
     
     /*!
@@ -65,6 +66,41 @@ namespace MAST {
          *   clears the solutions stored from a previous analysis.
          */
         virtual void clear_solutions();
+        
+        
+        /*!
+         *   clears the assembly object, and the reduced order matrices
+         *   cached for velocity-affine aerodynamics, since they are
+         *   specific to the assembly.
+         */
+        virtual void clear_assembly_object();
+        
+        
+        /*!
+         *   For piston theory linearized about a base solution with zero
+         *   velocity, the aerodynamic stiffness and damping matrices are
+         *   proportional to \f$ V^2 \f$ and \f$ V \f$, respectively,
+         *   with coefficient matrices that depend on the Mach number,
+         *   density and base solution, but not on the velocity. If \par f
+         *   is true, these coefficient matrices, together with the
+         *   structural matrices, are assembled and projected on the
+         *   basis only once, and each velocity sample is evaluated as a
+         *   combination of the reduced order matrices.
+         *
+         *   This requires that the base solution does not change with
+         *   velocity, so it cannot be used with a steady solver, and
+         *   that the velocity parameter provided to initialize() is the
+         *   velocity used by the piston theory boundary conditions. The
+         *   cached matrices are discarded by initialize(), clear() and
+         *   clear_assembly_object(), which should be called
+         *   after a change in the Mach number or the basis. This is
+         *   false by default.
+         */
+        void set_velocity_affine_aerodynamics(bool f) {
+            
+            _if_velocity_affine = f;
+            _affine_matrices_initialized = false;
+        }
 
         
         /*!
@@ -179,6 +215,19 @@ namespace MAST {
                  const MAST::FlutterSolutionBase* prev_sol=nullptr);
         
         
+        /*!
+         *   creates the solution at the reference value \p v_ref from the
+         *   eigensolution \p ges of the pencil with matrix \p A, and sorts
+         *   the roots based on the provided solution pointer, if it is not
+         *   nullptr.
+         */
+        std::auto_ptr<MAST::TimeDomainFlutterSolution>
+        _initialize_solution(const Real v_ref,
+                             const RealMatrixX& A,
+                             const MAST::LAPACK_DGGEV& ges,
+                             const MAST::FlutterSolutionBase* prev_sol);
+        
+        
         
         /*!
          *    bisection method search
@@ -200,6 +249,14 @@ namespace MAST {
                                   RealMatrixX& B);
 
         
+        /*!
+         *    Assembles the velocity independent reduced order matrices
+         *    used for velocity-affine aerodynamics. The velocity parameter
+         *    is temporarily set to unity for this assembly.
+         */
+        void _initialize_affine_matrices();
+        
+        
         /*!
          *    Assembles the reduced order system structural and aerodynmaic
          *    matrices for specified flight velocity \par U_inf.
@@ -237,6 +294,36 @@ namespace MAST {
          *    scanning
          */
         unsigned int                                    _n_V_divs;
+        
+        /*!
+         *   flag to use velocity-affine aerodynamic matrices, set by
+         *   set_velocity_affine_aerodynamics()
+         */
+        bool                                            _if_velocity_affine;
+        
+        /*!
+         *   true if the reduced order matrices below have been computed
+         *   for the current basis and assembly
+         */
+        bool                                            _affine_matrices_initialized;
+        
+        /*!
+         *   reduced order mass matrix
+         */
+        RealMatrixX                                     _affine_m;
+        
+        /*!
+         *   reduced order damping and stiffness matrices without the
+         *   piston theory contributions
+         */
+        RealMatrixX                                     _affine_c_s, _affine_k_s;
+        
+        /*!
+         *   reduced order piston theory damping and stiffness matrices at
+         *   unit velocity, which scale with \f$ V \f$ and \f$ V^2 \f$,
+         *   respectively.
+         */
+        RealMatrixX                                     _affine_c_a, _affine_k_a;
 
         
         /*!
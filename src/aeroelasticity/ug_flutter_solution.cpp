@@ -45,6 +45,7 @@ void
 MAST::UGFlutterSolution::init (const MAST::UGFlutterSolver& solver,
                                const Real kr_ref,
                                const Real b_ref,
+                               const ComplexMatrixX& amat,
                                const MAST::LAPACK_ZGGEV_Base& eig_sol) {
     
     // make sure that it hasn't already been initialized
@@ -53,7 +54,7 @@ MAST::UGFlutterSolution::init (const MAST::UGFlutterSolver& solver,
     _ref_val           = kr_ref;
     
     // iterate over the roots and initialize the vector
-    _Amat              = eig_sol.A();
+    _Amat              = amat;
     _Bmat              = eig_sol.B();
     const ComplexMatrixX
     &VR                = eig_sol.right_eigenvectors(),
@@ -81,6 +82,9 @@ MAST::UGFlutterSolution::init (const MAST::UGFlutterSolver& solver,
         
         _roots[i] = root;
     }
+    
+    _update_memory(MAST::MemoryLog::bytes(_Amat) +
+                   MAST::MemoryLog::bytes(_Bmat));
 }
 
 
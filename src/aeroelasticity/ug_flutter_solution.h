@@ -49,11 +49,13 @@ namespace MAST {
         
         
         /*!
-         *   initializes the root
+         *   initializes the root from the eigensolution of the pencil
+         *   with matrix \p amat
          */
         void init (const MAST::UGFlutterSolver& solver,
                    const Real v_ref,
                    const Real b_ref,
+                   const ComplexMatrixX& amat,
                    const MAST::LAPACK_ZGGEV_Base& eig_sol);
         
         
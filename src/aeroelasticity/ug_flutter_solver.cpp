@@ -28,8 +28,10 @@
 #include "base/physics_discipline_base.h"
 #include "base/boundary_condition_base.h"
 #include "numerics/lapack_zggev_interface.h"
+#include "numerics/lapack_ggev_batch.h"
 #include "base/parameter.h"
 #include "base/nonlinear_system.h"
+#include "base/performance_log.h"
 
 
 MAST::UGFlutterSolver::UGFlutterSolver():
@@ -261,6 +263,8 @@ MAST::UGFlutterSolver::find_critical_root(const Real g_tol,
 void
 MAST::UGFlutterSolver::scan_for_roots() {
     
+    MAST_LOG_SCOPE("UGFlutterSolver::scan_for_roots");
+    
     // if the initial scanning has not been done, then do it now
     if (!_flutter_solutions.size()) {
         // march from the upper limit to the lower to find the roots
@@ -275,12 +279,25 @@ MAST::UGFlutterSolver::scan_for_roots() {
         }
         k_vals[_n_kr_divs] = _kr_range.first; // to get around finite-precision arithmetic
         
+        // the matrices are assembled for all reference values, and the
+        // eigensolutions are computed together as one batch
+        std::vector<ComplexMatrixX>
+        A(_n_kr_divs+1),
+        B(_n_kr_divs+1);
+        
+        for (unsigned int i=0; i< _n_kr_divs+1; i++)
+            _initialize_matrices(k_vals[i], A[i], B[i]);
+        
+        MAST::LAPACK_GGEV_Batch<MAST::LAPACK_ZGGEV> ges;
+        ges.set_threaded(_if_threaded_eigensolution);
+        ges.compute(A, B);
+        
         MAST::FlutterSolutionBase* prev_sol = nullptr;
         for (unsigned int i=0; i< _n_kr_divs+1; i++) {
             
             current_kr = k_vals[i];
             std::auto_ptr<MAST::FlutterSolutionBase> sol =
-            _analyze(current_kr, prev_sol);
+            _initialize_solution(current_kr, A[i], ges.solver(i), prev_sol);
             
             prev_sol = sol.get();
             
@@ -486,6 +503,9 @@ std::auto_ptr<MAST::FlutterSolutionBase>
 MAST::UGFlutterSolver::_analyze(const Real kr_ref,
                                 const MAST::FlutterSolutionBase* prev_sol) {
     
+    MAST_LOG_SCOPE("UGFlutterSolver::_analyze");
+    LOG_SCOPE("_analyze()", "UGFlutterSolver");
+    
     libMesh::out
     << " ====================================================" << std::endl
     << "Eigensolution" << std::endl
@@ -502,16 +522,31 @@ MAST::UGFlutterSolver::_analyze(const Real kr_ref,
     ges.compute(A, B);
     ges.scale_eigenvectors_to_identity_innerproduct();
     
-    MAST::UGFlutterSolution* root = new MAST::UGFlutterSolution;
-    root->init(*this, kr_ref, (*_bref_param)(), ges);
-    if (prev_sol)
-        root->sort(*prev_sol);
+    std::auto_ptr<MAST::FlutterSolutionBase>
+    root = _initialize_solution(kr_ref, A, ges, prev_sol);
     
     libMesh::out
     << "Finished Eigensolution" << std::endl
     << " ====================================================" << std::endl;
     
     
+    return root;
+}
+
+
+
+
+std::auto_ptr<MAST::FlutterSolutionBase>
+MAST::UGFlutterSolver::_initialize_solution(const Real kr_ref,
+                                            const ComplexMatrixX& A,
+                                            const MAST::LAPACK_ZGGEV_Base& ges,
+                                            const MAST::FlutterSolutionBase* prev_sol) {
+    
+    MAST::UGFlutterSolution* root = new MAST::UGFlutterSolution;
+    root->init(*this, kr_ref, (*_bref_param)(), A, ges);
+    if (prev_sol)
+        root->sort(*prev_sol);
+    
     return std::auto_ptr<MAST::FlutterSolutionBase> (root);
 }
 
@@ -876,6 +911,9 @@ calculate_sensitivity(MAST::FlutterRootBase& root,
                       libMesh::NumericVector<Real>* dXdp,
                       libMesh::NumericVector<Real>* dXdkr) {
     
+    MAST_LOG_SCOPE("UGFlutterSolver::calculate_sensitivity");
+    LOG_SCOPE("calculate_sensitivity()", "UGFlutterSolver");
+    
     
     
     libMesh::out
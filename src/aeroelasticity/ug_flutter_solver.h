@@ -30,6 +30,9 @@
 
 namespace MAST {
     
+    // Forward declerations
+    class LAPACK_ZGGEV_Base;
+    
     
     /*!
      *   This implements a solver for a single parameter instability
@@ -165,6 +168,19 @@ namespace MAST {
                  const MAST::FlutterSolutionBase* prev_sol=nullptr);
         
         
+        /*!
+         *   creates the solution at the reference value \p kr_ref from the
+         *   eigensolution \p ges of the pencil with matrix \p A, and sorts
+         *   the roots based on the provided solution pointer, if it is not
+         *   nullptr.
+         */
+        std::auto_ptr<MAST::FlutterSolutionBase>
+        _initialize_solution(const Real kr_ref,
+                             const ComplexMatrixX& A,
+                             const MAST::LAPACK_ZGGEV_Base& ges,
+                             const MAST::FlutterSolutionBase* prev_sol);
+        
+        
         
         /*!
          *    bisection method search
@@ -24,6 +24,7 @@
 #include "base/elem_base.h"
 #include "base/physics_discipline_base.h"
 #include "base/nonlinear_system.h"
+#include "base/performance_log.h"
 
 
 // libMesh includes
@@ -93,6 +94,9 @@ std::auto_ptr<libMesh::NumericVector<Real> >
 MAST::AssemblyBase::_build_localized_vector(const libMesh::System& sys,
                                             const libMesh::NumericVector<Real>& global) {
     
+    MAST_LOG_SCOPE("AssemblyBase::localize");
+    MAST_LOG_COUNT("localizations", 1);
+    
     libMesh::NumericVector<Real>* local =
     libMesh::NumericVector<Real>::build(sys.comm()).release();
     
@@ -134,6 +138,7 @@ MAST::AssemblyBase::detach_solution_function() {
 void
 MAST::AssemblyBase::calculate_outputs(const libMesh::NumericVector<Real>& X) {
     
+    MAST_LOG_SCOPE("AssemblyBase::calculate_outputs");
     
     MAST::NonlinearSystem& sys = _system->system();
     
@@ -163,6 +168,8 @@ MAST::AssemblyBase::calculate_outputs(const libMesh::NumericVector<Real>& X) {
     
     for ( ; el != end_el; ++el) {
         
+        MAST_LOG_COUNT("elements", 1);
+        
         const libMesh::Elem* elem = *el;
         
         dof_map.dof_indices (elem, dof_indices);
@@ -207,6 +214,7 @@ calculate_output_sensitivity(libMesh::ParameterVector &params,
                              const bool if_total_sensitivity,
                              const libMesh::NumericVector<Real> &X) {
     
+    MAST_LOG_SCOPE("AssemblyBase::calculate_output_sensitivity");
     
     MAST::NonlinearSystem& sys = _system->system();
     
@@ -246,6 +254,8 @@ calculate_output_sensitivity(libMesh::ParameterVector &params,
         
         for ( ; el != end_el; ++el) {
             
+            MAST_LOG_COUNT("elements", 1);
+            
             const libMesh::Elem* elem = *el;
             
             dof_map.dof_indices (elem, dof_indices);
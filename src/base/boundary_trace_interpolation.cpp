@@ -0,0 +1,242 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2017  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+// C++ includes
+#include <algorithm>
+
+
+// MAST includes
+#include "base/boundary_trace_interpolation.h"
+#include "base/system_initialization.h"
+#include "base/nonlinear_system.h"
+
+
+// libMesh includes
+#include "libmesh/mesh_base.h"
+#include "libmesh/boundary_info.h"
+#include "libmesh/dof_map.h"
+#include "libmesh/elem.h"
+#include "libmesh/fe_base.h"
+#include "libmesh/fe_interface.h"
+#include "libmesh/point_locator_base.h"
+
+
+MAST::BoundaryTraceInterpolation::
+BoundaryTraceInterpolation(MAST::SystemInitialization& sys,
+                           const std::set<libMesh::boundary_id_type>& bids):
+_system      (sys),
+_bids        (bids),
+_max_points  (100000) {
+    
+    _init();
+}
+
+
+
+
+MAST::BoundaryTraceInterpolation::~BoundaryTraceInterpolation() {
+    
+}
+
+
+
+
+void
+MAST::BoundaryTraceInterpolation::_init() {
+    
+    MAST::NonlinearSystem& sys = _system.system();
+    
+    const libMesh::MeshBase& mesh      = sys.get_mesh();
+    const libMesh::BoundaryInfo& binfo = *mesh.boundary_info;
+    const libMesh::DofMap& dof_map     = sys.get_dof_map();
+    
+    std::set<libMesh::numeric_index_type>
+    dofs;
+    
+    std::vector<libMesh::dof_id_type>
+    dof_indices;
+    
+    // the interpolation can be queried on any processor, so the trace
+    // elements available on this processor are identified, and not just
+    // the local elements. On a distributed mesh these are only the local
+    // and ghosted elements, and points can be interpolated only if they
+    // lie in one of these.
+    libMesh::MeshBase::const_element_iterator       el     =
+    mesh.active_elements_begin();
+    const libMesh::MeshBase::const_element_iterator end_el =
+    mesh.active_elements_end();
+    
+    for ( ; el != end_el; ++el) {
+        
+        const libMesh::Elem* elem = *el;
+        
+        bool
+        on_trace = false;
+        
+        for (unsigned short int n=0; n<elem->n_sides(); n++) {
+            
+            if (elem->neighbor(n) || !binfo.n_boundary_ids(elem, n))
+                continue;
+            
+            std::vector<libMesh::boundary_id_type> bc_ids = binfo.boundary_ids(elem, n);
+            
+            for (unsigned int i=0; i<bc_ids.size(); i++)
+                if (_bids.count(bc_ids[i]))
+                    on_trace = true;
+        }
+        
+        if (on_trace) {
+            
+            _elems.insert(elem);
+            
+            dof_map.dof_indices(elem, dof_indices);
+            dofs.insert(dof_indices.begin(), dof_indices.end());
+        }
+    }
+    
+    _dofs.assign(dofs.begin(), dofs.end());
+    
+    _locator.reset(mesh.sub_point_locator().release());
+}
+
+
+
+
+void
+MAST::BoundaryTraceInterpolation::
+localize(const libMesh::NumericVector<Real>& v,
+         std::vector<Real>& v_trace) const {
+    
+    v.localize(v_trace, _dofs);
+}
+
+
+
+
+void
+MAST::BoundaryTraceInterpolation::
+interpolate(const libMesh::Point& p,
+            const std::vector<Real>& v_trace,
+            RealVectorX& sol) const {
+    
+    libmesh_assert_equal_to(v_trace.size(), _dofs.size());
+    
+    const PointData& d = _get_point_data(p);
+    
+    const unsigned int
+    n_vars = (unsigned int)d.index.size();
+    
+    sol.setZero(n_vars);
+    
+    for (unsigned int i=0; i<n_vars; i++)
+        for (unsigned int j=0; j<d.index[i].size(); j++)
+            sol(i) += d.phi[i][j] * v_trace[d.index[i][j]];
+}
+
+
+
+
+const MAST::BoundaryTraceInterpolation::PointData&
+MAST::BoundaryTraceInterpolation::_get_point_data(const libMesh::Point& p) const {
+    
+    std::map<libMesh::Point, PointData>::const_iterator
+    it = _point_data.find(p);
+    
+    if (it != _point_data.end())
+        return it->second;
+    
+    // identify the trace element that contains this point. The locator
+    // may return an element that shares only an edge or vertex with the
+    // trace, in which case its neighbors are searched.
+    const libMesh::Elem* elem = (*_locator)(p);
+    
+    if (elem && !_elems.count(elem)) {
+        
+        std::set<const libMesh::Elem*> nbrs;
+        elem->find_point_neighbors(p, nbrs);
+        
+        elem = nullptr;
+        std::set<const libMesh::Elem*>::const_iterator
+        n_it  = nbrs.begin(),
+        n_end = nbrs.end();
+        
+        for ( ; n_it != n_end; n_it++)
+            if (_elems.count(*n_it)) {
+                elem = *n_it;
+                break;
+            }
+    }
+    
+    if (!elem)
+        libmesh_error_msg("Point is not on the boundary trace elements "
+                          "available on this processor: " << p);
+    
+    // the oldest point is removed if the number of stored points has
+    // reached the limit. This does not invalidate the data of other points.
+    if (_point_order.size() >= _max_points) {
+        
+        _point_data.erase(_point_order.front());
+        _point_order.pop_front();
+    }
+    
+    _point_order.push_back(p);
+    
+    const MAST::NonlinearSystem& sys     = _system.system();
+    const libMesh::DofMap& dof_map       = sys.get_dof_map();
+    const std::vector<unsigned int> vars = _system.vars();
+    
+    PointData& d = _point_data[p];
+    d.index.resize(vars.size());
+    d.phi.resize(vars.size());
+    
+    std::vector<libMesh::dof_id_type>
+    dof_indices;
+    
+    std::vector<libMesh::Point>
+    pts(1);
+    
+    for (unsigned int i=0; i<vars.size(); i++) {
+        
+        const libMesh::FEType& fe_type = sys.variable_type(vars[i]);
+        
+        dof_map.dof_indices(elem, dof_indices, vars[i]);
+        
+        pts[0] = libMesh::FEInterface::inverse_map(elem->dim(), fe_type, elem, p);
+        
+        std::auto_ptr<libMesh::FEBase> fe(libMesh::FEBase::build(elem->dim(), fe_type).release());
+        const std::vector<std::vector<Real> >& phi = fe->get_phi();
+        fe->reinit(elem, &pts);
+        
+        libmesh_assert_equal_to(phi.size(), dof_indices.size());
+        
+        d.index[i].resize(dof_indices.size());
+        d.phi[i].resize(dof_indices.size());
+        
+        for (unsigned int j=0; j<dof_indices.size(); j++) {
+            
+            d.index[i][j] = (unsigned int)
+            (std::lower_bound(_dofs.begin(), _dofs.end(), dof_indices[j]) - _dofs.begin());
+            d.phi[i][j]   = phi[j][0];
+        }
+    }
+    
+    return d;
+}
+
@@ -0,0 +1,205 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2017  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#ifndef __mast__boundary_trace_interpolation_h__
+#define __mast__boundary_trace_interpolation_h__
+
+// C++ includes
+#include <set>
+#include <map>
+#include <vector>
+#include <memory>
+#include <deque>
+
+
+// MAST includes
+#include "base/mast_data_types.h"
+
+
+// libMesh includes
+#include "libmesh/point.h"
+#include "libmesh/numeric_vector.h"
+
+
+namespace libMesh {
+    class Elem;
+    class PointLocatorBase;
+}
+
+
+namespace MAST {
+    
+    // Forward declerations
+    class SystemInitialization;
+    
+    
+    /*!
+     *   This class interpolates the solution of a system at points on a
+     *   subset of its boundary, identified by a set of boundary ids. Only
+     *   the dofs of elements with a side on these boundaries are localized,
+     *   into a compact vector ordered by the sorted dof indices in
+     *   \p dof_indices(). The element containing each queried point and the
+     *   shape function values at that point are computed at the first
+     *   query and reused for subsequent queries of the same point, so that
+     *   repeated evaluations during coupling iterations only need the
+     *   updated compact vector. The number of stored points is limited by
+     *   set_max_points(), beyond which the oldest points are discarded.
+     *
+     *   Points can be interpolated on any processor, provided that they lie
+     *   in a trace element available on that processor. On a distributed
+     *   mesh these are only the local and ghosted elements.
+     */
+    class BoundaryTraceInterpolation {
+        
+    public:
+        
+        BoundaryTraceInterpolation(MAST::SystemInitialization& sys,
+                                   const std::set<libMesh::boundary_id_type>& bids);
+        
+        
+        virtual ~BoundaryTraceInterpolation();
+        
+        
+        /*!
+         *   @returns the sorted global dof indices of the elements on the
+         *   boundary trace
+         */
+        const std::vector<libMesh::numeric_index_type>& dof_indices() const {
+            return _dofs;
+        }
+        
+        
+        /*!
+         *   localizes the entries of \p v for dofs on the trace in
+         *   \p v_trace.
+         */
+        void localize(const libMesh::NumericVector<Real>& v,
+                      std::vector<Real>& v_trace) const;
+        
+        
+        /*!
+         *   interpolates the system variables at point \p p from the trace
+         *   vector \p v_trace and returns them in \p sol in the order of
+         *   SystemInitialization::vars(). \p p must lie on the boundary
+         *   trace.
+         */
+        void interpolate(const libMesh::Point& p,
+                         const std::vector<Real>& v_trace,
+                         RealVectorX& sol) const;
+        
+        
+        /*!
+         *   clears the interpolation data stored for the queried points.
+         *   This must be called if the mesh is modified.
+         */
+        void clear_point_data() {
+            _point_data.clear();
+            _point_order.clear();
+        }
+        
+        
+        /*!
+         *   sets the maximum number of points for which the interpolation
+         *   data is stored. Default value is 100000.
+         */
+        void set_max_points(unsigned int n) {
+            
+            libmesh_assert_greater(n, 0);
+            _max_points = n;
+            
+            while (_point_order.size() > _max_points) {
+                
+                _point_data.erase(_point_order.front());
+                _point_order.pop_front();
+            }
+        }
+        
+        
+    protected:
+        
+        /*!
+         *   interpolation data at a point. For each variable, this stores
+         *   the location of the element dofs in the trace vector and the
+         *   corresponding shape function values.
+         */
+        struct PointData {
+            std::vector<std::vector<unsigned int> > index;
+            std::vector<std::vector<Real> >         phi;
+        };
+        
+        
+        /*!
+         *   identifies the elements and dofs on the boundary trace
+         */
+        void _init();
+        
+        
+        /*!
+         *   @returns the interpolation data for point \p p, which is
+         *   computed if this point has not been queried before.
+         */
+        const PointData& _get_point_data(const libMesh::Point& p) const;
+        
+        
+        /*!
+         *   system associated with the mesh and solution vector
+         */
+        MAST::SystemInitialization&                   _system;
+        
+        /*!
+         *   boundary ids that define the trace
+         */
+        std::set<libMesh::boundary_id_type>           _bids;
+        
+        /*!
+         *   elements with at least one side on the trace
+         */
+        std::set<const libMesh::Elem*>                _elems;
+        
+        /*!
+         *   sorted global dof indices of the trace elements
+         */
+        std::vector<libMesh::numeric_index_type>      _dofs;
+        
+        /*!
+         *   point locator used to identify the element of queried points
+         */
+        std::auto_ptr<libMesh::PointLocatorBase>      _locator;
+        
+        /*!
+         *   interpolation data of the queried points
+         */
+        mutable std::map<libMesh::Point, PointData>   _point_data;
+        
+        /*!
+         *   queried points in the order in which they were added to
+         *   \p _point_data
+         */
+        mutable std::deque<libMesh::Point>            _point_order;
+        
+        /*!
+         *   maximum number of points in \p _point_data
+         */
+        unsigned int                                  _max_points;
+    };
+}
+
+
+#endif // __mast__boundary_trace_interpolation_h__
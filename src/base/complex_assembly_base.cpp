@@ -28,6 +28,8 @@
 #include "solver/complex_solver_base.h"
 #include "base/parameter.h"
 #include "base/nonlinear_system.h"
+#include "base/performance_log.h"
+#include "base/memory_log.h"
 
 
 // libMesh includes
@@ -168,7 +170,8 @@ MAST::ComplexAssemblyBase::base_sol(bool if_sens) const {
 Real
 MAST::ComplexAssemblyBase::residual_l2_norm() {
     
-    START_LOG("complex_solve()", "Residual-L2");
+    MAST_LOG_SCOPE("ComplexAssemblyBase::residual_l2_norm");
+    LOG_SCOPE("complex_solve()", "Residual-L2");
 
     MAST::NonlinearSystem& nonlin_sys = _system->system();
     
@@ -289,7 +292,6 @@ MAST::ComplexAssemblyBase::residual_l2_norm() {
     l2_real =  residual_re->l2_norm(),
     l2_imag =  residual_im->l2_norm();
     
-    STOP_LOG("complex_solve()", "Residual-L2");
 
     return sqrt(pow(l2_real,2) + pow(l2_imag,2));
 }
@@ -305,6 +307,8 @@ residual_and_jacobian (const libMesh::NumericVector<Real>& X,
                        libMesh::SparseMatrix<Real>*  J,
                        libMesh::NonlinearImplicitSystem& S) {
     
+    MAST_LOG_SCOPE("ComplexAssemblyBase::residual_and_jacobian");
+    
     MAST::NonlinearSystem& nonlin_sys = _system->system();
     
     // make sure that the system for which this object was created,
@@ -373,6 +377,8 @@ residual_and_jacobian (const libMesh::NumericVector<Real>& X,
     
     for ( ; el != end_el; ++el) {
         
+        MAST_LOG_COUNT("elements", 1);
+        
         const libMesh::Elem* elem = *el;
         
         dof_map.dof_indices (elem, dof_indices);
@@ -484,6 +490,8 @@ residual_and_jacobian_field_split (const libMesh::NumericVector<Real>& X_R,
                                    libMesh::SparseMatrix<Real>&  J_I,
                                    libMesh::NonlinearImplicitSystem& S) {
     
+    MAST_LOG_SCOPE("ComplexAssemblyBase::residual_and_jacobian_field_split");
+    
     MAST::NonlinearSystem& nonlin_sys = _system->system();
     
     // make sure that the system for which this object was created,
@@ -539,6 +547,8 @@ residual_and_jacobian_field_split (const libMesh::NumericVector<Real>& X_R,
     
     for ( ; el != end_el; ++el) {
         
+        MAST_LOG_COUNT("elements", 1);
+        
         const libMesh::Elem* elem = *el;
         
         dof_map.dof_indices (elem, dof_indices);
@@ -641,7 +651,8 @@ residual_and_jacobian_blocked (const libMesh::NumericVector<Real>& X,
                                libMesh::NonlinearImplicitSystem& S,
                                MAST::Parameter* p) {
 
-    START_LOG("residual_and_jacobian()", "ComplexSolve");
+    MAST_LOG_SCOPE("ComplexAssemblyBase::residual_and_jacobian_blocked");
+    LOG_SCOPE("residual_and_jacobian()", "ComplexSolve");
     
     MAST::NonlinearSystem& nonlin_sys = _system->system();
     
@@ -701,6 +712,11 @@ residual_and_jacobian_blocked (const libMesh::NumericVector<Real>& X,
         localized_base_solution.reset(_build_localized_vector(nonlin_sys,
                                                               *_base_sol).release());
     
+    // memory of the localized vectors, including the ghosted entries
+    MAST::MemoryAccount
+    work_memory(MAST::MEMORY_ASSEMBLY_WORK);
+    work_memory.set((2 + (_base_sol? 1 : 0)) * sizeof(Real) *
+                    (nonlin_sys.n_local_dofs() + send_list.size()));
     
 
     // if a solution function is attached, initialize it
@@ -716,6 +732,8 @@ residual_and_jacobian_blocked (const libMesh::NumericVector<Real>& X,
     
     for ( ; el != end_el; ++el) {
         
+        MAST_LOG_COUNT("elements", 1);
+        
         const libMesh::Elem* elem = *el;
         
         dof_map.dof_indices (elem, dof_indices);
@@ -825,7 +843,6 @@ residual_and_jacobian_blocked (const libMesh::NumericVector<Real>& X,
     J.close();
     
     libMesh::out << "R: " << R.l2_norm() << std::endl;
-    STOP_LOG("residual_and_jacobian()", "ComplexSolve");
 }
 
 
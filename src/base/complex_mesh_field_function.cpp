@@ -39,7 +39,8 @@ _perturbed_sol_im(nullptr),
 _function_re(nullptr),
 _function_im(nullptr),
 _perturbed_function_re(nullptr),
-_perturbed_function_im(nullptr)
+_perturbed_function_im(nullptr),
+_memory(MAST::MEMORY_FIELD_FUNCTIONS)
 { }
 
 
@@ -104,6 +105,9 @@ init(const libMesh::NumericVector<Real>& sol_re,
                                              system.get_dof_map(),
                                              _system->vars());
     _function_im->init();
+    
+    _memory.add(MAST::MemoryLog::bytes(*_sol_re) +
+                MAST::MemoryLog::bytes(*_sol_im));
 }
 
 
@@ -158,6 +162,9 @@ init_perturbation(const libMesh::NumericVector<Real>& sol_re,
                                                        system.get_dof_map(),
                                                        _system->vars());
     _perturbed_function_im->init();
+    
+    _memory.add(MAST::MemoryLog::bytes(*_perturbed_sol_re) +
+                MAST::MemoryLog::bytes(*_perturbed_sol_im));
 }
 
 
@@ -247,6 +254,8 @@ MAST::ComplexMeshFieldFunction::clear() {
         _perturbed_sol_re = nullptr;
         _perturbed_sol_im = nullptr;
     }
+    
+    _memory.clear();
 }
 
 
@@ -22,6 +22,7 @@
 
 // MAST includes
 #include "base/field_function_base.h"
+#include "base/memory_log.h"
 
 
 // libMesh includes
@@ -131,6 +132,11 @@ namespace MAST {
         *_perturbed_function_re,
         *_perturbed_function_im;
         
+        /*!
+         *   memory held by the serialized solution vectors
+         */
+        MAST::MemoryAccount _memory;
+        
     };
 }
 
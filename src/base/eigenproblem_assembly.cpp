@@ -24,6 +24,7 @@
 #include "base/elem_base.h"
 #include "base/physics_discipline_base.h"
 #include "numerics/utility.h"
+#include "base/performance_log.h"
 
 // libMesh includes
 #include "libmesh/numeric_vector.h"
@@ -146,6 +147,8 @@ MAST::EigenproblemAssembly::
 eigenproblem_assemble(libMesh::SparseMatrix<Real>* A,
                       libMesh::SparseMatrix<Real>* B) {
     
+    MAST_LOG_SCOPE("EigenproblemAssembly::eigenproblem_assemble");
+    
     MAST::NonlinearSystem& eigen_sys =
     dynamic_cast<MAST::NonlinearSystem&>(_system->system());
     
@@ -181,6 +184,8 @@ eigenproblem_assemble(libMesh::SparseMatrix<Real>* A,
     
     for ( ; el != end_el; ++el) {
         
+        MAST_LOG_COUNT("elements", 1);
+        
         const libMesh::Elem* elem = *el;
         
         dof_map.dof_indices (elem, dof_indices);
@@ -230,6 +235,8 @@ eigenproblem_sensitivity_assemble(const libMesh::ParameterVector& parameters,
                                   libMesh::SparseMatrix<Real>* sensitivity_A,
                                   libMesh::SparseMatrix<Real>* sensitivity_B) {
     
+    MAST_LOG_SCOPE("EigenproblemAssembly::eigenproblem_sensitivity_assemble");
+    
     MAST::NonlinearSystem& eigen_sys =
     dynamic_cast<MAST::NonlinearSystem&>(_system->system());
 
@@ -274,6 +281,8 @@ eigenproblem_sensitivity_assemble(const libMesh::ParameterVector& parameters,
     
     for ( ; el != end_el; ++el) {
         
+        MAST_LOG_COUNT("elements", 1);
+        
         const libMesh::Elem* elem = *el;
         
         dof_map.dof_indices (elem, dof_indices);
@@ -30,6 +30,9 @@
 
 namespace MAST
 {
+    // Forward declerations
+    class Parameter;
+    
     
     
     class FunctionBase {
@@ -88,6 +91,20 @@ namespace MAST
         }
         
         
+        /*!
+         *  adds to \p params all parameters that this function depends on,
+         *  either directly or through the functions that it depends on.
+         */
+        virtual void get_parameters(std::set<const MAST::Parameter*>& params) const {
+            
+            std::set<const MAST::FunctionBase*>::const_iterator
+            it = _functions.begin(), end = _functions.end();
+            
+            for ( ; it != end; it++)
+                (*it)->get_parameters(params);
+        }
+        
+        
         /*!
          *  @returns true if the function is a shape parameter. False by
          *  default. This should be reimplemneted in a new function
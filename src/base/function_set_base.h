@@ -96,6 +96,13 @@ namespace MAST {
          *  returns true if the property card depends on the function \p f
          */
         virtual bool depends_on(const MAST::FunctionBase& f) const;
+        
+        
+        /*!
+         *  adds to \p params all parameters that the functions in this
+         *  card depend on
+         */
+        void get_parameters(std::set<const MAST::Parameter*>& params) const;
 
         
     protected:
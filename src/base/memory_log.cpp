@@ -0,0 +1,203 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2017  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+
+// C++ includes
+#include <iomanip>
+#include <vector>
+
+// MAST includes
+#include "base/memory_log.h"
+
+// libMesh includes
+#include "libmesh/parallel.h"
+#include "libmesh/numeric_vector.h"
+#include "libmesh/petsc_matrix.h"
+
+
+std::size_t MAST::MemoryLog::_current[MAST::N_MEMORY_SUBSYSTEMS] = {0};
+std::size_t MAST::MemoryLog::_peak[MAST::N_MEMORY_SUBSYSTEMS]    = {0};
+std::size_t MAST::MemoryLog::_total                              = 0;
+std::size_t MAST::MemoryLog::_total_peak                         = 0;
+
+
+
+void
+MAST::MemoryLog::reset_peaks() {
+    
+    for (unsigned int i=0; i<MAST::N_MEMORY_SUBSYSTEMS; i++)
+        _peak[i] = _current[i];
+    
+    _total_peak = _total;
+}
+
+
+
+const char*
+MAST::MemoryLog::subsystem_name(MAST::MemorySubsystem s) {
+    
+    switch (s) {
+            
+        case MAST::MEMORY_ASSEMBLY_WORK:
+            return "assembly_work";
+            
+        case MAST::MEMORY_OUTPUT_DATA:
+            return "output_data";
+            
+        case MAST::MEMORY_FIELD_FUNCTIONS:
+            return "field_functions";
+            
+        case MAST::MEMORY_FLUTTER_SOLUTIONS:
+            return "flutter_solutions";
+            
+        case MAST::MEMORY_EIGEN_SOLVER:
+            return "eigen_solver";
+            
+        case MAST::MEMORY_PRECONDITIONER:
+            return "preconditioner";
+            
+        case MAST::MEMORY_REDUCED_BASIS:
+            return "reduced_basis";
+            
+        default:
+            libmesh_error();
+    }
+    
+    return "";
+}
+
+
+
+void
+MAST::MemoryLog::report(const libMesh::Parallel::Communicator& comm,
+                        std::ostream& out,
+                        const std::string& phase) {
+    
+    // current and peak of each subsystem, followed by the total
+    const unsigned int
+    n = MAST::N_MEMORY_SUBSYSTEMS + 1;
+    
+    std::vector<Real>
+    cur_min(n, 0.),
+    peak_min(n, 0.);
+    
+    for (unsigned int i=0; i<MAST::N_MEMORY_SUBSYSTEMS; i++) {
+        
+        cur_min[i]   = _current[i];
+        peak_min[i]  = _peak[i];
+    }
+    
+    cur_min[n-1]   = _total;
+    peak_min[n-1]  = _total_peak;
+    
+    std::vector<Real>
+    cur_max(cur_min),
+    peak_max(peak_min);
+    
+    comm.min(cur_min);
+    comm.min(peak_min);
+    comm.max(cur_max);
+    comm.max(peak_max);
+    
+    // the lowest rank with the largest peak
+    std::vector<unsigned int>
+    peak_rank(n, comm.size());
+    
+    for (unsigned int i=0; i<MAST::N_MEMORY_SUBSYSTEMS; i++)
+        if (_peak[i] == peak_max[i])
+            peak_rank[i] = comm.rank();
+    
+    if (_total_peak == peak_max[n-1])
+        peak_rank[n-1] = comm.rank();
+    
+    comm.min(peak_rank);
+    
+    if (comm.rank() != 0)
+        return;
+    
+    const Real
+    mb = 1024.*1024.;
+    
+    out
+    << std::endl
+    << " MAST memory log: " << phase << ", " << comm.size()
+    << " ranks, MB per rank" << std::endl
+    << std::setw(24) << std::left << " subsystem" << std::right
+    << std::setw(14) << "current min"
+    << std::setw(14) << "current max"
+    << std::setw(14) << "peak min"
+    << std::setw(14) << "peak max"
+    << std::setw(12) << "peak rank"
+    << std::endl;
+    
+    for (unsigned int i=0; i<n; i++) {
+        
+        const std::string
+        nm = (i < MAST::N_MEMORY_SUBSYSTEMS)?
+        subsystem_name(MAST::MemorySubsystem(i)) : "total";
+        
+        out
+        << std::setw(24) << std::left << (" " + nm) << std::right
+        << std::fixed << std::setprecision(3)
+        << std::setw(14) << cur_min[i]/mb
+        << std::setw(14) << cur_max[i]/mb
+        << std::setw(14) << peak_min[i]/mb
+        << std::setw(14) << peak_max[i]/mb
+        << std::setw(12) << peak_rank[i]
+        << std::endl;
+    }
+    
+    out.unsetf(std::ios_base::floatfield);
+    out << std::setprecision(6) << std::endl;
+}
+
+
+
+std::size_t
+MAST::MemoryLog::bytes(const libMesh::NumericVector<Real>& v) {
+    
+    // serial vectors store all entries on each rank. The ghost entries
+    // of ghosted vectors are not included.
+    if (v.type() == libMesh::SERIAL)
+        return v.size() * sizeof(Real);
+    else
+        return v.local_size() * sizeof(Real);
+}
+
+
+
+std::size_t
+MAST::MemoryLog::bytes(const libMesh::SparseMatrix<Real>& m) {
+    
+    const libMesh::PetscMatrix<Real>*
+    pm = dynamic_cast<const libMesh::PetscMatrix<Real>*>(&m);
+    
+    if (!pm || !m.initialized())
+        return 0;
+    
+    MatInfo info;
+    PetscErrorCode ierr =
+    MatGetInfo(const_cast<libMesh::PetscMatrix<Real>*>(pm)->mat(),
+               MAT_LOCAL,
+               &info);
+    CHKERRABORT(m.comm().get(), ierr);
+    
+    return (std::size_t)info.memory;
+}
@@ -0,0 +1,274 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2017  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+
+#ifndef __mast__memory_log__
+#define __mast__memory_log__
+
+// C++ includes
+#include <string>
+#include <iostream>
+
+// MAST includes
+#include "base/mast_data_types.h"
+
+
+namespace libMesh {
+    
+    namespace Parallel {
+        class Communicator;
+    }
+    
+    template <typename T> class NumericVector;
+    template <typename T> class SparseMatrix;
+}
+
+
+namespace MAST {
+    
+    /*!
+     *   subsystems to which the accounted memory is attributed
+     */
+    enum MemorySubsystem {
+        MEMORY_ASSEMBLY_WORK = 0,   // localized vectors used during assembly
+        MEMORY_OUTPUT_DATA,         // quadrature point output data
+        MEMORY_FIELD_FUNCTIONS,     // serialized solutions of field functions
+        MEMORY_FLUTTER_SOLUTIONS,   // flutter solutions and their matrices
+        MEMORY_EIGEN_SOLVER,        // eigenproblem operators and vectors
+        MEMORY_PRECONDITIONER,      // preconditioners stored by MAST
+        MEMORY_REDUCED_BASIS,       // reduced-basis snapshots and operators
+        N_MEMORY_SUBSYSTEMS
+    };
+    
+    
+    /*!
+     *   Accounts the memory held by the major data structures of MAST on
+     *   this rank, by subsystem. The accounting is done by
+     *   MAST::MemoryAccount objects owned by the data structures, which
+     *   report their current size in bytes. For each subsystem the current
+     *   and the peak bytes are kept, along with those of the sum over all
+     *   subsystems.
+     *
+     *   The sizes are the storage of the numerical data, and do not include
+     *   the overhead of the containers, so that they are a lower bound on
+     *   the memory used.
+     */
+    class MemoryLog {
+        
+    public:
+        
+        /*!
+         *   adds \p bytes to subsystem \p s
+         */
+        static void add(MAST::MemorySubsystem s, std::size_t bytes) {
+            
+            _current[s] += bytes;
+            _total      += bytes;
+            
+            if (_current[s] > _peak[s]) _peak[s]     = _current[s];
+            if (_total > _total_peak)   _total_peak  = _total;
+        }
+        
+        
+        /*!
+         *   removes \p bytes from subsystem \p s
+         */
+        static void remove(MAST::MemorySubsystem s, std::size_t bytes) {
+            
+            libmesh_assert_greater_equal(_current[s], bytes);
+            
+            _current[s] -= bytes;
+            _total      -= bytes;
+        }
+        
+        
+        /*!
+         *   @returns the bytes currently held by subsystem \p s
+         */
+        static std::size_t current(MAST::MemorySubsystem s) {
+            return _current[s];
+        }
+        
+        
+        /*!
+         *   @returns the peak bytes held by subsystem \p s since the last
+         *   call to reset_peaks()
+         */
+        static std::size_t peak(MAST::MemorySubsystem s) {
+            return _peak[s];
+        }
+        
+        
+        /*!
+         *   @returns the bytes currently held by all subsystems
+         */
+        static std::size_t total_current() {
+            return _total;
+        }
+        
+        
+        /*!
+         *   @returns the peak of the bytes held by all subsystems together
+         *   since the last call to reset_peaks(). This is not the sum of
+         *   the peaks of the subsystems, which need not occur together.
+         */
+        static std::size_t total_peak() {
+            return _total_peak;
+        }
+        
+        
+        /*!
+         *   sets the peak values to the current values
+         */
+        static void reset_peaks();
+        
+        
+        /*!
+         *   @returns the name of subsystem \p s
+         */
+        static const char* subsystem_name(MAST::MemorySubsystem s);
+        
+        
+        /*!
+         *   writes the current and peak memory of each subsystem to \p out
+         *   on rank 0, with the minimum and maximum over the ranks in
+         *   \p comm and the rank with the largest peak. \p phase is printed
+         *   in the header to identify the point in the analysis. This
+         *   should be called on all ranks.
+         */
+        static void report(const libMesh::Parallel::Communicator& comm,
+                           std::ostream& out,
+                           const std::string& phase);
+        
+        
+        /*!
+         *   @returns the bytes of the entries of \p v stored on this rank.
+         */
+        static std::size_t bytes(const libMesh::NumericVector<Real>& v);
+        
+        
+        /*!
+         *   @returns the bytes used by the local rows of \p m, as reported
+         *   by PETSc. Zero is returned for matrices of other types.
+         */
+        static std::size_t bytes(const libMesh::SparseMatrix<Real>& m);
+        
+        
+        /*!
+         *   @returns the bytes of the coefficients of the Eigen matrix or
+         *   vector \p m
+         */
+        template <typename Derived>
+        static std::size_t bytes(const Eigen::PlainObjectBase<Derived>& m) {
+            return m.size() * sizeof(typename Derived::Scalar);
+        }
+        
+        
+    protected:
+        
+        static std::size_t _current[MAST::N_MEMORY_SUBSYSTEMS];
+        static std::size_t _peak[MAST::N_MEMORY_SUBSYSTEMS];
+        static std::size_t _total;
+        static std::size_t _total_peak;
+    };
+    
+    
+    
+    /*!
+     *   Holds the bytes accounted for one data structure in subsystem
+     *   \p s of MAST::MemoryLog. The owner updates the size with set()
+     *   whenever its storage changes, and the bytes are released when
+     *   the account is destroyed.
+     */
+    class MemoryAccount {
+        
+    public:
+        
+        MemoryAccount(MAST::MemorySubsystem s):
+        _subsystem(s),
+        _bytes(0) { }
+        
+        
+        /*!
+         *   a copy accounts for the same bytes as \p a, since the
+         *   storage of the owner is copied along with it
+         */
+        MemoryAccount(const MAST::MemoryAccount& a):
+        _subsystem(a._subsystem),
+        _bytes(0) {
+            this->set(a._bytes);
+        }
+        
+        
+        ~MemoryAccount() {
+            this->clear();
+        }
+        
+        
+        MAST::MemoryAccount& operator= (const MAST::MemoryAccount& a) {
+            this->set(a._bytes);
+            return *this;
+        }
+        
+        
+        /*!
+         *   sets the bytes held by the owner to \p bytes
+         */
+        void set(std::size_t bytes) {
+            MAST::MemoryLog::remove(_subsystem, _bytes);
+            MAST::MemoryLog::add(_subsystem, bytes);
+            _bytes = bytes;
+        }
+        
+        
+        /*!
+         *   adds \p bytes to the bytes held by the owner
+         */
+        void add(std::size_t bytes) {
+            MAST::MemoryLog::add(_subsystem, bytes);
+            _bytes += bytes;
+        }
+        
+        
+        /*!
+         *   releases the bytes held by the owner
+         */
+        void clear() {
+            this->set(0);
+        }
+        
+        
+        /*!
+         *   @returns the bytes held by the owner
+         */
+        std::size_t bytes() const {
+            return _bytes;
+        }
+        
+    protected:
+        
+        const MAST::MemorySubsystem _subsystem;
+        
+        std::size_t                 _bytes;
+    };
+}
+
+
+#endif // __mast__memory_log__
@@ -36,7 +36,8 @@ _system(&sys),
 _sol(nullptr),
 _dsol(nullptr),
 _function(nullptr),
-_perturbed_function(nullptr)
+_perturbed_function(nullptr),
+_memory(MAST::MEMORY_FIELD_FUNCTIONS)
 { }
 
 
@@ -188,6 +189,9 @@ init(const libMesh::NumericVector<Real>& sol,
         _perturbed_function->init();
 
     }
+    
+    _memory.set(MAST::MemoryLog::bytes(*_sol) +
+                (_dsol? MAST::MemoryLog::bytes(*_dsol) : 0));
 }
 
 
@@ -214,6 +218,7 @@ MAST::MeshFieldFunction::clear() {
         _dsol = nullptr;
     }
 
+    _memory.clear();
     
     // clear flags for quadrature point solution
     _use_qp_sol = false;
@@ -22,6 +22,7 @@
 
 // MAST includes
 #include "base/field_function_base.h"
+#include "base/memory_log.h"
 
 
 // libMesh includes
@@ -165,6 +166,11 @@ namespace MAST {
          *   the MeshFunction object that performs the interpolation
          */
         libMesh::MeshFunction *_function, *_perturbed_function;
+        
+        /*!
+         *   memory held by the serialized solution vectors
+         */
+        MAST::MemoryAccount _memory;
     };
 }
 
@@ -25,6 +25,9 @@
 #include "numerics/utility.h"
 #include "base/mesh_field_function.h"
 #include "base/nonlinear_system.h"
+#include "solver/jacobian_lagging_policy.h"
+#include "base/performance_log.h"
+#include "base/memory_log.h"
 
 // libMesh includes
 #include "libmesh/nonlinear_solver.h"
@@ -217,12 +220,31 @@ residual_and_jacobian (const libMesh::NumericVector<Real>& X,
                        libMesh::SparseMatrix<Real>*  J,
                        libMesh::NonlinearImplicitSystem& S) {
     
+    MAST_LOG_SCOPE("NonlinearImplicitAssembly::residual_and_jacobian");
+    
     MAST::NonlinearSystem& nonlin_sys = _system->system();
     
     // make sure that the system for which this object was created,
     // and the system passed through the function call are the same
     libmesh_assert_equal_to(&S, &(nonlin_sys));
     
+    // if the lagging policy chooses to reuse the Jacobian from an earlier
+    // request, the matrix is left untouched and only the residual is
+    // computed. MAST::NonlinearSystem::solve() stops the nonlinear solver
+    // from zeroing the matrix before the request while a policy is
+    // attached.
+    MAST::JacobianLaggingPolicy*
+    lagging = nonlin_sys.jacobian_lagging_policy();
+    
+    if (J && lagging && !lagging->if_assemble_jacobian()) {
+        
+        J = nullptr;
+        if (!R) return;
+    }
+    
+    if (R) MAST_LOG_COUNT("residuals", 1);
+    if (J) MAST_LOG_COUNT("jacobians", 1);
+    
     if (R) R->zero();
     if (J) J->zero();
     
@@ -239,6 +261,13 @@ residual_and_jacobian (const libMesh::NumericVector<Real>& X,
     localized_solution.reset(_build_localized_vector(nonlin_sys,
                                                      X).release());
     
+    // memory of the localized solution, including the ghosted entries
+    MAST::MemoryAccount
+    work_memory(MAST::MEMORY_ASSEMBLY_WORK);
+    work_memory.set(sizeof(Real) *
+                    (nonlin_sys.n_local_dofs() +
+                     dof_map.get_send_list().size()));
+    
     
     // if a solution function is attached, initialize it
     if (_sol_function)
@@ -253,6 +282,8 @@ residual_and_jacobian (const libMesh::NumericVector<Real>& X,
 
     for ( ; el != end_el; ++el) {
         
+        MAST_LOG_COUNT("elements", 1);
+        
         const libMesh::Elem* elem = *el;
         
         dof_map.dof_indices (elem, dof_indices);
@@ -276,9 +307,12 @@ residual_and_jacobian (const libMesh::NumericVector<Real>& X,
         //_check_element_numerical_jacobian(*physics_elem, sol);
         
         // perform the element level calculations
-        _elem_calculations(*physics_elem,
-                           J!=nullptr?true:false,
-                           vec, mat);
+        {
+            MAST_LOG_SCOPE("NonlinearImplicitAssembly::element_calculations");
+            _elem_calculations(*physics_elem,
+                               J!=nullptr?true:false,
+                               vec, mat);
+        }
         
         physics_elem->detach_active_solution_function();
 
@@ -315,6 +349,11 @@ residual_and_jacobian (const libMesh::NumericVector<Real>& X,
     
     if (R) R->close();
     if (J) J->close();
+    
+    // the residual norm is used by the policy to detect a slow reduction
+    // of residual with a lagged Jacobian
+    if (R && lagging)
+        lagging->set_residual_norm(R->l2_norm());
 }
 
 
@@ -327,6 +366,8 @@ linearized_jacobian_solution_product (const libMesh::NumericVector<Real>& X,
                                       libMesh::NumericVector<Real>& JdX,
                                       libMesh::NonlinearImplicitSystem& S) {
     
+    MAST_LOG_SCOPE("NonlinearImplicitAssembly::linearized_jacobian_solution_product");
+    
     // zero the solution vector
     JdX.zero();
     
@@ -368,6 +409,8 @@ linearized_jacobian_solution_product (const libMesh::NumericVector<Real>& X,
     
     for ( ; el != end_el; ++el) {
         
+        MAST_LOG_COUNT("elements", 1);
+        
         const libMesh::Elem* elem = *el;
         
         dof_map.dof_indices (elem, dof_indices);
@@ -429,6 +472,8 @@ second_derivative_dot_solution_assembly (const libMesh::NumericVector<Real>& X,
                                          libMesh::SparseMatrix<Real>& d_JdX_dX,
                                          libMesh::NonlinearImplicitSystem& S) {
     
+    MAST_LOG_SCOPE("NonlinearImplicitAssembly::second_derivative_dot_solution_assembly");
+    
     // zero the matrix
     d_JdX_dX.zero();
     
@@ -470,6 +515,8 @@ second_derivative_dot_solution_assembly (const libMesh::NumericVector<Real>& X,
     
     for ( ; el != end_el; ++el) {
         
+        MAST_LOG_COUNT("elements", 1);
+        
         const libMesh::Elem* elem = *el;
         
         dof_map.dof_indices (elem, dof_indices);
@@ -538,6 +585,8 @@ sensitivity_assemble (const libMesh::ParameterVector& parameters,
                       const unsigned int i,
                       libMesh::NumericVector<Real>& sensitivity_rhs) {
     
+    MAST_LOG_SCOPE("NonlinearImplicitAssembly::sensitivity_assemble");
+    
     MAST::NonlinearSystem& nonlin_sys = _system->system();
     
     sensitivity_rhs.zero();
@@ -566,6 +615,8 @@ sensitivity_assemble (const libMesh::ParameterVector& parameters,
     
     for ( ; el != end_el; ++el) {
         
+        MAST_LOG_COUNT("elements", 1);
+        
         const libMesh::Elem* elem = *el;
         
         dof_map.dof_indices (elem, dof_indices);
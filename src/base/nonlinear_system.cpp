@@ -27,6 +27,9 @@
 #include "base/nonlinear_implicit_assembly.h"
 #include "base/parameter.h"
 #include "solver/slepc_eigen_solver.h"
+#include "solver/jacobian_lagging_policy.h"
+#include "solver/single_precision_preconditioner.h"
+#include "base/performance_log.h"
 
 // libMesh includes
 #include "libmesh/numeric_vector.h"
@@ -35,17 +38,197 @@
 #include "libmesh/sparse_matrix.h"
 #include "libmesh/dof_map.h"
 #include "libmesh/nonlinear_solver.h"
+#include "libmesh/petsc_nonlinear_solver.h"
+#include "libmesh/petsc_matrix.h"
+#include "libmesh/petsc_vector.h"
+
+// PETSc includes
+#include <petscsnes.h>
+
+
+
+//---------------------------------------------------------------
+// this function is called by PETSc to evaluate the residual at X for the
+// Jacobian-free Newton-Krylov solution
+PetscErrorCode
+__mast_nonlinear_system_petsc_snes_residual (SNES snes, Vec x, Vec r, void * ctx) {
+    
+    MAST_LOG_SCOPE("JFNKNonlinearSystem::residual");
+    LOG_SCOPE("residual()", "JFNKNonlinearSystem");
+    
+    PetscErrorCode ierr=0;
+    
+    libmesh_assert(x);
+    libmesh_assert(r);
+    libmesh_assert(ctx);
+    
+    MAST::NonlinearSystem * sys =
+    static_cast<MAST::NonlinearSystem*> (ctx);
+    
+    MAST::NonlinearImplicitAssembly * assembly =
+    dynamic_cast<MAST::NonlinearImplicitAssembly*>
+    (sys->nonlinear_solver->residual_and_jacobian_object);
+    
+    libmesh_assert(assembly);
+    
+    libMesh::PetscVector<Real>
+    X(x, sys->comm()),
+    R(r, sys->comm());
+    
+    // Enforce constraints (if any) exactly on the current solution.
+    sys->get_dof_map().enforce_constraints_exactly(*sys, &X);
+    
+    assembly->residual_and_jacobian(X, &R, nullptr, *sys);
+    
+    R.close();
+    
+    return ierr;
+}
+
+
+
+//---------------------------------------------------------------
+// this function is called by PETSc to evaluate the preconditioner at X for
+// the Jacobian-free Newton-Krylov solution
+PetscErrorCode
+__mast_nonlinear_system_petsc_snes_jacobian(SNES snes, Vec x, Mat jac, Mat pc, void * ctx)
+{
+    MAST_LOG_SCOPE("JFNKNonlinearSystem::preconditioner");
+    LOG_SCOPE("preconditioner()", "JFNKNonlinearSystem");
+    
+    PetscErrorCode ierr=0;
+    
+    libmesh_assert(x);
+    libmesh_assert(jac);
+    libmesh_assert(pc);
+    libmesh_assert(ctx);
+    
+    MAST::NonlinearSystem * sys =
+    static_cast<MAST::NonlinearSystem*> (ctx);
+    
+    MAST::NonlinearImplicitAssembly * assembly =
+    dynamic_cast<MAST::NonlinearImplicitAssembly*>
+    (sys->nonlinear_solver->residual_and_jacobian_object);
+    
+    libmesh_assert(assembly);
+    
+    libMesh::PetscVector<Real>
+    X(x, sys->comm());
+    
+    sys->get_dof_map().enforce_constraints_exactly(*sys, &X);
+    
+    // the system matrix is used as the preconditioner. The shell operator
+    // computes the product at the current iterate, and the assembly of the
+    // finite difference operator sets the base point of the differences
+    // to the current iterate.
+    assembly->residual_and_jacobian(X, nullptr, sys->matrix, *sys);
+    
+    sys->matrix->close();
+    
+    ierr = MatAssemblyBegin(jac, MAT_FINAL_ASSEMBLY);  CHKERRABORT(sys->comm().get(), ierr);
+    ierr = MatAssemblyEnd(jac, MAT_FINAL_ASSEMBLY);    CHKERRABORT(sys->comm().get(), ierr);
+    
+    return ierr;
+}
+
+
+
+//---------------------------------------------------------------
+// this function is called by PETSc in place of the Jacobian when the
+// preconditioner is assembled at the zero solution. The preconditioner is
+// left untouched, and only the operator is updated to the current iterate.
+PetscErrorCode
+__mast_nonlinear_system_petsc_snes_operator(SNES snes, Vec x, Mat jac, Mat pc, void * ctx)
+{
+    PetscErrorCode ierr=0;
+    
+    libmesh_assert(jac);
+    libmesh_assert(ctx);
+    
+    MAST::NonlinearSystem * sys =
+    static_cast<MAST::NonlinearSystem*> (ctx);
+    
+    ierr = MatAssemblyBegin(jac, MAT_FINAL_ASSEMBLY);  CHKERRABORT(sys->comm().get(), ierr);
+    ierr = MatAssemblyEnd(jac, MAT_FINAL_ASSEMBLY);    CHKERRABORT(sys->comm().get(), ierr);
+    
+    return ierr;
+}
+
+
+
+//---------------------------------------------------------------
+// method for matrix vector multiplicaiton of the Jacobian y=Jx for the
+// Jacobian-free Newton-Krylov solution
+struct
+__mast_nonlinear_system_petsc_shell_context {
+    SNES                     snes;
+    MAST::NonlinearSystem*   sys;
+};
+
+
+
+PetscErrorCode
+__mast_nonlinear_system_petsc_mat_mult(Mat mat, Vec dx, Vec y) {
+    
+    MAST_LOG_SCOPE("JFNKNonlinearSystem::mat_mult");
+    LOG_SCOPE("mat_mult()", "JFNKNonlinearSystem");
+    
+    PetscErrorCode ierr=0;
+    
+    libmesh_assert(mat);
+    libmesh_assert(dx);
+    libmesh_assert(y);
+    
+    void * ctx = PETSC_NULL;
+    
+    ierr = MatShellGetContext(mat, &ctx);
+    
+    __mast_nonlinear_system_petsc_shell_context
+    *mat_ctx = static_cast<__mast_nonlinear_system_petsc_shell_context*> (ctx);
+    
+    MAST::NonlinearSystem
+    *sys = mat_ctx->sys;
+    
+    MAST::NonlinearImplicitAssembly * assembly =
+    dynamic_cast<MAST::NonlinearImplicitAssembly*>
+    (sys->nonlinear_solver->residual_and_jacobian_object);
+    
+    libmesh_assert(assembly);
+    
+    // the product is computed at the current nonlinear solution
+    Vec x;
+    ierr = SNESGetSolution(mat_ctx->snes, &x);  CHKERRABORT(sys->comm().get(), ierr);
+    
+    libMesh::PetscVector<Real>
+    X (x,  sys->comm()),
+    dX(dx, sys->comm()),
+    Y (y,  sys->comm());
+    
+    sys->get_dof_map().enforce_constraints_exactly(*sys, &dX,
+                                                   true /* homogeneous = true */);
+    
+    assembly->linearized_jacobian_solution_product(X, dX, Y, *sys);
+    
+    Y.close();
+    
+    return ierr;
+}
 
 
 MAST::NonlinearSystem::NonlinearSystem(libMesh::EquationSystems& es,
                                        const std::string& name,
                                        const unsigned int number):
 libMesh::NonlinearImplicitSystem(es, name, number),
+_if_jfnk                              (false),
+_jfnk_pc_lag                          (0),
+_jfnk_reference_pc                    (nullptr),
+_jfnk_reference_pc_state              (0),
+_if_jfnk_fd_product                   (false),
+_if_single_precision_pc               (false),
+_jacobian_lagging                     (nullptr),
 _initialize_B_matrix                  (false),
 matrix_A                              (nullptr),
 matrix_B                              (nullptr),
-//condensed_matrix_A                    (nullptr),
-//condensed_matrix_B                    (nullptr),
 eigen_solver                          (nullptr),
 _condensed_dofs_initialized           (false),
 _exchange_A_and_B                     (false),
@@ -55,7 +238,9 @@ _n_iterations                         (0),
 _is_generalized_eigenproblem          (false),
 _eigen_problem_type                   (libMesh::NHEP),
 _eigenproblem_assemble_system_object  (nullptr),
-_output                               (nullptr) {
+_output                               (nullptr),
+_condensed_matrices_initialized       (false),
+_condensed_memory                     (MAST::MEMORY_EIGEN_SOLVER) {
     
 }
 
@@ -89,6 +274,244 @@ MAST::NonlinearSystem::clear() {
 }
 
 
+void
+MAST::NonlinearSystem::solve() {
+    
+    MAST_LOG_SCOPE("NonlinearSystem::solve");
+    
+    // Jacobian requests during the solve are lagged based on the policy
+    if (_jacobian_lagging)
+        _jacobian_lagging->init_solve();
+    
+    if (!_if_jfnk) {
+        
+        // the PETSc nonlinear solver zeros the matrix before each Jacobian
+        // request. This would discard the matrix that the lagging policy
+        // chooses to reuse, so the zeroing is left to the assembly, which
+        // zeros the matrix only when the Jacobian is assembled.
+        libMesh::PetscNonlinearSolver<Real>*
+        petsc_solver = nullptr;
+        
+        if (_jacobian_lagging) {
+            
+            petsc_solver =
+            dynamic_cast<libMesh::PetscNonlinearSolver<Real>*>(nonlinear_solver.get());
+            libmesh_assert(petsc_solver);
+            petsc_solver->set_jacobian_zero_out(false);
+        }
+        
+        libMesh::NonlinearImplicitSystem::solve();
+        MAST_LOG_COUNT("nonlinear_iterations", this->n_nonlinear_iterations());
+        MAST_LOG_COUNT("ksp_iterations",
+                       nonlinear_solver->get_total_linear_iterations());
+        
+        if (petsc_solver)
+            petsc_solver->set_jacobian_zero_out(true);
+    }
+    else
+        _jfnk_solve();
+    
+    if (_jacobian_lagging)
+        _jacobian_lagging->end_solve();
+}
+
+
+
+void
+MAST::NonlinearSystem::_jfnk_solve() {
+    
+    MAST_LOG_SCOPE("NonlinearSystem::jfnk_solve");
+    LOG_SCOPE("jfnk_solve()", "NonlinearSystem");
+    
+    // the assembly object must provide the Jacobian-vector product
+    MAST::NonlinearImplicitAssembly*
+    assembly = dynamic_cast<MAST::NonlinearImplicitAssembly*>
+    (nonlinear_solver->residual_and_jacobian_object);
+    libmesh_assert(assembly);
+    
+    PetscErrorCode   ierr;
+    SNES             snes;
+    Mat              jac;
+    KSP              ksp;
+    
+    const bool       sys_name = libMesh::on_command_line("--solver_system_names");
+    std::string      nm;
+    
+    ierr = SNESCreate(this->comm().get(), &snes);      CHKERRABORT(this->comm().get(), ierr);
+    
+    //////////////////////////////////////////////////////////////////////
+    // the system matrix is used as the preconditioner, and the system
+    // solution and rhs vectors are used by the solver.
+    //////////////////////////////////////////////////////////////////////
+    Mat
+    pc  = dynamic_cast<libMesh::PetscMatrix<Real>*>(this->matrix)->mat();
+    
+    Vec
+    sol = dynamic_cast<libMesh::PetscVector<Real>*>(this->solution.get())->vec(),
+    res = dynamic_cast<libMesh::PetscVector<Real>*>(this->rhs)->vec();
+    
+    ierr = SNESSetFunction (snes,
+                            res,
+                            __mast_nonlinear_system_petsc_snes_residual,
+                            this);
+    CHKERRABORT(this->comm().get(), ierr);
+    
+    //////////////////////////////////////////////////////////////////////
+    // the Jacobian operator is either a finite difference of the residual,
+    // or a shell matrix that uses the element-level Jacobian-vector
+    // product. The former needs the residual function set above.
+    //////////////////////////////////////////////////////////////////////
+    __mast_nonlinear_system_petsc_shell_context
+    mat_ctx;
+    mat_ctx.snes = snes;
+    mat_ctx.sys  = this;
+    
+    if (_if_jfnk_fd_product) {
+        
+        ierr = MatCreateSNESMF(snes, &jac);
+        CHKERRABORT(this->comm().get(), ierr);
+    }
+    else {
+        
+        ierr = MatCreateShell(this->comm().get(),
+                              this->n_local_dofs(),
+                              this->n_local_dofs(),
+                              this->n_dofs(),
+                              this->n_dofs(),
+                              &mat_ctx,
+                              &jac);
+        CHKERRABORT(this->comm().get(), ierr);
+        
+        ierr = MatShellSetOperation(jac,
+                                    MATOP_MULT,
+                                    (void(*)(void))__mast_nonlinear_system_petsc_mat_mult);
+        CHKERRABORT(this->comm().get(), ierr);
+    }
+    
+    if (_jfnk_pc_lag) {
+        
+        ierr = SNESSetJacobian(snes,
+                               jac,
+                               pc,
+                               __mast_nonlinear_system_petsc_snes_jacobian,
+                               this);
+        CHKERRABORT(this->comm().get(), ierr);
+        
+        // the preconditioner is assembled once every _jfnk_pc_lag
+        // iterations. Since the SNES is created for each solve, a lag of -1
+        // is passed as -2, which assembles the preconditioner at the first
+        // iteration and never again.
+        ierr = SNESSetLagJacobian(snes, (_jfnk_pc_lag == -1)? -2 : _jfnk_pc_lag);
+        CHKERRABORT(this->comm().get(), ierr);
+    }
+    else {
+        
+        //////////////////////////////////////////////////////////////////
+        // the preconditioner is the Jacobian at the zero solution. It is
+        // assembled only if the system matrix does not hold it from an
+        // earlier solve, which is checked from the PETSc state of the
+        // matrix. The callback then only updates the operator, and
+        // PETSc does not set up the preconditioner again since the matrix
+        // is unchanged.
+        //////////////////////////////////////////////////////////////////
+        PetscObjectState
+        state = 0;
+        ierr = PetscObjectStateGet((PetscObject)pc, &state);
+        CHKERRABORT(this->comm().get(), ierr);
+        
+        if (_jfnk_reference_pc != pc || _jfnk_reference_pc_state != state) {
+            
+            std::auto_ptr<libMesh::NumericVector<Real> >
+            x0(this->solution->zero_clone().release());
+            
+            // the lagging policy is detached, since it could choose to
+            // reuse the matrix from a different assembly
+            MAST::JacobianLaggingPolicy*
+            lagging           = _jacobian_lagging;
+            _jacobian_lagging = nullptr;
+            
+            assembly->residual_and_jacobian(*x0, nullptr, this->matrix, *this);
+            this->matrix->close();
+            
+            _jacobian_lagging = lagging;
+            
+            _jfnk_reference_pc = pc;
+            ierr = PetscObjectStateGet((PetscObject)pc, &_jfnk_reference_pc_state);
+            CHKERRABORT(this->comm().get(), ierr);
+        }
+        
+        ierr = SNESSetJacobian(snes,
+                               jac,
+                               pc,
+                               __mast_nonlinear_system_petsc_snes_operator,
+                               this);
+        CHKERRABORT(this->comm().get(), ierr);
+    }
+    
+    ierr = SNESSetTolerances(snes,
+                             nonlinear_solver->absolute_residual_tolerance,
+                             nonlinear_solver->relative_residual_tolerance,
+                             nonlinear_solver->relative_step_tolerance,
+                             nonlinear_solver->max_nonlinear_iterations,
+                             nonlinear_solver->max_function_evaluations);
+    CHKERRABORT(this->comm().get(), ierr);
+    
+    if (sys_name) {
+        
+        nm = this->name() + "_";
+        SNESSetOptionsPrefix(snes, nm.c_str());
+    }
+    
+    ierr = SNESGetKSP (snes, &ksp);                   CHKERRABORT(this->comm().get(), ierr);
+    ierr = SNESSetFromOptions(snes);                  CHKERRABORT(this->comm().get(), ierr);
+    
+    // the single precision preconditioner replaces the one set from the
+    // options. It is set up by PETSc each time the system matrix is
+    // assembled.
+    MAST::SinglePrecisionPreconditioner  sp_pc;
+    
+    if (_if_single_precision_pc) {
+        
+        PC      ksp_pc;
+        ierr = KSPGetPC(ksp, &ksp_pc);                CHKERRABORT(this->comm().get(), ierr);
+        sp_pc.attach(ksp_pc);
+    }
+    
+    //////////////////////////////////////////////////////////////////////
+    // now, solve
+    //////////////////////////////////////////////////////////////////////
+    this->get_dof_map().enforce_constraints_exactly(*this);
+    
+    ierr = SNESSolve(snes, PETSC_NULL, sol);          CHKERRABORT(this->comm().get(), ierr);
+    
+    PetscInt
+    n_iters     = 0,
+    n_lin_iters = 0;
+    PetscReal
+    res_norm = 0.;
+    
+    ierr = SNESGetIterationNumber(snes, &n_iters);    CHKERRABORT(this->comm().get(), ierr);
+    ierr = SNESGetLinearSolveIterations(snes, &n_lin_iters); CHKERRABORT(this->comm().get(), ierr);
+    MAST_LOG_COUNT("nonlinear_iterations", n_iters);
+    MAST_LOG_COUNT("ksp_iterations",       n_lin_iters);
+    ierr = VecNorm(res, NORM_2, &res_norm);           CHKERRABORT(this->comm().get(), ierr);
+    
+    _n_nonlinear_iterations   = n_iters;
+    _final_nonlinear_residual = res_norm;
+    
+    // the solution vector was modified through its PETSc handle
+    this->solution->close();
+    this->get_dof_map().enforce_constraints_exactly(*this);
+    this->update();
+    
+    // destroy the Petsc contexts
+    ierr = SNESDestroy(&snes);                        CHKERRABORT(this->comm().get(), ierr);
+    ierr = MatDestroy(&jac);                          CHKERRABORT(this->comm().get(), ierr);
+    
+}
+
+
+
 void
 MAST::NonlinearSystem::set_eigenproblem_type (libMesh::EigenProblemType ept) {
     
@@ -171,6 +594,9 @@ void MAST::NonlinearSystem::reinit () {
         matrix_B->init();
         matrix_B->zero();
     }
+    
+    // the condensed matrices have the old sparsity pattern
+    this->_clear_condensed_operators();
 }
 
 
@@ -180,7 +606,8 @@ void
 MAST::NonlinearSystem::eigenproblem_solve() {
     
     
-    START_LOG("eigensolve()", "NonlinearSystem");
+    MAST_LOG_SCOPE("NonlinearSystem::eigenproblem_solve");
+    LOG_SCOPE("eigensolve()", "NonlinearSystem");
     
     // A reference to the EquationSystems
     libMesh::EquationSystems& es = this->get_equation_systems();
@@ -254,21 +681,37 @@ MAST::NonlinearSystem::eigenproblem_solve() {
         // If we reach here, then there should be some non-condensed dofs
         libmesh_assert(!_local_non_condensed_dofs_vector.empty());
         
-        std::auto_ptr<libMesh::SparseMatrix<Real> >
-        condensed_matrix_A(libMesh::SparseMatrix<Real>::build(this->comm()).release()),
-        condensed_matrix_B(libMesh::SparseMatrix<Real>::build(this->comm()).release());
-
-        // Now condense the matrices
-        matrix_A->create_submatrix(*condensed_matrix_A,
-                                   _local_non_condensed_dofs_vector,
-                                   _local_non_condensed_dofs_vector);
-        
-        
-        if (generalized()) {
+        // Now condense the matrices. The submatrices are created at the
+        // first solve, and only their values are updated in subsequent
+        // solves, which avoids the reallocation of the sparsity pattern.
+        if (!_condensed_matrices_initialized) {
             
-            matrix_B->create_submatrix(*condensed_matrix_B,
+            _condensed_matrix_A.reset(libMesh::SparseMatrix<Real>::build(this->comm()).release());
+            matrix_A->create_submatrix(*_condensed_matrix_A,
                                        _local_non_condensed_dofs_vector,
                                        _local_non_condensed_dofs_vector);
+            
+            if (generalized()) {
+                
+                _condensed_matrix_B.reset(libMesh::SparseMatrix<Real>::build(this->comm()).release());
+                matrix_B->create_submatrix(*_condensed_matrix_B,
+                                           _local_non_condensed_dofs_vector,
+                                           _local_non_condensed_dofs_vector);
+            }
+            
+            _condensed_matrices_initialized = true;
+            _update_condensed_memory();
+        }
+        else {
+            
+            matrix_A->reinit_submatrix(*_condensed_matrix_A,
+                                       _local_non_condensed_dofs_vector,
+                                       _local_non_condensed_dofs_vector);
+            
+            if (generalized())
+                matrix_B->reinit_submatrix(*_condensed_matrix_B,
+                                           _local_non_condensed_dofs_vector,
+                                           _local_non_condensed_dofs_vector);
         }
         
         // call the solver depending on the type of eigenproblem
@@ -278,12 +721,12 @@ MAST::NonlinearSystem::eigenproblem_solve() {
             
             // exchange the matrices if requested by the user
             if (!_exchange_A_and_B) {
-                eig_A  =  condensed_matrix_A.get();
-                eig_B  =  condensed_matrix_B.get();
+                eig_A  =  _condensed_matrix_A.get();
+                eig_B  =  _condensed_matrix_B.get();
             }
             else {
-                eig_B  =  condensed_matrix_A.get();
-                eig_A  =  condensed_matrix_B.get();
+                eig_B  =  _condensed_matrix_A.get();
+                eig_A  =  _condensed_matrix_B.get();
             }
             
             solve_data = eigen_solver->solve_generalized(*eig_A,
@@ -298,7 +741,7 @@ MAST::NonlinearSystem::eigenproblem_solve() {
             libmesh_assert (!matrix_B);
             
             //in case of a standard eigenproblem
-            solve_data = eigen_solver->solve_standard (*condensed_matrix_A,
+            solve_data = eigen_solver->solve_standard (*_condensed_matrix_A,
                                                        nev,
                                                        ncv,
                                                        tol,
@@ -309,7 +752,6 @@ MAST::NonlinearSystem::eigenproblem_solve() {
     _n_converged_eigenpairs = solve_data.first;
     _n_iterations           = solve_data.second;
     
-    STOP_LOG("eigensolve()", "NonlinearSystem");
     
     return;
 }
@@ -324,7 +766,9 @@ MAST::NonlinearSystem::get_eigenpair(unsigned int i,
                                      libMesh::NumericVector<Real>& vec_re,
                                      libMesh::NumericVector<Real>* vec_im) {
     
-    START_LOG("get_eigenpair()", "NonlinearSystem");
+    MAST_LOG_SCOPE("NonlinearSystem::get_eigenpair");
+    LOG_SCOPE("get_eigenpair()", "NonlinearSystem");
+    
     std::pair<Real, Real>
     val;
     
@@ -357,28 +801,36 @@ MAST::NonlinearSystem::get_eigenpair(unsigned int i,
         // If we reach here, then there should be some non-condensed dofs
         libmesh_assert(!_local_non_condensed_dofs_vector.empty());
         
-        std::auto_ptr< libMesh::NumericVector<Real> >
-        temp_re(libMesh::NumericVector<Real>::build(this->comm()).release()),
-        temp_im;
-        
-        unsigned int
-        n_local   = (unsigned int)_local_non_condensed_dofs_vector.size(),
-        n         = n_local;
-        this->comm().sum(n);
-        
-        // initialize the vectors
-        temp_re->init (n, n_local, false, libMesh::PARALLEL);
+        // the condensed vectors are created once, and reused for all
+        // eigenpairs and solves
+        if (!_condensed_vec_re.get()) {
+            
+            unsigned int
+            n_local   = (unsigned int)_local_non_condensed_dofs_vector.size(),
+            n         = n_local;
+            this->comm().sum(n);
+            
+            _condensed_vec_re.reset(libMesh::NumericVector<Real>::build(this->comm()).release());
+            _condensed_vec_re->init (n, n_local, false, libMesh::PARALLEL);
+            
+            _condensed_local_indices.resize(n_local);
+            for (unsigned int j=0; j<n_local; j++)
+                _condensed_local_indices[j] = _condensed_vec_re->first_local_index()+j;
+        }
         
         // imaginary only if the problem is non-Hermitian
-        if (vec_im) {
+        if (vec_im && !_condensed_vec_im.get()) {
             
-            temp_im.reset(libMesh::NumericVector<Real>::build(this->comm()).release());
-            temp_im->init (n, n_local, false, libMesh::PARALLEL);
+            _condensed_vec_im.reset(_condensed_vec_re->zero_clone().release());
         }
         
-
+        _update_condensed_memory();
+        
+        
         // call the eigen_solver get_eigenpair method
-        val   = this->eigen_solver->get_eigenpair (i, *temp_re, temp_im.get());
+        val   = this->eigen_solver->get_eigenpair (i,
+                                                   *_condensed_vec_re,
+                                                   vec_im?_condensed_vec_im.get():nullptr);
         
         if (!_exchange_A_and_B) {
             re   = val.first;
@@ -390,29 +842,24 @@ MAST::NonlinearSystem::get_eigenpair(unsigned int i,
             re = complex_val.real();
             im = complex_val.imag();
         }
-
         
-        // Now map temp to solution. Loop over local entries of local_non_condensed_dofs_vector
+        
+        // Now map the condensed vector to solution. The local values are
+        // copied in one call, and inserted in one call.
+        std::vector<Real> vals;
+        
         // the real part
+        _condensed_vec_re->get(_condensed_local_indices, vals);
         vec_re.zero();
-        for (unsigned int j=0; j<_local_non_condensed_dofs_vector.size(); j++) {
-            
-            unsigned int index = _local_non_condensed_dofs_vector[j];
-            vec_re.set(index,(*temp_re)(temp_re->first_local_index()+j));
-        }
+        vec_re.insert(vals, _local_non_condensed_dofs_vector);
         vec_re.close();
         
         // now the imaginary part if it was provided
         if (vec_im) {
             
+            _condensed_vec_im->get(_condensed_local_indices, vals);
             vec_im->zero();
-            
-            for (unsigned int j=0; j<_local_non_condensed_dofs_vector.size(); j++) {
-                
-                unsigned int index = _local_non_condensed_dofs_vector[j];
-                vec_im->set(index,(*temp_im)(temp_im->first_local_index()+j));
-            }
-            
+            vec_im->insert(vals, _local_non_condensed_dofs_vector);
             vec_im->close();
         }
     }
@@ -457,7 +904,6 @@ MAST::NonlinearSystem::get_eigenpair(unsigned int i,
 
     this->update();
     
-    STOP_LOG("get_eigenpair()", "NonlinearSystem");
 }
 
 
@@ -469,6 +915,8 @@ MAST::NonlinearSystem::
 eigenproblem_sensitivity_solve (const libMesh::ParameterVector& parameters,
                                 std::vector<Real>& sens) {
     
+    MAST_LOG_SCOPE("NonlinearSystem::eigenproblem_sensitivity_solve");
+    
     // make sure that eigensolution is already available
     libmesh_assert(_n_converged_eigenpairs);
     
@@ -676,6 +1124,62 @@ initialize_condensed_dofs(MAST::PhysicsDisciplineBase& physics) {
         _local_non_condensed_dofs_vector.push_back(*iter);
     
     _condensed_dofs_initialized = true;
+    
+    // the condensed matrices and vectors are recreated for the new dofs
+    this->_clear_condensed_operators();
+}
+
+
+
+void
+MAST::NonlinearSystem::
+zero_condensed_dofs(libMesh::NumericVector<Real>& v) const {
+    
+    if (!_condensed_dofs_initialized)
+        return;
+    
+    // the values at the non-condensed dofs are copied and inserted back
+    // in the zeroed vector
+    std::vector<Real> vals;
+    v.get(_local_non_condensed_dofs_vector, vals);
+    v.zero();
+    v.insert(vals, _local_non_condensed_dofs_vector);
+    v.close();
+}
+
+
+
+void
+MAST::NonlinearSystem::_clear_condensed_operators() {
+    
+    _condensed_matrices_initialized = false;
+    
+    _condensed_matrix_A.reset();
+    _condensed_matrix_B.reset();
+    _condensed_vec_re.reset();
+    _condensed_vec_im.reset();
+    _condensed_local_indices.clear();
+    _condensed_memory.clear();
+}
+
+
+
+void
+MAST::NonlinearSystem::_update_condensed_memory() {
+    
+    std::size_t
+    bytes = _condensed_local_indices.size() * sizeof(libMesh::numeric_index_type);
+    
+    if (_condensed_matrix_A.get())
+        bytes += MAST::MemoryLog::bytes(*_condensed_matrix_A);
+    if (_condensed_matrix_B.get())
+        bytes += MAST::MemoryLog::bytes(*_condensed_matrix_B);
+    if (_condensed_vec_re.get())
+        bytes += MAST::MemoryLog::bytes(*_condensed_vec_re);
+    if (_condensed_vec_im.get())
+        bytes += MAST::MemoryLog::bytes(*_condensed_vec_im);
+    
+    _condensed_memory.set(bytes);
 }
 
 
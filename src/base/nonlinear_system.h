@@ -25,12 +25,16 @@
 
 // MAST includes
 #include "base/mast_data_types.h"
+#include "base/memory_log.h"
 
 // libMesh includes
 #include "libmesh/nonlinear_implicit_system.h"
 #include "libmesh/enum_eigen_solver_type.h"
 #include "libmesh/eigen_system.h"
 
+// PETSc includes
+#include <petscmat.h>
+
 
 namespace MAST {
     
@@ -41,6 +45,7 @@ namespace MAST {
     class EigenSystemAssembly;
     class PhysicsDisciplineBase;
     class OutputAssemblyBase;
+    class JacobianLaggingPolicy;
     
     
     /*!
@@ -89,6 +94,103 @@ namespace MAST {
         virtual void reinit () libmesh_override;
         
         
+        /*!
+         *   solves the nonlinear system. If the Jacobian-free Newton-Krylov
+         *   solution has been requested with
+         *   set_jacobian_free_newton_krylov() the system is solved by a
+         *   SNES context created here, otherwise the libMesh nonlinear
+         *   solver is used.
+         */
+        virtual void solve () libmesh_override;
+        
+        
+        /*!
+         *   sets the flag to solve the nonlinear system with a Jacobian-free
+         *   Newton-Krylov method. The Jacobian is never assembled, and only
+         *   a preconditioner matrix is assembled in the system matrix.
+         *
+         *   With the default \p pc_lag of 0 the preconditioner is the
+         *   Jacobian at the zero solution, which for geometrically
+         *   nonlinear structures is the linear stiffness matrix. This does
+         *   not depend on the Newton iterate, so it is assembled once and
+         *   reused by the following solves until the system matrix is
+         *   modified elsewhere. Since the effective matrix of the transient
+         *   solvers depends on the time step, transient analyses should
+         *   use a nonzero \p pc_lag.
+         *
+         *   A \p pc_lag of -1 assembles the Jacobian at the current iterate
+         *   as the preconditioner at the first iteration of each solve, and
+         *   a positive value assembles it once every \p pc_lag Newton
+         *   iterations.
+         *
+         *   If \p if_fd_product is false the Jacobian-vector product is the
+         *   element-level linearized residual from
+         *   NonlinearImplicitAssembly::linearized_jacobian_solution_product.
+         *   Otherwise the product is approximated by a finite difference of
+         *   the residual,
+         *   \f$ J \Delta x \approx (R(x+h \Delta x) - R(x))/h \f$.
+         *
+         *   libMesh allocates the system matrix in both cases, so the
+         *   savings are in the assembly of the operator, and not in its
+         *   storage.
+         */
+        void set_jacobian_free_newton_krylov(bool flag,
+                                             int pc_lag = 0,
+                                             bool if_fd_product = false) {
+            
+            libmesh_assert(pc_lag >= -1);
+            _if_jfnk            = flag;
+            _jfnk_pc_lag        = pc_lag;
+            _if_jfnk_fd_product = if_fd_product;
+            _jfnk_reference_pc  = nullptr;
+        }
+        
+        
+        /*!
+         *   @returns true if the Jacobian-free Newton-Krylov solution has
+         *   been requested.
+         */
+        bool if_jacobian_free_newton_krylov() const {
+            return _if_jfnk;
+        }
+        
+        
+        /*!
+         *   sets the flag to precondition the Krylov iterations of the
+         *   Jacobian-free Newton-Krylov solution with
+         *   MAST::SinglePrecisionPreconditioner, which stores the ILU(0)
+         *   factors of the assembled system matrix in single precision.
+         *   The Krylov iterations remain in double precision. This replaces
+         *   the preconditioner chosen through the PETSc options. The flag
+         *   has no effect on the Newton solves of the libMesh nonlinear
+         *   solver, which are used if JFNK is not enabled, nor on the
+         *   eigenproblem solves with matrix_A and matrix_B.
+         */
+        void set_single_precision_preconditioner(bool flag) {
+            _if_single_precision_pc = flag;
+        }
+        
+        
+        /*!
+         *   attaches a policy that decides when the Jacobian is assembled
+         *   during solve(), and when the matrix from a previous assembly is
+         *   reused. Passing nullptr removes the policy, in which case the
+         *   Jacobian is assembled at every request.
+         */
+        void set_jacobian_lagging_policy(MAST::JacobianLaggingPolicy* policy) {
+            _jacobian_lagging = policy;
+        }
+        
+        
+        /*!
+         *   @returns a pointer to the Jacobian lagging policy attached to this
+         *   system, or nullptr if none has been attached.
+         */
+        MAST::JacobianLaggingPolicy* jacobian_lagging_policy() {
+            return _jacobian_lagging;
+        }
+        
+        
         /**
          *   calculates and stores the sensitivity RHS in System::add_sensitivity_rhs(0).
          *   This assumes that \p parameters is of size 1. For solving sensitivity
@@ -260,6 +362,12 @@ namespace MAST {
          */
         unsigned int n_global_non_condensed_dofs() const;
         
+        /*!
+         *   zeros the entries of \p v at the condensed dofs. Nothing is
+         *   done if the condensed dofs have not been initialized.
+         */
+        void zero_condensed_dofs(libMesh::NumericVector<Real>& v) const;
+        
     protected:
         
         
@@ -285,6 +393,59 @@ namespace MAST {
         { _n_iterations = its;}
         
         
+        /*!
+         *   solves the nonlinear system using the Jacobian-free
+         *   Newton-Krylov method.
+         */
+        void _jfnk_solve();
+        
+        
+        /*!
+         *   flag to use the Jacobian-free Newton-Krylov solution
+         */
+        bool _if_jfnk;
+        
+        
+        /*!
+         *   number of Newton iterations between assembly of the
+         *   preconditioner matrix for the Jacobian-free Newton-Krylov
+         *   solution. A value of 0 uses the Jacobian at the zero solution.
+         */
+        int _jfnk_pc_lag;
+        
+        
+        /*!
+         *   system matrix that holds the preconditioner assembled at the
+         *   zero solution, and its PETSc object state after the assembly.
+         *   The preconditioner is assembled again if the matrix or its
+         *   state has changed. This is nullptr if no preconditioner has
+         *   been assembled.
+         */
+        Mat              _jfnk_reference_pc;
+        PetscObjectState _jfnk_reference_pc_state;
+        
+        
+        /*!
+         *   flag to use the finite difference Jacobian-vector product for
+         *   the Jacobian-free Newton-Krylov solution
+         */
+        bool _if_jfnk_fd_product;
+        
+        
+        /*!
+         *   flag to use the single precision preconditioner for the
+         *   Jacobian-free Newton-Krylov solution
+         */
+        bool _if_single_precision_pc;
+        
+        
+        /*!
+         *   policy for reuse of the Jacobian across nonlinear iterations and
+         *   solves. This is nullptr unless set by the user.
+         */
+        MAST::JacobianLaggingPolicy* _jacobian_lagging;
+        
+        
         /*!
          *   initialize the B matrix in addition to A, which might be needed
          *   for solution of complex system of equations using PC field split
@@ -347,6 +508,53 @@ namespace MAST {
          */
         std::vector<libMesh::dof_id_type>  _local_non_condensed_dofs_vector;
         
+        /*!
+         *   clears the condensed matrices and vectors, which are recreated
+         *   at the next solve. This is needed when the dofs or the
+         *   sparsity pattern change.
+         */
+        void _clear_condensed_operators();
+        
+        /*!
+         *   flag to indicate that the condensed matrices have been created
+         *   and only need an update of their values for the next solve.
+         */
+        bool                               _condensed_matrices_initialized;
+        
+        /**
+         * Matrices of the non-condensed dofs. These are created with the
+         * sparsity pattern at the first eigenproblem solve, after which
+         * only the values are updated.
+         */
+        std::auto_ptr<libMesh::SparseMatrix<Real> >
+        _condensed_matrix_A,
+        _condensed_matrix_B;
+        
+        /**
+         * Eigenvectors of the condensed eigenproblem, before they are
+         * mapped to the system dofs.
+         */
+        std::auto_ptr<libMesh::NumericVector<Real> >
+        _condensed_vec_re,
+        _condensed_vec_im;
+        
+        /**
+         * Indices of the local entries in the condensed vectors, in the
+         * same sequence as \p _local_non_condensed_dofs_vector.
+         */
+        std::vector<libMesh::numeric_index_type> _condensed_local_indices;
+        
+        /*!
+         *   updates \p _condensed_memory with the storage of the condensed
+         *   matrices and vectors
+         */
+        void _update_condensed_memory();
+        
+        /*!
+         *   memory held by the condensed matrices and vectors
+         */
+        MAST::MemoryAccount                _condensed_memory;
+        
     };
 }
 
@@ -91,6 +91,14 @@ namespace MAST {
         
         
         
+        /*!
+         *  adds \p this to \p params.
+         */
+        virtual void get_parameters(std::set<const MAST::Parameter*>& params) const {
+            params.insert(this);
+        }
+        
+        
         /*!
          *  sets the value of this function
          */
@@ -0,0 +1,504 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2017  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+// C++ includes
+#include <cstring>
+#include <algorithm>
+#include <chrono>
+#include <set>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+
+// MAST includes
+#include "base/performance_log.h"
+
+// libMesh includes
+#include "libmesh/parallel.h"
+
+
+bool                                   MAST::PerformanceLog::_enabled          = false;
+bool                                   MAST::PerformanceLog::_trace            = false;
+unsigned int                           MAST::PerformanceLog::_max_trace_depth  = 0;
+unsigned int                           MAST::PerformanceLog::_max_trace_events = 0;
+unsigned int                           MAST::PerformanceLog::_rank             = 0;
+Real                                   MAST::PerformanceLog::_t0               = 0.;
+MAST::PerformanceLog::Node             MAST::PerformanceLog::_root             =
+{"", nullptr, std::vector<MAST::PerformanceLog::Node*>(), 0, 0, 0., 0.};
+MAST::PerformanceLog::Node*            MAST::PerformanceLog::_current          = &MAST::PerformanceLog::_root;
+std::vector<Real>                      MAST::PerformanceLog::_start_times;
+std::vector<MAST::PerformanceLog::Event> MAST::PerformanceLog::_events;
+std::map<std::string, unsigned long>   MAST::PerformanceLog::_counters;
+
+
+
+void
+MAST::PerformanceLog::enable(const libMesh::Parallel::Communicator& comm,
+                             bool trace,
+                             unsigned int max_trace_depth,
+                             unsigned int max_trace_events) {
+    
+    comm.barrier();
+    
+    _enabled          = true;
+    _trace            = trace;
+    _max_trace_depth  = max_trace_depth;
+    _max_trace_events = max_trace_events;
+    _rank             = comm.rank();
+    _t0               = wall_time();
+    
+    if (_trace)
+        _events.reserve(std::min(_max_trace_events, 100000u));
+}
+
+
+
+void
+MAST::PerformanceLog::disable() {
+    
+    _enabled = false;
+}
+
+
+
+void
+MAST::PerformanceLog::clear() {
+    
+    // the tree is deleted recursively, children first
+    libmesh_assert(_current == &_root);
+    
+    std::vector<Node*> nodes(_root.children);
+    
+    for (unsigned int i=0; i<nodes.size(); i++)
+        nodes.insert(nodes.end(),
+                     nodes[i]->children.begin(),
+                     nodes[i]->children.end());
+    
+    for (unsigned int i=0; i<nodes.size(); i++)
+        delete nodes[i];
+    
+    _root.children.clear();
+    _start_times.clear();
+    _events.clear();
+    
+    // the counters are zeroed, and not erased, since references to them
+    // are held by the MAST_LOG_COUNT macros
+    std::map<std::string, unsigned long>::iterator
+    it   = _counters.begin(),
+    end  = _counters.end();
+    
+    for ( ; it != end; it++)
+        it->second = 0;
+    
+    _t0 = wall_time();
+}
+
+
+
+void
+MAST::PerformanceLog::push(const char* label) {
+    
+    // look for the label in the children of the current scope. The
+    // number of children is small, so a linear search is used.
+    Node* n = nullptr;
+    
+    for (unsigned int i=0; i<_current->children.size(); i++)
+        if (_current->children[i]->label == label ||
+            strcmp(_current->children[i]->label, label) == 0) {
+            
+            n = _current->children[i];
+            break;
+        }
+    
+    if (!n) {
+        
+        n            = new Node;
+        n->label     = label;
+        n->parent    = _current;
+        n->depth     = _current->depth+1;
+        n->calls     = 0;
+        n->inclusive = 0.;
+        n->child     = 0.;
+        _current->children.push_back(n);
+    }
+    
+    _current = n;
+    _start_times.push_back(wall_time());
+}
+
+
+
+void
+MAST::PerformanceLog::pop() {
+    
+    libmesh_assert(_current != &_root);
+    libmesh_assert(!_start_times.empty());
+    
+    const Real
+    start = _start_times.back(),
+    dt    = wall_time() - start;
+    
+    _start_times.pop_back();
+    
+    _current->calls++;
+    _current->inclusive     += dt;
+    _current->parent->child += dt;
+    
+    if (_trace &&
+        _current->depth <= _max_trace_depth &&
+        _events.size() < _max_trace_events) {
+        
+        Event e = {_current, start, dt};
+        _events.push_back(e);
+    }
+    
+    _current = _current->parent;
+}
+
+
+
+unsigned long&
+MAST::PerformanceLog::counter(const std::string& name) {
+    
+    // std::map does not invalidate references on insertion
+    return _counters[name];
+}
+
+
+
+void
+MAST::PerformanceLog::
+scope_data(std::map<std::string, std::pair<Real, unsigned long> >& data) {
+    
+    data.clear();
+    
+    std::map<std::string, const Node*> paths;
+    _add_paths(&_root, paths);
+    
+    std::map<std::string, const Node*>::const_iterator
+    it   = paths.begin(),
+    end  = paths.end();
+    
+    for ( ; it != end; it++)
+        data[it->first] =
+        std::pair<Real, unsigned long>(it->second->inclusive - it->second->child,
+                                       it->second->calls);
+}
+
+
+
+void
+MAST::PerformanceLog::print_summary(const libMesh::Parallel::Communicator& comm,
+                                    std::ostream& out) {
+    
+    // the scopes and counters may differ between ranks, so the union of
+    // their names is obtained first. Scope paths are prefixed with 'S' and
+    // counters with 'C'. The separator in the paths is replaced by '\1'
+    // so that children are sorted immediately after their parent.
+    std::map<std::string, const Node*> paths;
+    _add_paths(&_root, paths);
+    
+    std::vector<char> buf;
+    {
+        std::map<std::string, const Node*>::const_iterator
+        it   = paths.begin(),
+        end  = paths.end();
+        
+        for ( ; it != end; it++) {
+            buf.push_back('S');
+            for (unsigned int i=0; i<it->first.size(); i++)
+                buf.push_back(it->first[i] == '/' ? '\1' : it->first[i]);
+            buf.push_back('\n');
+        }
+        
+        std::map<std::string, unsigned long>::const_iterator
+        c_it   = _counters.begin(),
+        c_end  = _counters.end();
+        
+        for ( ; c_it != c_end; c_it++) {
+            buf.push_back('C');
+            buf.insert(buf.end(), c_it->first.begin(), c_it->first.end());
+            buf.push_back('\n');
+        }
+    }
+    
+    comm.allgather(buf, false);
+    
+    std::set<std::string> names;
+    {
+        std::string nm;
+        for (unsigned int i=0; i<buf.size(); i++) {
+            if (buf[i] == '\n') {
+                names.insert(nm);
+                nm.clear();
+            }
+            else
+                nm.push_back(buf[i]);
+        }
+    }
+    
+    // the values are stored in the order of the set, which is identical
+    // on all ranks
+    const unsigned int
+    n = (unsigned int)names.size();
+    
+    std::vector<Real>
+    incl_min(n, 0.),
+    excl_min(n, 0.),
+    calls   (n, 0.);
+    
+    {
+        std::set<std::string>::const_iterator
+        it   = names.begin(),
+        end  = names.end();
+        
+        for (unsigned int i=0; it != end; it++, i++) {
+            
+            std::string nm = it->substr(1);
+            std::replace(nm.begin(), nm.end(), '\1', '/');
+            
+            if ((*it)[0] == 'S') {
+                
+                std::map<std::string, const Node*>::const_iterator
+                p = paths.find(nm);
+                if (p != paths.end()) {
+                    incl_min[i] = p->second->inclusive;
+                    excl_min[i] = p->second->inclusive - p->second->child;
+                    calls[i]    = p->second->calls;
+                }
+            }
+            else {
+                
+                std::map<std::string, unsigned long>::const_iterator
+                c = _counters.find(nm);
+                if (c != _counters.end())
+                    incl_min[i] = c->second;
+            }
+        }
+    }
+    
+    std::vector<Real>
+    incl_max(incl_min),
+    incl_sum(incl_min),
+    excl_sum(excl_min);
+    
+    comm.min(incl_min);
+    comm.max(incl_max);
+    comm.sum(incl_sum);
+    comm.sum(excl_sum);
+    comm.sum(calls);
+    
+    if (comm.rank() != 0)
+        return;
+    
+    const Real
+    n_ranks = comm.size();
+    
+    // total time is the sum of the top level scopes
+    Real total = 0.;
+    {
+        std::set<std::string>::const_iterator
+        it   = names.begin(),
+        end  = names.end();
+        
+        for (unsigned int i=0; it != end; it++, i++)
+            if ((*it)[0] == 'S' && it->find('\1') == std::string::npos)
+                total += incl_sum[i]/n_ranks;
+    }
+    
+    out
+    << std::endl
+    << " MAST performance log: " << comm.size() << " ranks, times in seconds"
+    << std::endl
+    << std::setw(60) << std::left << " scope" << std::right
+    << std::setw(12) << "calls/rank"
+    << std::setw(12) << "min"
+    << std::setw(12) << "avg"
+    << std::setw(12) << "max"
+    << std::setw(12) << "excl avg"
+    << std::setw(9)  << "%"
+    << std::endl;
+    
+    std::set<std::string>::const_iterator
+    it   = names.begin(),
+    end  = names.end();
+    unsigned int
+    i    = 0;
+    
+    for ( ; it != end; it++, i++) {
+        
+        if ((*it)[0] != 'S')
+            continue;
+        
+        // the label is indented by the depth of the scope
+        const std::string
+        path  = it->substr(1);
+        const size_t
+        pos   = path.rfind('\1');
+        const unsigned int
+        depth = (unsigned int)std::count(path.begin(), path.end(), '\1');
+        
+        std::string
+        label = std::string(2*depth+1, ' ') +
+        (pos == std::string::npos ? path : path.substr(pos+1));
+        
+        out
+        << std::setw(60) << std::left << label << std::right
+        << std::setw(12) << std::setprecision(4) << calls[i]/n_ranks
+        << std::setw(12) << incl_min[i]
+        << std::setw(12) << incl_sum[i]/n_ranks
+        << std::setw(12) << incl_max[i]
+        << std::setw(12) << excl_sum[i]/n_ranks
+        << std::setw(9)  << std::setprecision(3)
+        << (total > 0.? 100.*incl_sum[i]/n_ranks/total : 0.)
+        << std::endl;
+    }
+    
+    out
+    << std::endl
+    << std::setw(60) << std::left << " counter" << std::right
+    << std::setw(12) << "min"
+    << std::setw(12) << "avg"
+    << std::setw(12) << "max"
+    << std::setw(12) << "total"
+    << std::endl;
+    
+    for (it = names.begin(), i = 0; it != end; it++, i++) {
+        
+        if ((*it)[0] != 'C')
+            continue;
+        
+        out
+        << std::setw(60) << std::left << (" " + it->substr(1)) << std::right
+        << std::setprecision(6)
+        << std::setw(12) << incl_min[i]
+        << std::setw(12) << incl_sum[i]/n_ranks
+        << std::setw(12) << incl_max[i]
+        << std::setw(12) << incl_sum[i]
+        << std::endl;
+    }
+    
+    out << std::endl;
+}
+
+
+
+void
+MAST::PerformanceLog::write_chrome_trace(const libMesh::Parallel::Communicator& comm,
+                                         const std::string& nm) {
+    
+    const Real
+    t_end = wall_time();
+    
+    const unsigned int
+    r     = comm.rank();
+    
+    // the events of this rank are written to a buffer, which is gathered
+    // on rank 0. Each record is preceded by its separator, so that the
+    // buffers can be concatenated in the order of the ranks.
+    std::ostringstream
+    oss;
+    
+    oss
+    << std::setprecision(15)
+    << (r == 0 ? "" : ",\n")
+    << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << r
+    << ",\"args\":{\"name\":\"rank " << r << "\"}}";
+    
+    for (unsigned int i=0; i<_events.size(); i++)
+        oss
+        << ",\n"
+        << "{\"name\":\"" << _events[i].node->label
+        << "\",\"cat\":\"mast\",\"ph\":\"X\",\"pid\":" << r
+        << ",\"tid\":0,\"ts\":" << (_events[i].start-_t0)*1.e6
+        << ",\"dur\":" << _events[i].duration*1.e6 << "}";
+    
+    // counters are written with their final values
+    std::map<std::string, unsigned long>::const_iterator
+    it   = _counters.begin(),
+    end  = _counters.end();
+    
+    for ( ; it != end; it++)
+        oss
+        << ",\n"
+        << "{\"name\":\"" << it->first
+        << "\",\"ph\":\"C\",\"pid\":" << r
+        << ",\"ts\":" << (t_end-_t0)*1.e6
+        << ",\"args\":{\"value\":" << it->second << "}}";
+    
+    const std::string
+    str = oss.str();
+    
+    std::vector<char>
+    buf(str.begin(), str.end());
+    
+    comm.gather(0, buf);
+    
+    if (r != 0)
+        return;
+    
+    std::ofstream
+    out(nm.c_str());
+    
+    if (!out.good())
+        libmesh_error_msg("Unable to open file for writing: " << nm);
+    
+    out << "{\"traceEvents\":[" << std::endl;
+    if (!buf.empty())
+        out.write(&buf[0], buf.size());
+    out << std::endl << "]}" << std::endl;
+}
+
+
+
+Real
+MAST::PerformanceLog::wall_time() {
+    
+    return
+    std::chrono::duration<Real>
+    (std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+
+
+std::string
+MAST::PerformanceLog::_path(const Node* n) {
+    
+    std::string p = n->label;
+    
+    for (n = n->parent; n && n != &_root; n = n->parent)
+        p = std::string(n->label) + "/" + p;
+    
+    return p;
+}
+
+
+
+void
+MAST::PerformanceLog::_add_paths(const Node* n,
+                                 std::map<std::string, const Node*>& paths) {
+    
+    if (n != &_root)
+        paths[_path(n)] = n;
+    
+    for (unsigned int i=0; i<n->children.size(); i++)
+        _add_paths(n->children[i], paths);
+}
+
@@ -0,0 +1,266 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2017  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#ifndef __mast__performance_log__
+#define __mast__performance_log__
+
+// C++ includes
+#include <string>
+#include <vector>
+#include <map>
+#include <iostream>
+
+// MAST includes
+#include "base/mast_data_types.h"
+#include "base/mast_config.h"
+
+
+namespace libMesh {
+    namespace Parallel {
+        class Communicator;
+    }
+}
+
+
+namespace MAST {
+    
+    /*!
+     *   Hierarchical log of wall time and event counters.
+     *
+     *   Scopes are opened with MAST_LOG_SCOPE and are nested in the order
+     *   in which they are entered, so that the same label called from two
+     *   different parents is accounted separately. For each scope the
+     *   number of calls, and the inclusive and exclusive times are
+     *   accumulated. Counters are incremented with MAST_LOG_COUNT.
+     *
+     *   The log is disabled by default, in which case a scope costs a
+     *   single branch. Both macros are removed at compile time if MAST is
+     *   configured with ENABLE_TIMERS=OFF. The solvers keep their libMesh
+     *   perflog events next to the MAST scopes, so that the libMesh log is
+     *   available independently of this option.
+     *
+     *   If requested, the individual scope events up to a maximum depth are
+     *   also stored for export in the Chrome trace format, which can be
+     *   viewed in chrome://tracing or Perfetto. Each rank is shown as a
+     *   separate process.
+     */
+    class PerformanceLog {
+        
+    public:
+        
+        /*!
+         *   enables the log. The ranks in \p comm are synchronized before
+         *   the reference time for the trace events is set. If \p trace is
+         *   true, events for scopes up to depth \p max_trace_depth (top
+         *   level scopes are at depth 1) are stored for the Chrome trace,
+         *   up to a total of \p max_trace_events per rank.
+         */
+        static void enable(const libMesh::Parallel::Communicator& comm,
+                           bool trace = false,
+                           unsigned int max_trace_depth = 4,
+                           unsigned int max_trace_events = 1000000);
+        
+        
+        /*!
+         *   disables the log. The accumulated data is retained.
+         */
+        static void disable();
+        
+        
+        /*!
+         *   @returns true if the log is enabled
+         */
+        static bool enabled() {
+            return _enabled;
+        }
+        
+        
+        /*!
+         *   clears the timing data, the trace events and zeros the
+         *   counters. This should not be called with open scopes.
+         */
+        static void clear();
+        
+        
+        /*!
+         *   opens a scope with \p label, which should be a string literal.
+         */
+        static void push(const char* label);
+        
+        
+        /*!
+         *   closes the most recently opened scope.
+         */
+        static void pop();
+        
+        
+        /*!
+         *   @returns a reference to the counter \p name. The reference
+         *   remains valid for the life of the program.
+         */
+        static unsigned long& counter(const std::string& name);
+        
+        
+        /*!
+         *   provides the exclusive time and number of calls on this rank
+         *   for each scope, identified by the path of labels from the top
+         *   level scope separated by "/".
+         */
+        static void
+        scope_data(std::map<std::string, std::pair<Real, unsigned long> >& data);
+        
+        
+        /*!
+         *   writes the min/avg/max over all ranks in \p comm of the time in
+         *   each scope and of the counters to \p out on rank 0. This should
+         *   be called on all ranks.
+         */
+        static void print_summary(const libMesh::Parallel::Communicator& comm,
+                                  std::ostream& out);
+        
+        
+        /*!
+         *   writes the trace events from all ranks in \p comm to the file
+         *   \p nm in the Chrome trace JSON format. The events are gathered
+         *   on rank 0, which writes the file. This should be called on all
+         *   ranks.
+         */
+        static void write_chrome_trace(const libMesh::Parallel::Communicator& comm,
+                                       const std::string& nm);
+        
+        
+        /*!
+         *   @returns the wall clock time in seconds
+         */
+        static Real wall_time();
+        
+        
+    protected:
+        
+        /*!
+         *   node in the tree of scopes
+         */
+        struct Node {
+            
+            const char*           label;
+            Node*                 parent;
+            std::vector<Node*>    children;
+            unsigned int          depth;
+            unsigned long         calls;
+            Real                  inclusive;
+            Real                  child;
+        };
+        
+        
+        /*!
+         *   scope event stored for the trace
+         */
+        struct Event {
+            
+            const Node*   node;
+            Real          start;
+            Real          duration;
+        };
+        
+        
+        /*!
+         *   @returns the path of labels from the top level scope to \p n
+         */
+        static std::string _path(const Node* n);
+        
+        
+        /*!
+         *   adds the path of \p n and all of its children to \p paths
+         */
+        static void _add_paths(const Node* n,
+                               std::map<std::string, const Node*>& paths);
+        
+        
+        static bool                              _enabled;
+        static bool                              _trace;
+        static unsigned int                      _max_trace_depth;
+        static unsigned int                      _max_trace_events;
+        static unsigned int                      _rank;
+        static Real                              _t0;
+        static Node                              _root;
+        static Node*                             _current;
+        static std::vector<Real>                 _start_times;
+        static std::vector<Event>                _events;
+        static std::map<std::string, unsigned long> _counters;
+    };
+    
+    
+    
+    /*!
+     *   opens a scope in the constructor and closes it in the destructor
+     */
+    class PerformanceLogScope {
+        
+    public:
+        
+        PerformanceLogScope(const char* label):
+        _active(MAST::PerformanceLog::enabled()) {
+            if (_active)
+                MAST::PerformanceLog::push(label);
+        }
+        
+        
+        ~PerformanceLogScope() {
+            if (_active)
+                MAST::PerformanceLog::pop();
+        }
+        
+    protected:
+        
+        /*!
+         *   the scope is closed only if it was opened, even if the log is
+         *   enabled or disabled in between.
+         */
+        const bool _active;
+    };
+}
+
+
+#define MAST_LOG_CONCAT_(a, b) a ## b
+#define MAST_LOG_CONCAT(a, b)  MAST_LOG_CONCAT_(a, b)
+
+
+#if MAST_ENABLE_TIMERS == 1
+
+#define MAST_LOG_SCOPE(label)                                               \
+MAST::PerformanceLogScope MAST_LOG_CONCAT(__mast_log_scope_, __LINE__)(label)
+
+#define MAST_LOG_COUNT(name, n)                                             \
+do {                                                                        \
+    static unsigned long& __mast_log_counter =                              \
+    MAST::PerformanceLog::counter(name);                                    \
+    if (MAST::PerformanceLog::enabled())                                    \
+        __mast_log_counter += (n);                                          \
+} while (0)
+
+#else
+
+#define MAST_LOG_SCOPE(label)
+#define MAST_LOG_COUNT(name, n) do { } while (0)
+
+#endif // MAST_ENABLE_TIMERS
+
+
+#endif // __mast__performance_log__
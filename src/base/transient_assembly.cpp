@@ -26,6 +26,8 @@
 #include "numerics/utility.h"
 #include "base/mesh_field_function.h"
 #include "base/nonlinear_system.h"
+#include "solver/jacobian_lagging_policy.h"
+#include "base/performance_log.h"
 
 // libMesh includes
 #include "libmesh/nonlinear_solver.h"
@@ -109,12 +111,28 @@ residual_and_jacobian (const libMesh::NumericVector<Real>& X,
                        libMesh::SparseMatrix<Real>*  J,
                        libMesh::NonlinearImplicitSystem& S) {
     
+    MAST_LOG_SCOPE("TransientAssembly::residual_and_jacobian");
+    
     MAST::NonlinearSystem& transient_sys = _system->system();
     
     // make sure that the system for which this object was created,
     // and the system passed through the function call are the same
     libmesh_assert_equal_to(&S, &transient_sys);
     
+    // if the lagging policy chooses to reuse the Jacobian from an earlier
+    // request, the matrix is left untouched and only the residual is
+    // computed. MAST::NonlinearSystem::solve() stops the nonlinear solver
+    // from zeroing the matrix before the request while a policy is
+    // attached.
+    MAST::JacobianLaggingPolicy*
+    lagging = transient_sys.jacobian_lagging_policy();
+    
+    if (J && lagging && !lagging->if_assemble_jacobian()) {
+        
+        J = nullptr;
+        if (!R) return;
+    }
+    
     if (R) R->zero();
     if (J) J->zero();
     
@@ -129,7 +147,7 @@ residual_and_jacobian (const libMesh::NumericVector<Real>& X,
     
     
     // stores the localized solution, velocity, acceleration, etc. vectors.
-    // These pointers will have to be deleted
+    // These vectors are owned by the transient solver
     std::vector<libMesh::NumericVector<Real>*>
     local_qtys;
     
@@ -147,6 +165,8 @@ residual_and_jacobian (const libMesh::NumericVector<Real>& X,
     
     for ( ; el != end_el; ++el) {
         
+        MAST_LOG_COUNT("elements", 1);
+        
         const libMesh::Elem* elem = *el;
         
         dof_map.dof_indices (elem, dof_indices);
@@ -193,16 +213,17 @@ residual_and_jacobian (const libMesh::NumericVector<Real>& X,
         if (J) J->add_matrix(m, dof_indices);
     }
     
-    // delete pointers to the local solutions
-    for (unsigned int i=0; i<local_qtys.size(); i++)
-        delete local_qtys[i];
-    
     // if a solution function is attached, clear it
     if (_sol_function)
         _sol_function->clear();
     
     if (R) R->close();
     if (J) J->close();
+    
+    // the residual norm is used by the policy to detect a slow reduction
+    // of residual with a lagged Jacobian
+    if (R && lagging)
+        lagging->set_residual_norm(R->l2_norm());
 }
 
 
@@ -215,6 +236,8 @@ linearized_jacobian_solution_product (const libMesh::NumericVector<Real>& X,
                                       libMesh::NumericVector<Real>& JdX,
                                       libMesh::NonlinearImplicitSystem& S) {
     
+    MAST_LOG_SCOPE("TransientAssembly::linearized_jacobian_solution_product");
+    
     MAST::NonlinearSystem& transient_sys = _system->system();
     
     // make sure that the system for which this object was created,
@@ -232,7 +255,7 @@ linearized_jacobian_solution_product (const libMesh::NumericVector<Real>& X,
     std::auto_ptr<MAST::ElementBase> physics_elem;
     
     // stores the localized solution, velocity, acceleration, etc. vectors.
-    // These pointers will have to be deleted
+    // These vectors are owned by the transient solver
     std::vector<libMesh::NumericVector<Real>*>
     local_qtys,
     local_perturbed_qtys;
@@ -252,6 +275,8 @@ linearized_jacobian_solution_product (const libMesh::NumericVector<Real>& X,
     
     for ( ; el != end_el; ++el) {
         
+        MAST_LOG_COUNT("elements", 1);
+        
         const libMesh::Elem* elem = *el;
         
         dof_map.dof_indices (elem, dof_indices);
@@ -290,13 +315,6 @@ linearized_jacobian_solution_product (const libMesh::NumericVector<Real>& X,
         JdX.add_vector(v, dof_indices);
     }
     
-    // delete pointers to the local solutions
-    for (unsigned int i=0; i<local_qtys.size(); i++) {
-        
-        delete local_qtys[i];
-        delete local_perturbed_qtys[i];
-    }
-    
     // if a solution function is attached, clear it
     if (_sol_function)
         _sol_function->clear();
@@ -311,6 +329,8 @@ MAST::TransientAssembly::
 sensitivity_assemble (const libMesh::ParameterVector& parameters,
                       const unsigned int i,
                       libMesh::NumericVector<Real>& sensitivity_rhs) {
+    
+    MAST_LOG_SCOPE("TransientAssembly::sensitivity_assemble");
 
     MAST::NonlinearSystem& transient_sys = _system->system();
     
@@ -349,6 +369,8 @@ sensitivity_assemble (const libMesh::ParameterVector& parameters,
     
     for ( ; el != end_el; ++el) {
         
+        MAST_LOG_COUNT("elements", 1);
+        
         const libMesh::Elem* elem = *el;
         
         dof_map.dof_indices (elem, dof_indices);
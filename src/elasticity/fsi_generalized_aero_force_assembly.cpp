@@ -33,6 +33,8 @@
 #include "property_cards/element_property_card_base.h"
 #include "numerics/utility.h"
 #include "base/nonlinear_system.h"
+#include "base/performance_log.h"
+#include "base/memory_log.h"
 
 
 // libMesh includes
@@ -110,6 +112,8 @@ assemble_generalized_aerodynamic_force_matrix
  ComplexMatrixX& mat,
  MAST::Parameter* p) {
     
+    MAST_LOG_SCOPE("FSIGeneralizedAeroForceAssembly::assemble_generalized_aerodynamic_force_matrix");
+    
     // make sure the data provided is sane
     libmesh_assert(_complex_displ);
     
@@ -142,6 +146,13 @@ assemble_generalized_aerodynamic_force_matrix
     for (unsigned int i=0; i<n_basis; i++)
         localized_basis[i] = _build_localized_vector(_system->system(), *basis[i]).release();
     
+    // memory of the localized basis vectors, including the ghosted entries
+    MAST::MemoryAccount
+    basis_memory(MAST::MEMORY_ASSEMBLY_WORK);
+    basis_memory.set(n_basis * sizeof(Real) *
+                     (_system->system().n_local_dofs() +
+                      _system->system().get_dof_map().get_send_list().size()));
+    
     //create a zero-clone copy for the imaginary component of the solution
     localized_zero.reset(localized_basis[0]->zero_clone().release());
     
@@ -184,6 +195,8 @@ assemble_generalized_aerodynamic_force_matrix
         
         for ( ; el != end_el; ++el) {
             
+            MAST_LOG_COUNT("elements", 1);
+            
             const libMesh::Elem* elem = *el;
             
             dof_map.dof_indices (elem, dof_indices);
@@ -250,6 +263,7 @@ assemble_generalized_aerodynamic_force_matrix
     // delete the localized basis vectors
     for (unsigned int i=0; i<basis.size(); i++)
         delete localized_basis[i];
+    basis_memory.clear();
     
     // sum the matrix and provide it to each processor
     // this assumes that the structural comm is a subset of fluid comm
@@ -0,0 +1,93 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2017  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+// MAST includes
+#include "elasticity/incompatible_mode_condensation.h"
+
+
+
+MAST::IncompatibleModeCondensation::IncompatibleModeCondensation():
+_initialized(false),
+_memory(MAST::MEMORY_ASSEMBLY_WORK) {
+    
+}
+
+
+
+void
+MAST::IncompatibleModeCondensation::clear() {
+    
+    _initialized = false;
+    _node_coords.resize(0);
+    _material_mats.clear();
+    _K_alphaalpha_lu = Eigen::PartialPivLU<RealMatrixX>();
+    _K_ualpha.resize(0, 0);
+    _K_corr.resize(0, 0);
+    _memory.clear();
+}
+
+
+
+bool
+MAST::IncompatibleModeCondensation::
+if_valid(const RealVectorX& node_coords,
+         const std::vector<RealMatrixX>& material_mats) const {
+    
+    if (!_initialized                                 ||
+        _node_coords.size()   != node_coords.size()   ||
+        _node_coords          != node_coords          ||
+        _material_mats.size() != material_mats.size())
+        return false;
+    
+    for (unsigned int i=0; i<material_mats.size(); i++)
+        if (_material_mats[i].rows() != material_mats[i].rows() ||
+            _material_mats[i].cols() != material_mats[i].cols() ||
+            _material_mats[i]        != material_mats[i])
+            return false;
+    
+    return true;
+}
+
+
+
+void
+MAST::IncompatibleModeCondensation::
+init(const RealVectorX& node_coords,
+     const std::vector<RealMatrixX>& material_mats,
+     const RealMatrixX& K_alphaalpha,
+     const RealMatrixX& K_ualpha) {
+    
+    _node_coords    = node_coords;
+    _material_mats  = material_mats;
+    _K_ualpha       = K_ualpha;
+    _K_alphaalpha_lu.compute(K_alphaalpha);
+    _K_corr         = _K_ualpha * _K_alphaalpha_lu.solve(_K_ualpha.transpose());
+    _initialized    = true;
+    
+    std::size_t
+    n_bytes = (MAST::MemoryLog::bytes(_node_coords) +
+               MAST::MemoryLog::bytes(_K_ualpha) +
+               MAST::MemoryLog::bytes(_K_corr)   +
+               MAST::MemoryLog::bytes(K_alphaalpha));
+    for (unsigned int i=0; i<_material_mats.size(); i++)
+        n_bytes += MAST::MemoryLog::bytes(_material_mats[i]);
+    _memory.set(n_bytes);
+}
+
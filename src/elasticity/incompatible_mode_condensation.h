@@ -0,0 +1,148 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2017  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#ifndef __mast__incompatible_mode_condensation__
+#define __mast__incompatible_mode_condensation__
+
+// C++ includes
+#include <vector>
+
+// MAST includes
+#include "base/mast_data_types.h"
+#include "base/memory_log.h"
+
+
+namespace MAST {
+    
+    /*!
+     *   Static condensation of the incompatible modes of a single element.
+     *   For linear strain the matrices \f$ K_{\alpha\alpha} \f$ and
+     *   \f$ K_{u\alpha} \f$ depend only on the element geometry and the
+     *   material stiffness. The factored \f$ K_{\alpha\alpha} \f$, the
+     *   coupling matrix and the stiffness correction are therefore stored
+     *   here by the assembly and reused by each newly built element,
+     *   until the nodal coordinates of the element or the material
+     *   matrices at the quadrature points change.
+     */
+    class IncompatibleModeCondensation {
+        
+    public:
+        
+        IncompatibleModeCondensation();
+        
+        
+        /*!
+         *   clears the stored matrices
+         */
+        void clear();
+        
+        
+        /*!
+         *   @returns true if the stored matrices were computed with the
+         *   nodal coordinates \p node_coords and the quadrature point
+         *   material matrices \p material_mats.
+         */
+        bool if_valid(const RealVectorX& node_coords,
+                      const std::vector<RealMatrixX>& material_mats) const;
+        
+        
+        /*!
+         *   factors \p K_alphaalpha and stores it with \p K_ualpha, and
+         *   the nodal coordinates \p node_coords and material matrices
+         *   \p material_mats used to compute them.
+         */
+        void init(const RealVectorX& node_coords,
+                  const std::vector<RealMatrixX>& material_mats,
+                  const RealMatrixX& K_alphaalpha,
+                  const RealMatrixX& K_ualpha);
+        
+        
+        /*!
+         *   @returns the coupling matrix \f$ K_{u\alpha} \f$
+         */
+        const RealMatrixX& K_ualpha() const {
+            
+            libmesh_assert(_initialized);
+            return _K_ualpha;
+        }
+        
+        
+        /*!
+         *   @returns the stiffness correction
+         *   \f$ K_{u\alpha} K_{\alpha\alpha}^{-1} K_{u\alpha}^T \f$
+         */
+        const RealMatrixX& K_corr() const {
+            
+            libmesh_assert(_initialized);
+            return _K_corr;
+        }
+        
+        
+        /*!
+         *   @returns \f$ K_{\alpha\alpha}^{-1} \f$ \p v
+         */
+        RealVectorX solve(const RealVectorX& v) const {
+            
+            libmesh_assert(_initialized);
+            return _K_alphaalpha_lu.solve(v);
+        }
+        
+    protected:
+        
+        /*!
+         *   true after init() has been called
+         */
+        bool                              _initialized;
+        
+        /*!
+         *   nodal coordinates of the element used to compute the
+         *   stored matrices
+         */
+        RealVectorX                       _node_coords;
+        
+        /*!
+         *   material matrices at the quadrature points used to compute
+         *   the stored matrices
+         */
+        std::vector<RealMatrixX>          _material_mats;
+        
+        /*!
+         *   factored incompatible mode stiffness matrix
+         */
+        Eigen::PartialPivLU<RealMatrixX>  _K_alphaalpha_lu;
+        
+        /*!
+         *   coupling matrix between the element dofs and incompatible modes
+         */
+        RealMatrixX                       _K_ualpha;
+        
+        /*!
+         *   correction to the element stiffness matrix
+         */
+        RealMatrixX                       _K_corr;
+        
+        /*!
+         *   memory of the stored matrices
+         */
+        MAST::MemoryAccount               _memory;
+    };
+}
+
+#endif // __mast__incompatible_mode_condensation__
@@ -19,6 +19,7 @@
 
 // MAST includes
 #include "elasticity/solid_element_3d.h"
+#include "elasticity/incompatible_mode_condensation.h"
 #include "numerics/fem_operator_matrix.h"
 #include "mesh/local_elem_base.h"
 #include "property_cards/element_property_card_base.h"
@@ -141,7 +142,6 @@ MAST::StructuralElement3D::internal_residual(bool request_jacobian,
     n3                 =30;
     
     RealMatrixX
-    material_mat,
     mat_x        = RealMatrixX::Zero(6,3),
     mat_y        = RealMatrixX::Zero(6,3),
     mat_z        = RealMatrixX::Zero(6,3),
@@ -154,8 +154,7 @@ MAST::StructuralElement3D::internal_residual(bool request_jacobian,
     mat7_3n3     = RealMatrixX::Zero(3, n3),
     Gmat         = RealMatrixX::Zero(6, n3),
     K_alphaalpha = RealMatrixX::Zero(n3, n3),
-    K_ualpha     = RealMatrixX::Zero(n2, n3),
-    K_corr       = RealMatrixX::Zero(n2, n2);
+    K_ualpha     = RealMatrixX::Zero(n2, n3);
     RealVectorX
     strain    = RealVectorX::Zero(6),
     stress    = RealVectorX::Zero(6),
@@ -173,6 +172,36 @@ MAST::StructuralElement3D::internal_residual(bool request_jacobian,
     _property.stiffness_A_matrix(*this);
     
     libMesh::Point p;
+    
+    // the material matrix at each quadrature point
+    std::vector<RealMatrixX> material_mats(JxW.size());
+    for (unsigned int qp=0; qp<JxW.size(); qp++) {
+        
+        _local_elem->global_coordinates_location(xyz[qp], p);
+        (*mat_stiff)(p, _time, material_mats[qp]);
+    }
+    
+    // the nodal coordinates, so that the condensation is recomputed if
+    // the geometry of the element changes
+    RealVectorX node_coords = RealVectorX::Zero(3*_elem.n_nodes());
+    for (unsigned int i=0; i<_elem.n_nodes(); i++)
+        for (unsigned int j=0; j<3; j++)
+            node_coords(3*i+j) = _elem.point(i)(j);
+    
+    // the condensation of the incompatible modes is constant for linear
+    // strain, and is reused from the previous call on this element if the
+    // geometry and material have not changed.
+    const bool
+    if_nonlinear = (_property.strain_type() == MAST::NONLINEAR_STRAIN);
+    
+    MAST::IncompatibleModeCondensation
+    local_condensation,
+    &condensation = (_incompatible_condensation && !if_nonlinear)?
+    *_incompatible_condensation : local_condensation;
+    
+    const bool
+    if_cached = condensation.if_valid(node_coords, material_mats);
+    
     MAST::FEMOperatorMatrix
     Bmat_lin,
     Bmat_nl_x,
@@ -195,14 +224,12 @@ MAST::StructuralElement3D::internal_residual(bool request_jacobian,
     // initialize the incompatible mode mapping at element mid-point
     _init_incompatible_fe_mapping(_elem);
     
-    ///////////////////////////////////////////////////////////////////
-    // first for loop to evaluate alpha
+    ///////////////////////////////////////////////////////////////////////
+    // a single loop for the incompatible mode matrices, and the residual
+    // and stiffness contributions
     for (unsigned int qp=0; qp<JxW.size(); qp++) {
         
-        _local_elem->global_coordinates_location(xyz[qp], p);
-        
-        // get the material matrix
-        (*mat_stiff)(p, _time, material_mat);
+        const RealMatrixX& material_mat = material_mats[qp];
         
         this->initialize_green_lagrange_strain_operator(qp,
                                                         *_fe,
@@ -218,74 +245,44 @@ MAST::StructuralElement3D::internal_residual(bool request_jacobian,
                                                         Bmat_nl_w);
         this->initialize_incompatible_strain_operator(qp, *_fe, Bmat_inc, Gmat);
         
-        // calculate the incompatible mode matrices
-        // incompatible mode diagonal stiffness matrix
-        mat5_n1n3    =  material_mat * Gmat;
-        K_alphaalpha += JxW[qp] * ( Gmat.transpose() * mat5_n1n3);
-        
-        // off-diagonal coupling matrix
-        // linear strain term
-        Bmat_lin.right_multiply_transpose(mat6_n2n3, mat5_n1n3);
-        K_ualpha  += JxW[qp] * mat6_n2n3;
+        // calculate the stress
+        stress = material_mat * (strain + Gmat * alpha);
         
+        // residual from incompatible modes
+        f_alpha += JxW[qp] * Gmat.transpose() * stress;
         
-        if (_property.strain_type() == MAST::NONLINEAR_STRAIN) {
+        if (!if_cached) {
             
-            // nonlinear component
-            // along x
-            mat7_3n3  = mat_x.transpose() * mat5_n1n3;
-            Bmat_nl_x.right_multiply_transpose(mat6_n2n3, mat7_3n3);
-            K_ualpha  += JxW[qp] * mat6_n2n3;
+            // calculate the incompatible mode matrices
+            // incompatible mode diagonal stiffness matrix
+            mat5_n1n3    =  material_mat * Gmat;
+            K_alphaalpha += JxW[qp] * ( Gmat.transpose() * mat5_n1n3);
             
-            // along y
-            mat7_3n3  = mat_y.transpose() * mat5_n1n3;
-            Bmat_nl_y.right_multiply_transpose(mat6_n2n3, mat7_3n3);
+            // off-diagonal coupling matrix
+            // linear strain term
+            Bmat_lin.right_multiply_transpose(mat6_n2n3, mat5_n1n3);
             K_ualpha  += JxW[qp] * mat6_n2n3;
             
-            // along z
-            mat7_3n3  = mat_z.transpose() * mat5_n1n3;
-            Bmat_nl_z.right_multiply_transpose(mat6_n2n3, mat7_3n3);
-            K_ualpha  += JxW[qp] * mat6_n2n3;
+            
+            if (if_nonlinear) {
+                
+                // nonlinear component
+                // along x
+                mat7_3n3  = mat_x.transpose() * mat5_n1n3;
+                Bmat_nl_x.right_multiply_transpose(mat6_n2n3, mat7_3n3);
+                K_ualpha  += JxW[qp] * mat6_n2n3;
+                
+                // along y
+                mat7_3n3  = mat_y.transpose() * mat5_n1n3;
+                Bmat_nl_y.right_multiply_transpose(mat6_n2n3, mat7_3n3);
+                K_ualpha  += JxW[qp] * mat6_n2n3;
+                
+                // along z
+                mat7_3n3  = mat_z.transpose() * mat5_n1n3;
+                Bmat_nl_z.right_multiply_transpose(mat6_n2n3, mat7_3n3);
+                K_ualpha  += JxW[qp] * mat6_n2n3;
+            }
         }
-    }
-    
-    
-    // incompatible mode corrections
-    K_alphaalpha = K_alphaalpha.inverse();
-    K_corr = K_ualpha * K_alphaalpha * K_ualpha.transpose();
-    
-    if (request_jacobian)
-        jac.topLeftCorner(n2, n2) -= K_corr;
-
-    
-    ///////////////////////////////////////////////////////////////////////
-    // second for loop to calculate the residual and stiffness contributions
-    for (unsigned int qp=0; qp<JxW.size(); qp++) {
-        
-        _local_elem->global_coordinates_location(xyz[qp], p);
-        
-        // get the material matrix
-        (*mat_stiff)(p, _time, material_mat);
-        
-        this->initialize_green_lagrange_strain_operator(qp,
-                                                        *_fe,
-                                                        local_disp,
-                                                        strain,
-                                                        mat_x, mat_y, mat_z,
-                                                        Bmat_lin,
-                                                        Bmat_nl_x,
-                                                        Bmat_nl_y,
-                                                        Bmat_nl_z,
-                                                        Bmat_nl_u,
-                                                        Bmat_nl_v,
-                                                        Bmat_nl_w);
-        this->initialize_incompatible_strain_operator(qp, *_fe, Bmat_inc, Gmat);
-        
-        // calculate the stress
-        stress = material_mat * (strain + Gmat * alpha);
-        
-        // residual from incompatible modes
-        f_alpha += JxW[qp] * Gmat.transpose() * stress;
         
         // calculate contribution to the residual
         // linear strain operator
@@ -406,6 +403,13 @@ MAST::StructuralElement3D::internal_residual(bool request_jacobian,
         }
     }
     
+    // incompatible mode corrections
+    if (!if_cached)
+        condensation.init(node_coords, material_mats, K_alphaalpha, K_ualpha);
+    
+    if (request_jacobian)
+        jac.topLeftCorner(n2, n2) -= condensation.K_corr();
+    
     // if jacobian is requested, add a small diagonal value for the
     // rotational dofs
     if (request_jacobian)
@@ -413,7 +417,7 @@ MAST::StructuralElement3D::internal_residual(bool request_jacobian,
         1.0e-20 * jac.diagonal().maxCoeff();
 
     // correction to the residual from incompatible mode
-    f.topRows(n2) -= K_ualpha * (K_alphaalpha * f_alpha);
+    f.topRows(n2) -= condensation.K_ualpha() * condensation.solve(f_alpha);
     
     return request_jacobian;
 }
@@ -435,7 +439,6 @@ update_incompatible_mode_solution(const RealVectorX& dsol) {
     n3                 =30;
     
     RealMatrixX
-    material_mat,
     mat_x        = RealMatrixX::Zero(6,3),
     mat_y        = RealMatrixX::Zero(6,3),
     mat_z        = RealMatrixX::Zero(6,3),
@@ -448,8 +451,7 @@ update_incompatible_mode_solution(const RealVectorX& dsol) {
     mat7_3n3     = RealMatrixX::Zero(3, n3),
     Gmat         = RealMatrixX::Zero(6, n3),
     K_alphaalpha = RealMatrixX::Zero(n3, n3),
-    K_ualpha     = RealMatrixX::Zero(n2, n3),
-    K_corr       = RealMatrixX::Zero(n2, n2);
+    K_ualpha     = RealMatrixX::Zero(n2, n3);
     RealVectorX
     strain    = RealVectorX::Zero(6),
     stress    = RealVectorX::Zero(6),
@@ -467,6 +469,35 @@ update_incompatible_mode_solution(const RealVectorX& dsol) {
     _property.stiffness_A_matrix(*this);
     
     libMesh::Point p;
+    
+    // the material matrix at each quadrature point
+    std::vector<RealMatrixX> material_mats(JxW.size());
+    for (unsigned int qp=0; qp<JxW.size(); qp++) {
+        
+        _local_elem->global_coordinates_location(xyz[qp], p);
+        (*mat_stiff)(p, _time, material_mats[qp]);
+    }
+    
+    // the nodal coordinates, so that the condensation is recomputed if
+    // the geometry of the element changes
+    RealVectorX node_coords = RealVectorX::Zero(3*_elem.n_nodes());
+    for (unsigned int i=0; i<_elem.n_nodes(); i++)
+        for (unsigned int j=0; j<3; j++)
+            node_coords(3*i+j) = _elem.point(i)(j);
+    
+    // reuse the condensation for linear strain if the geometry and
+    // material have not changed
+    const bool
+    if_nonlinear = (_property.strain_type() == MAST::NONLINEAR_STRAIN);
+    
+    MAST::IncompatibleModeCondensation
+    local_condensation,
+    &condensation = (_incompatible_condensation && !if_nonlinear)?
+    *_incompatible_condensation : local_condensation;
+    
+    const bool
+    if_cached = condensation.if_valid(node_coords, material_mats);
+    
     MAST::FEMOperatorMatrix
     Bmat_lin,
     Bmat_nl_x,
@@ -494,10 +525,7 @@ update_incompatible_mode_solution(const RealVectorX& dsol) {
     // first for loop to evaluate alpha
     for (unsigned int qp=0; qp<JxW.size(); qp++) {
         
-        _local_elem->global_coordinates_location(xyz[qp], p);
-        
-        // get the material matrix
-        (*mat_stiff)(p, _time, material_mat);
+        const RealMatrixX& material_mat = material_mats[qp];
         
         this->initialize_green_lagrange_strain_operator(qp,
                                                         *_fe,
@@ -519,42 +547,45 @@ update_incompatible_mode_solution(const RealVectorX& dsol) {
         // residual of the incompatible strains
         f += JxW[qp] * Gmat.transpose() * stress;
         
-        // calculate the incompatible mode matrices
-        // incompatible mode diagonal stiffness matrix
-        mat5_n1n3    =  material_mat * Gmat;
-        K_alphaalpha += JxW[qp] * ( Gmat.transpose() * mat5_n1n3);
-
-        // off-diagonal coupling matrix
-        // linear strain term
-        Bmat_lin.right_multiply_transpose(mat6_n2n3, mat5_n1n3);
-        K_ualpha  += JxW[qp] * mat6_n2n3;
-        
-        if (_property.strain_type() == MAST::NONLINEAR_STRAIN) {
-            
-            // nonlinear component
-            // along x
-            mat7_3n3  = mat_x.transpose() * mat5_n1n3;
-            Bmat_nl_x.right_multiply_transpose(mat6_n2n3, mat7_3n3);
-            K_ualpha  += JxW[qp] * mat6_n2n3;
+        if (!if_cached) {
             
-            // along y
-            mat7_3n3  = mat_y.transpose() * mat5_n1n3;
-            Bmat_nl_y.right_multiply_transpose(mat6_n2n3, mat7_3n3);
+            // calculate the incompatible mode matrices
+            // incompatible mode diagonal stiffness matrix
+            mat5_n1n3    =  material_mat * Gmat;
+            K_alphaalpha += JxW[qp] * ( Gmat.transpose() * mat5_n1n3);
+
+            // off-diagonal coupling matrix
+            // linear strain term
+            Bmat_lin.right_multiply_transpose(mat6_n2n3, mat5_n1n3);
             K_ualpha  += JxW[qp] * mat6_n2n3;
             
-            // along z
-            mat7_3n3  = mat_z.transpose() * mat5_n1n3;
-            Bmat_nl_z.right_multiply_transpose(mat6_n2n3, mat7_3n3);
-            K_ualpha  += JxW[qp] * mat6_n2n3;
+            if (if_nonlinear) {
+                
+                // nonlinear component
+                // along x
+                mat7_3n3  = mat_x.transpose() * mat5_n1n3;
+                Bmat_nl_x.right_multiply_transpose(mat6_n2n3, mat7_3n3);
+                K_ualpha  += JxW[qp] * mat6_n2n3;
+                
+                // along y
+                mat7_3n3  = mat_y.transpose() * mat5_n1n3;
+                Bmat_nl_y.right_multiply_transpose(mat6_n2n3, mat7_3n3);
+                K_ualpha  += JxW[qp] * mat6_n2n3;
+                
+                // along z
+                mat7_3n3  = mat_z.transpose() * mat5_n1n3;
+                Bmat_nl_z.right_multiply_transpose(mat6_n2n3, mat7_3n3);
+                K_ualpha  += JxW[qp] * mat6_n2n3;
+            }
         }
     }
     
     
-    // incompatible mode Jacobian inverse
-    K_alphaalpha = K_alphaalpha.inverse();
+    if (!if_cached)
+        condensation.init(node_coords, material_mats, K_alphaalpha, K_ualpha);
     
     // update the alpha values
-    alpha += K_alphaalpha * (-f - K_ualpha.transpose() * dsol.topRows(n2));
+    alpha += condensation.solve(-f - condensation.K_ualpha().transpose() * dsol.topRows(n2));
 }
 
 
@@ -32,13 +32,15 @@ _stress(stress),
 _strain(strain),
 _qp(qp),
 _xyz(xyz),
-_JxW(JxW) {
+_JxW(JxW),
+_memory(MAST::MEMORY_OUTPUT_DATA) {
 
     // make sure that both the stress and strain are for a 3D configuration,
     // which is the default for this data structure
     libmesh_assert_equal_to(stress.size(), 6);
     libmesh_assert_equal_to(strain.size(), 6);
     
+    _update_memory();
 }
 
 
@@ -76,6 +78,8 @@ MAST::StressStrainOutputBase::Data::set_derivatives(const RealMatrixX& dstress_d
     
     _dstress_dX = dstress_dX;
     _dstrain_dX = dstrain_dX;
+    
+    _update_memory();
 }
 
 
@@ -113,6 +117,8 @@ MAST::StressStrainOutputBase::Data::set_sensitivity(const MAST::FunctionBase* f,
     
     _stress_sensitivity[f] = dstress_df;
     _strain_sensitivity[f] = dstrain_df;
+    
+    _update_memory();
 }
 
 
@@ -239,6 +245,22 @@ dvon_Mises_stress_dp(const MAST::FunctionBase* f) const {
 
 
 
+
+void
+MAST::StressStrainOutputBase::Data::_update_memory() {
+    
+    // the sensitivity vectors are of the same size for all functions
+    _memory.set(sizeof(MAST::StressStrainOutputBase::Data) +
+                MAST::MemoryLog::bytes(_stress) +
+                MAST::MemoryLog::bytes(_strain) +
+                MAST::MemoryLog::bytes(_dstress_dX) +
+                MAST::MemoryLog::bytes(_dstrain_dX) +
+                (_stress_sensitivity.size() + _strain_sensitivity.size()) *
+                6 * sizeof(Real));
+}
+
+
+
 MAST::StressStrainOutputBase::StressStrainOutputBase():
 MAST::OutputFunctionBase(MAST::STRAIN_STRESS_TENSOR),
 _vol_loads(nullptr) {
@@ -28,6 +28,7 @@
 #include "base/mast_data_types.h"
 #include "base/output_function_base.h"
 #include "base/physics_discipline_base.h"
+#include "base/memory_log.h"
 
 
 // libMesh includes
@@ -218,6 +219,19 @@ namespace MAST {
              *   quadrature weight) for use in definition of functionals
              */
             Real _JxW;
+            
+            
+            /*!
+             *   updates the memory account with the current size of the
+             *   stored data
+             */
+            void _update_memory();
+            
+            
+            /*!
+             *   memory held by this object
+             */
+            MAST::MemoryAccount _memory;
         };
         
 
@@ -272,12 +272,16 @@ MAST::StructuralElement1D::calculate_stress(bool request_derivative,
     mat_stiff  =
     const_cast<MAST::MaterialPropertyCardBase&>(_property.get_material()).stiffness_matrix(1);
 
-    // get the thickness values for the bending strain calculation
+    // get the section dimensions for the bending strain calculation.
+    // For general sections these are the bounding box of the section.
+    const MAST::ElementPropertyCard1D&
+    property_1d = dynamic_cast<const MAST::ElementPropertyCard1D&>(_property);
+    
     const MAST::FieldFunction<Real>
-    &hy     =  _property.get<MAST::FieldFunction<Real> >("hy"),
-    &hz     =  _property.get<MAST::FieldFunction<Real> >("hz"),
-    &hy_off =  _property.get<MAST::FieldFunction<Real> >("hy_off"),
-    &hz_off =  _property.get<MAST::FieldFunction<Real> >("hz_off");
+    &hy     =  property_1d.stress_recovery_function("hy"),
+    &hz     =  property_1d.stress_recovery_function("hz"),
+    &hy_off =  property_1d.stress_recovery_function("hy_off"),
+    &hz_off =  property_1d.stress_recovery_function("hz_off");
 
     
     bool if_vk = (_property.strain_type() == MAST::NONLINEAR_STRAIN),
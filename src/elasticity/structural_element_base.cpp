@@ -42,7 +42,8 @@ MAST::StructuralElementBase::StructuralElementBase(MAST::SystemInitialization& s
 MAST::ElementBase(sys, elem),
 follower_forces(false),
 _property(p),
-_incompatible_sol(nullptr) {
+_incompatible_sol(nullptr),
+_incompatible_condensation(nullptr) {
     
     MAST::LocalElemBase* rval = nullptr;
     
@@ -36,6 +36,7 @@ namespace MAST {
     class BoundaryConditionBase;
     class FEMOperatorMatrix;
     class OutputFunctionBase;
+    class IncompatibleModeCondensation;
     
     
     class StructuralElementBase:
@@ -368,6 +369,19 @@ namespace MAST {
         }
         
         
+        /*!
+         *  sets the pointer to the object that stores the static
+         *  condensation of the incompatible modes of this element, so
+         *  that it can be reused by later calculations on the same
+         *  element. If this is not set, the condensation is computed
+         *  for each call.
+         */
+        void
+        set_incompatible_mode_condensation(MAST::IncompatibleModeCondensation& c) {
+            _incompatible_condensation = &c;
+        }
+        
+        
         /*!
          *    updates the incompatible solution for this element. \p dsol
          *    is the update to the element solution for the current
@@ -702,6 +716,12 @@ namespace MAST {
          */
         RealVectorX* _incompatible_sol;
         
+        
+        /*!
+         *   cached static condensation of the incompatible modes
+         */
+        MAST::IncompatibleModeCondensation* _incompatible_condensation;
+        
     };
     
     
@@ -29,6 +29,8 @@
 #include "numerics/utility.h"
 #include "base/real_output_function.h"
 #include "base/nonlinear_system.h"
+#include "base/performance_log.h"
+#include "base/memory_log.h"
 
 
 // libMesh includes
@@ -40,6 +42,34 @@
 #include "libmesh/parameter_vector.h"
 
 
+namespace MAST {
+    
+    // copies the loads of type MAST::PISTON_THEORY from \p bc to
+    // \p piston_bc, and all other loads to \p other_bc.
+    template <typename MapType>
+    static void
+    __split_piston_theory_loads(const MapType& bc,
+                                MapType&       piston_bc,
+                                MapType&       other_bc) {
+        
+        piston_bc.clear();
+        other_bc.clear();
+        
+        typename MapType::const_iterator
+        it   = bc.begin(),
+        end  = bc.end();
+        
+        for ( ; it != end; it++) {
+            
+            if (it->second->type() == MAST::PISTON_THEORY)
+                piston_bc.insert(*it);
+            else
+                other_bc.insert(*it);
+        }
+    }
+}
+
+
 
 MAST::StructuralFluidInteractionAssembly::
 StructuralFluidInteractionAssembly():
@@ -140,6 +170,8 @@ assemble_reduced_order_quantity
 (std::vector<libMesh::NumericVector<Real>*>& basis,
  std::map<MAST::StructuralQuantityType, RealMatrixX*>& mat_qty_map) {
     
+    MAST_LOG_SCOPE("StructuralFluidInteractionAssembly::assemble_reduced_order_quantity");
+    
     MAST::NonlinearSystem& nonlin_sys = _system->system();
     
     unsigned int
@@ -172,6 +204,13 @@ assemble_reduced_order_quantity
     for (unsigned int i=0; i<n_basis; i++)
         localized_basis[i] = _build_localized_vector(nonlin_sys, *basis[i]).release();
     
+    // memory of the localized basis vectors, including the ghosted entries
+    MAST::MemoryAccount
+    basis_memory(MAST::MEMORY_ASSEMBLY_WORK);
+    basis_memory.set(n_basis * sizeof(Real) *
+                     (nonlin_sys.n_local_dofs() +
+                      nonlin_sys.get_dof_map().get_send_list().size()));
+    
     
     // if a solution function is attached, initialize it
     if (_sol_function && _base_sol)
@@ -186,6 +225,8 @@ assemble_reduced_order_quantity
     
     for ( ; el != end_el; ++el) {
         
+        MAST_LOG_COUNT("elements", 1);
+        
         const libMesh::Elem* elem = *el;
         
         dof_map.dof_indices (elem, dof_indices);
@@ -248,6 +289,7 @@ assemble_reduced_order_quantity
     // delete the localized basis vectors
     for (unsigned int i=0; i<basis.size(); i++)
         delete localized_basis[i];
+    basis_memory.clear();
 
     // sum the matrix and provide it to each processor
     it  = mat_qty_map.begin(),
@@ -270,6 +312,8 @@ assemble_reduced_order_quantity_sensitivity
  std::vector<libMesh::NumericVector<Real>*>& basis,
  std::map<MAST::StructuralQuantityType, RealMatrixX*>& mat_qty_map) {
     
+    MAST_LOG_SCOPE("StructuralFluidInteractionAssembly::assemble_reduced_order_quantity_sensitivity");
+    
     
     MAST::NonlinearSystem& nonlin_sys = _system->system();
     
@@ -314,6 +358,13 @@ assemble_reduced_order_quantity_sensitivity
     for (unsigned int i=0; i<n_basis; i++)
         localized_basis[i] = _build_localized_vector(nonlin_sys, *basis[i]).release();
     
+    // memory of the localized basis vectors, including the ghosted entries
+    MAST::MemoryAccount
+    basis_memory(MAST::MEMORY_ASSEMBLY_WORK);
+    basis_memory.set(n_basis * sizeof(Real) *
+                     (nonlin_sys.n_local_dofs() +
+                      nonlin_sys.get_dof_map().get_send_list().size()));
+    
     
     // if a solution function is attached, initialize it
     if (_sol_function && _base_sol)
@@ -328,6 +379,8 @@ assemble_reduced_order_quantity_sensitivity
     
     for ( ; el != end_el; ++el) {
         
+        MAST_LOG_COUNT("elements", 1);
+        
         const libMesh::Elem* elem = *el;
         
         dof_map.dof_indices (elem, dof_indices);
@@ -395,6 +448,7 @@ assemble_reduced_order_quantity_sensitivity
     // delete the localized basis vectors
     for (unsigned int i=0; i<basis.size(); i++)
         delete localized_basis[i];
+    basis_memory.clear();
     
     // sum the matrix and provide it to each processor
     it  = mat_qty_map.begin(),
@@ -485,6 +539,69 @@ _elem_calculations(MAST::ElementBase& elem,
         }
             break;
             
+        case MAST::STRUCTURAL_DAMPING:
+        case MAST::AERODYNAMIC_DAMPING: {
+            
+            // only the loads of the requested kind are included
+            MAST::SideBCMapType   piston_side, other_side;
+            MAST::VolumeBCMapType piston_vol,  other_vol;
+            MAST::__split_piston_theory_loads(_discipline->side_loads(),
+                                              piston_side,
+                                              other_side);
+            MAST::__split_piston_theory_loads(_discipline->volume_loads(),
+                                              piston_vol,
+                                              other_vol);
+            
+            const bool if_aero = (_qty_type == MAST::AERODYNAMIC_DAMPING);
+            
+            if (!if_aero)
+                e.inertial_residual(true, vec, dummy, mat, dummy);
+            e.side_external_residual(true,
+                                     vec,
+                                     mat,
+                                     dummy,
+                                     if_aero? piston_side : other_side);
+            e.volume_external_residual(true,
+                                       vec,
+                                       mat,
+                                       dummy,
+                                       if_aero? piston_vol  : other_vol);
+        }
+            break;
+            
+        case MAST::STRUCTURAL_STIFFNESS:
+        case MAST::AERODYNAMIC_STIFFNESS: {
+            
+            // only the loads of the requested kind are included
+            MAST::SideBCMapType   piston_side, other_side;
+            MAST::VolumeBCMapType piston_vol,  other_vol;
+            MAST::__split_piston_theory_loads(_discipline->side_loads(),
+                                              piston_side,
+                                              other_side);
+            MAST::__split_piston_theory_loads(_discipline->volume_loads(),
+                                              piston_vol,
+                                              other_vol);
+            
+            const bool if_aero = (_qty_type == MAST::AERODYNAMIC_STIFFNESS);
+            
+            if (!if_aero) {
+                
+                e.internal_residual(true, vec, mat);
+                e.inertial_residual(true, vec, dummy, dummy, mat);
+            }
+            e.side_external_residual(true,
+                                     vec,
+                                     dummy,
+                                     mat,
+                                     if_aero? piston_side : other_side);
+            e.volume_external_residual(true,
+                                       vec,
+                                       dummy,
+                                       mat,
+                                       if_aero? piston_vol  : other_vol);
+        }
+            break;
+            
         default:
             libmesh_error(); // should not get here
     }
@@ -34,7 +34,11 @@ namespace MAST {
         MASS,                    // mass matrix
         DAMPING,                 // velocity proportional term
         STIFFNESS,               // tangent stiffess matrix
-        FORCE                    // force vector
+        FORCE,                   // force vector
+        STRUCTURAL_DAMPING,      // DAMPING without piston theory loads
+        STRUCTURAL_STIFFNESS,    // STIFFNESS without piston theory loads
+        AERODYNAMIC_DAMPING,     // piston theory contribution to DAMPING
+        AERODYNAMIC_STIFFNESS    // piston theory contribution to STIFFNESS
     };
     
     
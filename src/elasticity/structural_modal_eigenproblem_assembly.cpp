@@ -46,6 +46,16 @@ MAST::StructuralModalEigenproblemAssembly::
 
 
 
+void
+MAST::StructuralModalEigenproblemAssembly::clear_discipline_and_system() {
+    
+    _incompatible_condensation.clear();
+    
+    MAST::EigenproblemAssembly::clear_discipline_and_system();
+}
+
+
+
 void
 MAST::StructuralModalEigenproblemAssembly::
 eigenproblem_assemble(libMesh::SparseMatrix<Real> *A,
@@ -117,6 +127,7 @@ eigenproblem_assemble(libMesh::SparseMatrix<Real> *A,
             if (!_incompatible_sol.count(elem))
                 _incompatible_sol[elem] = RealVectorX::Zero(p_elem.incompatible_mode_size());
             p_elem.set_incompatible_mode_solution(_incompatible_sol[elem]);
+            p_elem.set_incompatible_mode_condensation(_incompatible_condensation[elem]);
         }
 
         _elem_calculations(*physics_elem, mat_A, mat_B);
@@ -234,6 +245,7 @@ eigenproblem_sensitivity_assemble (const libMesh::ParameterVector& parameters,
             if (!_incompatible_sol.count(elem))
                 _incompatible_sol[elem] = RealVectorX::Zero(p_elem.incompatible_mode_size());
             p_elem.set_incompatible_mode_solution(_incompatible_sol[elem]);
+            p_elem.set_incompatible_mode_condensation(_incompatible_condensation[elem]);
         }
         
         _elem_sensitivity_calculations(*physics_elem, mat_A, mat_B);
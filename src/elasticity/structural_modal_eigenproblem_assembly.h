@@ -22,6 +22,7 @@
 
 // MAST includes
 #include "base/eigenproblem_assembly.h"
+#include "elasticity/incompatible_mode_condensation.h"
 
 
 namespace MAST {
@@ -67,6 +68,12 @@ namespace MAST {
                                            libMesh::SparseMatrix<Real>* sensitivity_A,
                                            libMesh::SparseMatrix<Real>* sensitivity_B);
         
+        
+        /*!
+         *   clears the cached condensation of the incompatible modes
+         */
+        virtual void clear_discipline_and_system();
+        
 
     protected:
         
@@ -101,6 +108,15 @@ namespace MAST {
          *   map of local incompatible mode solution per 3D elements
          */
         std::map<const libMesh::Elem*, RealVectorX> _incompatible_sol;
+        
+        /*!
+         *   map of the static condensation of incompatible modes per 3D
+         *   elements, which is reused while the element geometry and
+         *   material are unchanged. This is cleared by
+         *   clear_discipline_and_system().
+         */
+        std::map<const libMesh::Elem*, MAST::IncompatibleModeCondensation>
+        _incompatible_condensation;
     };
     
 }
@@ -130,6 +130,7 @@ residual_and_jacobian (const libMesh::NumericVector<Real>& X,
             if (!_incompatible_sol.count(elem))
                 _incompatible_sol[elem] = RealVectorX::Zero(p_elem.incompatible_mode_size());
             p_elem.set_incompatible_mode_solution(_incompatible_sol[elem]);
+            p_elem.set_incompatible_mode_condensation(_incompatible_condensation[elem]);
         }
         
         if (_sol_function)
@@ -247,6 +248,7 @@ sensitivity_assemble (const libMesh::ParameterVector& parameters,
             if (!_incompatible_sol.count(elem))
                 _incompatible_sol[elem] = RealVectorX::Zero(p_elem.incompatible_mode_size());
             p_elem.set_incompatible_mode_solution(_incompatible_sol[elem]);
+            p_elem.set_incompatible_mode_condensation(_incompatible_condensation[elem]);
         }
 
         if (_sol_function)
@@ -350,6 +352,7 @@ update_incompatible_solution(libMesh::NumericVector<Real>& X,
             
             p_elem.set_solution(sol);
             p_elem.set_incompatible_mode_solution(_incompatible_sol[elem]);
+            p_elem.set_incompatible_mode_condensation(_incompatible_condensation[elem]);
             
             if (_sol_function)
                 p_elem.attach_active_solution_function(*_sol_function);
@@ -552,6 +555,7 @@ _calculate_compliance (const libMesh::NumericVector<Real>& X,
             if (!_incompatible_sol.count(elem))
                 _incompatible_sol[elem] = RealVectorX::Zero(p_elem.incompatible_mode_size());
             p_elem.set_incompatible_mode_solution(_incompatible_sol[elem]);
+            p_elem.set_incompatible_mode_condensation(_incompatible_condensation[elem]);
         }
         
         if (_sol_function)
@@ -766,6 +770,9 @@ clear_discipline_and_system( ) {
     SNESMonitorCancel(snes);
     libmesh_assert(!ierr);
     
+    // the cached condensations belong to the elements of this system
+    _incompatible_condensation.clear();
+    
     // call the parent's method firts
     MAST::NonlinearImplicitAssembly::clear_discipline_and_system();
     
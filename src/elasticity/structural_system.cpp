@@ -23,6 +23,7 @@
 // MAST includes
 #include "elasticity/structural_system.h"
 #include "base/parameter.h"
+#include "base/performance_log.h"
 
 // libMesh includes
 #include "libmesh/numeric_vector.h"
@@ -134,7 +135,8 @@ MAST::StructuralSystem::solve() {
     //  or, ((dg/dx)^T dx2 + dg/dp) dp = -g - (dg/dx)^T dx1
     //  or, dp = - (g + (dg/dx)^T dx1) / ((dg/dx)^T dx2 + dg/dp)
     
-    START_LOG("solve()", "StructuralSystem");
+    MAST_LOG_SCOPE("StructuralSystem::solve");
+    LOG_SCOPE("solve()", "StructuralSystem");
 
     //  the computations outlined above are repeated unless the
     //  nonlinear convergence criteria are satisfied.
@@ -246,7 +248,6 @@ MAST::StructuralSystem::solve() {
     // Update the system after the solve
     this->update();
 
-    STOP_LOG("solve()", "StructuralSystem");
 }
 
 
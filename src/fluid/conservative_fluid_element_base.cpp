@@ -30,12 +30,35 @@
 #include "base/nonlinear_system.h"
 
 
+namespace MAST {
+    
+    /*!
+     *   applies the intrinsic time scale matrix to \p v. For a diagonal
+     *   \p tau only the diagonal is used, consistent with
+     *   FluidElemBase::calculate_differential_operator_matrix().
+     */
+    static void
+    __apply_tau(const RealMatrixX& tau,
+                const bool if_diagonal,
+                const RealVectorX& v,
+                RealVectorX& res) {
+        
+        if (if_diagonal)
+            res = tau.diagonal().cwiseProduct(v);
+        else
+            res = tau * v;
+    }
+}
+
+
+
 MAST::ConservativeFluidElementBase::
 ConservativeFluidElementBase(MAST::SystemInitialization& sys,
                              const libMesh::Elem& elem,
                              const MAST::FlightCondition& f):
 MAST::FluidElemBase(elem.dim(), f),
-MAST::ElementBase(sys, elem) {
+MAST::ElementBase(sys, elem),
+_if_frozen_coefficient_jacobian(false) {
     
     // initialize the finite element data structures
     _init_fe_and_qrule(elem, &_fe, &_qrule);
@@ -54,6 +77,14 @@ bool
 MAST::ConservativeFluidElementBase::internal_residual (bool request_jacobian,
                                                        RealVectorX& f,
                                                        RealMatrixX& jac) {
+    
+    // the residual by itself does not need any of the n2 x n2 operators
+    if (!request_jacobian) {
+        
+        _matrix_free_internal_residual(&f, nullptr, nullptr);
+        return request_jacobian;
+    }
+    
     const std::vector<Real>& JxW                  = _fe->get_JxW();
     const std::vector<std::vector<Real> >& phi    = _fe->get_phi();
     const unsigned int
@@ -209,12 +240,15 @@ MAST::ConservativeFluidElementBase::internal_residual (bool request_jacobian,
                 jac -= JxW[qp]*mat4_n2n2;
                 
                 // sensitivity of Ai_Bi with respect to U:   [dAi/dUj.Bi.U  ...  dAi/dUn.Bi.U]
-                dBmat[i_dim].vector_mult(vec1_n1, _sol);
-                for (unsigned int i_cvar=0; i_cvar<n1; i_cvar++) {
+                if (!_if_frozen_coefficient_jacobian) {
                     
-                    vec2_n1 = Ai_sens[i_dim][i_cvar] * vec1_n1;
-                    for (unsigned int i_phi=0; i_phi<nphi; i_phi++)
-                        A_sens.col(nphi*i_cvar+i_phi) += phi[i_phi][qp] *vec2_n1; // assuming that all variables have same n_phi
+                    dBmat[i_dim].vector_mult(vec1_n1, _sol);
+                    for (unsigned int i_cvar=0; i_cvar<n1; i_cvar++) {
+                        
+                        vec2_n1 = Ai_sens[i_dim][i_cvar] * vec1_n1;
+                        for (unsigned int i_phi=0; i_phi<nphi; i_phi++)
+                            A_sens.col(nphi*i_cvar+i_phi) += phi[i_phi][qp] *vec2_n1; // assuming that all variables have same n_phi
+                    }
                 }
                 
                 // viscous flux Jacobian
@@ -241,10 +275,14 @@ MAST::ConservativeFluidElementBase::internal_residual (bool request_jacobian,
             // stabilization term
             jac  += JxW[qp] * LS.transpose() * AiBi_adv;                          // A_i dB_i
 
-            // linearization of the Jacobian terms
-            jac += JxW[qp] * LS.transpose() * A_sens; // LS^T tau d^2F^adv_i / dx dU  (Ai sensitivity)
-                                          // linearization of the LS terms
-            jac += JxW[qp] * LS_sens;
+            // linearization of the Jacobian terms. These are left out of
+            // the frozen-coefficient approximation
+            if (!_if_frozen_coefficient_jacobian) {
+                
+                jac += JxW[qp] * LS.transpose() * A_sens; // LS^T tau d^2F^adv_i / dx dU  (Ai sensitivity)
+                                              // linearization of the LS terms
+                jac += JxW[qp] * LS_sens;
+            }
             
         }
     }
@@ -270,23 +308,251 @@ linearized_internal_residual (bool request_jacobian,
     n1     = dim+2,
     n2     = _fe->n_shape_functions()*n1;
     
+    if (request_jacobian) {
+        
+        RealMatrixX
+        f_jac_x         = RealMatrixX::Zero(   n2,    n2);
+        
+        RealVectorX
+        local_f    = RealVectorX::Zero(n2);
+        
+        // df/dx
+        this->internal_residual(true, local_f, f_jac_x);
+        jac      +=  f_jac_x;
+    }
+    
+    // the product df/dx * dx is evaluated at the quadrature points, so
+    // that the n2 x n2 Jacobian is not needed for the residual. This is
+    // also exact when the frozen-coefficient Jacobian is requested.
+    _matrix_free_internal_residual(nullptr, &_delta_sol, &f);
+    
+    return request_jacobian;
+}
+
+
+
+
+void
+MAST::ConservativeFluidElementBase::
+_matrix_free_internal_residual(RealVectorX* f,
+                               const RealVectorX* dsol,
+                               RealVectorX* jac_dsol) {
+    
+    libmesh_assert(f || (dsol && jac_dsol));
+    
+    const std::vector<Real>& JxW                  = _fe->get_JxW();
+    const unsigned int
+    dim    = _elem.dim(),
+    n1     = dim+2,
+    n2     = _fe->n_shape_functions()*n1;
+    
+    const bool
+    if_jac = (dsol != nullptr);
+    
     RealMatrixX
-    f_jac_x         = RealMatrixX::Zero(   n2,    n2),
-    fm_jac_xdot     = RealMatrixX::Zero(   n2,    n2);
+    mat1_n1n1       = RealMatrixX::Zero(   n1,    n1),
+    mat3_n1n2       = RealMatrixX::Zero(   n1,    n2),
+    AiBi_adv        = RealMatrixX::Zero(   n1,    n2),
+    tau             = RealMatrixX::Zero(   n1,    n1),
+    stress          = RealMatrixX::Zero(  dim,   dim),
+    dprim_dcons     = RealMatrixX::Zero(   n1,    n1),
+    dcons_dprim     = RealMatrixX::Zero(   n1,    n1);
     
     RealVectorX
-    local_f    = RealVectorX::Zero(n2);
+    vec1_n1   = RealVectorX::Zero(n1),
+    vec2_n1   = RealVectorX::Zero(n1),
+    vec3_n2   = RealVectorX::Zero(n2),
+    strong_res= RealVectorX::Zero(n1),
+    tau_res   = RealVectorX::Zero(n1),
+    dsol_qp   = RealVectorX::Zero(n1),
+    lin_res   = RealVectorX::Zero(n1),
+    dc        = RealVectorX::Zero(dim),
+    temp_grad = RealVectorX::Zero(dim);
     
-    // df/dx. We always need the Jacobian, since it is used to calculate
-    // the residual
-    this->internal_residual(true, local_f, f_jac_x);
+    std::vector<RealVectorX>
+    dsol_dx   (dim),
+    ddsol_dx  (dim);
     
-    if (request_jacobian)
-        jac      +=  f_jac_x;
+    std::vector<RealMatrixX>
+    Ai_adv   (dim),
+    tau_sens (n1);
     
-    f        +=  f_jac_x * _delta_sol;
+    std::vector<std::vector<RealMatrixX> >
+    Ai_sens  (dim);
     
-    return request_jacobian;
+    for (unsigned int i=0; i<dim; i++) {
+        dsol_dx [i].setZero(n1);
+        ddsol_dx[i].setZero(n1);
+        Ai_adv  [i].setZero(n1, n1);
+        Ai_sens [i].resize(n1);
+        for (unsigned int j=0; j<n1; j++)
+            Ai_sens[i][j].setZero(n1, n1);
+    }
+    
+    for (unsigned int i=0; i<n1; i++)
+        tau_sens[i].setZero(n1, n1);
+    
+    std::vector<MAST::FEMOperatorMatrix> dBmat(dim);
+    MAST::FEMOperatorMatrix Bmat;
+    MAST::PrimitiveSolution      primitive_sol;
+    
+    
+    for (unsigned int qp=0; qp<JxW.size(); qp++) {
+        
+        // initialize the Bmat operator for this term
+        _initialize_fem_interpolation_operator(qp, dim, *_fe, Bmat);
+        
+        // calculate the local element solution
+        Bmat.vector_mult(vec1_n1, _sol);
+        
+        primitive_sol.zero();
+        primitive_sol.init(dim,
+                           vec1_n1,
+                           flight_condition->gas_property.cp,
+                           flight_condition->gas_property.cv,
+                           if_viscous());
+        
+        // initialize the FEM derivative operator
+        _initialize_fem_gradient_operator(qp, dim, *_fe, dBmat);
+        
+        if (if_viscous()) {
+            
+            calculate_conservative_variable_jacobian(primitive_sol,
+                                                     dcons_dprim,
+                                                     dprim_dcons);
+            calculate_diffusion_tensors(_sol,
+                                        dBmat,
+                                        dprim_dcons,
+                                        primitive_sol,
+                                        stress,
+                                        temp_grad);
+        }
+        
+        // strong form of the advection residual: sum_i A_i dU/dx_i
+        AiBi_adv.setZero();
+        strong_res.setZero();
+        for (unsigned int i_dim=0; i_dim<dim; i_dim++) {
+            
+            calculate_advection_flux_jacobian(i_dim, primitive_sol, Ai_adv[i_dim]);
+            if (if_jac)
+                calculate_advection_flux_jacobian_sensitivity_for_conservative_variable
+                (i_dim, primitive_sol, Ai_sens[i_dim]);
+            
+            dBmat[i_dim].left_multiply(mat3_n1n2, Ai_adv[i_dim]);
+            AiBi_adv += mat3_n1n2;
+            
+            dBmat[i_dim].vector_mult(dsol_dx[i_dim], _sol);
+            strong_res += Ai_adv[i_dim] * dsol_dx[i_dim];
+        }
+        
+        // intrinsic time operator for this quadrature point. This is the
+        // same tau used by calculate_differential_operator_matrix(), but
+        // the LS operator is applied through its factors A_i and dB_i.
+        const bool
+        if_diagonal_tau = this->calculate_barth_tau_matrix(qp,
+                                                           *_fe,
+                                                           primitive_sol,
+                                                           tau,
+                                                           tau_sens);
+        
+        // discontinuity capturing operator for this quadrature point
+        calculate_aliabadi_discontinuity_operator(qp,
+                                                  *_fe,
+                                                  primitive_sol,
+                                                  _sol,
+                                                  dBmat,
+                                                  AiBi_adv,
+                                                  dc);
+        
+        if (f) {
+            
+            // LS^T r = sum_i dB_i^T A_i tau r
+            __apply_tau(tau, if_diagonal_tau, strong_res, tau_res);
+            
+            for (unsigned int i_dim=0; i_dim<dim; i_dim++) {
+                
+                // first the flux
+                calculate_advection_flux(i_dim, primitive_sol, vec1_n1);
+                
+                // diffusive flux
+                if (if_viscous()) {
+                    
+                    calculate_diffusion_flux(i_dim,
+                                             primitive_sol,
+                                             stress,
+                                             temp_grad,
+                                             vec2_n1);
+                    vec1_n1 -= vec2_n1;
+                }
+                
+                // discontinuity capturing and stabilization terms
+                vec1_n1 -= dc(i_dim) * dsol_dx[i_dim];
+                vec1_n1 -= Ai_adv[i_dim] * tau_res;
+                
+                dBmat[i_dim].vector_mult_transpose(vec3_n2, vec1_n1);
+                *f -= JxW[qp] * vec3_n2;
+            }
+        }
+        
+        if (if_jac) {
+            
+            Bmat.vector_mult(dsol_qp, *dsol);
+            for (unsigned int i_dim=0; i_dim<dim; i_dim++)
+                dBmat[i_dim].vector_mult(ddsol_dx[i_dim], *dsol);
+            
+            // linearized strong residual: sum_i (A_i dB_i dU + dA_i/dU dU dB_i U)
+            lin_res.setZero();
+            for (unsigned int i_dim=0; i_dim<dim; i_dim++) {
+                
+                lin_res += Ai_adv[i_dim] * ddsol_dx[i_dim];
+                
+                for (unsigned int i_cvar=0; i_cvar<n1; i_cvar++)
+                    lin_res += dsol_qp(i_cvar) * (Ai_sens[i_dim][i_cvar] * dsol_dx[i_dim]);
+            }
+            __apply_tau(tau, if_diagonal_tau, lin_res, tau_res);
+            
+            // tau times the strong residual, used for the linearization
+            // of the LS operator
+            __apply_tau(tau, if_diagonal_tau, strong_res, vec2_n1);
+            
+            for (unsigned int i_dim=0; i_dim<dim; i_dim++) {
+                
+                // flux term: -dB_i^T A_i B dU
+                vec1_n1 = -(Ai_adv[i_dim] * dsol_qp);
+                
+                // viscous flux Jacobian: dB_i^T K_ij dB_j dU
+                if (if_viscous()) {
+                    
+                    for (unsigned int j_dim=0; j_dim<dim; j_dim++) {
+                        
+                        calculate_diffusion_flux_jacobian(i_dim,
+                                                          j_dim,
+                                                          primitive_sol,
+                                                          mat1_n1n1);
+                        vec1_n1 += mat1_n1n1 * ddsol_dx[j_dim];
+                    }
+                }
+                
+                // discontinuity capturing term
+                vec1_n1 += dc(i_dim) * ddsol_dx[i_dim];
+                
+                // stabilization term: LS^T (AiBi + A_sens) dU
+                vec1_n1 += Ai_adv[i_dim] * tau_res;
+                
+                // linearization of the LS operator. This is always included,
+                // since the product is the exact Jacobian-vector product
+                // used by the Krylov iterations, and only the assembled
+                // Jacobian uses the frozen-coefficient approximation.
+                for (unsigned int i_cvar=0; i_cvar<n1; i_cvar++)
+                    vec1_n1 += dsol_qp(i_cvar) *
+                    (Ai_sens[i_dim][i_cvar] * vec2_n1 +
+                     Ai_adv[i_dim] * (tau_sens[i_cvar] * strong_res));
+                
+                dBmat[i_dim].vector_mult_transpose(vec3_n2, vec1_n1);
+                *jac_dsol += JxW[qp] * vec3_n2;
+            }
+        }
+    }
 }
 
 
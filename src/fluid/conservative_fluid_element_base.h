@@ -52,6 +52,20 @@ namespace MAST {
         virtual ~ConservativeFluidElementBase();
         
         
+        /*!
+         *   If \p f is true, the Jacobian returned by internal_residual()
+         *   leaves out the linearization of the flux Jacobians and of the
+         *   stabilization operator with respect to the solution. This
+         *   frozen-coefficient Jacobian is cheaper to assemble and is
+         *   intended as the preconditioner for Jacobian-free Newton-Krylov
+         *   solves, where the exact Jacobian-vector product is computed by
+         *   linearized_internal_residual(). The residual is not affected.
+         */
+        void set_frozen_coefficient_jacobian(bool f) {
+            _if_frozen_coefficient_jacobian = f;
+        }
+        
+        
         /*!
          *   internal force contribution to system residual
          */
@@ -63,7 +77,10 @@ namespace MAST {
         
         /*!
          *   internal force contribution to system residual of the linearized 
-         *   problem.
+         *   problem. The product of the Jacobian with the perturbed solution
+         *   is computed at the quadrature points without forming the
+         *   element Jacobian, which is only assembled if
+         *   \p request_jacobian is true.
          */
         virtual bool
         linearized_internal_residual (bool request_jacobian,
@@ -269,6 +286,27 @@ namespace MAST {
                                                const libMesh::FEBase& fe,
                                                std::vector<MAST::FEMOperatorMatrix>& dBmat);
         
+        
+        /*!
+         *   Matrix-free evaluation of the internal residual. If \p f is
+         *   provided, the residual is added to it. If \p dsol is provided,
+         *   the product of the internal residual Jacobian with \p dsol is
+         *   added to \p jac_dsol. The stabilization operator and its
+         *   linearization are applied through their factors at each
+         *   quadrature point, so that the cost scales with the number of
+         *   element dofs instead of its square. This makes the evaluation
+         *   practical for high-order elements.
+         */
+        void _matrix_free_internal_residual(RealVectorX* f,
+                                            const RealVectorX* dsol,
+                                            RealVectorX* jac_dsol);
+        
+        
+        /*!
+         *   flag to use the frozen-coefficient approximation of the
+         *   internal residual Jacobian
+         */
+        bool _if_frozen_coefficient_jacobian;
     };
 }
 
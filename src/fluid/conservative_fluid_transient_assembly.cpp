@@ -27,7 +27,8 @@
 
 MAST::ConservativeFluidTransientAssembly::
 ConservativeFluidTransientAssembly():
-MAST::TransientAssembly() {
+MAST::TransientAssembly(),
+_if_frozen_coefficient_pc(false) {
     
 }
 
@@ -124,8 +125,9 @@ MAST::ConservativeFluidTransientAssembly::_build_elem(const libMesh::Elem& elem)
     const MAST::FlightCondition& p =
     dynamic_cast<MAST::ConservativeFluidDiscipline*>(_discipline)->flight_condition();
     
-    MAST::ElementBase* rval =
+    MAST::ConservativeFluidElementBase* rval =
     new MAST::ConservativeFluidElementBase(*_system, elem, p);
+    rval->set_frozen_coefficient_jacobian(_if_frozen_coefficient_pc);
     
     return std::auto_ptr<MAST::ElementBase>(rval);
 }
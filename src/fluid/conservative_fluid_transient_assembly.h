@@ -44,6 +44,18 @@ namespace MAST {
          */
         virtual ~ConservativeFluidTransientAssembly();
         
+        
+        /*!
+         *   If \p f is true, the elements assemble the frozen-coefficient
+         *   approximation of the Jacobian. This should be used along with
+         *   NonlinearSystem::set_jacobian_free_newton_krylov(), where the
+         *   assembled matrix only serves as the preconditioner and the
+         *   Jacobian-vector products are computed exactly.
+         */
+        void set_frozen_coefficient_preconditioner(bool f) {
+            _if_frozen_coefficient_pc = f;
+        }
+        
         //**************************************************************
         //these methods are provided for use by the solvers
         //**************************************************************
@@ -121,6 +133,11 @@ namespace MAST {
         virtual std::auto_ptr<MAST::ElementBase>
         _build_elem(const libMesh::Elem& elem);
         
+        
+        /*!
+         *   flag to assemble the frozen-coefficient Jacobian
+         */
+        bool _if_frozen_coefficient_pc;
     };
     
     
@@ -26,6 +26,7 @@
 #include "fluid/small_disturbance_primitive_fluid_solution.h"
 #include "fluid/flight_condition.h"
 #include "base/nonlinear_system.h"
+#include "base/boundary_trace_interpolation.h"
 
 
 // libMesh includes
@@ -40,7 +41,8 @@ FrequencyDomainPressureFunction(MAST::SystemInitialization& sys,
 MAST::FieldFunction<Complex>("frequency_domain_pressure"),
 _if_cp(false),
 _system(sys),
-_flt_cond(flt) {
+_flt_cond(flt),
+_memory(MAST::MEMORY_FIELD_FUNCTIONS) {
     
 }
 
@@ -54,6 +56,24 @@ MAST::FrequencyDomainPressureFunction::~FrequencyDomainPressureFunction() {
 
 
 
+void
+MAST::FrequencyDomainPressureFunction::
+use_boundary_trace(const std::set<libMesh::boundary_id_type>& bids) {
+    
+    _trace.reset(new MAST::BoundaryTraceInterpolation(_system, bids));
+    
+    _sol_function.reset();
+    _dsol_re_function.reset();
+    _dsol_im_function.reset();
+    _sol.reset();
+    _dsol_real.reset();
+    _dsol_imag.reset();
+    _memory.clear();
+}
+
+
+
+
 void
 MAST::FrequencyDomainPressureFunction::
 init(const libMesh::NumericVector<Real>& steady_sol,
@@ -62,6 +82,20 @@ init(const libMesh::NumericVector<Real>& steady_sol,
     
     MAST::NonlinearSystem& sys = _system.system();
     
+    // only the dofs on the trace are needed if it has been specified
+    if (_trace.get()) {
+        
+        _trace->localize(steady_sol,          _sol_trace);
+        _trace->localize(small_dist_sol_real, _dsol_real_trace);
+        _trace->localize(small_dist_sol_imag, _dsol_imag_trace);
+        
+        _memory.set((_sol_trace.size() +
+                     _dsol_real_trace.size() +
+                     _dsol_imag_trace.size()) * sizeof(Real));
+        
+        return;
+    }
+    
     // first initialize the solution to the given vector
     // steady state solution
     _sol.reset(libMesh::NumericVector<Real>::build(sys.comm()).release());
@@ -103,6 +137,9 @@ init(const libMesh::NumericVector<Real>& steady_sol,
                                                       _system.vars()));
     _dsol_im_function->init();
 
+    _memory.set(MAST::MemoryLog::bytes(*_sol) +
+                MAST::MemoryLog::bytes(*_dsol_real) +
+                MAST::MemoryLog::bytes(*_dsol_imag));
 }
 
 
@@ -116,7 +153,8 @@ operator () (const libMesh::Point& p,
              Complex&              dpress) const {
     
     
-    libmesh_assert(_sol_function.get()); // should be initialized before this call
+    // should be initialized before this call
+    libmesh_assert(_sol_function.get() || _sol_trace.size());
     
     dpress = 0.;
     
@@ -131,21 +169,34 @@ operator () (const libMesh::Point& p,
     dsol   = ComplexVectorX::Zero(_system.system().n_vars());
     
     
-    // first copy the real and imaginary solutions
-    (*_dsol_re_function)(p, 0., v);
-    MAST::copy(sol, v);
-    dsol.real() = sol;
-    
-    
-    // now the imaginary part
-    (*_dsol_im_function)(p, 0., v);
-    MAST::copy(sol, v);
-    dsol.imag() = sol;
-    
-    
-    // now the steady state function itself
-    (*_sol_function)(p, 0., v);
-    MAST::copy(sol, v);
+    if (_trace.get()) {
+        
+        _trace->interpolate(p, _dsol_real_trace, sol);
+        dsol.real() = sol;
+        
+        _trace->interpolate(p, _dsol_imag_trace, sol);
+        dsol.imag() = sol;
+        
+        _trace->interpolate(p, _sol_trace, sol);
+    }
+    else {
+        
+        // first copy the real and imaginary solutions
+        (*_dsol_re_function)(p, 0., v);
+        MAST::copy(sol, v);
+        dsol.real() = sol;
+        
+        
+        // now the imaginary part
+        (*_dsol_im_function)(p, 0., v);
+        MAST::copy(sol, v);
+        dsol.imag() = sol;
+        
+        
+        // now the steady state function itself
+        (*_sol_function)(p, 0., v);
+        MAST::copy(sol, v);
+    }
     
     
     MAST::PrimitiveSolution                     p_sol;
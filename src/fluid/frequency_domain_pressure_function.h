@@ -22,8 +22,13 @@
 #define __mast__frequency_domain_pressure_function_h__
 
 
+// C++ includes
+#include <set>
+
+
 // MAST includes
 #include "base/field_function_base.h"
+#include "base/memory_log.h"
 
 
 // libMesh includes
@@ -37,6 +42,7 @@ namespace MAST {
     class FrequencyFunction;
     class SystemInitialization;
     class FlightCondition;
+    class BoundaryTraceInterpolation;
     
     
     class FrequencyDomainPressureFunction:
@@ -60,6 +66,16 @@ namespace MAST {
         }
 
         
+        /*!
+         *   restricts the evaluation of pressure to points on the fluid
+         *   boundaries with ids in \p bids. With this option init() localizes
+         *   only the dofs of elements on these boundaries, and no mesh
+         *   function is created over the fluid domain. This must be called
+         *   before init().
+         */
+        void use_boundary_trace(const std::set<libMesh::boundary_id_type>& bids);
+        
+        
         /*!
          *   initiate the mesh function for this solution
          */
@@ -119,6 +135,25 @@ namespace MAST {
          *   imag part of small-disturbance solution
          */
         std::auto_ptr<libMesh::NumericVector<Real> > _dsol_imag;
+        
+        /*!
+         *   interpolation on the boundary trace, if requested by
+         *   use_boundary_trace()
+         */
+        std::auto_ptr<MAST::BoundaryTraceInterpolation> _trace;
+        
+        /*!
+         *   steady and small-disturbance solutions on the boundary trace
+         */
+        std::vector<Real>
+        _sol_trace,
+        _dsol_real_trace,
+        _dsol_imag_trace;
+        
+        /*!
+         *   memory held by the localized solutions
+         */
+        MAST::MemoryAccount _memory;
 
     };
 }
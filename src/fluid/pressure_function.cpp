@@ -26,6 +26,7 @@
 #include "fluid/small_disturbance_primitive_fluid_solution.h"
 #include "fluid/flight_condition.h"
 #include "base/nonlinear_system.h"
+#include "base/boundary_trace_interpolation.h"
 
 
 // libMesh includes
@@ -41,7 +42,8 @@ MAST::FieldFunction<Real>("pressure"),
 _if_cp            (false),
 _ref_pressure     (0.),
 _system           (sys),
-_flt_cond         (flt) {
+_flt_cond         (flt),
+_memory           (MAST::MEMORY_FIELD_FUNCTIONS) {
     
 }
 
@@ -55,6 +57,22 @@ MAST::PressureFunction::~PressureFunction() {
 
 
 
+void
+MAST::PressureFunction::
+use_boundary_trace(const std::set<libMesh::boundary_id_type>& bids) {
+    
+    _trace.reset(new MAST::BoundaryTraceInterpolation(_system, bids));
+    
+    _sol_function.reset();
+    _dsol_function.reset();
+    _sol.reset();
+    _dsol.reset();
+    _memory.clear();
+}
+
+
+
+
 void
 MAST::PressureFunction::
 init(const libMesh::NumericVector<Real>& steady_sol,
@@ -62,6 +80,21 @@ init(const libMesh::NumericVector<Real>& steady_sol,
     
     MAST::NonlinearSystem& sys = _system.system();
     
+    // only the dofs on the trace are needed if it has been specified
+    if (_trace.get()) {
+        
+        _trace->localize(steady_sol, _sol_trace);
+        
+        if (small_dist_sol)
+            _trace->localize(*small_dist_sol, _dsol_trace);
+        else
+            _dsol_trace.clear();
+        
+        _memory.set((_sol_trace.size() + _dsol_trace.size()) * sizeof(Real));
+        
+        return;
+    }
+    
     // first initialize the solution to the given vector
     // steady state solution
     _sol.reset(libMesh::NumericVector<Real>::build(sys.comm()).release());
@@ -98,7 +131,9 @@ init(const libMesh::NumericVector<Real>& steady_sol,
         _dsol.reset();
         _dsol_function.reset();
     }
-        
+    
+    _memory.set(MAST::MemoryLog::bytes(*_sol) +
+                (_dsol.get()? MAST::MemoryLog::bytes(*_dsol) : 0));
 }
 
 
@@ -112,7 +147,8 @@ operator() (const libMesh::Point& p,
             Real                  &press) const {
     
     
-    libmesh_assert(_sol_function.get()); // should be initialized before this call
+    // should be initialized before this call
+    libmesh_assert(_sol_function.get() || _sol_trace.size());
     
     press  = 0.;
     
@@ -126,8 +162,13 @@ operator() (const libMesh::Point& p,
     
     
     // now the steady state function itself
-    (*_sol_function)(p, 0., v);
-    MAST::copy(sol, v);
+    if (_trace.get())
+        _trace->interpolate(p, _sol_trace, sol);
+    else {
+        
+        (*_sol_function)(p, 0., v);
+        MAST::copy(sol, v);
+    }
     
     
     MAST::PrimitiveSolution                     p_sol;
@@ -156,8 +197,9 @@ perturbation(const libMesh::Point& p,
              Real                  &dpress) const {
     
     
-    libmesh_assert(_sol_function.get()); // should be initialized before this call
-    libmesh_assert(_dsol_function.get()); // should be initialized before this call
+    // should be initialized before this call
+    libmesh_assert(_sol_function.get()  || _sol_trace.size());
+    libmesh_assert(_dsol_function.get() || _dsol_trace.size());
     
     dpress = 0.;
     
@@ -171,14 +213,22 @@ perturbation(const libMesh::Point& p,
     dsol   = RealVectorX::Zero(_system.system().n_vars());
     
     
-    // first copy the real and imaginary solutions
-    (*_dsol_function)(p, 0., v);
-    MAST::copy(sol, v);
-    dsol = sol;
-    
-    // now the steady state function itself
-    (*_sol_function)(p, 0., v);
-    MAST::copy(sol, v);
+    if (_trace.get()) {
+        
+        _trace->interpolate(p, _dsol_trace, dsol);
+        _trace->interpolate(p,  _sol_trace,  sol);
+    }
+    else {
+        
+        // first copy the real and imaginary solutions
+        (*_dsol_function)(p, 0., v);
+        MAST::copy(sol, v);
+        dsol = sol;
+        
+        // now the steady state function itself
+        (*_sol_function)(p, 0., v);
+        MAST::copy(sol, v);
+    }
     
     
     MAST::PrimitiveSolution                     p_sol;
@@ -22,8 +22,13 @@
 #define __mast__pressure_function_h__
 
 
+// C++ includes
+#include <set>
+
+
 // MAST includes
 #include "base/field_function_base.h"
+#include "base/memory_log.h"
 
 
 // libMesh includes
@@ -37,6 +42,7 @@ namespace MAST {
     class FrequencyFunction;
     class SystemInitialization;
     class FlightCondition;
+    class BoundaryTraceInterpolation;
     
     
     class PressureFunction:
@@ -72,6 +78,16 @@ namespace MAST {
         }
 
         
+        /*!
+         *   restricts the evaluation of pressure to points on the fluid
+         *   boundaries with ids in \p bids. With this option init() localizes
+         *   only the dofs of elements on these boundaries, and no mesh
+         *   function is created over the fluid domain. This must be called
+         *   before init().
+         */
+        void use_boundary_trace(const std::set<libMesh::boundary_id_type>& bids);
+        
+        
         /*!
          *   initiate the mesh function for this solution
          */
@@ -140,6 +156,24 @@ namespace MAST {
          *   small-disturbance solution
          */
         std::auto_ptr<libMesh::NumericVector<Real> > _dsol;
+        
+        /*!
+         *   interpolation on the boundary trace, if requested by
+         *   use_boundary_trace()
+         */
+        std::auto_ptr<MAST::BoundaryTraceInterpolation> _trace;
+        
+        /*!
+         *   steady and small-disturbance solutions on the boundary trace
+         */
+        std::vector<Real>
+        _sol_trace,
+        _dsol_trace;
+        
+        /*!
+         *   memory held by the localized solutions
+         */
+        MAST::MemoryAccount _memory;
     };
 }
 
@@ -18,79 +18,165 @@
  */
 
 
+// C++ includes
+#include <algorithm>
+
 // MAST includes
 #include "numerics/lapack_dggev_interface.h"
 
 
+void
+MAST::LAPACK_DGGEV::Workspace::init(int n_in, bool computeEigenvectors) {
+    
+    libmesh_assert_greater(n_in, 0);
+    
+    if (n == n_in && if_vecs == computeEigenvectors)
+        return;
+    
+    n       = n_in;
+    if_vecs = computeEigenvectors;
+    
+    a.setZero(n, n);
+    b.setZero(n, n);
+    aval_r.setZero(n);
+    aval_i.setZero(n);
+    bval.setZero(n);
+    
+    if (computeEigenvectors) {
+        vecl.setZero(n, n);
+        vecr.setZero(n, n);
+    }
+    else {
+        vecl.resize(0, 0);
+        vecr.resize(0, 0);
+    }
+    
+    // workspace query for the optimal size of work. The eigenvalue and
+    // eigenvector arrays are not referenced by the query.
+    char L='N',R='N';
+    if (computeEigenvectors) {
+        L = 'V'; R = 'V';
+    }
+    
+    int
+    query    = -1,
+    info     = -1;
+    
+    Real
+    lwork_val = 0.;
+    
+    dggev_(&L, &R, &n,
+           a.data(), &n,
+           b.data(), &n,
+           aval_r.data(), aval_i.data(), bval.data(),
+           a.data(), &n, a.data(), &n,
+           &lwork_val, &query,
+           &info);
+    
+    lwork = std::max((int)lwork_val, 8*n);
+    work.setZero(lwork);
+}
+
+
+
+std::size_t
+MAST::LAPACK_DGGEV::Workspace::bytes() const {
+    
+    return (MAST::MemoryLog::bytes(a)      +
+            MAST::MemoryLog::bytes(b)      +
+            MAST::MemoryLog::bytes(vecl)   +
+            MAST::MemoryLog::bytes(vecr)   +
+            MAST::MemoryLog::bytes(work)   +
+            3 * MAST::MemoryLog::bytes(bval));
+}
+
+
+
 void
 MAST::LAPACK_DGGEV::compute(const RealMatrixX &A,
                             const RealMatrixX &B,
                             bool computeEigenvectors) {
     
+    _workspace.init((int)A.cols(), computeEigenvectors);
+    
+    this->_compute(A, B, _workspace, computeEigenvectors);
+    
+    _update_memory();
+    _workspace_memory.set(_workspace.bytes());
+    
+    if (info_val  != 0)
+        libMesh::out
+        << "Warning!!  DGGEV returned with nonzero info = "
+        << info_val << std::endl;
+}
+
+
+
+void
+MAST::LAPACK_DGGEV::clear_workspace() {
+    
+    _workspace = MAST::LAPACK_DGGEV::Workspace();
+    _workspace_memory.clear();
+}
+
+
+
+void
+MAST::LAPACK_DGGEV::_compute(const RealMatrixX &A,
+                             const RealMatrixX &B,
+                             MAST::LAPACK_DGGEV::Workspace& ws,
+                             bool computeEigenvectors) {
+    
     libmesh_assert(A.cols() == A.rows() &&
                    B.cols() == A.rows() &&
                    B.cols() == B.rows());
+    libmesh_assert_equal_to(ws.n, A.cols());
+    libmesh_assert_equal_to(ws.if_vecs, computeEigenvectors);
     
-    _A = A;
-    _B = B;
-    
-    RealMatrixX
-    Amat = A,
-    Bmat = B;
+    // the matrices are copied to the workspace, since they are
+    // overwritten by LAPACK. Only B is retained, for the scaling of the
+    // eigenvectors. The copies are assigned to matrices of the same size,
+    // which does not allocate memory after the first call.
+    _B   = B;
+    ws.a = A;
+    ws.b = B;
     
-    int n = (int)A.cols();
+    int n = ws.n;
     
     char L='N',R='N';
     
     if (computeEigenvectors) {
         
         L = 'V'; R = 'V';
-        VL.setZero(n, n);
-        VR.setZero(n, n);
+        VL.resize(n, n);
+        VR.resize(n, n);
     }
     
-    int
-    lwork=16*n;
-    
     info_val=-1;
     
-    alpha.setZero(n);
-    beta.setZero(n);
+    alpha.resize(n);
+    beta.resize(n);
     
     RealVectorX
-    work,
-    aval_r,
-    aval_i,
-    bval;
+    &aval_r = ws.aval_r,
+    &aval_i = ws.aval_i,
+    &bval   = ws.bval;
     
     RealMatrixX
-    vecl,
-    vecr;
-    
-    work.setZero(lwork);
-    aval_r.setZero(n);
-    aval_i.setZero(n);
-    bval.setZero(n);
-    vecl.setZero(n,n);
-    vecr.setZero(n,n);
+    &vecl   = ws.vecl,
+    &vecr   = ws.vecr;
     
+    // vecl and vecr are not referenced if the eigenvectors are not computed
     Real
-    *a_vals    = Amat.data(),
-    *b_vals    = Bmat.data(),
-    *alpha_r_v = aval_r.data(),
-    *alpha_i_v = aval_i.data(),
-    *beta_v    = bval.data(),
-    *vecl_v    = vecl.data(),
-    *vecr_v    = vecr.data(),
-    *work_v    = work.data();
+    *vecl_v    = computeEigenvectors? vecl.data(): ws.a.data(),
+    *vecr_v    = computeEigenvectors? vecr.data(): ws.a.data();
     
-        
     dggev_(&L, &R, &n,
-           &(a_vals[0]), &n,
-           &(b_vals[0]), &n,
-           &(alpha_r_v[0]), &(alpha_i_v[0]), &(beta_v[0]),
-           &(vecl_v[0]), &n, &(vecr_v[0]), &n,
-           &(work_v[0]), &lwork,
+           ws.a.data(), &n,
+           ws.b.data(), &n,
+           aval_r.data(), aval_i.data(), bval.data(),
+           vecl_v, &n, vecr_v, &n,
+           ws.work.data(), &ws.lwork,
            &info_val);
     
     // now sort the eigenvalues for complex conjugates
@@ -140,11 +226,6 @@ MAST::LAPACK_DGGEV::compute(const RealMatrixX &A,
             n_located++;
         }
     }
-    
-    if (info_val  != 0)
-        libMesh::out
-        << "Warning!!  DGGEV returned with nonzero info = "
-        << info_val << std::endl;
 }
 
 
@@ -23,6 +23,7 @@
 
 // MAST includes
 #include "base/mast_data_types.h"
+#include "base/memory_log.h"
 
 
 extern "C" {
@@ -176,31 +177,90 @@ extern "C" {
 
 namespace MAST {
     
+    // Forward declerations
+    template <typename SolverType> class LAPACK_GGEV_Batch;
+    
     
     class LAPACK_DGGEV{
         
     public:
         
+        /*!
+         *   type of the matrices of the pencil
+         */
+        typedef RealMatrixX MatrixType;
+        
+        
+        /*!
+         *   work arrays for dggev_. These are sized by a workspace query
+         *   for the order of the pencil, and are reused without any
+         *   allocation for all pencils of the same order.
+         */
+        class Workspace {
+            
+        public:
+            
+            Workspace():
+            n(0),
+            if_vecs(false),
+            lwork(0)
+            { }
+            
+            /*!
+             *   sizes the arrays for pencils of order \p n_in. Nothing is
+             *   done if the arrays already have this size.
+             */
+            void init(int n_in, bool computeEigenvectors);
+            
+            /*!
+             *   @returns the bytes of the arrays
+             */
+            std::size_t bytes() const;
+            
+            int            n;
+            bool           if_vecs;
+            int            lwork;
+            
+            /*!
+             *   copies of the matrices, which are overwritten by dggev_,
+             *   and the real eigenvectors before their conversion to
+             *   complex vectors
+             */
+            RealMatrixX    a, b, vecl, vecr;
+            
+            RealVectorX    work, aval_r, aval_i, bval;
+        };
+        
+        
         LAPACK_DGGEV():
-        info_val(-1)
+        info_val(-1),
+        _workspace_memory(MAST::MEMORY_EIGEN_SOLVER),
+        _memory(MAST::MEMORY_EIGEN_SOLVER)
         { }
         
         /*!
-         *    computes the eigensolution for A x = \lambda B x. A & B will be
-         *    overwritten
+         *    computes the eigensolution for A x = \lambda B x. A and B are
+         *    left intact, and are copied once into the workspace of this
+         *    object, which is reused for repeated calls with matrices of
+         *    the same size.
          */
         void compute(const RealMatrixX& A,
                      const RealMatrixX& B,
                      bool computeEigenvectors = true);
         
-        ComputationInfo info() const;
-        
-        const RealMatrixX& A() const {
-            libmesh_assert(info_val == 0);
-            return this->_A;
-        }
+        /*!
+         *    releases the workspace used by compute(). The solution is
+         *    retained.
+         */
+        void clear_workspace();
         
+        ComputationInfo info() const;
         
+        /*!
+         *    @returns the matrix B of the pencil, which is retained for
+         *    the scaling of the eigenvectors. The matrix A is not
+         *    retained.
+         */
         const RealMatrixX& B() const {
             libmesh_assert(info_val == 0);
             return this->_B;
@@ -235,23 +295,26 @@ namespace MAST {
         void scale_eigenvectors_to_identity_innerproduct() {
             libmesh_assert(info_val == 0);
             
-            // this product should be an identity matrix
-            ComplexMatrixX r = this->VL.conjugate().transpose() * _B * this->VR;
-            
-            // scale the right eigenvectors by the inverse of the inner-product
-            // diagonal
+            // scale the right eigenvectors by the inverse of the diagonal
+            // of the inner-product, which is computed one column at a time
+            // without the rest of the product
             Complex val;
             for (unsigned int i=0; i<_B.cols(); i++) {
-                val = r(i,i);
+                val = this->VL.col(i).dot(_B * this->VR.col(i));
                 if (std::abs(val) > 0.)
                     this->VR.col(i) *= (1./val);
             }
         }
         
-        void print_inner_product(std::ostream& out) const {
+        /*!
+         *    writes the inner products of the eigenvectors with \p A,
+         *    which should be the matrix A of the last pencil, and with B
+         */
+        void print_inner_product(const RealMatrixX& A,
+                                 std::ostream& out) const {
             libmesh_assert(info_val == 0);
             ComplexMatrixX r;
-            r = this->VL.conjugate().transpose() * _A * this->VR;
+            r = this->VL.conjugate().transpose() * A * this->VR;
             out << "conj(VL)' * A * VR" << std::endl
             << r << std::endl;
             
@@ -263,7 +326,18 @@ namespace MAST {
         
     protected:
         
-        RealMatrixX    _A;
+        friend class MAST::LAPACK_GGEV_Batch<MAST::LAPACK_DGGEV>;
+        
+        /*!
+         *    computes the eigensolution with the workspace \p ws, which
+         *    should be initialized for the size of the matrices. The memory
+         *    account is not updated, so that this can be called
+         *    concurrently for different objects and workspaces.
+         */
+        void _compute(const RealMatrixX& A,
+                      const RealMatrixX& B,
+                      MAST::LAPACK_DGGEV::Workspace& ws,
+                      bool computeEigenvectors);
         
         RealMatrixX    _B;
         
@@ -276,6 +350,39 @@ namespace MAST {
         RealVectorX    beta;
         
         int info_val;
+        
+        
+        /*!
+         *   updates the memory account with the storage of the matrix B
+         *   and the solution, which are held until the next call to
+         *   compute(). The workspace is accounted separately.
+         */
+        void _update_memory() {
+            
+            _memory.set(MAST::MemoryLog::bytes(_B)    +
+                        MAST::MemoryLog::bytes(VL)    +
+                        MAST::MemoryLog::bytes(VR)    +
+                        MAST::MemoryLog::bytes(alpha) +
+                        MAST::MemoryLog::bytes(beta));
+        }
+        
+        
+        /*!
+         *   workspace used by compute()
+         */
+        MAST::LAPACK_DGGEV::Workspace _workspace;
+        
+        
+        /*!
+         *   memory of the workspace
+         */
+        MAST::MemoryAccount _workspace_memory;
+        
+        
+        /*!
+         *   memory of the matrices and the solution
+         */
+        MAST::MemoryAccount _memory;
     };
     
 }
@@ -0,0 +1,202 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2017  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+// C++ includes
+#include <algorithm>
+
+// MAST includes
+#include "numerics/lapack_ggev_batch.h"
+#include "numerics/lapack_zggev_interface.h"
+#include "numerics/lapack_zggevx_interface.h"
+#include "numerics/lapack_dggev_interface.h"
+#include "base/performance_log.h"
+
+// libMesh includes
+#include "libmesh/threads.h"
+
+
+template <typename SolverType>
+MAST::LAPACK_GGEV_Batch<SolverType>::LAPACK_GGEV_Batch():
+_if_threaded(false),
+_A(nullptr),
+_B(nullptr),
+_if_vecs(true),
+_if_scale(true),
+_chunk_size(0),
+_memory(MAST::MEMORY_EIGEN_SOLVER) {
+    
+}
+
+
+
+template <typename SolverType>
+MAST::LAPACK_GGEV_Batch<SolverType>::~LAPACK_GGEV_Batch() {
+    
+    this->clear();
+}
+
+
+
+template <typename SolverType>
+void
+MAST::LAPACK_GGEV_Batch<SolverType>::clear() {
+    
+    for (unsigned int i=0; i<_solvers.size(); i++)
+        delete _solvers[i];
+    
+    _solvers.clear();
+    _workspaces.clear();
+    _memory.clear();
+}
+
+
+
+template <typename SolverType>
+void
+MAST::LAPACK_GGEV_Batch<SolverType>::compute(const std::vector<MatrixType>& A,
+                                             const std::vector<MatrixType>& B,
+                                             bool computeEigenvectors,
+                                             bool scaleEigenvectors) {
+    
+    MAST_LOG_SCOPE("LAPACK_GGEV_Batch::compute");
+    
+    libmesh_assert_equal_to(A.size(), B.size());
+    libmesh_assert(!scaleEigenvectors || computeEigenvectors);
+    
+    const unsigned int
+    n_pencils = (unsigned int)A.size();
+    
+    // the solvers of the previous batch are reused, which also reuses the
+    // storage of their solutions
+    for (unsigned int i=n_pencils; i<_solvers.size(); i++)
+        delete _solvers[i];
+    
+    const unsigned int
+    n_old     = (unsigned int)std::min(_solvers.size(), A.size());
+    
+    _solvers.resize(n_pencils);
+    for (unsigned int i=n_old; i<n_pencils; i++)
+        _solvers[i] = new SolverType;
+    
+    if (!n_pencils) {
+        
+        _workspaces.clear();
+        _memory.clear();
+        return;
+    }
+    
+    // one chunk for each thread
+    unsigned int
+    n_chunks = _if_threaded? std::min(libMesh::n_threads(), n_pencils): 1;
+    
+    _chunk_size = (n_pencils + n_chunks - 1)/n_chunks;
+    n_chunks    = (n_pencils + _chunk_size - 1)/_chunk_size;
+    
+    // the workspaces are sized here, since the workspace query and the
+    // memory account should not be used from multiple threads
+    const int
+    n = (int)A[0].cols();
+    
+    _workspaces.resize(n_chunks);
+    
+    std::size_t
+    bytes = 0;
+    
+    for (unsigned int c=0; c<n_chunks; c++) {
+        
+        _workspaces[c].init(n, computeEigenvectors);
+        bytes += _workspaces[c].bytes();
+    }
+    
+    _memory.set(bytes);
+    
+    _A        = &A;
+    _B        = &B;
+    _if_vecs  = computeEigenvectors;
+    _if_scale = scaleEigenvectors;
+    
+    if (n_chunks > 1)
+        libMesh::Threads::parallel_for
+        (libMesh::Threads::BlockedRange<unsigned int>(0, n_chunks, 1),
+         MAST::LAPACK_GGEV_Batch<SolverType>::ChunkBody(*this));
+    else
+        this->_compute_chunk(0, 0, n_pencils);
+    
+    _A        = nullptr;
+    _B        = nullptr;
+    
+    for (unsigned int i=0; i<n_pencils; i++) {
+        
+        _solvers[i]->_update_memory();
+        
+        if (_solvers[i]->info_val != 0)
+            libMesh::out
+            << "Warning!!  Generalized eigensolution of pencil " << i
+            << " returned with nonzero info = "
+            << _solvers[i]->info_val << std::endl;
+    }
+    
+    MAST_LOG_COUNT("ggev_pencils", n_pencils);
+}
+
+
+
+template <typename SolverType>
+void
+MAST::LAPACK_GGEV_Batch<SolverType>::_compute_chunk(unsigned int c,
+                                                    unsigned int i0,
+                                                    unsigned int i1) {
+    
+    libmesh_assert_less(c, _workspaces.size());
+    
+    for (unsigned int i=i0; i<i1; i++) {
+        
+        libmesh_assert_equal_to((*_A)[i].cols(), _workspaces[c].n);
+        
+        _solvers[i]->_compute((*_A)[i], (*_B)[i], _workspaces[c], _if_vecs);
+        
+        if (_if_scale && _solvers[i]->info_val == 0)
+            _solvers[i]->scale_eigenvectors_to_identity_innerproduct();
+    }
+}
+
+
+
+template <typename SolverType>
+void
+MAST::LAPACK_GGEV_Batch<SolverType>::ChunkBody::
+operator() (const libMesh::Threads::BlockedRange<unsigned int>& range) const {
+    
+    const unsigned int
+    n_pencils = (unsigned int)_batch._solvers.size();
+    
+    for (unsigned int c=range.begin(); c<range.end(); c++)
+        _batch._compute_chunk(c,
+                              c*_batch._chunk_size,
+                              std::min((c+1)*_batch._chunk_size, n_pencils));
+}
+
+
+
+// explicit instantiations
+template class MAST::LAPACK_GGEV_Batch<MAST::LAPACK_ZGGEV>;
+template class MAST::LAPACK_GGEV_Batch<MAST::LAPACK_ZGGEVX>;
+template class MAST::LAPACK_GGEV_Batch<MAST::LAPACK_DGGEV>;
+
@@ -0,0 +1,179 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2017  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#ifndef __mast__lapack_ggev_batch_h__
+#define __mast__lapack_ggev_batch_h__
+
+// C++ includes
+#include <vector>
+
+// MAST includes
+#include "base/mast_data_types.h"
+#include "base/memory_log.h"
+
+
+namespace libMesh {
+    namespace Threads {
+        template <typename T> class BlockedRange;
+    }
+}
+
+
+namespace MAST {
+    
+    /*!
+     *   Computes the generalized eigensolutions of a batch of pencils of
+     *   the same order, with one of MAST::LAPACK_ZGGEV, MAST::LAPACK_ZGGEVX
+     *   or MAST::LAPACK_DGGEV as \p SolverType. The LAPACK workspace is
+     *   sized with a single workspace query and reused for all pencils
+     *   and for subsequent batches of the same order, and the right
+     *   eigenvectors are optionally scaled to unit inner product with
+     *   the B matrix.
+     *
+     *   The pencils can be solved concurrently with the libMesh threads,
+     *   as set by \p --n_threads. The batch is then divided in one
+     *   contiguous chunk per thread, each with its own workspace. This
+     *   requires a LAPACK library that is safe to call from multiple
+     *   threads, and should be combined with a single threaded BLAS.
+     */
+    template <typename SolverType>
+    class LAPACK_GGEV_Batch {
+        
+    public:
+        
+        typedef typename SolverType::MatrixType MatrixType;
+        
+        LAPACK_GGEV_Batch();
+        
+        virtual ~LAPACK_GGEV_Batch();
+        
+        
+        /*!
+         *   sets the flag to solve the pencils concurrently with the
+         *   libMesh threads. This is false by default.
+         */
+        void set_threaded(bool f) {
+            _if_threaded = f;
+        }
+        
+        
+        /*!
+         *    computes the eigensolutions for \f$ A_i x = \lambda B_i x \f$
+         *    for all pencils, which should be of the same order. If
+         *    \p scaleEigenvectors is true, the right eigenvectors are scaled
+         *    so that \f$ VL^* B VR = I \f$ for the pencils with a
+         *    successful solution.
+         */
+        void compute(const std::vector<MatrixType>& A,
+                     const std::vector<MatrixType>& B,
+                     bool computeEigenvectors = true,
+                     bool scaleEigenvectors   = true);
+        
+        
+        /*!
+         *   @returns the number of pencils in the last batch
+         */
+        unsigned int size() const {
+            return (unsigned int)_solvers.size();
+        }
+        
+        
+        /*!
+         *   @returns the solver with the solution of the \p i^th pencil
+         */
+        const SolverType& solver(unsigned int i) const {
+            
+            libmesh_assert_less(i, _solvers.size());
+            return *_solvers[i];
+        }
+        
+        
+        /*!
+         *   clears the solutions and the workspace
+         */
+        void clear();
+        
+        
+    protected:
+        
+        /*!
+         *   computes the eigensolutions for the pencils in \p [i0, i1)
+         *   with the workspace of chunk \p c
+         */
+        void _compute_chunk(unsigned int c,
+                            unsigned int i0,
+                            unsigned int i1);
+        
+        
+        /*!
+         *   executes _compute_chunk() for a range of chunks in a thread
+         */
+        class ChunkBody {
+            
+        public:
+            
+            ChunkBody(MAST::LAPACK_GGEV_Batch<SolverType>& batch):
+            _batch(batch)
+            { }
+            
+            void operator() (const libMesh::Threads::BlockedRange<unsigned int>& range) const;
+            
+        protected:
+            
+            MAST::LAPACK_GGEV_Batch<SolverType>& _batch;
+        };
+        
+        
+        /*!
+         *   flag to solve the pencils concurrently
+         */
+        bool _if_threaded;
+        
+        
+        /*!
+         *   solution of each pencil
+         */
+        std::vector<SolverType*> _solvers;
+        
+        
+        /*!
+         *   one workspace for each chunk of the batch
+         */
+        std::vector<typename SolverType::Workspace> _workspaces;
+        
+        
+        /*!
+         *   matrices, flags and chunk size of the batch being computed
+         */
+        const std::vector<MatrixType> *_A, *_B;
+        bool _if_vecs, _if_scale;
+        unsigned int _chunk_size;
+        
+        
+        /*!
+         *   memory of the workspaces. The solutions are accounted by the
+         *   solvers.
+         */
+        MAST::MemoryAccount _memory;
+    };
+}
+
+
+#endif // __mast__lapack_ggev_batch_h__
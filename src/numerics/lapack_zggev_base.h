@@ -23,34 +23,49 @@
 
 // MAST includes
 #include "base/mast_data_types.h"
+#include "base/memory_log.h"
 
 
 
 
 namespace MAST {
     
+    // Forward declerations
+    template <typename SolverType> class LAPACK_GGEV_Batch;
+    
+    
     class LAPACK_ZGGEV_Base{
         
     public:
         
+        /*!
+         *   type of the matrices of the pencil
+         */
+        typedef ComplexMatrixX MatrixType;
+        
+        
         LAPACK_ZGGEV_Base():
-        info_val(-1)
+        info_val(-1),
+        _memory(MAST::MEMORY_EIGEN_SOLVER)
         { }
         
+        virtual ~LAPACK_ZGGEV_Base() { }
+        
+        
         /*!
-         *    computes the eigensolution for A x = \lambda B x. A & B will be
-         *    overwritten
+         *    computes the eigensolution for A x = \lambda B x. A and B are
+         *    left intact. They are copied once into the workspace of this
+         *    object, which is overwritten by LAPACK.
          */
         virtual void compute(const ComplexMatrixX& A,
                              const ComplexMatrixX& B,
                              bool computeEigenvectors = true) = 0;
         
-        const ComplexMatrixX& A() const {
-            libmesh_assert(info_val == 0);
-            return this->_A;
-        }
-        
-        
+        /*!
+         *    @returns the matrix B of the pencil, which is retained for
+         *    the scaling of the eigenvectors. The matrix A is not
+         *    retained.
+         */
         const ComplexMatrixX& B() const {
             libmesh_assert(info_val == 0);
             return this->_B;
@@ -85,23 +100,26 @@ namespace MAST {
         void scale_eigenvectors_to_identity_innerproduct() {
             libmesh_assert(info_val == 0);
             
-            // this product should be an identity matrix
-            ComplexMatrixX r = this->VL.conjugate().transpose() * _B * this->VR;
-            
-            // scale the right eigenvectors by the inverse of the inner-product
-            // diagonal
+            // scale the right eigenvectors by the inverse of the diagonal
+            // of the inner-product, which is computed one column at a time
+            // without the rest of the product
             Complex val;
             for (unsigned int i=0; i<_B.cols(); i++) {
-                val = r(i,i);
+                val = this->VL.col(i).dot(_B * this->VR.col(i));
                 if (std::abs(val) > 0.)
                     this->VR.col(i) *= (1./val);
             }
         }
         
-        void print_inner_product(std::ostream& out) const {
+        /*!
+         *    writes the inner products of the eigenvectors with \p A,
+         *    which should be the matrix A of the last pencil, and with B
+         */
+        void print_inner_product(const ComplexMatrixX& A,
+                                 std::ostream& out) const {
             libmesh_assert(info_val == 0);
             ComplexMatrixX r;
-            r = this->VL.conjugate().transpose() * _A * this->VR;
+            r = this->VL.conjugate().transpose() * A * this->VR;
             out << "conj(VL)' * A * VR" << std::endl
             << r << std::endl;
             
@@ -113,8 +131,6 @@ namespace MAST {
         
     protected:
         
-        ComplexMatrixX _A;
-        
         ComplexMatrixX _B;
         
         ComplexMatrixX VL;
@@ -126,6 +142,27 @@ namespace MAST {
         ComplexVectorX beta;
         
         int info_val;
+        
+        
+        /*!
+         *   updates the memory account with the storage of the matrix B
+         *   and the solution, which are held until the next call to
+         *   compute(). The workspace is accounted separately.
+         */
+        void _update_memory() {
+            
+            _memory.set(MAST::MemoryLog::bytes(_B)    +
+                        MAST::MemoryLog::bytes(VL)    +
+                        MAST::MemoryLog::bytes(VR)    +
+                        MAST::MemoryLog::bytes(alpha) +
+                        MAST::MemoryLog::bytes(beta));
+        }
+        
+        
+        /*!
+         *   memory of the matrices and the solution
+         */
+        MAST::MemoryAccount _memory;
     };
 }
 
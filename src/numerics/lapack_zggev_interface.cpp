@@ -18,75 +18,145 @@
  */
 
 
+// C++ includes
+#include <algorithm>
+
 // MAST includes
 #include "numerics/lapack_zggev_interface.h"
 
 
+void
+MAST::LAPACK_ZGGEV::Workspace::init(int n_in, bool computeEigenvectors) {
+    
+    libmesh_assert_greater(n_in, 0);
+    
+    if (n == n_in && if_vecs == computeEigenvectors)
+        return;
+    
+    n       = n_in;
+    if_vecs = computeEigenvectors;
+    
+    a.setZero(n, n);
+    b.setZero(n, n);
+    rwork.setZero(8*n);
+    
+    // workspace query for the optimal size of work. The eigenvalue and
+    // eigenvector arrays are not referenced by the query.
+    char L='N',R='N';
+    if (computeEigenvectors) {
+        L = 'V'; R = 'V';
+    }
+    
+    int
+    query    = -1,
+    info     = -1;
+    
+    Complex
+    lwork_val = 0.;
+    
+    zggev_(&L, &R, &n,
+           a.data(), &n,
+           b.data(), &n,
+           a.data(), a.data(),
+           a.data(), &n, a.data(), &n,
+           &lwork_val, &query,
+           rwork.data(),
+           &info);
+    
+    lwork = std::max((int)lwork_val.real(), 2*n);
+    work.setZero(lwork);
+}
+
+
+
+std::size_t
+MAST::LAPACK_ZGGEV::Workspace::bytes() const {
+    
+    return (MAST::MemoryLog::bytes(a)    +
+            MAST::MemoryLog::bytes(b)    +
+            MAST::MemoryLog::bytes(work) +
+            MAST::MemoryLog::bytes(rwork));
+}
+
+
+
 void
 MAST::LAPACK_ZGGEV::compute(const ComplexMatrixX &A,
                             const ComplexMatrixX &B,
                             bool computeEigenvectors) {
     
+    _workspace.init((int)A.cols(), computeEigenvectors);
+    
+    this->_compute(A, B, _workspace, computeEigenvectors);
+    
+    _update_memory();
+    _workspace_memory.set(_workspace.bytes());
+    
+    if (info_val  != 0)
+        libMesh::out
+        << "Warning!!  ZGGEV returned with nonzero info = "
+        << info_val << std::endl;
+}
+
+
+
+void
+MAST::LAPACK_ZGGEV::clear_workspace() {
+    
+    _workspace = MAST::LAPACK_ZGGEV::Workspace();
+    _workspace_memory.clear();
+}
+
+
+
+void
+MAST::LAPACK_ZGGEV::_compute(const ComplexMatrixX &A,
+                             const ComplexMatrixX &B,
+                             MAST::LAPACK_ZGGEV::Workspace& ws,
+                             bool computeEigenvectors) {
+    
     libmesh_assert(A.cols() == A.rows() &&
                    B.cols() == A.rows() &&
                    B.cols() == B.rows());
+    libmesh_assert_equal_to(ws.n, A.cols());
+    libmesh_assert_equal_to(ws.if_vecs, computeEigenvectors);
     
-    _A = A;
-    _B = B;
-    
-    ComplexMatrixX
-    Amat = _A,
-    Bmat = _B;
+    // the matrices are copied to the workspace, since they are
+    // overwritten by LAPACK. Only B is retained, for the scaling of the
+    // eigenvectors. The copies are assigned to matrices of the same size,
+    // which does not allocate memory after the first call.
+    _B   = B;
+    ws.a = A;
+    ws.b = B;
     
-    int n = (int)A.cols();
+    int n = ws.n;
     
     char L='N',R='N';
     
     if (computeEigenvectors)
     {
         L = 'V'; R = 'V';
-        VL.setZero(n, n);
-        VR.setZero(n, n);
+        VL.resize(n, n);
+        VR.resize(n, n);
     }
     
-    int
-    lwork=16*n,
-    l_rwork=8*n;
     info_val=-1;
     
-    alpha.setZero(n);
-    beta.setZero(n);
-    ComplexVectorX
-    work  = ComplexVectorX::Zero(lwork);
-    RealVectorX
-    rwork = RealVectorX::Zero(l_rwork);
+    alpha.resize(n);
+    beta.resize(n);
     
+    // VL and VR are not referenced if the eigenvectors are not computed
     Complex
-    *a_vals     = Amat.data(),
-    *b_vals     = Bmat.data(),
-    *alpha_v    = alpha.data(),
-    *beta_v     = beta.data(),
-    *VL_v       = VL.data(),
-    *VR_v       = VR.data(),
-    *work_v     = work.data();
-    
-    Real
-    *rwork_v    = rwork.data();
-    
+    *VL_v       = computeEigenvectors? VL.data(): ws.a.data(),
+    *VR_v       = computeEigenvectors? VR.data(): ws.a.data();
     
     zggev_(&L, &R, &n,
-           &(a_vals[0]), &n,
-           &(b_vals[0]), &n,
-           &(alpha_v[0]), &(beta_v[0]),
-           &(VL_v[0]), &n, &(VR_v[0]), &n,
-           &(work_v[0]), &lwork,
-           &(rwork_v[0]),
+           ws.a.data(), &n,
+           ws.b.data(), &n,
+           alpha.data(), beta.data(),
+           VL_v, &n, VR_v, &n,
+           ws.work.data(), &ws.lwork,
+           ws.rwork.data(),
            &info_val);
-    
-    if (info_val  != 0)
-        libMesh::out
-        << "Warning!!  ZGGEV returned with nonzero info = "
-        << info_val << std::endl;
 }
 
-
@@ -172,18 +172,93 @@ namespace MAST {
         
     public:
         
+        /*!
+         *   work arrays for zggev_. These are sized by a workspace query
+         *   for the order of the pencil, and are reused without any
+         *   allocation for all pencils of the same order.
+         */
+        class Workspace {
+            
+        public:
+            
+            Workspace():
+            n(0),
+            if_vecs(false),
+            lwork(0)
+            { }
+            
+            /*!
+             *   sizes the arrays for pencils of order \p n_in. Nothing is
+             *   done if the arrays already have this size.
+             */
+            void init(int n_in, bool computeEigenvectors);
+            
+            /*!
+             *   @returns the bytes of the arrays
+             */
+            std::size_t bytes() const;
+            
+            int            n;
+            bool           if_vecs;
+            int            lwork;
+            
+            /*!
+             *   copies of the matrices, which are overwritten by zggev_
+             */
+            ComplexMatrixX a, b;
+            
+            ComplexVectorX work;
+            RealVectorX    rwork;
+        };
+        
+        
         LAPACK_ZGGEV():
-        MAST::LAPACK_ZGGEV_Base()
+        MAST::LAPACK_ZGGEV_Base(),
+        _workspace_memory(MAST::MEMORY_EIGEN_SOLVER)
         { }
         
         /*!
-         *    computes the eigensolution for A x = \lambda B x. A & B will be
-         *    overwritten
+         *    computes the eigensolution for A x = \lambda B x. A and B are
+         *    left intact, and are copied once into the workspace of this
+         *    object, which is reused for repeated calls with matrices of
+         *    the same size.
          */
         virtual void compute(const ComplexMatrixX& A,
                              const ComplexMatrixX& B,
                              bool computeEigenvectors = true);
         
+        /*!
+         *    releases the workspace used by compute(). The solution is
+         *    retained.
+         */
+        void clear_workspace();
+        
+        
+    protected:
+        
+        friend class MAST::LAPACK_GGEV_Batch<MAST::LAPACK_ZGGEV>;
+        
+        /*!
+         *    computes the eigensolution with the workspace \p ws, which
+         *    should be initialized for the size of the matrices. The memory
+         *    account is not updated, so that this can be called
+         *    concurrently for different objects and workspaces.
+         */
+        void _compute(const ComplexMatrixX& A,
+                      const ComplexMatrixX& B,
+                      MAST::LAPACK_ZGGEV::Workspace& ws,
+                      bool computeEigenvectors);
+        
+        /*!
+         *   workspace used by compute()
+         */
+        MAST::LAPACK_ZGGEV::Workspace _workspace;
+        
+        
+        /*!
+         *   memory of the workspace
+         */
+        MAST::MemoryAccount _workspace_memory;
     };
 }
 
@@ -18,99 +18,181 @@
  */
 
 
+// C++ includes
+#include <algorithm>
+
 // MAST includes
 #include "numerics/lapack_zggevx_interface.h"
 
 
+void
+MAST::LAPACK_ZGGEVX::Workspace::init(int n_in, bool computeEigenvectors) {
+    
+    libmesh_assert_greater(n_in, 0);
+    
+    if (n == n_in && if_vecs == computeEigenvectors)
+        return;
+    
+    n       = n_in;
+    if_vecs = computeEigenvectors;
+    
+    a.setZero(n, n);
+    b.setZero(n, n);
+    rwork.setZero(8*n);
+    lscale.setZero(n);
+    rscale.setZero(n);
+    rconde.setZero(n);
+    rcondv.setZero(n);
+    iwork.assign(n+2, 0);
+    bwork.assign(n,   0);
+    
+    // workspace query for the optimal size of work. The other arrays are
+    // not referenced by the query.
+    char BAL='B', L='N',R='N', S='E';
+    if (computeEigenvectors) {
+        L = 'V'; R = 'V'; S='B';
+    }
+    
+    int
+    query    = -1,
+    info     = -1,
+    ilo      = 0,
+    ihi      = 0;
+    
+    Real
+    abnrm    = 0.,
+    bbnrm    = 0.;
+    
+    Complex
+    lwork_val = 0.;
+    
+    zggevx_(&BAL, &L, &R, &S, &n,
+            a.data(), &n,
+            b.data(), &n,
+            a.data(), a.data(),
+            a.data(), &n,
+            a.data(), &n,
+            &ilo, &ihi,
+            lscale.data(), rscale.data(),
+            &abnrm, &bbnrm,
+            rconde.data(), rcondv.data(),
+            &lwork_val, &query,
+            rwork.data(),
+            &(iwork[0]),
+            &(bwork[0]),
+            &info);
+    
+    // minimum size for the balancing and condition numbers requested above
+    lwork = std::max((int)lwork_val.real(), 2*(n*n+n));
+    work.setZero(lwork);
+}
+
+
+
+std::size_t
+MAST::LAPACK_ZGGEVX::Workspace::bytes() const {
+    
+    return (MAST::MemoryLog::bytes(a)      +
+            MAST::MemoryLog::bytes(b)      +
+            MAST::MemoryLog::bytes(work)   +
+            MAST::MemoryLog::bytes(rwork)  +
+            4 * MAST::MemoryLog::bytes(lscale) +
+            (iwork.size() + bwork.size()) * sizeof(int));
+}
+
+
+
 void
 MAST::LAPACK_ZGGEVX::compute(const ComplexMatrixX &A,
                              const ComplexMatrixX &B,
                              bool computeEigenvectors) {
     
+    _workspace.init((int)A.cols(), computeEigenvectors);
+    
+    this->_compute(A, B, _workspace, computeEigenvectors);
+    
+    _update_memory();
+    _workspace_memory.set(_workspace.bytes());
+    
+    if (info_val  != 0)
+        libMesh::out
+        << "Warning!!  ZGGEVX returned with nonzero info = "
+        << info_val << std::endl;
+}
+
+
+
+void
+MAST::LAPACK_ZGGEVX::clear_workspace() {
+    
+    _workspace = MAST::LAPACK_ZGGEVX::Workspace();
+    _workspace_memory.clear();
+}
+
+
+
+void
+MAST::LAPACK_ZGGEVX::_compute(const ComplexMatrixX &A,
+                              const ComplexMatrixX &B,
+                              MAST::LAPACK_ZGGEVX::Workspace& ws,
+                              bool computeEigenvectors) {
+    
     libmesh_assert(A.cols() == A.rows() &&
                    B.cols() == A.rows() &&
                    B.cols() == B.rows());
+    libmesh_assert_equal_to(ws.n, A.cols());
+    libmesh_assert_equal_to(ws.if_vecs, computeEigenvectors);
     
-    _A = A;
-    _B = B;
+    // the matrices are copied to the workspace, since they are
+    // overwritten by LAPACK. Only B is retained, for the scaling of the
+    // eigenvectors. The copies are assigned to matrices of the same size,
+    // which does not allocate memory after the first call.
+    _B   = B;
+    ws.a = A;
+    ws.b = B;
     
-    ComplexMatrixX
-    Amat = _A,
-    Bmat = _B;
-    
-    int n = (int)A.cols();
+    int n = ws.n;
     
     char BAL='B', L='N',R='N', S='E';
     
     if (computeEigenvectors) {
         
         L = 'V'; R = 'V'; S='B';
-        VL.setZero(n, n);
-        VR.setZero(n, n);
+        VL.resize(n, n);
+        VR.resize(n, n);
     }
     
     int
-    lwork    =4*(n*n+n),
-    l_rwork  =8*n,
     ilo      = 0,
     ihi      = 0;
-    info_val =-1,
-    
-    alpha.setZero(n);
-    beta.setZero(n);
-    ComplexVectorX
-    work   = ComplexVectorX::Zero(lwork);
-    RealVectorX
-    rwork  = RealVectorX::Zero(l_rwork),
-    lscale = RealVectorX::Zero(n),
-    rscale = RealVectorX::Zero(n),
-    rconde = RealVectorX::Zero(n),
-    rcondv = RealVectorX::Zero(n);
+    info_val =-1;
     
-    Complex
-    *a_vals  = Amat.data(),
-    *b_vals  = Bmat.data(),
-    *alpha_v = alpha.data(),
-    *beta_v  = beta.data(),
-    *VL_v    = VL.data(),
-    *VR_v    = VR.data(),
-    *work_v  = work.data();
+    alpha.resize(n);
+    beta.resize(n);
     
     Real
-    *rwork_v  = rwork.data(),
-    *lscale_v = lscale.data(),
-    *rscale_v = rscale.data(),
-    *rconde_v = rconde.data(),
-    *rcondv_v = rcondv.data(),
     abnrm     = 0.,
     bbnrm     = 0.;
     
-    std::vector<int>
-    iwork(n+2, 0);
-    
-    bool
-    bwork[n];
+    // VL and VR are not referenced if the eigenvectors are not computed
+    Complex
+    *VL_v    = computeEigenvectors? VL.data(): ws.a.data(),
+    *VR_v    = computeEigenvectors? VR.data(): ws.a.data();
     
     zggevx_(&BAL, &L, &R, &S, &n,
-            &(a_vals[0]), &n,
-            &(b_vals[0]), &n,
-            &(alpha_v[0]), &(beta_v[0]),
-            &(VL_v[0]), &n,
-            &(VR_v[0]), &n,
+            ws.a.data(), &n,
+            ws.b.data(), &n,
+            alpha.data(), beta.data(),
+            VL_v, &n,
+            VR_v, &n,
             &ilo, &ihi,
-            &(lscale_v[0]), &(rscale_v[0]),
+            ws.lscale.data(), ws.rscale.data(),
             &abnrm, &bbnrm,
-            &(rconde_v[0]), &(rcondv_v[0]),
-            &(work_v[0]), &lwork,
-            &(rwork_v[0]),
-            &(iwork[0]),
-            &(bwork[0]),
+            ws.rconde.data(), ws.rcondv.data(),
+            ws.work.data(), &ws.lwork,
+            ws.rwork.data(),
+            &(ws.iwork[0]),
+            &(ws.bwork[0]),
             &info_val);
-    
-    if (info_val  != 0)
-        libMesh::out
-        << "Warning!!  ZGGEVX returned with nonzero info = "
-        << info_val << std::endl;
 }
 
-
@@ -0,0 +1,450 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2017  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+// C++ includes
+#include <cmath>
+#include <unordered_map>
+#include <limits>
+
+
+// MAST includes
+#include "optimization/density_filter.h"
+
+
+// libMesh includes
+#include "libmesh/sparse_matrix.h"
+#include "libmesh/numeric_vector.h"
+#include "libmesh/parallel.h"
+
+
+
+namespace MAST {
+    
+    /*!
+     *   @returns the processor that owns variable \p i, when \p n variables
+     *   are split into contiguous blocks over \p n_procs processors.
+     */
+    inline unsigned int
+    density_filter_owner(unsigned int i,
+                         unsigned int n,
+                         unsigned int n_procs) {
+        
+        unsigned int p = (unsigned int)((1.*i*n_procs)/n);
+        
+        // correct for the rounding in the block boundaries
+        while (p+1 < n_procs && (unsigned int)((1.*n*(p+1))/n_procs) <= i) p++;
+        while (p > 0         && (unsigned int)((1.*n*p)/n_procs)      >  i) p--;
+        
+        return p;
+    }
+}
+
+
+
+
+MAST::DensityFilter::DensityFilter(const libMesh::Parallel::Communicator& comm_in,
+                                   const Real radius):
+libMesh::ParallelObject(comm_in),
+_radius(radius),
+_n_vars(0),
+_first(0),
+_last(0),
+_max_n_neighbors(0) {
+    
+    libmesh_assert_greater(radius, 0.);
+}
+
+
+
+MAST::DensityFilter::~DensityFilter() {
+    
+}
+
+
+
+void
+MAST::DensityFilter::init(const unsigned int n_vars,
+                          const std::map<unsigned int, libMesh::Point>& centroids) {
+    
+    libmesh_assert(!_filter.get());
+    libmesh_assert_greater(n_vars, 0);
+    
+    const unsigned int
+    rank    = this->comm().rank(),
+    n_procs = this->comm().size();
+    
+    _n_vars = n_vars;
+    _first  = (unsigned int)((1.*n_vars*rank)/n_procs);
+    _last   = (unsigned int)((1.*n_vars*(rank+1))/n_procs);
+    
+    //////////////////////////////////////////////////////////////////////
+    // send the centroids to the processors that own the variables. Each
+    // point is communicated as (id, x, y, z).
+    //////////////////////////////////////////////////////////////////////
+    std::vector<std::vector<Real> >
+    send(n_procs);
+    std::vector<Real>
+    recv;
+    
+    {
+        std::map<unsigned int, libMesh::Point>::const_iterator
+        it   = centroids.begin(),
+        end  = centroids.end();
+        
+        for ( ; it != end; it++) {
+            
+            libmesh_assert_less(it->first, n_vars);
+            
+            std::vector<Real>&
+            v = send[MAST::density_filter_owner(it->first, n_vars, n_procs)];
+            
+            v.push_back(it->first);
+            for (unsigned int i=0; i<3; i++)
+                v.push_back(it->second(i));
+        }
+    }
+    
+    this->_exchange(send, recv);
+    
+    std::map<unsigned int, libMesh::Point> local;
+    
+    for (unsigned int i=0; i<recv.size(); i+=4)
+        local[(unsigned int)recv[i]] = libMesh::Point(recv[i+1], recv[i+2], recv[i+3]);
+    
+    libmesh_assert_equal_to(local.size(), _last-_first);
+    
+    //////////////////////////////////////////////////////////////////////
+    // bounding box of the local variables. Processors whose box
+    // expanded by the radius includes a local point need it to
+    // compute their rows.
+    //////////////////////////////////////////////////////////////////////
+    std::vector<Real> box(6, 0.);
+    for (unsigned int i=0; i<3; i++) {
+        box[i]    =  std::numeric_limits<Real>::max();
+        box[i+3]  = -std::numeric_limits<Real>::max();
+    }
+    
+    std::map<unsigned int, libMesh::Point>::const_iterator
+    it   = local.begin(),
+    end  = local.end();
+    
+    for ( ; it != end; it++)
+        for (unsigned int i=0; i<3; i++) {
+            box[i]   = std::min(box[i],   it->second(i));
+            box[i+3] = std::max(box[i+3], it->second(i));
+        }
+    
+    this->comm().allgather(box, true);
+    
+    for (unsigned int p=0; p<n_procs; p++) {
+        
+        send[p].clear();
+        
+        if (p == rank)
+            continue;
+        
+        for (it = local.begin(); it != end; it++) {
+            
+            bool inside = true;
+            for (unsigned int i=0; i<3; i++)
+                inside = (inside &&
+                          it->second(i) >= box[6*p+i]   - _radius &&
+                          it->second(i) <= box[6*p+i+3] + _radius);
+            
+            if (inside) {
+                send[p].push_back(it->first);
+                for (unsigned int i=0; i<3; i++)
+                    send[p].push_back(it->second(i));
+            }
+        }
+    }
+    
+    this->_exchange(send, recv);
+    
+    // all points that may be neighbors of the local points
+    std::map<unsigned int, libMesh::Point> points(local);
+    
+    for (unsigned int i=0; i<recv.size(); i+=4)
+        points[(unsigned int)recv[i]] = libMesh::Point(recv[i+1], recv[i+2], recv[i+3]);
+    
+    //////////////////////////////////////////////////////////////////////
+    // uniform grid with cells of the size of the radius, so that
+    // the neighbors of a point are in the adjacent cells.
+    //////////////////////////////////////////////////////////////////////
+    Real
+    x_min[3] = { std::numeric_limits<Real>::max(),
+                 std::numeric_limits<Real>::max(),
+                 std::numeric_limits<Real>::max()};
+    long long
+    n_cells[3] = {1, 1, 1};
+    
+    for (it = points.begin(); it != points.end(); it++)
+        for (unsigned int i=0; i<3; i++)
+            x_min[i] = std::min(x_min[i], it->second(i));
+    
+    for (it = points.begin(); it != points.end(); it++)
+        for (unsigned int i=0; i<3; i++)
+            n_cells[i] = std::max(n_cells[i],
+                                  (long long)floor((it->second(i)-x_min[i])/_radius)+1);
+    
+    std::vector<unsigned int>
+    ids;
+    std::vector<libMesh::Point>
+    pts;
+    std::unordered_map<long long, std::vector<unsigned int> >
+    grid;
+    
+    for (it = points.begin(); it != points.end(); it++) {
+        
+        long long c[3];
+        for (unsigned int i=0; i<3; i++)
+            c[i] = (long long)floor((it->second(i)-x_min[i])/_radius);
+        
+        grid[(c[0]*n_cells[1] + c[1])*n_cells[2] + c[2]].push_back((unsigned int)ids.size());
+        ids.push_back(it->first);
+        pts.push_back(it->second);
+    }
+    
+    //////////////////////////////////////////////////////////////////////
+    // filter weights for the local rows
+    //////////////////////////////////////////////////////////////////////
+    std::vector<std::vector<std::pair<unsigned int, Real> > >
+    rows(_last-_first);
+    
+    unsigned int
+    n_diag    = 1,
+    n_offdiag = 0;
+    
+    _max_n_neighbors = 0;
+    
+    for (it = local.begin(); it != local.end(); it++) {
+        
+        std::vector<std::pair<unsigned int, Real> >&
+        row = rows[it->first-_first];
+        
+        long long c[3];
+        for (unsigned int i=0; i<3; i++)
+            c[i] = (long long)floor((it->second(i)-x_min[i])/_radius);
+        
+        Real
+        sum = 0.;
+        
+        for (long long i=std::max(c[0]-1, 0LL); i<=std::min(c[0]+1, n_cells[0]-1); i++)
+            for (long long j=std::max(c[1]-1, 0LL); j<=std::min(c[1]+1, n_cells[1]-1); j++)
+                for (long long k=std::max(c[2]-1, 0LL); k<=std::min(c[2]+1, n_cells[2]-1); k++) {
+                    
+                    std::unordered_map<long long, std::vector<unsigned int> >::const_iterator
+                    g_it = grid.find((i*n_cells[1] + j)*n_cells[2] + k);
+                    
+                    if (g_it == grid.end())
+                        continue;
+                    
+                    for (unsigned int l=0; l<g_it->second.size(); l++) {
+                        
+                        const unsigned int
+                        q = g_it->second[l];
+                        
+                        const Real
+                        w = _radius - (pts[q] - it->second).norm();
+                        
+                        if (w > 0.) {
+                            row.push_back(std::pair<unsigned int, Real>(ids[q], w));
+                            sum += w;
+                        }
+                    }
+                }
+        
+        unsigned int
+        nd  = 0,
+        nod = 0;
+        
+        for (unsigned int l=0; l<row.size(); l++) {
+            
+            row[l].second /= sum;
+            
+            if (row[l].first >= _first && row[l].first < _last)
+                nd++;
+            else
+                nod++;
+        }
+        
+        n_diag           = std::max(n_diag,                     nd);
+        n_offdiag        = std::max(n_offdiag,                 nod);
+        _max_n_neighbors = std::max(_max_n_neighbors, (unsigned int)row.size());
+    }
+    
+    this->comm().max(n_diag);
+    this->comm().max(n_offdiag);
+    this->comm().max(_max_n_neighbors);
+    
+    //////////////////////////////////////////////////////////////////////
+    // now create the sparse matrices
+    //////////////////////////////////////////////////////////////////////
+    _filter.reset(libMesh::SparseMatrix<Real>::build(this->comm()).release());
+    _filter->init(n_vars, n_vars, _last-_first, _last-_first, n_diag, n_offdiag);
+    
+    for (unsigned int i=0; i<rows.size(); i++)
+        for (unsigned int l=0; l<rows[i].size(); l++)
+            _filter->set(_first+i, rows[i][l].first, rows[i][l].second);
+    
+    _filter->close();
+    
+    _filter_transpose.reset(libMesh::SparseMatrix<Real>::build(this->comm()).release());
+    _filter->get_transpose(*_filter_transpose);
+}
+
+
+
+void
+MAST::DensityFilter::filter(const libMesh::NumericVector<Real>& x,
+                            libMesh::NumericVector<Real>& y) const {
+    
+    libmesh_assert(_filter.get());
+    
+    _filter->vector_mult(y, x);
+}
+
+
+
+void
+MAST::DensityFilter::filter_sensitivity(const libMesh::NumericVector<Real>& dy,
+                                        libMesh::NumericVector<Real>& dx) const {
+    
+    libmesh_assert(_filter_transpose.get());
+    
+    _filter_transpose->vector_mult(dx, dy);
+}
+
+
+
+void
+MAST::DensityFilter::filter(const std::vector<Real>& x,
+                            std::vector<Real>& y) const {
+    
+    libmesh_assert(_filter.get());
+    
+    this->_mult(*_filter, x, y);
+}
+
+
+
+void
+MAST::DensityFilter::filter_sensitivity(const std::vector<Real>& dy,
+                                        std::vector<Real>& dx) const {
+    
+    libmesh_assert(_filter_transpose.get());
+    
+    this->_mult(*_filter_transpose, dy, dx);
+}
+
+
+
+std::auto_ptr<libMesh::NumericVector<Real> >
+MAST::DensityFilter::build_vector() const {
+    
+    libmesh_assert(_filter.get());
+    
+    std::auto_ptr<libMesh::NumericVector<Real> >
+    v(libMesh::NumericVector<Real>::build(this->comm()).release());
+    
+    v->init(_n_vars, _last-_first, false, libMesh::PARALLEL);
+    
+    return v;
+}
+
+
+
+void
+MAST::DensityFilter::_exchange(const std::vector<std::vector<Real> >& send,
+                               std::vector<Real>& recv) const {
+    
+    const unsigned int
+    rank    = this->comm().rank(),
+    n_procs = this->comm().size();
+    
+    libmesh_assert_equal_to(send.size(), n_procs);
+    
+    // number of values sent to and received from each processor. Only
+    // the processors with a nonzero size exchange messages, so that the
+    // point-to-point communication is limited to the neighboring blocks.
+    std::vector<unsigned int>
+    sizes(n_procs, 0);
+    
+    for (unsigned int p=0; p<n_procs; p++)
+        if (p != rank)
+            sizes[p] = (unsigned int)send[p].size();
+    
+    this->comm().alltoall(sizes);
+    
+    const libMesh::Parallel::MessageTag
+    tag = this->comm().get_unique_tag(3461);
+    
+    std::vector<libMesh::Parallel::Request>
+    requests;
+    
+    for (unsigned int p=0; p<n_procs; p++)
+        if (p != rank && send[p].size())
+            requests.push_back(libMesh::Parallel::Request());
+    
+    unsigned int
+    n_req = 0;
+    
+    for (unsigned int p=0; p<n_procs; p++)
+        if (p != rank && send[p].size())
+            this->comm().send(p, send[p], requests[n_req++], tag);
+    
+    recv = send[rank];
+    
+    std::vector<Real> buf;
+    
+    for (unsigned int p=0; p<n_procs; p++)
+        if (p != rank && sizes[p]) {
+            
+            buf.clear();
+            this->comm().receive(p, buf, tag);
+            libmesh_assert_equal_to(buf.size(), sizes[p]);
+            recv.insert(recv.end(), buf.begin(), buf.end());
+        }
+    
+    libMesh::Parallel::wait(requests);
+}
+
+
+
+void
+MAST::DensityFilter::_mult(const libMesh::SparseMatrix<Real>& m,
+                           const std::vector<Real>& x,
+                           std::vector<Real>& y) const {
+    
+    libmesh_assert_equal_to(x.size(), _n_vars);
+    
+    std::auto_ptr<libMesh::NumericVector<Real> >
+    xv(this->build_vector().release()),
+    yv(this->build_vector().release());
+    
+    for (unsigned int i=_first; i<_last; i++)
+        xv->set(i, x[i]);
+    xv->close();
+    
+    m.vector_mult(*yv, *xv);
+    
+    yv->localize(y);
+}
+
@@ -0,0 +1,204 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2017  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#ifndef __mast__density_filter__
+#define __mast__density_filter__
+
+// C++ includes
+#include <vector>
+#include <map>
+#include <memory>
+
+
+// MAST includes
+#include "base/mast_data_types.h"
+
+
+// libMesh includes
+#include "libmesh/parallel_object.h"
+#include "libmesh/point.h"
+
+
+namespace libMesh {
+    
+    // Forward declerations
+    template <typename T> class SparseMatrix;
+    template <typename T> class NumericVector;
+}
+
+
+namespace MAST {
+    
+    
+    /*!
+     *   Linear density filter for topology optimization,
+     *   \f$ \tilde{\rho}_i = \sum_j H_{ij} \rho_j / \sum_j H_{ij} \f$, with
+     *   \f$ H_{ij} = \max(0, r - |x_i - x_j|) \f$, where \f$ x_i \f$ is the
+     *   centroid of design variable \f$ i \f$ and \f$ r \f$ is the filter
+     *   radius. The sensitivity of a function with respect to the design
+     *   variables is obtained from its sensitivity with respect to the
+     *   filtered variables by the transposed filter.
+     *
+     *   The rows of the filter are split into contiguous blocks over the
+     *   processors of the communicator, in the same manner as the design
+     *   variables of MAST::MMAOptimizationInterface. Neighbors within the
+     *   radius are identified with a uniform grid of cell size \f$ r \f$,
+     *   so that the setup cost is proportional to the number of variables.
+     *   Only the centroids within the radius of the bounding box of a
+     *   processor's block are communicated to it, so that each processor
+     *   exchanges points with its neighboring blocks only. The filter and its transpose are stored as
+     *   distributed sparse matrices, and are applied as parallel
+     *   matrix-vector products.
+     */
+    class DensityFilter:
+    public libMesh::ParallelObject {
+        
+    public:
+        
+        DensityFilter(const libMesh::Parallel::Communicator& comm_in,
+                      const Real radius);
+        
+        
+        virtual ~DensityFilter();
+        
+        
+        /*!
+         *   @returns the filter radius
+         */
+        Real radius() const {
+            return _radius;
+        }
+        
+        
+        /*!
+         *   initializes the filter for \p n_vars design variables.
+         *   \p centroids provides the location of the design variables
+         *   known on this processor, identified by their index. Each
+         *   variable must be provided by at least one processor. Variables
+         *   provided by more than one processor must have the same
+         *   location.
+         */
+        void init(const unsigned int n_vars,
+                  const std::map<unsigned int, libMesh::Point>& centroids);
+        
+        
+        /*!
+         *   @returns the index of the first variable owned by this processor
+         */
+        unsigned int first_local_index() const {
+            return _first;
+        }
+        
+        
+        /*!
+         *   @returns the index past the last variable owned by this processor
+         */
+        unsigned int last_local_index() const {
+            return _last;
+        }
+        
+        
+        /*!
+         *   @returns the maximum number of neighbors of a variable,
+         *   including itself.
+         */
+        unsigned int max_n_neighbors() const {
+            return _max_n_neighbors;
+        }
+        
+        
+        /*!
+         *   computes the filtered variables \p y from the variables \p x
+         */
+        void filter(const libMesh::NumericVector<Real>& x,
+                    libMesh::NumericVector<Real>& y) const;
+        
+        
+        /*!
+         *   computes the sensitivity with respect to the variables, \p dx,
+         *   from the sensitivity with respect to the filtered variables,
+         *   \p dy.
+         */
+        void filter_sensitivity(const libMesh::NumericVector<Real>& dy,
+                                libMesh::NumericVector<Real>& dx) const;
+        
+        
+        /*!
+         *   same as above, for vectors of all variables that are
+         *   available on all processors, such as those provided to
+         *   MAST::FunctionEvaluation::evaluate. \p x and \p y may be
+         *   the same vector.
+         */
+        void filter(const std::vector<Real>& x,
+                    std::vector<Real>& y) const;
+        
+        
+        /*!
+         *   same as above, for vectors of all variables that are
+         *   available on all processors. \p dy and \p dx may be the
+         *   same vector.
+         */
+        void filter_sensitivity(const std::vector<Real>& dy,
+                                std::vector<Real>& dx) const;
+        
+        
+        /*!
+         *   @returns a new parallel vector with the row distribution of
+         *   the filter
+         */
+        std::auto_ptr<libMesh::NumericVector<Real> > build_vector() const;
+        
+        
+    protected:
+        
+        /*!
+         *   sends \p send[p] to processor \p p, and returns the data received
+         *   from all processors, including this one, in \p recv. The message
+         *   sizes are exchanged with an all-to-all, after which only the
+         *   processors with nonempty data exchange point-to-point messages.
+         */
+        void _exchange(const std::vector<std::vector<Real> >& send,
+                       std::vector<Real>& recv) const;
+        
+        
+        /*!
+         *   applies \p m to the vector of all variables \p x
+         */
+        void _mult(const libMesh::SparseMatrix<Real>& m,
+                   const std::vector<Real>& x,
+                   std::vector<Real>& y) const;
+        
+        
+        Real _radius;
+        
+        unsigned int _n_vars;
+        
+        unsigned int _first, _last;
+        
+        unsigned int _max_n_neighbors;
+        
+        std::auto_ptr<libMesh::SparseMatrix<Real> > _filter;
+        
+        std::auto_ptr<libMesh::SparseMatrix<Real> > _filter_transpose;
+    };
+}
+
+
+#endif // __mast__density_filter__
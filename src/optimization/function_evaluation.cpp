@@ -17,10 +17,24 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
+// C++ includes
+#include <algorithm>
+#include <random>
+#include <cstring>
+#include <stdint.h>
+
 // MAST includes
 #include "optimization/function_evaluation.h"
 
 
+namespace MAST {
+    
+    // identifies the binary checkpoint files written by FunctionEvaluation
+    static const char __function_evaluation_checkpoint_id[8] =
+    {'M', 'A', 'S', 'T', 'F', 'E', 'C', '2'};
+}
+
+
 void
 MAST::FunctionEvaluation::output(unsigned int iter, const std::vector<Real> &x,
                                  Real obj, const std::vector<Real> &fval,
@@ -140,60 +154,97 @@ MAST::FunctionEvaluation::output(unsigned int iter, const std::vector<Real> &x,
 bool
 MAST::FunctionEvaluation::verify_gradients(const std::vector<Real>& dvars) {
     
+    std::vector<unsigned int>
+    dv_ids(_n_vars);
+    
+    for (unsigned int i=0; i<_n_vars; i++)
+        dv_ids[i] = i;
+    
+    return this->verify_gradients(dvars, dv_ids);
+}
+
+
+
+
+bool
+MAST::FunctionEvaluation::verify_gradients(const std::vector<Real>& dvars,
+                                           const std::vector<unsigned int>& dv_ids,
+                                           const libMesh::Parallel::Communicator* global_comm,
+                                           unsigned int group_id,
+                                           unsigned int n_groups,
+                                           Real delta,
+                                           Real tol) {
+    
+    libmesh_assert_equal_to(dvars.size(), _n_vars);
+    libmesh_assert_greater(n_groups, 0);
+    libmesh_assert_less(group_id, n_groups);
+    libmesh_assert(global_comm || n_groups == 1);
+    
+    const unsigned int
+    n_con   = _n_eq + _n_ineq,
+    n_sel   = (unsigned int)dv_ids.size();
     
-    // first call theh evaluate method to get the analytical sensitivities
     Real
-    delta           = 1.e-5,
-    tol             = 1.e-3,
     obj             = 0.,
     obj_fd          = 0.;
     
+    // only the first group computes the analytical sensitivities. All
+    // groups need the function values at the unperturbed point.
     bool
-    eval_obj_grad   = true;
+    eval_obj_grad   = (group_id == 0),
+    if_write        = (this->comm().rank() == 0);
     
     
     std::vector<Real>
     dvars_fd   (dvars),
-    obj_grad   (_n_vars),
-    obj_grad_fd(_n_vars),
-    fvals      (_n_ineq + _n_eq),
-    fvals_fd   (_n_ineq + _n_eq),
-    grads      (_n_vars*(_n_ineq + _n_eq)),
-    grads_fd   (_n_vars*(_n_ineq + _n_eq));
+    obj_grad   (_n_vars,       0.),
+    fvals      (n_con,         0.),
+    fvals_fd   (n_con,         0.),
+    grads      (_n_vars*n_con, 0.),
+    // values for the selected variables
+    obj_grad_sel    (n_sel,       0.),
+    obj_grad_fd_sel (n_sel,       0.),
+    grads_sel       (n_sel*n_con, 0.),
+    grads_fd_sel    (n_sel*n_con, 0.);
     
     
     std::vector<bool>
-    eval_grads (_n_eq+_n_ineq);
-    
+    eval_grads (n_con, eval_obj_grad);
     
-    std::fill(    dvars_fd.begin(),     dvars_fd.end(),   0.);
-    std::fill(    obj_grad.begin(),     obj_grad.end(),   0.);
-    std::fill( obj_grad_fd.begin(),  obj_grad_fd.end(),   0.);
-    std::fill(       fvals.begin(),        fvals.end(),   0.);
-    std::fill(    fvals_fd.begin(),     fvals_fd.end(),   0.);
-    std::fill(       grads.begin(),        grads.end(),   0.);
-    std::fill(    grads_fd.begin(),     grads_fd.end(),   0.);
-    std::fill(  eval_grads.begin(),   eval_grads.end(), true);
     
+    // calculate the analytical sensitivity. The cache is used for this
+    // point only, since the perturbed points are not revisited.
+    this->cached_evaluate(dvars,
+                          obj,
+                          eval_obj_grad,
+                          obj_grad,
+                          fvals,
+                          eval_grads,
+                          grads);
     
-    // calculate the analytical sensitivity
-    this->evaluate(dvars,
-                   obj,
-                   eval_obj_grad,
-                   obj_grad,
-                   fvals,
-                   eval_grads,
-                   grads);
+    if (eval_obj_grad && if_write)
+        for (unsigned int k=0; k<n_sel; k++) {
+            
+            libmesh_assert_less(dv_ids[k], _n_vars);
+            
+            obj_grad_sel[k] = obj_grad[dv_ids[k]];
+            for (unsigned int j=0; j<n_con; j++)
+                grads_sel[k*n_con+j] = grads[dv_ids[k]*n_con+j];
+        }
     
     
     // now turn off the sensitivity variables
     eval_obj_grad = false;
     std::fill(  eval_grads.begin(),   eval_grads.end(), false);
     
-    // now iteratve over the design variables, and calculate the finite
-    // difference sensitivity values
+    // now iteratve over the selected design variables, and calculate the
+    // finite difference sensitivity values. The variables are distributed
+    // cyclically among the groups.
     
-    for (unsigned int i=0; i<_n_vars; i++) {
+    for (unsigned int k=group_id; k<n_sel; k+=n_groups) {
+        
+        const unsigned int
+        i = dv_ids[k];
         
         // copy the original vector
         dvars_fd =  dvars;
@@ -207,17 +258,31 @@ MAST::FunctionEvaluation::verify_gradients(const std::vector<Real>& dvars) {
         this->evaluate(dvars_fd,
                        obj_fd,
                        eval_obj_grad,
-                       obj_grad_fd,
+                       obj_grad,
                        fvals_fd,
                        eval_grads,
-                       grads_fd);
+                       grads);
         
-        // objective gradient
-        obj_grad_fd[i]  = (obj_fd-obj)/delta;
+        if (if_write) {
+            
+            // objective gradient
+            obj_grad_fd_sel[k]  = (obj_fd-obj)/delta;
+            
+            // constraint gradient
+            for (unsigned int j=0; j<n_con; j++)
+                grads_fd_sel[k*n_con+j]  = (fvals_fd[j]-fvals[j])/delta;
+        }
+    }
+    
+    
+    // only the first rank of each group has written its values, so the
+    // sum over all groups gives the complete set on all ranks
+    if (global_comm) {
         
-        // constraint gradient
-        for (unsigned int j=0; j<_n_eq+_n_ineq; j++)
-            grads_fd[i*(_n_eq+_n_ineq)+j]  = (fvals_fd[j]-fvals[j])/delta;
+        global_comm->sum(obj_grad_sel);
+        global_comm->sum(obj_grad_fd_sel);
+        global_comm->sum(grads_sel);
+        global_comm->sum(grads_fd_sel);
     }
     
     
@@ -228,11 +293,11 @@ MAST::FunctionEvaluation::verify_gradients(const std::vector<Real>& dvars) {
     
     bool accurate_sens = true;
     
-    for (unsigned int i=0; i<_n_vars; i++)
-        if (fabs((obj_grad[i] - obj_grad_fd[i])/obj_grad[i]) > tol) {
+    for (unsigned int k=0; k<n_sel; k++)
+        if (fabs((obj_grad_sel[k] - obj_grad_fd_sel[k])/obj_grad_sel[k]) > tol) {
             libMesh::out
-            << " Mismatched sensitivity: DV:  "  << i << "   "
-            << obj_grad[i] << "    " << obj_grad_fd[i] << std::endl;
+            << " Mismatched sensitivity: DV:  "  << dv_ids[k] << "   "
+            << obj_grad_sel[k] << "    " << obj_grad_fd_sel[k] << std::endl;
             accurate_sens = false;
         }
     
@@ -242,15 +307,15 @@ MAST::FunctionEvaluation::verify_gradients(const std::vector<Real>& dvars) {
     << " *** Constraint function gradients: analytical vs numerical"
     << std::endl;
     
-    for (unsigned int j=0; j<_n_eq+_n_ineq; j++) {
+    for (unsigned int j=0; j<n_con; j++) {
         
         libMesh::out << "  Constraint: " << j << std::endl;
-        for (unsigned int i=0; i<_n_vars; i++) {
+        for (unsigned int k=0; k<n_sel; k++) {
             libMesh::out
-            << " DV:  "  << i << "   "
-            << grads[i*(_n_eq+_n_ineq)+j] << "    "
-            << grads_fd[i*(_n_eq+_n_ineq)+j];
-            if (fabs((grads[i*(_n_eq+_n_ineq)+j] - grads_fd[i*(_n_eq+_n_ineq)+j])/grads[i*(_n_eq+_n_ineq)+j]) > tol) {
+            << " DV:  "  << dv_ids[k] << "   "
+            << grads_sel[k*n_con+j] << "    "
+            << grads_fd_sel[k*n_con+j];
+            if (fabs((grads_sel[k*n_con+j] - grads_fd_sel[k*n_con+j])/grads_sel[k*n_con+j]) > tol) {
                 libMesh::out << "    Mismatched sensitivity" << std::endl;
                 accurate_sens = false;
             }
@@ -270,3 +335,690 @@ MAST::FunctionEvaluation::verify_gradients(const std::vector<Real>& dvars) {
 
 
 
+
+unsigned int
+MAST::FunctionEvaluation::split_communicator(const libMesh::Parallel::Communicator& global_comm,
+                                             unsigned int n_groups,
+                                             libMesh::Parallel::Communicator& group_comm) {
+    
+    libmesh_assert_greater(n_groups, 0);
+    
+    if (n_groups > global_comm.size())
+        libmesh_error_msg("Number of groups: " << n_groups
+                          << " exceeds number of processors: " << global_comm.size());
+    
+    // contiguous blocks of ranks are assigned to each group
+    unsigned int
+    group_id = (global_comm.rank() * n_groups) / global_comm.size();
+    
+    global_comm.split(group_id, global_comm.rank(), group_comm);
+    
+    return group_id;
+}
+
+
+
+
+std::vector<unsigned int>
+MAST::FunctionEvaluation::random_variable_subset(unsigned int n_vars,
+                                                 unsigned int n,
+                                                 unsigned int seed) {
+    
+    std::vector<unsigned int>
+    ids(n_vars);
+    
+    for (unsigned int i=0; i<n_vars; i++)
+        ids[i] = i;
+    
+    if (n >= n_vars)
+        return ids;
+    
+    // partial Fisher-Yates shuffle with a fixed generator, so that all
+    // ranks select the same subset for the same seed
+    std::mt19937
+    gen(seed);
+    
+    for (unsigned int i=0; i<n; i++) {
+        
+        std::uniform_int_distribution<unsigned int>
+        dist(i, n_vars-1);
+        
+        std::swap(ids[i], ids[dist(gen)]);
+    }
+    
+    ids.resize(n);
+    std::sort(ids.begin(), ids.end());
+    
+    return ids;
+}
+
+
+
+
+void
+MAST::FunctionEvaluation::set_evaluation_cache(bool f,
+                                               Real tol,
+                                               unsigned int max_evaluations) {
+    
+    libmesh_assert_greater_equal(tol, 0.);
+    
+    _if_cache               = f;
+    _cache_tol              = tol;
+    _max_cached_evaluations = max_evaluations;
+    
+    this->_limit_cache_size();
+}
+
+
+
+
+void
+MAST::FunctionEvaluation::clear_evaluation_cache() {
+    
+    _cache.clear();
+    _n_cache_hits     = 0;
+    _n_uncheckpointed = 0;
+}
+
+
+
+
+void
+MAST::FunctionEvaluation::set_checkpoint_file(const std::string& nm,
+                                              unsigned int interval) {
+    
+    _checkpoint_file     = nm;
+    _checkpoint_interval = interval;
+    _n_uncheckpointed    = 0;
+    
+    if (!interval)
+        return;
+    
+    // the checkpoint is written from the cache
+    _if_cache = true;
+    
+    // new records are appended to the file read by load_checkpoint().
+    // Any other file is replaced, and all evaluations in the cache are
+    // written to it with the next checkpoint.
+    if (nm == _loaded_checkpoint_file)
+        return;
+    
+    for (std::list<CachedEvaluation>::iterator
+         it = _cache.begin(); it != _cache.end(); it++)
+        it->if_checkpointed = false;
+    
+    if (this->comm().rank() != 0)
+        return;
+    
+    std::ofstream
+    file(nm.c_str(), std::ofstream::out | std::ofstream::binary | std::ofstream::trunc);
+    
+    if (!file.good())
+        libmesh_error_msg("Unable to open checkpoint file: " << nm);
+    
+    // header: identifier, size of Real and problem dimensions
+    uint32_t
+    header[4] = {
+        (uint32_t) sizeof(Real),
+        (uint32_t) _n_vars,
+        (uint32_t) _n_eq,
+        (uint32_t) _n_ineq};
+    
+    file.write(MAST::__function_evaluation_checkpoint_id, 8);
+    file.write(reinterpret_cast<const char*>(header), sizeof(header));
+    file.close();
+    
+    if (!file.good())
+        libmesh_error_msg("Unable to write checkpoint file: " << nm);
+}
+
+
+
+
+MAST::FunctionEvaluation::CachedEvaluation*
+MAST::FunctionEvaluation::_find_cached_evaluation(const std::vector<Real>& dvars) {
+    
+    libmesh_assert_equal_to(dvars.size(), _n_vars);
+    
+    for (std::list<CachedEvaluation>::reverse_iterator
+         it = _cache.rbegin(); it != _cache.rend(); it++) {
+        
+        bool
+        match = true;
+        
+        for (unsigned int i=0; i<_n_vars; i++)
+            if (fabs(dvars[i] - it->dvars[i]) > _cache_tol * (1. + fabs(it->dvars[i]))) {
+                match = false;
+                break;
+            }
+        
+        if (match) {
+            
+            // move the entry to the end of the list, which holds the most
+            // recently used entries
+            _cache.splice(_cache.end(), _cache, --(it.base()));
+            return &_cache.back();
+        }
+    }
+    
+    return nullptr;
+}
+
+
+
+
+void
+MAST::FunctionEvaluation::_limit_cache_size() {
+    
+    if (!_max_cached_evaluations)
+        return;
+    
+    while (_cache.size() > _max_cached_evaluations) {
+        
+        // the history is preserved in the checkpoint file
+        if (_checkpoint_interval &&
+            !_cache.front().if_checkpointed)
+            this->write_checkpoint();
+        
+        _cache.pop_front();
+    }
+}
+
+
+
+
+void
+MAST::FunctionEvaluation::evaluate_local(const std::vector<Real>& dvars,
+                                         unsigned int first,
+                                         unsigned int last,
+                                         Real& obj,
+                                         bool eval_obj_grad,
+                                         std::vector<Real>& obj_grad,
+                                         std::vector<Real>& fvals,
+                                         std::vector<bool>& eval_grads,
+                                         std::vector<Real>& grads) {
+    
+    libmesh_assert_less_equal(first, last);
+    libmesh_assert_less_equal(last, _n_vars);
+    
+    if (first == 0 && last == _n_vars) {
+        
+        this->evaluate(dvars, obj, eval_obj_grad, obj_grad, fvals, eval_grads, grads);
+        return;
+    }
+    
+    const unsigned int
+    n_con = _n_eq + _n_ineq;
+    
+    std::vector<Real>
+    obj_grad_all(_n_vars, 0.),
+    grads_all   (_n_vars*n_con, 0.);
+    
+    this->evaluate(dvars, obj, eval_obj_grad, obj_grad_all, fvals, eval_grads, grads_all);
+    
+    if (eval_obj_grad)
+        for (unsigned int i=first; i<last; i++)
+            obj_grad[i-first] = obj_grad_all[i];
+    
+    for (unsigned int j=0; j<n_con; j++)
+        if (eval_grads[j])
+            for (unsigned int i=first; i<last; i++)
+                grads[(i-first)*n_con+j] = grads_all[i*n_con+j];
+}
+
+
+
+
+void
+MAST::FunctionEvaluation::init_distributed_dvar(libMesh::NumericVector<Real>& x,
+                                                libMesh::NumericVector<Real>& xmin,
+                                                libMesh::NumericVector<Real>& xmax) {
+    
+    libmesh_assert_equal_to(x.size(), _n_vars);
+    
+    std::vector<Real>
+    x_all    (_n_vars, 0.),
+    xmin_all (_n_vars, 0.),
+    xmax_all (_n_vars, 0.);
+    
+    this->init_dvar(x_all, xmin_all, xmax_all);
+    
+    for (libMesh::numeric_index_type i=x.first_local_index(); i<x.last_local_index(); i++) {
+        
+        x.set   (i,    x_all[i]);
+        xmin.set(i, xmin_all[i]);
+        xmax.set(i, xmax_all[i]);
+    }
+    
+    x.close();
+    xmin.close();
+    xmax.close();
+}
+
+
+
+
+void
+MAST::FunctionEvaluation::evaluate_distributed(const libMesh::NumericVector<Real>& dvars,
+                                               Real& obj,
+                                               bool eval_obj_grad,
+                                               std::vector<Real>& obj_grad,
+                                               std::vector<Real>& fvals,
+                                               std::vector<bool>& eval_grads,
+                                               std::vector<Real>& grads) {
+    
+    std::vector<Real>
+    x_all;
+    
+    dvars.localize(x_all);
+    
+    this->evaluate_local(x_all,
+                         dvars.first_local_index(),
+                         dvars.last_local_index(),
+                         obj, eval_obj_grad, obj_grad,
+                         fvals, eval_grads, grads);
+}
+
+
+
+
+void
+MAST::FunctionEvaluation::output_distributed(unsigned int iter,
+                                             const libMesh::NumericVector<Real>& x,
+                                             Real obj,
+                                             const std::vector<Real>& fval,
+                                             bool if_write_to_optim_file) const {
+    
+    std::vector<Real>
+    x_all;
+    
+    x.localize(x_all);
+    
+    this->output(iter, x_all, obj, fval, if_write_to_optim_file);
+}
+
+
+
+
+void
+MAST::FunctionEvaluation::cached_evaluate(const std::vector<Real>& dvars,
+                                          Real& obj,
+                                          bool eval_obj_grad,
+                                          std::vector<Real>& obj_grad,
+                                          std::vector<Real>& fvals,
+                                          std::vector<bool>& eval_grads,
+                                          std::vector<Real>& grads) {
+    
+    this->cached_evaluate_local(dvars, 0, _n_vars,
+                                obj, eval_obj_grad, obj_grad,
+                                fvals, eval_grads, grads);
+}
+
+
+
+
+void
+MAST::FunctionEvaluation::cached_evaluate_local(const std::vector<Real>& dvars,
+                                                unsigned int first,
+                                                unsigned int last,
+                                                Real& obj,
+                                                bool eval_obj_grad,
+                                                std::vector<Real>& obj_grad,
+                                                std::vector<Real>& fvals,
+                                                std::vector<bool>& eval_grads,
+                                                std::vector<Real>& grads) {
+    
+    if (!_if_cache) {
+        
+        this->evaluate_local(dvars, first, last,
+                             obj, eval_obj_grad, obj_grad,
+                             fvals, eval_grads, grads);
+        return;
+    }
+    
+    const unsigned int
+    n_con = _n_eq + _n_ineq;
+    
+    libmesh_assert_equal_to(eval_grads.size(), n_con);
+    
+    CachedEvaluation
+    *entry = this->_find_cached_evaluation(dvars);
+    
+    // check if the stored data includes all requested gradients for the
+    // requested design variables
+    bool
+    hit      = (entry != nullptr);
+    
+    const bool
+    if_range = (hit && entry->first <= first && last <= entry->last);
+    
+    if (hit && eval_obj_grad && !(if_range && entry->if_obj_grad))
+        hit = false;
+    
+    for (unsigned int j=0; hit && j<n_con; j++)
+        if (eval_grads[j] && !(if_range && entry->if_grads[j]))
+            hit = false;
+    
+    if (hit) {
+        
+        _n_cache_hits++;
+        
+        obj   = entry->obj;
+        fvals = entry->fvals;
+        
+        const unsigned int
+        offset = if_range? first - entry->first: 0;
+        
+        if (eval_obj_grad)
+            for (unsigned int i=0; i<last-first; i++)
+                obj_grad[i] = entry->obj_grad[offset+i];
+        
+        for (unsigned int j=0; j<n_con; j++)
+            if (eval_grads[j])
+                for (unsigned int i=0; i<last-first; i++)
+                    grads[i*n_con+j] = entry->grads[(offset+i)*n_con+j];
+        
+        return;
+    }
+    
+    this->evaluate_local(dvars, first, last,
+                         obj, eval_obj_grad, obj_grad,
+                         fvals, eval_grads, grads);
+    
+    // add the new data to the cache. If the point was already stored
+    // without the requested gradients, the entry is updated in place
+    // so that previously stored gradients are retained, unless they were
+    // stored for a different block of design variables.
+    const bool
+    if_new = (entry == nullptr);
+    
+    if (if_new) {
+        
+        _cache.push_back(CachedEvaluation());
+        entry = &_cache.back();
+        
+        entry->dvars           = dvars;
+        entry->if_checkpointed = false;
+    }
+    
+    if (if_new || entry->first != first || entry->last != last) {
+        
+        entry->first       = first;
+        entry->last        = last;
+        entry->if_obj_grad = false;
+        entry->obj_grad.assign(last-first, 0.);
+        entry->if_grads.assign(n_con, false);
+        entry->grads.assign((last-first)*n_con, 0.);
+    }
+    
+    entry->obj             = obj;
+    entry->fvals           = fvals;
+    entry->if_checkpointed = false;
+    
+    if (eval_obj_grad) {
+        
+        entry->if_obj_grad = true;
+        for (unsigned int i=0; i<last-first; i++)
+            entry->obj_grad[i] = obj_grad[i];
+    }
+    
+    for (unsigned int j=0; j<n_con; j++)
+        if (eval_grads[j]) {
+            
+            entry->if_grads[j] = true;
+            for (unsigned int i=0; i<last-first; i++)
+                entry->grads[i*n_con+j] = grads[i*n_con+j];
+        }
+    
+    _n_uncheckpointed++;
+    
+    if (_checkpoint_interval &&
+        _n_uncheckpointed >= _checkpoint_interval)
+        this->write_checkpoint();
+    
+    this->_limit_cache_size();
+}
+
+
+
+
+void
+MAST::FunctionEvaluation::
+cached_evaluate_distributed(const libMesh::NumericVector<Real>& dvars,
+                            Real& obj,
+                            bool eval_obj_grad,
+                            std::vector<Real>& obj_grad,
+                            std::vector<Real>& fvals,
+                            std::vector<bool>& eval_grads,
+                            std::vector<Real>& grads) {
+    
+    if (!_if_cache) {
+        
+        this->evaluate_distributed(dvars,
+                                   obj, eval_obj_grad, obj_grad,
+                                   fvals, eval_grads, grads);
+        return;
+    }
+    
+    std::vector<Real>
+    x_all;
+    
+    dvars.localize(x_all);
+    
+    this->cached_evaluate_local(x_all,
+                                dvars.first_local_index(),
+                                dvars.last_local_index(),
+                                obj, eval_obj_grad, obj_grad,
+                                fvals, eval_grads, grads);
+}
+
+
+
+
+void
+MAST::FunctionEvaluation::write_checkpoint() {
+    
+    libmesh_assert(!_checkpoint_file.empty());
+    
+    _n_uncheckpointed = 0;
+    
+    const unsigned int
+    n_con = _n_eq + _n_ineq;
+    
+    const bool
+    if_write = (this->comm().rank() == 0);
+    
+    // the header was written by set_checkpoint_file(), and only the
+    // records that have not been written yet are appended
+    std::ofstream
+    file;
+    
+    if (if_write) {
+        
+        file.open(_checkpoint_file.c_str(),
+                  std::ofstream::out | std::ofstream::binary | std::ofstream::app);
+        
+        if (!file.good())
+            libmesh_error_msg("Unable to open checkpoint file: " << _checkpoint_file);
+    }
+    
+    std::vector<char>
+    flags(n_con+1);
+    
+    std::vector<Real>
+    obj_grad,
+    grads;
+    
+    for (std::list<CachedEvaluation>::iterator
+         it = _cache.begin(); it != _cache.end(); it++) {
+        
+        CachedEvaluation& e = *it;
+        
+        // the cache is identical on all ranks, so all ranks skip the
+        // same records
+        if (e.if_checkpointed)
+            continue;
+        
+        e.if_checkpointed = true;
+        
+        obj_grad = e.obj_grad;
+        grads    = e.grads;
+        
+        // gradients stored in contiguous blocks over the ranks by
+        // cached_evaluate_local() are gathered on rank 0 in rank order
+        bool
+        if_distributed = (e.first != 0 || e.last != _n_vars);
+        this->comm().max(if_distributed);
+        
+        if (if_distributed) {
+            
+            this->comm().gather(0, obj_grad);
+            this->comm().gather(0, grads);
+        }
+        
+        if (!if_write)
+            continue;
+        
+        libmesh_assert_equal_to(obj_grad.size(), _n_vars);
+        libmesh_assert_equal_to(grads.size(), _n_vars*n_con);
+        
+        file.write(reinterpret_cast<const char*>(&e.dvars[0]), _n_vars*sizeof(Real));
+        file.write(reinterpret_cast<const char*>(&e.obj), sizeof(Real));
+        if (n_con)
+            file.write(reinterpret_cast<const char*>(&e.fvals[0]), n_con*sizeof(Real));
+        
+        flags[0] = e.if_obj_grad;
+        for (unsigned int j=0; j<n_con; j++)
+            flags[j+1] = e.if_grads[j];
+        file.write(&flags[0], n_con+1);
+        
+        // only the gradients that were computed are written
+        if (e.if_obj_grad)
+            file.write(reinterpret_cast<const char*>(&obj_grad[0]), _n_vars*sizeof(Real));
+        
+        for (unsigned int j=0; j<n_con; j++)
+            if (e.if_grads[j])
+                for (unsigned int i=0; i<_n_vars; i++)
+                    file.write(reinterpret_cast<const char*>(&grads[i*n_con+j]), sizeof(Real));
+    }
+    
+    if (!if_write)
+        return;
+    
+    file.close();
+    
+    if (!file.good())
+        libmesh_error_msg("Unable to write checkpoint file: " << _checkpoint_file);
+}
+
+
+
+
+unsigned int
+MAST::FunctionEvaluation::load_checkpoint(const std::string& nm) {
+    
+    const unsigned int
+    n_con = _n_eq + _n_ineq;
+    
+    std::ifstream
+    file(nm.c_str(), std::ifstream::in | std::ifstream::binary);
+    
+    if (!file.good())
+        libmesh_error_msg("Unable to open checkpoint file: " << nm);
+    
+    char
+    id[8];
+    
+    uint32_t
+    header[4];
+    
+    file.read(id, 8);
+    file.read(reinterpret_cast<char*>(header), sizeof(header));
+    
+    if (!file.good() ||
+        std::memcmp(id, MAST::__function_evaluation_checkpoint_id, 8) != 0)
+        libmesh_error_msg("Invalid checkpoint file: " << nm);
+    
+    if (header[0] != sizeof(Real) ||
+        header[1] != _n_vars      ||
+        header[2] != _n_eq        ||
+        header[3] != _n_ineq)
+        libmesh_error_msg("Checkpoint file " << nm
+                          << " does not match the dimensions of this problem");
+    
+    _if_cache = true;
+    
+    std::vector<char>
+    flags(n_con+1);
+    
+    unsigned int
+    n_read = 0;
+    
+    bool
+    if_complete = true;
+    
+    // records are read until the end of the file
+    while (true) {
+        
+        CachedEvaluation e;
+        e.first           = 0;
+        e.last            = _n_vars;
+        e.if_checkpointed = true;
+        e.dvars.resize(_n_vars, 0.);
+        e.obj_grad.resize(_n_vars, 0.);
+        e.fvals.resize(n_con, 0.);
+        e.if_grads.resize(n_con, false);
+        e.grads.resize(_n_vars*n_con, 0.);
+        
+        file.read(reinterpret_cast<char*>(&e.dvars[0]), _n_vars*sizeof(Real));
+        
+        if (file.eof() && file.gcount() == 0)
+            break;
+        
+        file.read(reinterpret_cast<char*>(&e.obj), sizeof(Real));
+        if (n_con)
+            file.read(reinterpret_cast<char*>(&e.fvals[0]), n_con*sizeof(Real));
+        
+        file.read(&flags[0], n_con+1);
+        e.if_obj_grad = flags[0];
+        for (unsigned int j=0; j<n_con; j++)
+            e.if_grads[j] = flags[j+1];
+        
+        if (e.if_obj_grad)
+            file.read(reinterpret_cast<char*>(&e.obj_grad[0]), _n_vars*sizeof(Real));
+        
+        for (unsigned int j=0; j<n_con; j++)
+            if (e.if_grads[j])
+                for (unsigned int i=0; i<_n_vars; i++)
+                    file.read(reinterpret_cast<char*>(&e.grads[i*n_con+j]), sizeof(Real));
+        
+        // the last record may have been interrupted while it was written
+        if (!file.good()) {
+            
+            if_complete = false;
+            libMesh::out
+            << "Ignoring the incomplete last record in checkpoint file: "
+            << nm << std::endl;
+            break;
+        }
+        
+        // a point is written again when its gradients are updated, and
+        // the later record replaces the earlier one
+        CachedEvaluation
+        *entry = this->_find_cached_evaluation(e.dvars);
+        
+        if (entry)
+            *entry = e;
+        else
+            _cache.push_back(e);
+        
+        n_read++;
+    }
+    
+    // new records are not appended after an incomplete record, so the
+    // file is rewritten if it is used again for checkpointing
+    _loaded_checkpoint_file = if_complete? nm: std::string();
+    
+    return n_read;
+}
+
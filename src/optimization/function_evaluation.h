@@ -23,9 +23,11 @@
 
 // C++ includes
 #include <vector>
+#include <list>
 #include <iostream>
 #include <iomanip>
 #include <fstream>
+#include <string>
 
 
 // MAST includes
@@ -34,6 +36,7 @@
 
 // libMesh includes
 #include "libmesh/parallel_object.h"
+#include "libmesh/numeric_vector.h"
 
 
 namespace MAST {
@@ -51,7 +54,13 @@ namespace MAST {
         _max_iters(0),
         _n_rel_change_iters(5),
         _tol(1.0e-6),
-        _output(nullptr)
+        _output(nullptr),
+        _if_cache(false),
+        _cache_tol(1.e-12),
+        _max_cached_evaluations(100),
+        _n_cache_hits(0),
+        _checkpoint_interval(0),
+        _n_uncheckpointed(0)
         { }
         
         virtual ~FunctionEvaluation() { }
@@ -91,6 +100,20 @@ namespace MAST {
                                std::vector<Real>& xmin,
                                std::vector<Real>& xmax) = 0;
         
+        
+        /*!
+         *   initializes the design variables and their bounds in vectors
+         *   that are distributed over the ranks of the communicator. The
+         *   vectors are initialized by the caller with the parallel layout
+         *   of the optimizer. The default implementation calls init_dvar()
+         *   and copies the local entries. Derived classes that store the
+         *   design variables in distributed form should override this,
+         *   so that the complete design vector is not formed.
+         */
+        virtual void init_distributed_dvar(libMesh::NumericVector<Real>& x,
+                                           libMesh::NumericVector<Real>& xmin,
+                                           libMesh::NumericVector<Real>& xmax);
+        
         /*!
          *   \par grads(k): Derivative of f_i(x) with respect
          *   to x_j, where k = (j-1)*M + i.
@@ -104,6 +127,48 @@ namespace MAST {
                               std::vector<Real>& grads) = 0;
         
         
+        /*!
+         *   Same as evaluate(), except that the gradients are computed and
+         *   returned only for the design variables in [\p first, \p last).
+         *   \p obj_grad has \p last - \p first entries, and
+         *   \par grads(k): Derivative of f_i(x) with respect to x_j, where
+         *   k = (j-first)*M + i. This is used by optimizers that distribute
+         *   the design variables over the ranks of the communicator, so that
+         *   each rank stores only the gradients of its own variables.
+         *   The default implementation calls evaluate() with the complete
+         *   gradient vectors and copies out the requested block. Derived
+         *   classes whose analysis is replicated on each rank should
+         *   override this to compute only the sensitivities of the
+         *   requested variables.
+         */
+        virtual void evaluate_local(const std::vector<Real>& dvars,
+                                    unsigned int first,
+                                    unsigned int last,
+                                    Real& obj,
+                                    bool eval_obj_grad,
+                                    std::vector<Real>& obj_grad,
+                                    std::vector<Real>& fvals,
+                                    std::vector<bool>& eval_grads,
+                                    std::vector<Real>& grads);
+        
+        
+        /*!
+         *   Same as evaluate_local(), with the design variables in the
+         *   distributed vector \p dvars. The gradients are returned for the
+         *   local entries of \p dvars. The default implementation localizes
+         *   \p dvars on all ranks and calls evaluate_local(). Derived
+         *   classes whose analysis needs only the local design variables
+         *   should override this.
+         */
+        virtual void evaluate_distributed(const libMesh::NumericVector<Real>& dvars,
+                                          Real& obj,
+                                          bool eval_obj_grad,
+                                          std::vector<Real>& obj_grad,
+                                          std::vector<Real>& fvals,
+                                          std::vector<bool>& eval_grads,
+                                          std::vector<Real>& grads);
+        
+        
         /*!
          *   sets the output file and the function evaluation will 
          *   write the optimization iterates to this file. If this is not called
@@ -134,12 +199,212 @@ namespace MAST {
                             bool if_write_to_optim_file) const;
         
         
+        /*!
+         *   same as output(), with the design variables in the distributed
+         *   vector \p x. The default implementation localizes \p x on all
+         *   ranks and calls output(), so this must be called on all ranks.
+         */
+        virtual void output_distributed(unsigned int iter,
+                                        const libMesh::NumericVector<Real>& x,
+                                        Real obj,
+                                        const std::vector<Real>& fval,
+                                        bool if_write_to_optim_file) const;
+        
+        
         /*!
          *  verifies the gradients at the specified design point
          */
         virtual bool verify_gradients(const std::vector<Real>& dvars);
         
         
+        /*!
+         *  verifies the gradients with respect to the design variables in
+         *  \p dv_ids at the specified design point using forward differences
+         *  with step \p delta.
+         *
+         *  For concurrent evaluation of the perturbed designs, the
+         *  communicator \p global_comm is split into \p n_groups groups using
+         *  split_communicator() and a separate object is constructed on each
+         *  group communicator. Each object then calls this method with its
+         *  \p group_id. The selected variables are distributed among the
+         *  groups, and the results are summed over \p global_comm so that
+         *  all ranks report the same comparison.
+         */
+        bool verify_gradients(const std::vector<Real>& dvars,
+                              const std::vector<unsigned int>& dv_ids,
+                              const libMesh::Parallel::Communicator* global_comm = nullptr,
+                              unsigned int group_id = 0,
+                              unsigned int n_groups = 1,
+                              Real delta = 1.e-5,
+                              Real tol   = 1.e-3);
+        
+        
+        /*!
+         *  splits \p global_comm into \p n_groups communicators of
+         *  contiguous ranks and initializes \p group_comm with the group of
+         *  this rank.
+         *  @returns the id of the group of this rank.
+         */
+        static unsigned int
+        split_communicator(const libMesh::Parallel::Communicator& global_comm,
+                           unsigned int n_groups,
+                           libMesh::Parallel::Communicator& group_comm);
+        
+        
+        /*!
+         *  @returns a sorted random subset of \p n design variable ids out
+         *  of \p n_vars. The same \p seed gives the same subset on all ranks.
+         */
+        static std::vector<unsigned int>
+        random_variable_subset(unsigned int n_vars,
+                               unsigned int n,
+                               unsigned int seed = 0);
+        
+        
+        /*!
+         *   Enables or disables the memoization of function evaluations.
+         *   When enabled, cached_evaluate() returns the stored objective,
+         *   constraint and gradient values for a design point that matches
+         *   a previously evaluated point with
+         *   \f$ |x_i - \bar{x}_i| \le tol (1 + |\bar{x}_i|) \f$ for all i.
+         *   The tolerance should be well below any finite difference step
+         *   used with this object. Note that a cache hit does not call
+         *   evaluate(), so any side effects of evaluate() on the analysis
+         *   systems will not be repeated. At most \p max_evaluations design
+         *   points are kept, and the least recently used point is discarded
+         *   when a new point is added. A value of zero does not limit the
+         *   size of the cache.
+         */
+        void set_evaluation_cache(bool f,
+                                  Real tol = 1.e-12,
+                                  unsigned int max_evaluations = 100);
+        
+        
+        /*!
+         *   clears the stored evaluation history.
+         */
+        void clear_evaluation_cache();
+        
+        
+        /*!
+         *   @returns the number of design points stored in the cache.
+         */
+        unsigned int n_cached_evaluations() const {
+            return (unsigned int)_cache.size();
+        }
+        
+        
+        /*!
+         *   @returns the number of calls to cached_evaluate() that were
+         *   satisfied from the cache.
+         */
+        unsigned int n_cache_hits() const {
+            return _n_cache_hits;
+        }
+        
+        
+        /*!
+         *   The history of evaluations is written to the binary file
+         *   \p nm after every \p interval new evaluations. Only rank 0
+         *   writes the file. Each write appends the evaluations that were
+         *   added or updated since the previous write, and evaluations are
+         *   also written before they are discarded from the cache, so the
+         *   file holds the complete history. A record that was only partly
+         *   written when a run was interrupted is ignored when the file is
+         *   read. If \p nm is the file last read by load_checkpoint(), new
+         *   evaluations are appended to it. Otherwise the file is truncated
+         *   in place by this call, and the evaluations in the cache are
+         *   written to it with the next checkpoint. Setting \p interval to
+         *   zero disables checkpointing. Checkpointing requires the
+         *   evaluation cache.
+         *
+         *   The records are appended with an ordinary stream write, and
+         *   no temporary file or rename is used. An interrupted write
+         *   loses at most the last record. The file is not synced to disk,
+         *   so records written shortly before a system failure may be lost.
+         */
+        void set_checkpoint_file(const std::string& nm,
+                                 unsigned int interval = 1);
+        
+        
+        /*!
+         *   appends the evaluations that have not yet been written to the
+         *   checkpoint file. If the gradients are stored in blocks
+         *   distributed over the ranks, they are gathered on rank 0, so
+         *   all ranks must call this. Only rank 0 opens the file, appends
+         *   the records and closes it.
+         */
+        void write_checkpoint();
+        
+        
+        /*!
+         *   reads the evaluation history from the binary file \p nm written
+         *   by a previous run and adds it to the cache, which is enabled
+         *   if it was not already. All ranks read the file. The optimizers
+         *   in MAST are deterministic, so restarting from the initial design
+         *   replays the previous iterates from the cache without any
+         *   analysis until the history is exhausted, which restores the
+         *   optimizer state at the point of the last checkpoint. All records
+         *   are kept until the replay is complete, even if they exceed the
+         *   size of the cache, since they are discarded only when new
+         *   evaluations are added.
+         *   @returns the number of evaluations read from the file.
+         */
+        unsigned int load_checkpoint(const std::string& nm);
+        
+        
+        /*!
+         *   Same interface as evaluate(). If the evaluation cache is enabled
+         *   and contains the design point along with all requested
+         *   gradients, the stored values are returned. Otherwise,
+         *   evaluate() is called and its results are added to the cache.
+         *   The optimizer interfaces use this method. Since the design
+         *   vector is identical on all ranks, all ranks take the same
+         *   branch and the collective operations in evaluate() are
+         *   unaffected.
+         */
+        void cached_evaluate(const std::vector<Real>& dvars,
+                             Real& obj,
+                             bool eval_obj_grad,
+                             std::vector<Real>& obj_grad,
+                             std::vector<Real>& fvals,
+                             std::vector<bool>& eval_grads,
+                             std::vector<Real>& grads);
+        
+        
+        /*!
+         *   Same interface as evaluate_local(), with the cache used as in
+         *   cached_evaluate(). A stored evaluation is used if its gradients
+         *   include the design variables in [\p first, \p last). The
+         *   cache of each rank stores only the gradients of its own block.
+         */
+        void cached_evaluate_local(const std::vector<Real>& dvars,
+                                   unsigned int first,
+                                   unsigned int last,
+                                   Real& obj,
+                                   bool eval_obj_grad,
+                                   std::vector<Real>& obj_grad,
+                                   std::vector<Real>& fvals,
+                                   std::vector<bool>& eval_grads,
+                                   std::vector<Real>& grads);
+        
+        
+        /*!
+         *   Same interface as evaluate_distributed(). If the evaluation
+         *   cache is disabled this calls evaluate_distributed(). Otherwise,
+         *   the cache stores complete design points, so \p dvars is
+         *   localized on all ranks and cached_evaluate_local() is used for
+         *   the local block of design variables.
+         */
+        void cached_evaluate_distributed(const libMesh::NumericVector<Real>& dvars,
+                                         Real& obj,
+                                         bool eval_obj_grad,
+                                         std::vector<Real>& obj_grad,
+                                         std::vector<Real>& fvals,
+                                         std::vector<bool>& eval_grads,
+                                         std::vector<Real>& grads);
+        
+        
         
         /*!
          *  @returns a pointer to the function that evaluates the objective
@@ -187,6 +452,41 @@ namespace MAST {
         
     protected:
         
+        /*!
+         *   stored data from a single call to evaluate(). The gradients
+         *   are stored for the design variables in [first, last).
+         */
+        struct CachedEvaluation {
+            
+            std::vector<Real>  dvars;
+            unsigned int       first;
+            unsigned int       last;
+            Real               obj;
+            bool               if_obj_grad;
+            std::vector<Real>  obj_grad;
+            std::vector<Real>  fvals;
+            std::vector<bool>  if_grads;
+            std::vector<Real>  grads;
+            bool               if_checkpointed;
+        };
+        
+        
+        /*!
+         *   @returns the cached evaluation matching \p dvars within the
+         *   cache tolerance, or nullptr if none was found. The most recent
+         *   evaluations are searched first, and the matching evaluation is
+         *   marked as the most recently used.
+         */
+        CachedEvaluation* _find_cached_evaluation(const std::vector<Real>& dvars);
+        
+        
+        /*!
+         *   discards the least recently used evaluations in excess of the
+         *   cache size, after writing them to the checkpoint file if needed.
+         */
+        void _limit_cache_size();
+        
+        
         unsigned int _n_vars;
         
         unsigned int _n_eq;
@@ -200,6 +500,33 @@ namespace MAST {
         Real _tol;
         
         std::ofstream* _output;
+        
+        bool _if_cache;
+        
+        Real _cache_tol;
+        
+        unsigned int _max_cached_evaluations;
+        
+        unsigned int _n_cache_hits;
+        
+        /*!
+         *   cached evaluations, ordered from the least to the most recently
+         *   used
+         */
+        std::list<CachedEvaluation> _cache;
+        
+        std::string _checkpoint_file;
+        
+        /*!
+         *   file read by the last call to load_checkpoint(), to which new
+         *   records can be appended. This is empty if the file ended
+         *   with an incomplete record.
+         */
+        std::string _loaded_checkpoint_file;
+        
+        unsigned int _checkpoint_interval;
+        
+        unsigned int _n_uncheckpointed;
     };
 
 
@@ -147,9 +147,9 @@ MAST::GCMMAOptimizationInterface::optimize() {
          C  at XVAL. The result should be put in F0VAL,DF0DX,FVAL,DFDX.
          C*/
         std::fill(eval_grads.begin(), eval_grads.end(), true);
-        _feval->evaluate(XVAL,
-                         F0VAL, true, DF0DX,
-                         FVAL, eval_grads, DFDX);
+        _feval->cached_evaluate(XVAL,
+                                F0VAL, true, DF0DX,
+                                FVAL, eval_grads, DFDX);
         if (ITER == 1)
             // output the very first iteration
             _feval->output(0, XVAL, F0VAL, FVAL, true);
@@ -183,9 +183,9 @@ MAST::GCMMAOptimizationInterface::optimize() {
              C  The result should be put in F0NEW and FNEW.
              C*/
             std::fill(eval_grads.begin(), eval_grads.end(), false);
-            _feval->evaluate(XMMA,
-                             F0NEW, false, DF0DX,
-                             FNEW, eval_grads, DFDX);
+            _feval->cached_evaluate(XMMA,
+                                    F0NEW, false, DF0DX,
+                                    FNEW, eval_grads, DFDX);
             
             if (INNER >= INNMAX)
                 inner_terminate = true;
@@ -0,0 +1,626 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2017  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+// C++ includes
+#include <limits>
+
+// MAST includes
+#include "optimization/mma_optimization_interface.h"
+#include "optimization/function_evaluation.h"
+
+// libMesh includes
+#include "libmesh/numeric_vector.h"
+
+
+MAST::MMAOptimizationInterface::MMAOptimizationInterface():
+MAST::OptimizationInterface(),
+max_inner_iterations (15),
+move_limit           (0.5),
+asymptote_init       (0.5),
+asymptote_increase   (1.2),
+asymptote_decrease   (0.7),
+_epsimin             (1.e-7) {
+    
+}
+
+
+
+void
+MAST::MMAOptimizationInterface::optimize() {
+    
+    libmesh_assert(_feval);
+    
+    const libMesh::Parallel::Communicator& comm = _feval->comm();
+    
+    const unsigned int
+    N                  = _feval->n_vars(),
+    M                  = _feval->n_eq() + _feval->n_ineq(),
+    n_rel_change_iters = _feval->n_iters_relative_change(),
+    n                  = (unsigned int)((1.*N*(comm.rank()+1))/comm.size()) -
+                         (unsigned int)((1.*N*comm.rank())/comm.size());
+    
+    libmesh_assert_greater(M, 0);
+    libmesh_assert_greater(N, 0);
+    
+    const Real
+    GEPS      = _feval->tolerance(),
+    albefa    = 0.1,
+    raa0eps   = 1.e-6,
+    raaeps    = 1.e-6,
+    raacofmin = 1.e-12;
+    
+    //////////////////////////////////////////////////////////////////////
+    // the design variables and their bounds are stored in distributed
+    // vectors, and the function evaluation object returns the gradients
+    // only for the local block of design variables.
+    //////////////////////////////////////////////////////////////////////
+    std::auto_ptr<libMesh::NumericVector<Real> >
+    x_vec    (libMesh::NumericVector<Real>::build(comm).release()),
+    xmin_vec (libMesh::NumericVector<Real>::build(comm).release()),
+    xmax_vec (libMesh::NumericVector<Real>::build(comm).release());
+    
+    x_vec->init   (N, n, false, libMesh::PARALLEL);
+    xmin_vec->init(N, n, false, libMesh::PARALLEL);
+    xmax_vec->init(N, n, false, libMesh::PARALLEL);
+    
+    _feval->init_distributed_dvar(*x_vec, *xmin_vec, *xmax_vec);
+    
+    const unsigned int
+    first = x_vec->first_local_index();
+    
+    std::vector<Real>
+    df0dx_loc (n, 0.),
+    dfdx_loc  (n*M, 0.),
+    fval_all  (M, 0.),
+    fnew_all  (M, 0.),
+    f0_iters  (n_rel_change_iters, 0.);
+    
+    std::vector<bool>
+    eval_grads(M, false);
+    
+    RealVectorX
+    xval    = RealVectorX::Zero(n),
+    xold1   = RealVectorX::Zero(n),
+    xold2   = RealVectorX::Zero(n),
+    xmin    = RealVectorX::Zero(n),
+    xmax    = RealVectorX::Zero(n),
+    xmami   = RealVectorX::Zero(n),
+    df0dx   = RealVectorX::Zero(n),
+    uxinv,
+    xlinv,
+    fval    = RealVectorX::Zero(M),
+    fnew    = RealVectorX::Zero(M),
+    fapp    = RealVectorX::Zero(M),
+    r       = RealVectorX::Zero(M),
+    raa     = RealVectorX::Zero(M);
+    
+    RealMatrixX
+    dfdx    = RealMatrixX::Zero(M, n);
+    
+    for (unsigned int j=0; j<n; j++) {
+        xval(j) = (*x_vec)   (first+j);
+        xmin(j) = (*xmin_vec)(first+j);
+        xmax(j) = (*xmax_vec)(first+j);
+    }
+    
+    xmami = (xmax - xmin).cwiseMax(1.e-5);
+    
+    // set the value of c[i] to be very large numbers
+    const Real
+    max_x = x_vec->linfty_norm();
+    
+    Subproblem sp;
+    sp.a0   = 1.;
+    sp.a    = RealVectorX::Zero(M);
+    sp.c    = RealVectorX::Constant(M, std::max(1.e6*max_x, 1.e6));
+    sp.d    = RealVectorX::Ones(M);
+    sp.low  = RealVectorX::Zero(n);
+    sp.upp  = RealVectorX::Zero(n);
+    
+    SubproblemSolution v;
+    
+    Real
+    f0val   = 0.,
+    f0new   = 0.,
+    f0app   = 0.,
+    r0      = 0.,
+    raa0    = 0.;
+    
+    unsigned int
+    iter    = 0;
+    
+    bool
+    terminate = false;
+    
+    while (!terminate) {
+        
+        iter++;
+        
+        //////////////////////////////////////////////////////////////////
+        // function values and gradients at the current design
+        //////////////////////////////////////////////////////////////////
+        std::fill(eval_grads.begin(), eval_grads.end(), true);
+        _feval->cached_evaluate_distributed(*x_vec,
+                                            f0val, true, df0dx_loc,
+                                            fval_all, eval_grads, dfdx_loc);
+        if (iter == 1)
+            // output the very first iteration
+            _feval->output_distributed(0, *x_vec, f0val, fval_all, true);
+        
+        for (unsigned int i=0; i<M; i++)
+            fval(i) = fval_all[i];
+        
+        for (unsigned int j=0; j<n; j++) {
+            df0dx(j) = df0dx_loc[j];
+            for (unsigned int i=0; i<M; i++)
+                dfdx(i, j) = dfdx_loc[j*M+i];
+        }
+        
+        //////////////////////////////////////////////////////////////////
+        // initial values of raa0 and raa for this iteration
+        //////////////////////////////////////////////////////////////////
+        raa0 = df0dx.cwiseAbs().dot(xmami);
+        comm.sum(raa0);
+        raa0 = std::max(raa0eps, (0.1/N)*raa0);
+        
+        raa  = dfdx.cwiseAbs() * xmami;
+        _sum(raa);
+        raa  = ((0.1/N)*raa).cwiseMax(raaeps);
+        
+        //////////////////////////////////////////////////////////////////
+        // asymptotes and bounds of the subproblem
+        //////////////////////////////////////////////////////////////////
+        if (iter <= 2) {
+            
+            sp.low = xval - asymptote_init*(xmax-xmin);
+            sp.upp = xval + asymptote_init*(xmax-xmin);
+        }
+        else {
+            
+            for (unsigned int j=0; j<n; j++) {
+                
+                Real
+                zzz    = (xval(j)-xold1(j))*(xold1(j)-xold2(j)),
+                factor = 1.;
+                
+                if (zzz > 0.)      factor = asymptote_increase;
+                else if (zzz < 0.) factor = asymptote_decrease;
+                
+                sp.low(j) = xval(j) - factor*(xold1(j) - sp.low(j));
+                sp.upp(j) = xval(j) + factor*(sp.upp(j) - xold1(j));
+                
+                sp.low(j) = std::max(sp.low(j), xval(j) - 10.  *(xmax(j)-xmin(j)));
+                sp.low(j) = std::min(sp.low(j), xval(j) - 0.01 *(xmax(j)-xmin(j)));
+                sp.upp(j) = std::min(sp.upp(j), xval(j) + 10.  *(xmax(j)-xmin(j)));
+                sp.upp(j) = std::max(sp.upp(j), xval(j) + 0.01 *(xmax(j)-xmin(j)));
+            }
+        }
+        
+        sp.alfa = (sp.low + albefa*(xval-sp.low)).cwiseMax(xval - move_limit*(xmax-xmin)).cwiseMax(xmin);
+        sp.beta = (sp.upp - albefa*(sp.upp-xval)).cwiseMin(xval + move_limit*(xmax-xmin)).cwiseMin(xmax);
+        
+        //////////////////////////////////////////////////////////////////
+        // inner iterations until the approximations are conservative
+        //////////////////////////////////////////////////////////////////
+        unsigned int
+        inner = 0;
+        
+        bool
+        inner_terminate = false;
+        
+        while (!inner_terminate) {
+            
+            // approximation coefficients
+            const RealVectorX
+            ux1 = sp.upp - xval,
+            xl1 = xval - sp.low;
+            
+            uxinv = ux1.cwiseInverse();
+            xlinv = xl1.cwiseInverse();
+            
+            sp.p0 = df0dx.cwiseMax(0.);
+            sp.q0 = (-df0dx).cwiseMax(0.);
+            {
+                const RealVectorX pq0 = 0.001*(sp.p0 + sp.q0) + raa0*xmami.cwiseInverse();
+                sp.p0 = (sp.p0 + pq0).cwiseProduct(ux1.cwiseAbs2());
+                sp.q0 = (sp.q0 + pq0).cwiseProduct(xl1.cwiseAbs2());
+            }
+            
+            sp.P  = dfdx.cwiseMax(0.);
+            sp.Q  = (-dfdx).cwiseMax(0.);
+            {
+                const RealMatrixX PQ = 0.001*(sp.P + sp.Q) + raa*xmami.cwiseInverse().transpose();
+                sp.P  = (sp.P + PQ) * ux1.cwiseAbs2().asDiagonal();
+                sp.Q  = (sp.Q + PQ) * xl1.cwiseAbs2().asDiagonal();
+            }
+            
+            r0 = sp.p0.dot(uxinv) + sp.q0.dot(xlinv);
+            comm.sum(r0);
+            r0 = f0val - r0;
+            
+            r  = sp.P * uxinv + sp.Q * xlinv;
+            _sum(r);
+            r  = fval - r;
+            
+            sp.b = -r;
+            
+            // solve the subproblem
+            _solve_subproblem(sp, v);
+            
+            // function values at the new design
+            for (unsigned int j=0; j<n; j++)
+                x_vec->set(first+j, v.x(j));
+            x_vec->close();
+            
+            std::fill(eval_grads.begin(), eval_grads.end(), false);
+            _feval->cached_evaluate_distributed(*x_vec,
+                                                f0new, false, df0dx_loc,
+                                                fnew_all, eval_grads, dfdx_loc);
+            
+            for (unsigned int i=0; i<M; i++)
+                fnew(i) = fnew_all[i];
+            
+            // value of the approximations at the new design
+            uxinv = (sp.upp - v.x).cwiseInverse();
+            xlinv = (v.x - sp.low).cwiseInverse();
+            
+            f0app = sp.p0.dot(uxinv) + sp.q0.dot(xlinv);
+            comm.sum(f0app);
+            f0app += r0;
+            
+            fapp  = sp.P * uxinv + sp.Q * xlinv;
+            _sum(fapp);
+            fapp += r;
+            
+            // check if the approximations were conservative
+            bool
+            conservative = (f0app + _epsimin >= f0new);
+            for (unsigned int i=0; i<M; i++)
+                conservative = conservative && (fapp(i) + _epsimin >= fnew(i));
+            
+            if (conservative || inner >= max_inner_iterations)
+                inner_terminate = true;
+            else {
+                
+                // the approximations were not conservative, so raa0 and
+                // raa are updated and one more inner iteration is started.
+                inner++;
+                
+                Real
+                raacof = 0.;
+                
+                for (unsigned int j=0; j<n; j++)
+                    raacof +=
+                    (v.x(j)-xval(j))/(sp.upp(j)-v.x(j)) *
+                    (v.x(j)-xval(j))/(v.x(j)-sp.low(j)) *
+                    (sp.upp(j)-sp.low(j))/xmami(j);
+                comm.sum(raacof);
+                raacof = std::max(raacof, raacofmin);
+                
+                if (f0new > f0app + 0.5*_epsimin)
+                    raa0 = std::min(1.1*(raa0 + (f0new-f0app)/raacof), 10.*raa0);
+                
+                for (unsigned int i=0; i<M; i++)
+                    if (fnew(i) > fapp(i) + 0.5*_epsimin)
+                        raa(i) = std::min(1.1*(raa(i) + (fnew(i)-fapp(i))/raacof), 10.*raa(i));
+            }
+        }
+        
+        //////////////////////////////////////////////////////////////////
+        // update the design variables and function values
+        //////////////////////////////////////////////////////////////////
+        xold2    = xold1;
+        xold1    = xval;
+        xval     = v.x;
+        f0val    = f0new;
+        fval_all = fnew_all;
+        
+        _feval->output_distributed(iter, *x_vec, f0val, fval_all, true);
+        f0_iters[(iter-1)%n_rel_change_iters] = f0val;
+        
+        if (iter == _feval->max_iters()) {
+            libMesh::out
+            << "MMA: Reached maximum iterations, terminating! "
+            << std::endl;
+            terminate = true;
+        }
+        
+        // relative change in objective
+        bool rel_change_conv = (iter >= n_rel_change_iters);
+        
+        for (unsigned int i=0; i<n_rel_change_iters; i++) {
+            if (fabs(f0val) > sqrt(GEPS))
+                rel_change_conv = (rel_change_conv &&
+                                   fabs(f0_iters[i]-f0val)/fabs(f0val) < GEPS);
+            else
+                rel_change_conv = (rel_change_conv &&
+                                   fabs(f0_iters[i]-f0val) < GEPS);
+        }
+        if (rel_change_conv) {
+            libMesh::out
+            << "MMA: Converged relative change tolerance, terminating! "
+            << std::endl;
+            terminate = true;
+        }
+    }
+}
+
+
+
+void
+MAST::MMAOptimizationInterface::_solve_subproblem(const Subproblem& sp,
+                                                  SubproblemSolution& v) const {
+    
+    const libMesh::Parallel::Communicator& comm = _feval->comm();
+    
+    const unsigned int
+    m = (unsigned int)sp.b.size(),
+    n = (unsigned int)sp.low.size();
+    
+    Real
+    epsi     = 1.,
+    res_norm = 0.,
+    res_max  = 0.;
+    
+    // initial point
+    v.x   = 0.5*(sp.alfa + sp.beta);
+    v.y   = RealVectorX::Ones(m);
+    v.z   = 1.;
+    v.lam = RealVectorX::Ones(m);
+    v.xsi = (v.x - sp.alfa).cwiseInverse().cwiseMax(1.);
+    v.eta = (sp.beta - v.x).cwiseInverse().cwiseMax(1.);
+    v.mu  = (0.5*sp.c).cwiseMax(1.);
+    v.zet = 1.;
+    v.s   = RealVectorX::Ones(m);
+    
+    RealVectorX
+    ux1, xl1, ux2, xl2, plam, qlam, gvec, dpsidx,
+    delx, dely, dellam, diagx, diagxinv, diagy, diaglamyi, blam, bb, solut,
+    dx, dy, dlam, dxsi, deta, dmu, ds;
+    
+    RealMatrixX
+    GG, Alam, AA;
+    
+    Real
+    delz = 0., dz = 0., dzet = 0.;
+    
+    SubproblemSolution
+    v_old;
+    
+    while (epsi > _epsimin) {
+        
+        res_norm = _subproblem_residual(sp, v, epsi, res_max);
+        
+        unsigned int
+        iter = 0;
+        
+        while (res_max > 0.9*epsi && iter < 200) {
+            
+            iter++;
+            
+            ux1   = sp.upp - v.x;
+            xl1   = v.x - sp.low;
+            ux2   = ux1.cwiseAbs2();
+            xl2   = xl1.cwiseAbs2();
+            
+            plam  = sp.p0 + sp.P.transpose() * v.lam;
+            qlam  = sp.q0 + sp.Q.transpose() * v.lam;
+            
+            gvec  = sp.P * ux1.cwiseInverse() + sp.Q * xl1.cwiseInverse();
+            _sum(gvec);
+            
+            GG    = sp.P * ux2.cwiseInverse().asDiagonal() - sp.Q * xl2.cwiseInverse().asDiagonal();
+            
+            dpsidx = plam.cwiseQuotient(ux2) - qlam.cwiseQuotient(xl2);
+            
+            delx   = dpsidx - epsi*(v.x - sp.alfa).cwiseInverse() + epsi*(sp.beta - v.x).cwiseInverse();
+            dely   = sp.c + sp.d.cwiseProduct(v.y) - v.lam - epsi*v.y.cwiseInverse();
+            delz   = sp.a0 - sp.a.dot(v.lam) - epsi/v.z;
+            dellam = gvec - sp.a*v.z - v.y - sp.b + epsi*v.lam.cwiseInverse();
+            
+            diagx  = 2.*(plam.cwiseQuotient(ux2.cwiseProduct(ux1)) +
+                         qlam.cwiseQuotient(xl2.cwiseProduct(xl1))) +
+            v.xsi.cwiseQuotient(v.x - sp.alfa) + v.eta.cwiseQuotient(sp.beta - v.x);
+            diagxinv  = diagx.cwiseInverse();
+            diagy     = sp.d + v.mu.cwiseQuotient(v.y);
+            diaglamyi = v.s.cwiseQuotient(v.lam) + diagy.cwiseInverse();
+            
+            // the reduced system is of size m+1, and its contributions
+            // from the design variables are summed over all processors
+            blam   = GG * delx.cwiseProduct(diagxinv);
+            Alam   = GG * diagxinv.asDiagonal() * GG.transpose();
+            _sum(blam);
+            _sum(Alam);
+            
+            blam   = dellam + dely.cwiseQuotient(diagy) - blam;
+            Alam  += diaglamyi.asDiagonal();
+            
+            AA     = RealMatrixX::Zero(m+1, m+1);
+            bb     = RealVectorX::Zero(m+1);
+            AA.topLeftCorner(m, m) = Alam;
+            AA.topRightCorner(m, 1)    = sp.a;
+            AA.bottomLeftCorner(1, m)  = sp.a.transpose();
+            AA(m, m) = -v.zet/v.z;
+            bb.head(m) = blam;
+            bb(m)      = delz;
+            
+            solut  = AA.partialPivLu().solve(bb);
+            dlam   = solut.head(m);
+            dz     = solut(m);
+            
+            dx     = -(delx + GG.transpose() * dlam).cwiseProduct(diagxinv);
+            dy     = (dlam - dely).cwiseQuotient(diagy);
+            dxsi   = -v.xsi + epsi*(v.x - sp.alfa).cwiseInverse() - v.xsi.cwiseProduct(dx).cwiseQuotient(v.x - sp.alfa);
+            deta   = -v.eta + epsi*(sp.beta - v.x).cwiseInverse() + v.eta.cwiseProduct(dx).cwiseQuotient(sp.beta - v.x);
+            dmu    = -v.mu  + epsi*v.y.cwiseInverse() - v.mu.cwiseProduct(dy).cwiseQuotient(v.y);
+            dzet   = -v.zet + epsi/v.z - v.zet*dz/v.z;
+            ds     = -v.s   + epsi*v.lam.cwiseInverse() - v.s.cwiseProduct(dlam).cwiseQuotient(v.lam);
+            
+            // largest step that keeps the variables feasible
+            Real
+            stmx   = 1.;
+            
+            if (n) {
+                stmx = std::max(stmx, (-1.01*dx.cwiseQuotient(v.x - sp.alfa)).maxCoeff());
+                stmx = std::max(stmx, ( 1.01*dx.cwiseQuotient(sp.beta - v.x)).maxCoeff());
+                stmx = std::max(stmx, (-1.01*dxsi.cwiseQuotient(v.xsi)).maxCoeff());
+                stmx = std::max(stmx, (-1.01*deta.cwiseQuotient(v.eta)).maxCoeff());
+            }
+            comm.max(stmx);
+            
+            stmx = std::max(stmx, (-1.01*dy.cwiseQuotient(v.y)).maxCoeff());
+            stmx = std::max(stmx, (-1.01*dlam.cwiseQuotient(v.lam)).maxCoeff());
+            stmx = std::max(stmx, (-1.01*dmu.cwiseQuotient(v.mu)).maxCoeff());
+            stmx = std::max(stmx, (-1.01*ds.cwiseQuotient(v.s)).maxCoeff());
+            stmx = std::max(stmx, -1.01*dz/v.z);
+            stmx = std::max(stmx, -1.01*dzet/v.zet);
+            
+            Real
+            steg   = 1./stmx,
+            resinew = 2.*res_norm;
+            
+            v_old  = v;
+            
+            unsigned int
+            itto   = 0;
+            
+            // step length reduction until the residual decreases
+            while (resinew > res_norm && itto < 50) {
+                
+                itto++;
+                
+                v.x   = v_old.x   + steg*dx;
+                v.y   = v_old.y   + steg*dy;
+                v.z   = v_old.z   + steg*dz;
+                v.lam = v_old.lam + steg*dlam;
+                v.xsi = v_old.xsi + steg*dxsi;
+                v.eta = v_old.eta + steg*deta;
+                v.mu  = v_old.mu  + steg*dmu;
+                v.zet = v_old.zet + steg*dzet;
+                v.s   = v_old.s   + steg*ds;
+                
+                resinew = _subproblem_residual(sp, v, epsi, res_max);
+                steg   /= 2.;
+            }
+            
+            res_norm = resinew;
+        }
+        
+        epsi *= 0.1;
+    }
+}
+
+
+
+Real
+MAST::MMAOptimizationInterface::_subproblem_residual(const Subproblem& sp,
+                                                     const SubproblemSolution& v,
+                                                     Real epsi,
+                                                     Real& res_max) const {
+    
+    const libMesh::Parallel::Communicator& comm = _feval->comm();
+    
+    const RealVectorX
+    ux1  = sp.upp - v.x,
+    xl1  = v.x - sp.low,
+    plam = sp.p0 + sp.P.transpose() * v.lam,
+    qlam = sp.q0 + sp.Q.transpose() * v.lam;
+    
+    RealVectorX
+    gvec = sp.P * ux1.cwiseInverse() + sp.Q * xl1.cwiseInverse();
+    _sum(gvec);
+    
+    // residuals of the local design variables
+    const RealVectorX
+    rex   = plam.cwiseQuotient(ux1.cwiseAbs2()) - qlam.cwiseQuotient(xl1.cwiseAbs2()) - v.xsi + v.eta,
+    rexsi = ((v.xsi.cwiseProduct(v.x - sp.alfa)).array() - epsi).matrix(),
+    reeta = ((v.eta.cwiseProduct(sp.beta - v.x)).array() - epsi).matrix();
+    
+    Real
+    res_norm = rex.squaredNorm() + rexsi.squaredNorm() + reeta.squaredNorm();
+    
+    res_max  = 0.;
+    if (rex.size())
+        res_max = std::max(rex.lpNorm<Eigen::Infinity>(),
+                           std::max(rexsi.lpNorm<Eigen::Infinity>(),
+                                    reeta.lpNorm<Eigen::Infinity>()));
+    
+    comm.sum(res_norm);
+    comm.max(res_max);
+    
+    // residuals of the constraint quantities, which are the same on all
+    // processors
+    const RealVectorX
+    rey   = sp.c + sp.d.cwiseProduct(v.y) - v.mu - v.lam,
+    relam = gvec - sp.a*v.z - v.y + v.s - sp.b,
+    remu  = ((v.mu.cwiseProduct(v.y)).array() - epsi).matrix(),
+    res   = ((v.lam.cwiseProduct(v.s)).array() - epsi).matrix();
+    
+    const Real
+    rez   = sp.a0 - v.zet - sp.a.dot(v.lam),
+    rezet = v.zet*v.z - epsi;
+    
+    res_norm +=
+    rey.squaredNorm() + relam.squaredNorm() + remu.squaredNorm() + res.squaredNorm() +
+    rez*rez + rezet*rezet;
+    
+    res_max = std::max(res_max, rey.lpNorm<Eigen::Infinity>());
+    res_max = std::max(res_max, relam.lpNorm<Eigen::Infinity>());
+    res_max = std::max(res_max, remu.lpNorm<Eigen::Infinity>());
+    res_max = std::max(res_max, res.lpNorm<Eigen::Infinity>());
+    res_max = std::max(res_max, std::max(fabs(rez), fabs(rezet)));
+    
+    return sqrt(res_norm);
+}
+
+
+
+void
+MAST::MMAOptimizationInterface::_sum(RealVectorX& v) const {
+    
+    if (!v.size())
+        return;
+    
+    std::vector<Real>
+    vals(v.data(), v.data()+v.size());
+    
+    _feval->comm().sum(vals);
+    
+    for (unsigned int i=0; i<vals.size(); i++)
+        v(i) = vals[i];
+}
+
+
+
+void
+MAST::MMAOptimizationInterface::_sum(RealMatrixX& m) const {
+    
+    if (!m.size())
+        return;
+    
+    std::vector<Real>
+    vals(m.data(), m.data()+m.size());
+    
+    _feval->comm().sum(vals);
+    
+    for (unsigned int i=0; i<vals.size(); i++)
+        m.data()[i] = vals[i];
+}
+
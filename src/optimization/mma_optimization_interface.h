@@ -0,0 +1,146 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2017  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#ifndef __MAST_mma_optimization_interface_h__
+#define __MAST_mma_optimization_interface_h__
+
+// C++ includes
+#include <vector>
+
+// MAST includes
+#include "optimization/optimization_interface.h"
+
+
+namespace MAST {
+    
+    /*!
+     *   Native implementation of the globally convergent method of moving
+     *   asymptotes (GCMMA) by K. Svanberg, which does not need the external
+     *   GCMMA library. The subproblem is solved by the primal-dual
+     *   interior point method of Svanberg.
+     *
+     *   The design variables are split into contiguous blocks over the
+     *   processors of the function evaluation communicator. The
+     *   asymptotes, move limits and the approximation coefficients, which
+     *   include the \f$ M \times N \f$ arrays, are stored only for the
+     *   local block. The subproblem solution needs only reductions of
+     *   vectors and matrices of size \f$ M \f$. The design variables and
+     *   their bounds are stored in distributed vectors, which are passed
+     *   to MAST::FunctionEvaluation::evaluate_distributed, and the
+     *   gradients are returned only for the local block of design
+     *   variables. The default implementations of the distributed methods
+     *   in MAST::FunctionEvaluation localize the design vector for
+     *   derived classes that need the complete vector.
+     */
+    class MMAOptimizationInterface: public MAST::OptimizationInterface {
+        
+    public:
+        
+        MMAOptimizationInterface();
+        
+        virtual ~MMAOptimizationInterface()
+        { }
+        
+        virtual void optimize();
+        
+        /*!
+         *   maximum number of inner iterations for conservative
+         *   approximations. Default is 15.
+         */
+        unsigned int max_inner_iterations;
+        
+        /*!
+         *   move limit as a fraction of the design variable range.
+         *   Default is 0.5.
+         */
+        Real move_limit;
+        
+        /*!
+         *   initial distance of the asymptotes from the design variable, as
+         *   a fraction of the design variable range. Default is 0.5.
+         */
+        Real asymptote_init;
+        
+        /*!
+         *   factor by which the asymptotes are expanded when the design
+         *   variable changes monotonically. Default is 1.2.
+         */
+        Real asymptote_increase;
+        
+        /*!
+         *   factor by which the asymptotes are contracted when the design
+         *   variable oscillates. Default is 0.7.
+         */
+        Real asymptote_decrease;
+        
+    protected:
+        
+        /*!
+         *   coefficients of the MMA subproblem. The vectors of size N and
+         *   the matrices of size M x N only contain the entries for the
+         *   local design variables.
+         */
+        struct Subproblem {
+            RealVectorX low, upp, alfa, beta, p0, q0, a, b, c, d;
+            RealMatrixX P, Q;
+            Real a0;
+        };
+        
+        /*!
+         *   primal and dual variables of the MMA subproblem. The vectors
+         *   \p x, \p xsi and \p eta only contain the entries for the local
+         *   design variables.
+         */
+        struct SubproblemSolution {
+            RealVectorX x, xsi, eta, y, lam, mu, s;
+            Real z, zet;
+        };
+        
+        /*!
+         *   solves the subproblem with the primal-dual interior point method
+         */
+        void _solve_subproblem(const Subproblem& sp,
+                               SubproblemSolution& v) const;
+        
+        /*!
+         *   @returns the l2 norm of the residual of the subproblem
+         *   optimality conditions with relaxation \p epsi, and its maximum
+         *   absolute entry in \p res_max.
+         */
+        Real _subproblem_residual(const Subproblem& sp,
+                                  const SubproblemSolution& v,
+                                  Real epsi,
+                                  Real& res_max) const;
+        
+        /*!
+         *   sums the vector or matrix over all processors
+         */
+        void _sum(RealVectorX& v) const;
+        void _sum(RealMatrixX& m) const;
+        
+        /*!
+         *   tolerance of the interior point method for the subproblem
+         */
+        Real _epsimin;
+    };
+}
+
+
+#endif // __MAST_mma_optimization_interface_h__
@@ -23,6 +23,7 @@
 
 // MAST includes
 #include "property_cards/element_property_card_base.h"
+#include "base/field_function_base.h"
 
 
 
@@ -172,6 +173,21 @@ namespace MAST
          *   section area moment of inertia
          */
         virtual MAST::FieldFunction<RealMatrixX>& I() = 0;
+        
+        
+        /*!
+         *   @returns constant reference to the function \p nm, which is one
+         *   of "hy", "hz", "hy_off" and "hz_off". The stress recovery points
+         *   of the section are placed at \f$ y = \xi h_y/2 + h_{y,off} \f$
+         *   and \f$ z = \eta h_z/2 + h_{z,off} \f$ for section coordinates
+         *   \f$ \xi, \eta \in [-1, 1] \f$. By default, these are the
+         *   functions of the same name in this card.
+         */
+        virtual const MAST::FieldFunction<Real>&
+        stress_recovery_function(const std::string& nm) const {
+            
+            return this->get<MAST::FieldFunction<Real> >(nm);
+        }
 
         
     protected:
@@ -22,6 +22,7 @@
 #include "property_cards/multilayer_1d_section_element_property_card.h"
 #include "property_cards/solid_1d_section_element_property_card.h"
 #include "base/field_function_base.h"
+#include "property_cards/multilayer_section_cache.h"
 
 
 namespace MAST {
@@ -31,11 +32,13 @@ namespace MAST {
         public:
             LayerOffset(const Real base,
                         unsigned int layer_num,
-                        const std::vector<const MAST::FieldFunction<Real>*>& layer_hz):
+                        const std::vector<const MAST::FieldFunction<Real>*>& layer_hz,
+                        MAST::MultilayerSectionCache& cache):
             MAST::FieldFunction<Real>("hz_offset"),
             _base(base),
             _layer_num(layer_num),
-            _layer_hz(layer_hz) {
+            _layer_hz(layer_hz),
+            _cache(cache) {
                 for (unsigned int i=0; i < _layer_hz.size(); i++)
                     _functions.insert(_layer_hz[i]);
             }
@@ -49,21 +52,37 @@ namespace MAST {
             virtual void operator() (const libMesh::Point& p,
                                      const Real t,
                                      Real& m) const {
-                Real val = 0.;
-                m = 0.;
-                for (unsigned int i=0; i<_layer_num; i++) {
-                    (*_layer_hz[i])(p, t, val);
-                    m += val; // currently the offset is chosen from h=0;
-                }
-                // finally, add half of the current layer thickness
-                (*_layer_hz[_layer_num])(p, t, val);
-                m += 0.5*val;
                 
-                // now add the base offset
-                for (unsigned int i=0; i<_layer_hz.size(); i++) {
-                    (*_layer_hz[i])(p, t, val);
-                    m -= 0.5*(1.+_base)*val; // currently the offset is chosen from h=0;
+                const RealMatrixX*
+                off = _cache.get(MAST::MultilayerSectionCache::LAYER_OFFSETS,
+                                 nullptr, p, t);
+                
+                if (!off) {
+                    
+                    // offsets of all layers are computed in a single pass
+                    // over the layer thicknesses, and stored for the
+                    // other layers
+                    const unsigned int n = (unsigned int)_layer_hz.size();
+                    RealMatrixX v = RealMatrixX::Zero(n, 1);
+                    Real val = 0., h = 0., total = 0.;
+                    
+                    for (unsigned int i=0; i<n; i++) {
+                        (*_layer_hz[i])(p, t, val);
+                        v(i, 0) = h + 0.5*val; // offset from h=0
+                        h      += val;
+                    }
+                    total = h;
+                    
+                    // now add the base offset
+                    for (unsigned int i=0; i<n; i++)
+                        v(i, 0) -= 0.5*(1.+_base)*total;
+                    
+                    _cache.set(MAST::MultilayerSectionCache::LAYER_OFFSETS,
+                               nullptr, v);
+                    m = v(_layer_num, 0);
                 }
+                else
+                    m = (*off)(_layer_num, 0);
             }
             
             
@@ -71,21 +90,42 @@ namespace MAST {
                                 const libMesh::Point& p,
                                 const Real t,
                                 Real& m) const {
-                Real val = 0.;
-                m = 0.;
-                for (unsigned int i=0; i<_layer_num; i++) {
-                    _layer_hz[i]->derivative( f, p, t, val);
-                    m += val; // currently the offset is chosen from h=0;
-                }
-                // finally, add half of the current layer thickness
-                _layer_hz[_layer_num]->derivative( f, p, t, val);
-                m += 0.5*val;
                 
-                // now add the base offset
-                for (unsigned int i=0; i<_layer_hz.size(); i++) {
-                    _layer_hz[i]->derivative( f, p, t, val);
-                    m -= 0.5*(1.+_base)*val; // currently the offset is chosen from h=0;
+                const RealMatrixX*
+                off = _cache.get(MAST::MultilayerSectionCache::LAYER_OFFSETS,
+                                 &f, p, t);
+                
+                if (!off) {
+                    
+                    // only the layers with thickness dependent on f
+                    // contribute to the derivative
+                    const std::vector<bool>&
+                    dep = _cache.layer_dependence(MAST::MultilayerSectionCache::LAYER_OFFSETS,
+                                                  f, _layer_hz);
+                    
+                    const unsigned int n = (unsigned int)_layer_hz.size();
+                    RealMatrixX v = RealMatrixX::Zero(n, 1);
+                    Real val = 0., h = 0., total = 0.;
+                    
+                    for (unsigned int i=0; i<n; i++) {
+                        val = 0.;
+                        if (dep[i])
+                            _layer_hz[i]->derivative( f, p, t, val);
+                        v(i, 0) = h + 0.5*val; // offset from h=0
+                        h      += val;
+                    }
+                    total = h;
+                    
+                    // now add the base offset
+                    for (unsigned int i=0; i<n; i++)
+                        v(i, 0) -= 0.5*(1.+_base)*total;
+                    
+                    _cache.set(MAST::MultilayerSectionCache::LAYER_OFFSETS,
+                               &f, v);
+                    m = v(_layer_num, 0);
                 }
+                else
+                    m = (*off)(_layer_num, 0);
             }
             
         protected:
@@ -93,6 +133,7 @@ namespace MAST {
             const Real _base;
             const unsigned int _layer_num;
             const std::vector<const MAST::FieldFunction<Real>*> _layer_hz;
+            MAST::MultilayerSectionCache& _cache;
         };
         
         
@@ -101,14 +142,24 @@ namespace MAST {
         
         class Matrix: public MAST::FieldFunction<RealMatrixX> {
         public:
-            Matrix(std::vector<MAST::FieldFunction<RealMatrixX>*>& layer_mats):
+            /*!
+             *   \p cache stores the integrated values of quantity \p q.
+             *   If it is nullptr, the layers are integrated at every call.
+             */
+            Matrix(std::vector<MAST::FieldFunction<RealMatrixX>*>& layer_mats,
+                   MAST::MultilayerSectionCache* cache = nullptr,
+                   MAST::MultilayerSectionCache::Quantity q =
+                   MAST::MultilayerSectionCache::STIFFNESS_A):
             MAST::FieldFunction<RealMatrixX>("Matrix1D"),
-            _layer_mats(layer_mats) {
+            _layer_mats(layer_mats),
+            _cache(cache),
+            _q(q) {
                 for (unsigned int i=0; i < _layer_mats.size(); i++) {
                     _functions.insert(_layer_mats[i]);
                 }
             }
             
+            
             virtual ~Matrix() {
                 // delete all the layer functions
                 for (unsigned int i=0; i<_layer_mats.size(); i++)
@@ -118,6 +169,15 @@ namespace MAST {
             virtual void operator() (const libMesh::Point& p,
                                      const Real t,
                                      RealMatrixX& m) const {
+                
+                const RealMatrixX*
+                v = _cache?_cache->get(_q, nullptr, p, t):nullptr;
+                
+                if (v) {
+                    m = *v;
+                    return;
+                }
+                
                 // add the values of each matrix to get the integrated value
                 RealMatrixX mi;
                 for (unsigned int i=0; i<_layer_mats.size(); i++) {
@@ -129,6 +189,9 @@ namespace MAST {
                     
                     m += mi;
                 }
+                
+                if (_cache)
+                    _cache->set(_q, nullptr, m);
             }
             
             
@@ -136,23 +199,58 @@ namespace MAST {
                                 const libMesh::Point& p,
                                 const Real t,
                                 RealMatrixX& m) const {
+                
+                const RealMatrixX*
+                v = _cache?_cache->get(_q, &f, p, t):nullptr;
+                
+                if (v) {
+                    m = *v;
+                    return;
+                }
+                
+                // only the layers that depend on f contribute to the
+                // derivative
+                const std::vector<bool>*
+                dep = _cache?&_cache->layer_dependence(_q, f, _layer_mats):nullptr;
+                
                 // add the values of each matrix to get the integrated value
                 RealMatrixX mi;
+                bool sized = false;
                 for (unsigned int i=0; i<_layer_mats.size(); i++) {
+                    
+                    if (dep && !(*dep)[i])
+                        continue;
+                    
                     _layer_mats[i]->derivative( f, p, t, mi);
                     // use the size of the layer matrix to resize the output
                     // all other layers should return the same sized matrices
-                    if (i==0)
+                    if (!sized) {
                         m = RealMatrixX::Zero(mi.rows(), mi.cols());
+                        sized = true;
+                    }
                     
                     m += mi;
                 }
+                
+                // if no layer depends on f, the size is obtained from the
+                // value
+                if (!sized) {
+                    (*this)(p, t, m);
+                    m.setZero();
+                }
+                
+                if (_cache)
+                    _cache->set(_q, &f, m);
             }
             
             
         protected:
             
             std::vector<MAST::FieldFunction<RealMatrixX>*> _layer_mats;
+            
+            MAST::MultilayerSectionCache* _cache;
+            
+            MAST::MultilayerSectionCache::Quantity _q;
         };
     }
 }
@@ -194,10 +292,15 @@ set_layers(const Real base,
         // create the offset function
         _layer_offsets[i] =
         new MAST::Multilayer1DSectionProperty::LayerOffset
-        (base, i, layer_hz);
+        (base, i, layer_hz, _cache);
         // tell the layer about the offset
         _layers[i]->add(*_layer_offsets[i]);
     }
+    
+    // the integrated section quantities are cached for the state of the
+    // layer parameters
+    _cache.init(std::vector<const MAST::ElementPropertyCardBase*>(_layers.begin(),
+                                                                  _layers.end()));
 }
 
 
@@ -253,7 +356,7 @@ stiffness_A_matrix(const MAST::ElementBase& e) {
     // now create the integrated object
     std::auto_ptr<MAST::FieldFunction<RealMatrixX> > rval
     (new MAST::Multilayer1DSectionProperty::Matrix
-     (layer_mats));
+     (layer_mats, &_cache, MAST::MultilayerSectionCache::STIFFNESS_A));
     
     return rval;
 }
@@ -272,7 +375,7 @@ stiffness_B_matrix(const MAST::ElementBase& e) {
     // now create the integrated object
     std::auto_ptr<MAST::FieldFunction<RealMatrixX> > rval
     (new MAST::Multilayer1DSectionProperty::Matrix
-     (layer_mats));
+     (layer_mats, &_cache, MAST::MultilayerSectionCache::STIFFNESS_B));
     
     return rval;
 }
@@ -291,7 +394,7 @@ stiffness_D_matrix(const MAST::ElementBase& e) {
     // now create the integrated object
     std::auto_ptr<MAST::FieldFunction<RealMatrixX> > rval
     (new MAST::Multilayer1DSectionProperty::Matrix
-     (layer_mats));
+     (layer_mats, &_cache, MAST::MultilayerSectionCache::STIFFNESS_D));
     
     return rval;
 }
@@ -310,7 +413,7 @@ damping_matrix(const MAST::ElementBase& e) {
     // now create the integrated object
     std::auto_ptr<MAST::FieldFunction<RealMatrixX> > rval
     (new MAST::Multilayer1DSectionProperty::Matrix
-     (layer_mats));
+     (layer_mats, &_cache, MAST::MultilayerSectionCache::DAMPING));
     
     return rval;
 }
@@ -329,7 +432,7 @@ inertia_matrix(const MAST::ElementBase& e) {
     // now create the integrated object
     std::auto_ptr<MAST::FieldFunction<RealMatrixX> > rval
     (new MAST::Multilayer1DSectionProperty::Matrix
-     (layer_mats));
+     (layer_mats, &_cache, MAST::MultilayerSectionCache::INERTIA));
     
     return rval;
 }
@@ -348,7 +451,7 @@ thermal_expansion_A_matrix(const MAST::ElementBase& e) {
     // now create the integrated object
     std::auto_ptr<MAST::FieldFunction<RealMatrixX> > rval
     (new MAST::Multilayer1DSectionProperty::Matrix
-     (layer_mats));
+     (layer_mats, &_cache, MAST::MultilayerSectionCache::THERMAL_EXPANSION_A));
     
     return rval;
 }
@@ -367,7 +470,7 @@ thermal_expansion_B_matrix(const MAST::ElementBase& e) {
     // now create the integrated object
     std::auto_ptr<MAST::FieldFunction<RealMatrixX> > rval
     (new MAST::Multilayer1DSectionProperty::Matrix
-     (layer_mats));
+     (layer_mats, &_cache, MAST::MultilayerSectionCache::THERMAL_EXPANSION_B));
     
     return rval;
 }
@@ -386,7 +489,7 @@ transverse_shear_stiffness_matrix(const MAST::ElementBase& e) {
     // now create the integrated object
     std::auto_ptr<MAST::FieldFunction<RealMatrixX> > rval
     (new MAST::Multilayer1DSectionProperty::Matrix
-     (layer_mats));
+     (layer_mats, &_cache, MAST::MultilayerSectionCache::TRANSVERSE_SHEAR));
     
     return rval;
 }
@@ -23,6 +23,7 @@
 
 // MAST includes
 #include "property_cards/element_property_card_1D.h"
+#include "property_cards/multilayer_section_cache.h"
 
 
 namespace MAST {
@@ -76,6 +77,19 @@ namespace MAST {
         virtual bool depends_on(const MAST::FunctionBase& f) const;
         
         
+        /*!
+         *   The integrated section matrices and layer offsets are cached for
+         *   the current point, time and values of the parameters that the
+         *   layers depend on. If \p f is true, the layer properties are
+         *   assumed to not vary with location or time, and the integrated
+         *   matrices are computed only once for each state of the
+         *   parameters and reused at all quadrature points.
+         */
+        void set_uniform_layup(bool f) {
+            _cache.set_uniform(f);
+        }
+        
+        
         virtual std::auto_ptr<MAST::FieldFunction<RealMatrixX> >
         stiffness_A_matrix(const MAST::ElementBase& e);
         
@@ -111,6 +125,11 @@ namespace MAST {
 
         std::vector<MAST::FieldFunction<Real>*> _layer_offsets;
         
+        /*!
+         *   cache of the integrated section quantities
+         */
+        MAST::MultilayerSectionCache _cache;
+        
         /*!
          *   vector of thickness function for each layer
          */
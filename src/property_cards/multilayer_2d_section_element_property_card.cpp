@@ -22,6 +22,7 @@
 #include "property_cards/multilayer_2d_section_element_property_card.h"
 #include "property_cards/solid_2d_section_element_property_card.h"
 #include "base/field_function_base.h"
+#include "property_cards/multilayer_section_cache.h"
 
 
 namespace MAST {
@@ -32,11 +33,13 @@ namespace MAST {
         public:
             LayerOffset(const Real base,
                         unsigned int layer_num,
-                        const std::vector<const MAST::FieldFunction<Real>*>& layer_h):
+                        const std::vector<const MAST::FieldFunction<Real>*>& layer_h,
+                        MAST::MultilayerSectionCache& cache):
             MAST::FieldFunction<Real>("off"),
             _base(base),
             _layer_num(layer_num),
-            _layer_h(layer_h) {
+            _layer_h(layer_h),
+            _cache(cache) {
                 for (unsigned int i=0; i < _layer_h.size(); i++)
                     _functions.insert(_layer_h[i]);
             }
@@ -51,21 +54,37 @@ namespace MAST {
             virtual void operator() (const libMesh::Point& p,
                                      const Real t,
                                      Real& m) const {
-                Real val = 0.;
-                m = 0.;
-                for (unsigned int i=0; i<_layer_num; i++) {
-                    (*_layer_h[i])(p, t, val);
-                    m += val; // this calculates offset from h=0, and then it is modified for base
-                }
-                // finally, add half of the current layer thickness
-                (*_layer_h[_layer_num])(p, t, val);
-                m += 0.5*val;
                 
-                // now add the base offset
-                for (unsigned int i=0; i<_layer_h.size(); i++) {
-                    (*_layer_h[i])(p, t, val);
-                    m -= 0.5*(1.+_base)*val; // currently the offset is chosen from h=0;
+                const RealMatrixX*
+                off = _cache.get(MAST::MultilayerSectionCache::LAYER_OFFSETS,
+                                 nullptr, p, t);
+                
+                if (!off) {
+                    
+                    // offsets of all layers are computed in a single pass
+                    // over the layer thicknesses, and stored for the
+                    // other layers
+                    const unsigned int n = (unsigned int)_layer_h.size();
+                    RealMatrixX v = RealMatrixX::Zero(n, 1);
+                    Real val = 0., h = 0., total = 0.;
+                    
+                    for (unsigned int i=0; i<n; i++) {
+                        (*_layer_h[i])(p, t, val);
+                        v(i, 0) = h + 0.5*val; // offset from h=0
+                        h      += val;
+                    }
+                    total = h;
+                    
+                    // now add the base offset
+                    for (unsigned int i=0; i<n; i++)
+                        v(i, 0) -= 0.5*(1.+_base)*total;
+                    
+                    _cache.set(MAST::MultilayerSectionCache::LAYER_OFFSETS,
+                               nullptr, v);
+                    m = v(_layer_num, 0);
                 }
+                else
+                    m = (*off)(_layer_num, 0);
             }
             
             
@@ -73,21 +92,42 @@ namespace MAST {
                                 const libMesh::Point& p,
                                 const Real t,
                                 Real& m) const {
-                Real val = 0.;
-                m = 0.;
-                for (unsigned int i=0; i<_layer_num; i++) {
-                    _layer_h[i]->derivative( f, p, t, val);
-                    m += val; // this calculates offset from h=0, and then it is modified for base
-                }
-                // finally, add half of the current layer thickness
-                _layer_h[_layer_num]->derivative( f, p, t, val);
-                m += 0.5*val;
                 
-                // now add the base offset
-                for (unsigned int i=0; i<_layer_h.size(); i++) {
-                    _layer_h[i]->derivative( f, p, t, val);
-                    m -= 0.5*(1.+_base)*val; // currently the offset is chosen from h=0;
+                const RealMatrixX*
+                off = _cache.get(MAST::MultilayerSectionCache::LAYER_OFFSETS,
+                                 &f, p, t);
+                
+                if (!off) {
+                    
+                    // only the layers with thickness dependent on f
+                    // contribute to the derivative
+                    const std::vector<bool>&
+                    dep = _cache.layer_dependence(MAST::MultilayerSectionCache::LAYER_OFFSETS,
+                                                  f, _layer_h);
+                    
+                    const unsigned int n = (unsigned int)_layer_h.size();
+                    RealMatrixX v = RealMatrixX::Zero(n, 1);
+                    Real val = 0., h = 0., total = 0.;
+                    
+                    for (unsigned int i=0; i<n; i++) {
+                        val = 0.;
+                        if (dep[i])
+                            _layer_h[i]->derivative( f, p, t, val);
+                        v(i, 0) = h + 0.5*val; // offset from h=0
+                        h      += val;
+                    }
+                    total = h;
+                    
+                    // now add the base offset
+                    for (unsigned int i=0; i<n; i++)
+                        v(i, 0) -= 0.5*(1.+_base)*total;
+                    
+                    _cache.set(MAST::MultilayerSectionCache::LAYER_OFFSETS,
+                               &f, v);
+                    m = v(_layer_num, 0);
                 }
+                else
+                    m = (*off)(_layer_num, 0);
             }
             
         protected:
@@ -95,14 +135,24 @@ namespace MAST {
             const Real _base;
             const unsigned int _layer_num;
             const std::vector<const MAST::FieldFunction<Real>*> _layer_h;
+            MAST::MultilayerSectionCache& _cache;
         };
         
         
         class Matrix: public MAST::FieldFunction<RealMatrixX> {
         public:
-            Matrix(std::vector<MAST::FieldFunction<RealMatrixX>*>& layer_mats):
+            /*!
+             *   \p cache stores the integrated values of quantity \p q.
+             *   If it is nullptr, the layers are integrated at every call.
+             */
+            Matrix(std::vector<MAST::FieldFunction<RealMatrixX>*>& layer_mats,
+                   MAST::MultilayerSectionCache* cache = nullptr,
+                   MAST::MultilayerSectionCache::Quantity q =
+                   MAST::MultilayerSectionCache::STIFFNESS_A):
             MAST::FieldFunction<RealMatrixX>("Matrix2D"),
-            _layer_mats(layer_mats) {
+            _layer_mats(layer_mats),
+            _cache(cache),
+            _q(q) {
                 for (unsigned int i=0; i < _layer_mats.size(); i++) {
                     _functions.insert(_layer_mats[i]);
                 }
@@ -118,6 +168,15 @@ namespace MAST {
             virtual void operator() (const libMesh::Point& p,
                                      const Real t,
                                      RealMatrixX& m) const {
+                
+                const RealMatrixX*
+                v = _cache?_cache->get(_q, nullptr, p, t):nullptr;
+                
+                if (v) {
+                    m = *v;
+                    return;
+                }
+                
                 // add the values of each matrix to get the integrated value
                 RealMatrixX mi;
                 for (unsigned int i=0; i<_layer_mats.size(); i++) {
@@ -129,6 +188,9 @@ namespace MAST {
                     
                     m += mi;
                 }
+                
+                if (_cache)
+                    _cache->set(_q, nullptr, m);
             }
             
             
@@ -136,24 +198,58 @@ namespace MAST {
                                 const libMesh::Point& p,
                                 const Real t,
                                 RealMatrixX& m) const {
+                
+                const RealMatrixX*
+                v = _cache?_cache->get(_q, &f, p, t):nullptr;
+                
+                if (v) {
+                    m = *v;
+                    return;
+                }
+                
+                // only the layers that depend on f contribute to the
+                // derivative
+                const std::vector<bool>*
+                dep = _cache?&_cache->layer_dependence(_q, f, _layer_mats):nullptr;
+                
                 // add the values of each matrix to get the integrated value
                 RealMatrixX mi;
-                m = RealMatrixX::Zero(2,2);
+                bool sized = false;
                 for (unsigned int i=0; i<_layer_mats.size(); i++) {
+                    
+                    if (dep && !(*dep)[i])
+                        continue;
+                    
                     _layer_mats[i]->derivative( f, p, t, mi);
                     // use the size of the layer matrix to resize the output
                     // all other layers should return the same sized matrices
-                    if (i==0)
+                    if (!sized) {
                         m = RealMatrixX::Zero(mi.rows(), mi.cols());
+                        sized = true;
+                    }
                     
                     m += mi;
                 }
+                
+                // if no layer depends on f, the size is obtained from the
+                // value
+                if (!sized) {
+                    (*this)(p, t, m);
+                    m.setZero();
+                }
+                
+                if (_cache)
+                    _cache->set(_q, &f, m);
             }
             
             
         protected:
             
             std::vector<MAST::FieldFunction<RealMatrixX>*> _layer_mats;
+            
+            MAST::MultilayerSectionCache* _cache;
+            
+            MAST::MultilayerSectionCache::Quantity _q;
         };
         
         
@@ -204,10 +300,15 @@ set_layers(const Real base,
         // create the offset function
         _layer_offsets[i] =
         new MAST::Multilayer2DSectionProperty::LayerOffset
-        (base, i, layer_h);
+        (base, i, layer_h, _cache);
         // tell the layer about the offset
         _layers[i]->add(*_layer_offsets[i]);
     }
+    
+    // the integrated section quantities are cached for the state of the
+    // layer parameters
+    _cache.init(std::vector<const MAST::ElementPropertyCardBase*>(_layers.begin(),
+                                                                  _layers.end()));
 }
 
 
@@ -259,7 +360,8 @@ stiffness_A_matrix(const MAST::ElementBase& e) {
     
     // now create the integrated object
     std::auto_ptr<MAST::FieldFunction<RealMatrixX> > rval
-    (new MAST::Multilayer2DSectionProperty::Matrix(layer_mats));
+    (new MAST::Multilayer2DSectionProperty::Matrix
+     (layer_mats, &_cache, MAST::MultilayerSectionCache::STIFFNESS_A));
     
     return rval;
 }
@@ -277,7 +379,8 @@ stiffness_B_matrix(const MAST::ElementBase& e) {
     
     // now create the integrated object
     std::auto_ptr<MAST::FieldFunction<RealMatrixX> > rval
-    (new MAST::Multilayer2DSectionProperty::Matrix(layer_mats));
+    (new MAST::Multilayer2DSectionProperty::Matrix
+     (layer_mats, &_cache, MAST::MultilayerSectionCache::STIFFNESS_B));
     
     return rval;
 }
@@ -296,7 +399,8 @@ stiffness_D_matrix(const MAST::ElementBase& e) {
     
     // now create the integrated object
     std::auto_ptr<MAST::FieldFunction<RealMatrixX> > rval
-    (new MAST::Multilayer2DSectionProperty::Matrix(layer_mats));
+    (new MAST::Multilayer2DSectionProperty::Matrix
+     (layer_mats, &_cache, MAST::MultilayerSectionCache::STIFFNESS_D));
     
     return rval;
 }
@@ -314,7 +418,8 @@ damping_matrix(const MAST::ElementBase& e) {
     
     // now create the integrated object
     std::auto_ptr<MAST::FieldFunction<RealMatrixX> > rval
-    (new MAST::Multilayer2DSectionProperty::Matrix(layer_mats));
+    (new MAST::Multilayer2DSectionProperty::Matrix
+     (layer_mats, &_cache, MAST::MultilayerSectionCache::DAMPING));
     
     return rval;
 }
@@ -332,7 +437,8 @@ inertia_matrix(const MAST::ElementBase& e) {
     
     // now create the integrated object
     std::auto_ptr<MAST::FieldFunction<RealMatrixX> > rval
-    (new MAST::Multilayer2DSectionProperty::Matrix(layer_mats));
+    (new MAST::Multilayer2DSectionProperty::Matrix
+     (layer_mats, &_cache, MAST::MultilayerSectionCache::INERTIA));
     
     return rval;
 }
@@ -350,7 +456,8 @@ thermal_expansion_A_matrix(const MAST::ElementBase& e) {
     
     // now create the integrated object
     std::auto_ptr<MAST::FieldFunction<RealMatrixX> > rval
-    (new MAST::Multilayer2DSectionProperty::Matrix(layer_mats));
+    (new MAST::Multilayer2DSectionProperty::Matrix
+     (layer_mats, &_cache, MAST::MultilayerSectionCache::THERMAL_EXPANSION_A));
     
     return rval;
 }
@@ -368,7 +475,8 @@ thermal_expansion_B_matrix(const MAST::ElementBase& e) {
     
     // now create the integrated object
     std::auto_ptr<MAST::FieldFunction<RealMatrixX> > rval
-    (new MAST::Multilayer2DSectionProperty::Matrix(layer_mats));
+    (new MAST::Multilayer2DSectionProperty::Matrix
+     (layer_mats, &_cache, MAST::MultilayerSectionCache::THERMAL_EXPANSION_B));
     
     return rval;
 }
@@ -386,7 +494,8 @@ transverse_shear_stiffness_matrix(const MAST::ElementBase& e) {
     
     // now create the integrated object
     std::auto_ptr<MAST::FieldFunction<RealMatrixX> > rval
-    (new MAST::Multilayer2DSectionProperty::Matrix(layer_mats));
+    (new MAST::Multilayer2DSectionProperty::Matrix
+     (layer_mats, &_cache, MAST::MultilayerSectionCache::TRANSVERSE_SHEAR));
     
     return rval;
 }
@@ -0,0 +1,146 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2017  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+// MAST includes
+#include "property_cards/multilayer_section_cache.h"
+#include "property_cards/element_property_card_base.h"
+#include "property_cards/material_property_card_base.h"
+#include "base/parameter.h"
+
+
+MAST::MultilayerSectionCache::MultilayerSectionCache():
+_if_uniform(false),
+_if_parameters_initialized(false),
+_if_key_set(false),
+_t(0.)
+{ }
+
+
+
+MAST::MultilayerSectionCache::~MultilayerSectionCache() {
+    
+}
+
+
+
+void
+MAST::MultilayerSectionCache::
+init(const std::vector<const MAST::ElementPropertyCardBase*>& layers) {
+    
+    _layers = layers;
+    this->clear();
+}
+
+
+
+void
+MAST::MultilayerSectionCache::set_uniform(bool f) {
+    
+    _if_uniform = f;
+    _if_key_set = false;
+    _values.clear();
+}
+
+
+
+void
+MAST::MultilayerSectionCache::clear() {
+    
+    _if_parameters_initialized = false;
+    _if_key_set                = false;
+    _parameters.clear();
+    _parameter_values.clear();
+    _values.clear();
+    _dependence.clear();
+}
+
+
+
+void
+MAST::MultilayerSectionCache::_init_parameters() {
+    
+    std::set<const MAST::Parameter*> params;
+    
+    for (unsigned int i=0; i<_layers.size(); i++) {
+        _layers[i]->get_parameters(params);
+        _layers[i]->get_material().get_parameters(params);
+    }
+    
+    _parameters.assign(params.begin(), params.end());
+    _parameter_values.resize(_parameters.size(), 0.);
+    _if_parameters_initialized = true;
+    _if_key_set                = false;
+}
+
+
+
+const RealMatrixX*
+MAST::MultilayerSectionCache::get(Quantity q,
+                                  const MAST::FunctionBase* f,
+                                  const libMesh::Point& p,
+                                  const Real t) {
+    
+    if (!_if_parameters_initialized)
+        this->_init_parameters();
+    
+    // check if the stored values were computed for the same state
+    bool
+    same = _if_key_set;
+    
+    if (same && !_if_uniform)
+        same = (p(0) == _p(0) && p(1) == _p(1) && p(2) == _p(2) && t == _t);
+    
+    for (unsigned int i=0; same && i<_parameters.size(); i++)
+        same = ((*_parameters[i])() == _parameter_values[i]);
+    
+    if (!same) {
+        
+        // update the state and remove the old values
+        _p          = p;
+        _t          = t;
+        for (unsigned int i=0; i<_parameters.size(); i++)
+            _parameter_values[i] = (*_parameters[i])();
+        _if_key_set = true;
+        _values.clear();
+        
+        return nullptr;
+    }
+    
+    std::map<std::pair<int, const MAST::FunctionBase*>, RealMatrixX>::const_iterator
+    it = _values.find(std::pair<int, const MAST::FunctionBase*>(q, f));
+    
+    if (it == _values.end())
+        return nullptr;
+    else
+        return &(it->second);
+}
+
+
+
+void
+MAST::MultilayerSectionCache::set(Quantity q,
+                                  const MAST::FunctionBase* f,
+                                  const RealMatrixX& m) {
+    
+    libmesh_assert(_if_key_set);
+    
+    _values[std::pair<int, const MAST::FunctionBase*>(q, f)] = m;
+}
+
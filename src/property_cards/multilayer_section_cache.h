@@ -0,0 +1,200 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2017  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#ifndef __mast__multilayer_section_cache__
+#define __mast__multilayer_section_cache__
+
+// C++ includes
+#include <vector>
+#include <map>
+
+
+// MAST includes
+#include "base/mast_data_types.h"
+#include "base/field_function_base.h"
+
+
+namespace MAST {
+    
+    // Forward declerations
+    class Parameter;
+    class ElementPropertyCardBase;
+    
+    
+    /*!
+     *   Stores the layer offsets and the through-thickness integrated
+     *   section matrices of a multilayer section card, along with their
+     *   derivatives, so that the layers are evaluated only once for a
+     *   given point, time and state of the parameters that the layers
+     *   depend on. Subsequent requests for the same quantity, for example
+     *   from the offsets of each layer or from the different elements that
+     *   evaluate the section at the same state, are returned from the
+     *   stored values.
+     *
+     *   The stored values are cleared whenever the point, time or the value
+     *   of any of the parameters changes. If the layup is uniform, the
+     *   point and time are not considered, and the integrated matrices are
+     *   computed once for each parameter state and shared by all
+     *   quadrature points. The layer properties are assumed to depend only
+     *   on the parameters, point and time.
+     */
+    class MultilayerSectionCache {
+        
+    public:
+        
+        enum Quantity {
+            LAYER_OFFSETS,
+            STIFFNESS_A,
+            STIFFNESS_B,
+            STIFFNESS_D,
+            DAMPING,
+            INERTIA,
+            THERMAL_EXPANSION_A,
+            THERMAL_EXPANSION_B,
+            TRANSVERSE_SHEAR
+        };
+        
+        
+        MultilayerSectionCache();
+        
+        
+        virtual ~MultilayerSectionCache();
+        
+        
+        /*!
+         *   sets the layer cards whose parameters, along with those of their
+         *   materials, define the state of the cache. The parameters are
+         *   collected at the first use, so that materials may be set on the
+         *   layers after this call.
+         */
+        void init(const std::vector<const MAST::ElementPropertyCardBase*>& layers);
+        
+        
+        /*!
+         *   if \p f is true, the layup is assumed to not vary with location
+         *   and time
+         */
+        void set_uniform(bool f);
+        
+        
+        bool if_uniform() const {
+            return _if_uniform;
+        }
+        
+        
+        /*!
+         *   clears the stored values and the parameters, which will be
+         *   collected again at the next use
+         */
+        void clear();
+        
+        
+        /*!
+         *   @returns a pointer to the stored value of quantity \p q, or of
+         *   its derivative with respect to \p f if \p f is not nullptr, at
+         *   point \p p and time \p t. nullptr is returned if the value is
+         *   not available.
+         */
+        const RealMatrixX* get(Quantity q,
+                               const MAST::FunctionBase* f,
+                               const libMesh::Point& p,
+                               const Real t);
+        
+        
+        /*!
+         *   stores \p m as the value of quantity \p q, or of its derivative
+         *   with respect to \p f if \p f is not nullptr, at the point and
+         *   time of the last call to get().
+         */
+        void set(Quantity q,
+                 const MAST::FunctionBase* f,
+                 const RealMatrixX& m);
+        
+        
+        /*!
+         *   @returns a vector with the i-th entry true if the i-th layer
+         *   function of quantity \p q depends on \p f. This does not change
+         *   with the parameter values, and is computed only once for each
+         *   quantity and function.
+         */
+        template <typename ValType>
+        const std::vector<bool>&
+        layer_dependence(Quantity q,
+                         const MAST::FunctionBase& f,
+                         const std::vector<ValType*>& layer_functions) {
+            
+            std::pair<int, const MAST::FunctionBase*>
+            key(q, &f);
+            
+            std::map<std::pair<int, const MAST::FunctionBase*>, std::vector<bool> >::iterator
+            it = _dependence.find(key);
+            
+            if (it == _dependence.end()) {
+                
+                std::vector<bool> dep(layer_functions.size());
+                for (unsigned int i=0; i<layer_functions.size(); i++)
+                    dep[i] = layer_functions[i]->depends_on(f);
+                
+                it = _dependence.insert(std::make_pair(key, dep)).first;
+            }
+            
+            return it->second;
+        }
+        
+        
+    protected:
+        
+        /*!
+         *   collects the parameters of the layers
+         */
+        void _init_parameters();
+        
+        
+        bool _if_uniform;
+        
+        bool _if_parameters_initialized;
+        
+        bool _if_key_set;
+        
+        std::vector<const MAST::ElementPropertyCardBase*> _layers;
+        
+        std::vector<const MAST::Parameter*> _parameters;
+        
+        /*!
+         *   point, time and parameter values of the stored quantities
+         */
+        libMesh::Point _p;
+        
+        Real _t;
+        
+        std::vector<Real> _parameter_values;
+        
+        /*!
+         *   stored quantities. The function pointer is nullptr for values,
+         *   and points to the sensitivity function for derivatives.
+         */
+        std::map<std::pair<int, const MAST::FunctionBase*>, RealMatrixX> _values;
+        
+        std::map<std::pair<int, const MAST::FunctionBase*>, std::vector<bool> > _dependence;
+    };
+}
+
+
+#endif // __mast__multilayer_section_cache__
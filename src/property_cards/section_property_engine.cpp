@@ -0,0 +1,793 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2017  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+// C++ includes
+#include <cmath>
+
+
+// MAST includes
+#include "property_cards/section_property_engine.h"
+
+
+// Eigen includes
+#include "Eigen/Sparse"
+
+
+
+struct MAST::SectionPropertyEngine::SectionSolveData {
+    
+    SectionSolveData(): if_init(false) { }
+    
+    bool if_init;
+    
+    /*!
+     *   patch and local patch coordinates of each node, which locate the
+     *   node for any values of the dimensions
+     */
+    std::vector<unsigned int> node_patch;
+    
+    std::vector<Real> node_xi, node_eta;
+    
+    /*!
+     *   four nodes of each element
+     */
+    std::vector<unsigned int> elem_nodes;
+    
+    /*!
+     *   factorization of the warping operator. The symbolic factorization
+     *   is computed once, since the sparsity does not change.
+     */
+    Eigen::SimplicialLDLT<Eigen::SparseMatrix<Real> > solver;
+};
+
+
+
+namespace MAST {
+    namespace SectionPropertyEngineFunctions {
+        
+        class Property: public MAST::FieldFunction<Real> {
+        public:
+            Property(MAST::SectionPropertyEngine& engine,
+                     MAST::SectionPropertyEngine::Property prop,
+                     const std::vector<const MAST::FieldFunction<Real>*>& dims):
+            MAST::FieldFunction<Real>("SectionProperty"),
+            _engine(engine),
+            _prop(prop) {
+                for (unsigned int i=0; i<dims.size(); i++)
+                    _functions.insert(dims[i]);
+            }
+            
+            virtual ~Property() { }
+            
+            virtual void operator() (const libMesh::Point& p,
+                                     const Real t,
+                                     Real& m) const {
+                m = _engine.properties(p, t)(_prop);
+            }
+            
+            
+            virtual void derivative (const MAST::FunctionBase& f,
+                                     const libMesh::Point& p,
+                                     const Real t,
+                                     Real& m) const {
+                RealVectorX dv;
+                _engine.property_derivatives(f, p, t, dv);
+                m = dv(_prop);
+            }
+            
+        protected:
+            
+            MAST::SectionPropertyEngine& _engine;
+            
+            MAST::SectionPropertyEngine::Property _prop;
+        };
+        
+        
+        
+        class AreaInertiaMatrix: public MAST::FieldFunction<RealMatrixX> {
+        public:
+            AreaInertiaMatrix(MAST::SectionPropertyEngine& engine,
+                              const std::vector<const MAST::FieldFunction<Real>*>& dims):
+            MAST::FieldFunction<RealMatrixX>("AreaInertiaMatrix"),
+            _engine(engine) {
+                for (unsigned int i=0; i<dims.size(); i++)
+                    _functions.insert(dims[i]);
+            }
+            
+            virtual ~AreaInertiaMatrix() { }
+            
+            virtual void operator() (const libMesh::Point& p,
+                                     const Real t,
+                                     RealMatrixX& m) const {
+                this->_fill(_engine.properties(p, t), m);
+            }
+            
+            
+            virtual void derivative (const MAST::FunctionBase& f,
+                                     const libMesh::Point& p,
+                                     const Real t,
+                                     RealMatrixX& m) const {
+                RealVectorX dv;
+                _engine.property_derivatives(f, p, t, dv);
+                this->_fill(dv, m);
+            }
+            
+        protected:
+            
+            void _fill(const RealVectorX& v, RealMatrixX& m) const {
+                
+                m = RealMatrixX::Zero(2,2);
+                m(0,0) = v(MAST::SectionPropertyEngine::AREA_INERTIA_ZZ); // Izz for v-bending
+                m(0,1) = v(MAST::SectionPropertyEngine::AREA_INERTIA_YZ);
+                m(1,0) = m(0,1);
+                m(1,1) = v(MAST::SectionPropertyEngine::AREA_INERTIA_YY); // Iyy for w-bending
+            }
+            
+            MAST::SectionPropertyEngine& _engine;
+        };
+    }
+}
+
+
+
+MAST::SectionPropertyEngine::SectionPoint::SectionPoint(Real y, Real z):
+_y0(y),
+_z0(z) {
+    
+}
+
+
+
+MAST::SectionPropertyEngine::SectionPoint&
+MAST::SectionPropertyEngine::SectionPoint::add(unsigned int dim,
+                                               Real dy,
+                                               Real dz) {
+    
+    _dims.push_back(dim);
+    _dy.push_back(dy);
+    _dz.push_back(dz);
+    
+    return *this;
+}
+
+
+
+void
+MAST::SectionPropertyEngine::SectionPoint::
+coordinates(const std::vector<Real>& dims,
+            Real& y,
+            Real& z) const {
+    
+    y = _y0;
+    z = _z0;
+    
+    for (unsigned int i=0; i<_dims.size(); i++) {
+        
+        libmesh_assert_less(_dims[i], dims.size());
+        
+        y += _dy[i] * dims[_dims[i]];
+        z += _dz[i] * dims[_dims[i]];
+    }
+}
+
+
+
+MAST::SectionPropertyEngine::SectionPropertyEngine():
+_fd_step(1.e-6),
+_max_table_entries(10000) {
+    
+}
+
+
+
+MAST::SectionPropertyEngine::~SectionPropertyEngine() {
+    
+}
+
+
+
+unsigned int
+MAST::SectionPropertyEngine::add_dimension(const MAST::FieldFunction<Real>& d) {
+    
+    // the table is keyed on the dimension values, and would be
+    // inconsistent if the number of dimensions changes
+    this->clear_table();
+    
+    _dims.push_back(&d);
+    
+    return (unsigned int)_dims.size()-1;
+}
+
+
+
+void
+MAST::SectionPropertyEngine::
+add_patch(const MAST::SectionPropertyEngine::SectionPoint& p0,
+          const MAST::SectionPropertyEngine::SectionPoint& p1,
+          const MAST::SectionPropertyEngine::SectionPoint& p2,
+          const MAST::SectionPropertyEngine::SectionPoint& p3,
+          unsigned int n1,
+          unsigned int n2) {
+    
+    libmesh_assert_greater(n1, 0);
+    libmesh_assert_greater(n2, 0);
+    
+    this->clear_table();
+    
+    MAST::SectionPropertyEngine::Patch patch;
+    patch.corners.push_back(p0);
+    patch.corners.push_back(p1);
+    patch.corners.push_back(p2);
+    patch.corners.push_back(p3);
+    patch.n1 = n1;
+    patch.n2 = n2;
+    
+    _patches.push_back(patch);
+}
+
+
+
+void
+MAST::SectionPropertyEngine::add_rectangle(unsigned int hy,
+                                           unsigned int hz,
+                                           unsigned int y_off,
+                                           unsigned int z_off,
+                                           unsigned int n1,
+                                           unsigned int n2) {
+    
+    MAST::SectionPropertyEngine::SectionPoint p[4];
+    
+    const Real
+    sy[] = {-0.5,  0.5, 0.5, -0.5},
+    sz[] = {-0.5, -0.5, 0.5,  0.5};
+    
+    for (unsigned int i=0; i<4; i++)
+        p[i].add(hy, sy[i], 0.).add(hz, 0., sz[i]).add(y_off, 1., 0.).add(z_off, 0., 1.);
+    
+    this->add_patch(p[0], p[1], p[2], p[3], n1, n2);
+}
+
+
+
+void
+MAST::SectionPropertyEngine::set_max_table_entries(unsigned int n) {
+    
+    libmesh_assert_greater(n, 0);
+    
+    _max_table_entries = n;
+    
+    while (_table.size() > _max_table_entries) {
+        
+        _table.erase(_table_order.front());
+        _table_order.pop_front();
+    }
+}
+
+
+
+void
+MAST::SectionPropertyEngine::clear_table() {
+    
+    _table.clear();
+    _table_order.clear();
+}
+
+
+
+bool
+MAST::SectionPropertyEngine::depends_on(const MAST::FunctionBase& f) const {
+    
+    for (unsigned int i=0; i<_dims.size(); i++)
+        if (_dims[i] == &f || _dims[i]->depends_on(f))
+            return true;
+    
+    return false;
+}
+
+
+
+const RealVectorX&
+MAST::SectionPropertyEngine::properties(const libMesh::Point& p,
+                                        const Real t) {
+    
+    std::vector<Real> dims;
+    return this->_entry(p, t, dims).value;
+}
+
+
+
+void
+MAST::SectionPropertyEngine::property_derivatives(const MAST::FunctionBase& f,
+                                                  const libMesh::Point& p,
+                                                  const Real t,
+                                                  RealVectorX& dv) {
+    
+    std::vector<Real> dims;
+    MAST::SectionPropertyEngine::TableEntry& entry = this->_entry(p, t, dims);
+    
+    const unsigned int n_dims = (unsigned int)_dims.size();
+    
+    // the sensitivity with respect to the dimensions is computed once
+    // for each entry, and only when it is first requested
+    if (!entry.if_sensitivity) {
+        
+        entry.dvalue = RealMatrixX::Zero(N_PROPERTIES, n_dims);
+        
+        RealVectorX
+        vp,
+        vm;
+        
+        // the perturbed solutions share the mesh and the symbolic
+        // factorization of the warping operator
+        MAST::SectionPropertyEngine::SectionSolveData data;
+        
+        for (unsigned int i=0; i<n_dims; i++) {
+            
+            const Real
+            d0 = dims[i],
+            h  = (fabs(d0) > 0.)? _fd_step*fabs(d0) : _fd_step;
+            
+            dims[i] = d0 + h;
+            this->_compute_properties(dims, vp, data);
+            dims[i] = d0 - h;
+            this->_compute_properties(dims, vm, data);
+            dims[i] = d0;
+            
+            entry.dvalue.col(i) = (vp - vm)/(2.*h);
+        }
+        
+        entry.if_sensitivity = true;
+    }
+    
+    dv = RealVectorX::Zero(N_PROPERTIES);
+    
+    Real dd = 0.;
+    
+    for (unsigned int i=0; i<n_dims; i++)
+        if (_dims[i]->depends_on(f)) {
+            
+            _dims[i]->derivative(f, p, t, dd);
+            dv += dd * entry.dvalue.col(i);
+        }
+}
+
+
+
+MAST::SectionPropertyEngine::TableEntry&
+MAST::SectionPropertyEngine::_entry(const libMesh::Point& p,
+                                    const Real t,
+                                    std::vector<Real>& dims) {
+    
+    libmesh_assert(_patches.size());
+    
+    dims.resize(_dims.size());
+    for (unsigned int i=0; i<_dims.size(); i++)
+        (*_dims[i])(p, t, dims[i]);
+    
+    std::map<std::vector<Real>, MAST::SectionPropertyEngine::TableEntry>::iterator
+    it = _table.find(dims);
+    
+    if (it == _table.end()) {
+        
+        // the oldest entry is removed if the table is full
+        if (_table.size() >= _max_table_entries) {
+            
+            _table.erase(_table_order.front());
+            _table_order.pop_front();
+        }
+        
+        _table_order.push_back(dims);
+        it = _table.insert(std::make_pair(dims, MAST::SectionPropertyEngine::TableEntry())).first;
+        this->compute_properties(dims, it->second.value);
+    }
+    
+    return it->second;
+}
+
+
+
+void
+MAST::SectionPropertyEngine::compute_properties(const std::vector<Real>& dims,
+                                                RealVectorX& v) const {
+    
+    MAST::SectionPropertyEngine::SectionSolveData data;
+    this->_compute_properties(dims, v, data);
+}
+
+
+
+void
+MAST::SectionPropertyEngine::
+_compute_properties(const std::vector<Real>& dims,
+                    RealVectorX& v,
+                    MAST::SectionPropertyEngine::SectionSolveData& data) const {
+    
+    libmesh_assert(_patches.size());
+    
+    // 3x3 Gauss quadrature integrates the area moments exactly on the
+    // bilinear quadrilaterals
+    const Real
+    g     = sqrt(0.6),
+    qp[]  = {-g, 0., g},
+    qw[]  = {5./9., 8./9., 5./9.};
+    
+    //
+    // create the nodes and the elements. Nodes on the edges shared by
+    // two patches are merged by their coordinates. This is done only
+    // once for data, since the mesh topology does not depend on the
+    // dimensions.
+    //
+    std::vector<Real>
+    node_y,
+    node_z;
+    std::vector<unsigned int>
+    &elem_nodes = data.elem_nodes;
+    
+    Real
+    y_min  =  1.e100,
+    y_max  = -1.e100,
+    z_min  =  1.e100,
+    z_max  = -1.e100;
+    
+    std::vector<std::vector<Real> >
+    cy(_patches.size(), std::vector<Real>(4, 0.)),
+    cz(_patches.size(), std::vector<Real>(4, 0.));
+    
+    for (unsigned int i=0; i<_patches.size(); i++)
+        for (unsigned int j=0; j<4; j++) {
+            
+            _patches[i].corners[j].coordinates(dims, cy[i][j], cz[i][j]);
+            y_min = std::min(y_min, cy[i][j]);
+            y_max = std::max(y_max, cy[i][j]);
+            z_min = std::min(z_min, cz[i][j]);
+            z_max = std::max(z_max, cz[i][j]);
+        }
+    
+    if (!data.if_init) {
+        
+        const Real
+        bin = 1.e-8 * std::max(std::max(y_max-y_min, z_max-z_min), 1.e-100);
+        
+        std::map<std::pair<long long, long long>, unsigned int> node_map;
+        
+        for (unsigned int i=0; i<_patches.size(); i++) {
+            
+            const unsigned int
+            n1 = _patches[i].n1,
+            n2 = _patches[i].n2;
+            
+            std::vector<unsigned int> ids((n1+1)*(n2+1));
+            
+            for (unsigned int j2=0; j2<=n2; j2++)
+                for (unsigned int j1=0; j1<=n1; j1++) {
+                    
+                    const Real
+                    xi  = (1.*j1)/n1,
+                    eta = (1.*j2)/n2,
+                    y   = ((1.-xi)*(1.-eta)*cy[i][0] + xi*(1.-eta)*cy[i][1] +
+                           xi*eta*cy[i][2] + (1.-xi)*eta*cy[i][3]),
+                    z   = ((1.-xi)*(1.-eta)*cz[i][0] + xi*(1.-eta)*cz[i][1] +
+                           xi*eta*cz[i][2] + (1.-xi)*eta*cz[i][3]);
+                    
+                    const long long
+                    by = (long long)floor((y-y_min)/bin + 0.5),
+                    bz = (long long)floor((z-z_min)/bin + 0.5);
+                    
+                    // look for an existing node in the neighboring bins
+                    unsigned int id = (unsigned int)data.node_patch.size();
+                    
+                    for (long long ky=by-1; ky<=by+1 && id == data.node_patch.size(); ky++)
+                        for (long long kz=bz-1; kz<=bz+1 && id == data.node_patch.size(); kz++) {
+                            
+                            std::map<std::pair<long long, long long>, unsigned int>::const_iterator
+                            n_it = node_map.find(std::make_pair(ky, kz));
+                            if (n_it != node_map.end())
+                                id = n_it->second;
+                        }
+                    
+                    if (id == data.node_patch.size()) {
+                        
+                        node_map[std::make_pair(by, bz)] = id;
+                        data.node_patch.push_back(i);
+                        data.node_xi.push_back(xi);
+                        data.node_eta.push_back(eta);
+                    }
+                    
+                    ids[j2*(n1+1)+j1] = id;
+                }
+            
+            for (unsigned int j2=0; j2<n2; j2++)
+                for (unsigned int j1=0; j1<n1; j1++) {
+                    
+                    elem_nodes.push_back(ids[ j2   *(n1+1)+j1  ]);
+                    elem_nodes.push_back(ids[ j2   *(n1+1)+j1+1]);
+                    elem_nodes.push_back(ids[(j2+1)*(n1+1)+j1+1]);
+                    elem_nodes.push_back(ids[(j2+1)*(n1+1)+j1  ]);
+                }
+        }
+    }
+    
+    // node coordinates for the current dimensions
+    node_y.resize(data.node_patch.size());
+    node_z.resize(data.node_patch.size());
+    
+    for (unsigned int k=0; k<data.node_patch.size(); k++) {
+        
+        const unsigned int
+        i   = data.node_patch[k];
+        
+        const Real
+        xi  = data.node_xi[k],
+        eta = data.node_eta[k];
+        
+        node_y[k] = ((1.-xi)*(1.-eta)*cy[i][0] + xi*(1.-eta)*cy[i][1] +
+                     xi*eta*cy[i][2] + (1.-xi)*eta*cy[i][3]);
+        node_z[k] = ((1.-xi)*(1.-eta)*cz[i][0] + xi*(1.-eta)*cz[i][1] +
+                     xi*eta*cz[i][2] + (1.-xi)*eta*cz[i][3]);
+    }
+    
+    const unsigned int
+    n_nodes = (unsigned int)node_y.size(),
+    n_elems = (unsigned int)elem_nodes.size()/4;
+    
+    //
+    // area properties and the warping function system
+    //
+    v = RealVectorX::Zero(N_PROPERTIES);
+    
+    RealVectorX
+    f     = RealVectorX::Zero(n_nodes),
+    N     = RealVectorX::Zero(4),
+    Ny    = RealVectorX::Zero(4),
+    Nz    = RealVectorX::Zero(4);
+    
+    std::vector<Eigen::Triplet<Real> > k_entries;
+    k_entries.reserve(16*n_elems);
+    
+    const Real
+    xi_n[]  = {-1.,  1., 1., -1.},
+    eta_n[] = {-1., -1., 1.,  1.};
+    
+    for (unsigned int e=0; e<n_elems; e++) {
+        
+        const unsigned int* nd = &elem_nodes[4*e];
+        
+        RealMatrixX ke = RealMatrixX::Zero(4, 4);
+        
+        for (unsigned int q1=0; q1<3; q1++)
+            for (unsigned int q2=0; q2<3; q2++) {
+                
+                const Real
+                xi   = qp[q1],
+                eta  = qp[q2];
+                
+                Real
+                y = 0., z = 0.,
+                y_xi = 0., y_eta = 0., z_xi = 0., z_eta = 0.;
+                
+                RealVectorX
+                N_xi  = RealVectorX::Zero(4),
+                N_eta = RealVectorX::Zero(4);
+                
+                for (unsigned int a=0; a<4; a++) {
+                    
+                    N(a)     = 0.25*(1.+xi_n[a]*xi)*(1.+eta_n[a]*eta);
+                    N_xi(a)  = 0.25*xi_n[a]*(1.+eta_n[a]*eta);
+                    N_eta(a) = 0.25*eta_n[a]*(1.+xi_n[a]*xi);
+                    
+                    y     += N(a)     * node_y[nd[a]];
+                    z     += N(a)     * node_z[nd[a]];
+                    y_xi  += N_xi(a)  * node_y[nd[a]];
+                    y_eta += N_eta(a) * node_y[nd[a]];
+                    z_xi  += N_xi(a)  * node_z[nd[a]];
+                    z_eta += N_eta(a) * node_z[nd[a]];
+                }
+                
+                const Real
+                detJ = y_xi*z_eta - y_eta*z_xi,
+                JxW  = detJ * qw[q1] * qw[q2];
+                
+                // patch corners must be ordered counter-clockwise
+                libmesh_assert_greater(detJ, 0.);
+                
+                for (unsigned int a=0; a<4; a++) {
+                    
+                    Ny(a) = ( z_eta*N_xi(a) - z_xi*N_eta(a))/detJ;
+                    Nz(a) = (-y_eta*N_xi(a) + y_xi*N_eta(a))/detJ;
+                }
+                
+                v(AREA)             += JxW;
+                v(AREA_Y_MOMENT)    += JxW * z;
+                v(AREA_Z_MOMENT)    += JxW * y;
+                v(AREA_INERTIA_ZZ)  += JxW * y * y;
+                v(AREA_INERTIA_YZ)  += JxW * y * z;
+                v(AREA_INERTIA_YY)  += JxW * z * z;
+                
+                ke += JxW * (Ny * Ny.transpose() + Nz * Nz.transpose());
+                
+                for (unsigned int a=0; a<4; a++)
+                    f(nd[a]) += JxW * (Ny(a) * z - Nz(a) * y);
+            }
+        
+        for (unsigned int a=0; a<4; a++)
+            for (unsigned int b=0; b<4; b++)
+                k_entries.push_back(Eigen::Triplet<Real>(nd[a], nd[b], ke(a,b)));
+    }
+    
+    v(POLAR_INERTIA)    = v(AREA_INERTIA_ZZ) + v(AREA_INERTIA_YY);
+    v(SECTION_HY)       = y_max - y_min;
+    v(SECTION_HZ)       = z_max - z_min;
+    v(SECTION_Y_OFFSET) = 0.5*(y_max + y_min);
+    v(SECTION_Z_OFFSET) = 0.5*(z_max + z_min);
+    
+    //
+    // St. Venant warping function about the origin:
+    //    \nabla^2 w = 0,   dw/dn = z n_y - y n_z
+    // The Neumann problem is determined up to a constant, which is removed
+    // by fixing the value at the first node. The constant is later
+    // identified along with the shear center.
+    //
+    Eigen::SparseMatrix<Real> K(n_nodes, n_nodes);
+    K.setFromTriplets(k_entries.begin(), k_entries.end());
+    
+    for (Eigen::SparseMatrix<Real>::InnerIterator it(K, 0); it; ++it)
+        if (it.row() != 0) it.valueRef() = 0.;
+    for (unsigned int k=0; k<(unsigned int)K.outerSize(); k++)
+        for (Eigen::SparseMatrix<Real>::InnerIterator it(K, k); it; ++it)
+            if (it.row() == 0 && it.col() != 0) it.valueRef() = 0.;
+    f(0) = 0.;
+    
+    if (!data.if_init) {
+        
+        data.solver.analyzePattern(K);
+        data.if_init = true;
+    }
+    
+    data.solver.factorize(K);
+    libmesh_assert(data.solver.info() == Eigen::Success);
+    
+    const RealVectorX w = data.solver.solve(f);
+    
+    //
+    // torsional constant, and integrals of the warping function needed
+    // for the shear center
+    //
+    Real
+    J    = 0.,
+    Iw   = 0.,
+    Iwy  = 0.,
+    Iwz  = 0.,
+    Iww  = 0.;
+    
+    for (unsigned int e=0; e<n_elems; e++) {
+        
+        const unsigned int* nd = &elem_nodes[4*e];
+        
+        for (unsigned int q1=0; q1<3; q1++)
+            for (unsigned int q2=0; q2<3; q2++) {
+                
+                const Real
+                xi   = qp[q1],
+                eta  = qp[q2];
+                
+                Real
+                y = 0., z = 0., wq = 0., wy = 0., wz = 0.,
+                y_xi = 0., y_eta = 0., z_xi = 0., z_eta = 0.;
+                
+                Real N_xi[4], N_eta[4];
+                
+                for (unsigned int a=0; a<4; a++) {
+                    
+                    N(a)     = 0.25*(1.+xi_n[a]*xi)*(1.+eta_n[a]*eta);
+                    N_xi[a]  = 0.25*xi_n[a]*(1.+eta_n[a]*eta);
+                    N_eta[a] = 0.25*eta_n[a]*(1.+xi_n[a]*xi);
+                    
+                    y     += N(a)     * node_y[nd[a]];
+                    z     += N(a)     * node_z[nd[a]];
+                    wq    += N(a)     * w(nd[a]);
+                    y_xi  += N_xi[a]  * node_y[nd[a]];
+                    y_eta += N_eta[a] * node_y[nd[a]];
+                    z_xi  += N_xi[a]  * node_z[nd[a]];
+                    z_eta += N_eta[a] * node_z[nd[a]];
+                }
+                
+                const Real
+                detJ = y_xi*z_eta - y_eta*z_xi,
+                JxW  = detJ * qw[q1] * qw[q2];
+                
+                for (unsigned int a=0; a<4; a++) {
+                    
+                    wy += w(nd[a]) * ( z_eta*N_xi[a] - z_xi*N_eta[a])/detJ;
+                    wz += w(nd[a]) * (-y_eta*N_xi[a] + y_xi*N_eta[a])/detJ;
+                }
+                
+                J   += JxW * (y*y + z*z + y*wz - z*wy);
+                Iw  += JxW * wq;
+                Iwy += JxW * wq * y;
+                Iwz += JxW * wq * z;
+                Iww += JxW * wq * wq;
+            }
+    }
+    
+    v(TORSIONAL_CONSTANT) = J;
+    
+    //
+    // the warping function about the shear center (ys, zs) is
+    //    w_s = w - zs y + ys z + c
+    // where ys, zs and c are chosen such that
+    //    int w_s = int w_s y = int w_s z = 0
+    //
+    const Real
+    A       = v(AREA),
+    int_y   = v(AREA_Z_MOMENT),
+    int_z   = v(AREA_Y_MOMENT),
+    int_yy  = v(AREA_INERTIA_ZZ),
+    int_yz  = v(AREA_INERTIA_YZ),
+    int_zz  = v(AREA_INERTIA_YY);
+    
+    RealMatrixX m = RealMatrixX::Zero(3, 3);
+    RealVectorX
+    rhs = RealVectorX::Zero(3),
+    sol = RealVectorX::Zero(3);
+    
+    // unknowns: ys, zs, c
+    m(0,0) = int_z;   m(0,1) = -int_y;   m(0,2) = A;
+    m(1,0) = int_yz;  m(1,1) = -int_yy;  m(1,2) = int_y;
+    m(2,0) = int_zz;  m(2,1) = -int_yz;  m(2,2) = int_z;
+    
+    rhs(0) = -Iw;
+    rhs(1) = -Iwy;
+    rhs(2) = -Iwz;
+    
+    sol = m.partialPivLu().solve(rhs);
+    
+    const Real
+    ys  = sol(0),
+    zs  = sol(1),
+    c   = sol(2);
+    
+    v(SHEAR_CENTER_Y)    = ys;
+    v(SHEAR_CENTER_Z)    = zs;
+    
+    // int w_s^2 = int w_s w, since w_s is orthogonal to 1, y and z
+    v(WARPING_CONSTANT)  = Iww + (-zs*Iwy + ys*Iwz + c*Iw);
+}
+
+
+
+std::auto_ptr<MAST::FieldFunction<Real> >
+MAST::SectionPropertyEngine::
+property_function(MAST::SectionPropertyEngine::Property prop) {
+    
+    libmesh_assert_less(prop, N_PROPERTIES);
+    
+    return std::auto_ptr<MAST::FieldFunction<Real> >
+    (new MAST::SectionPropertyEngineFunctions::Property(*this, prop, _dims));
+}
+
+
+
+std::auto_ptr<MAST::FieldFunction<RealMatrixX> >
+MAST::SectionPropertyEngine::area_inertia_function() {
+    
+    return std::auto_ptr<MAST::FieldFunction<RealMatrixX> >
+    (new MAST::SectionPropertyEngineFunctions::AreaInertiaMatrix(*this, _dims));
+}
+
@@ -0,0 +1,325 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2017  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#ifndef __mast__section_property_engine__
+#define __mast__section_property_engine__
+
+// C++ includes
+#include <vector>
+#include <map>
+#include <deque>
+#include <memory>
+
+
+// MAST includes
+#include "base/mast_data_types.h"
+#include "base/field_function_base.h"
+
+
+namespace MAST {
+    
+    
+    /*!
+     *   Computes the properties of beam cross-sections of arbitrary shape.
+     *   The section is described by quadrilateral patches, whose corners
+     *   depend linearly on a set of dimensions. The dimensions are field
+     *   functions, and the section is evaluated once for each distinct set
+     *   of dimension values. The results are stored in a lookup table, so
+     *   that quadrature points with the same dimensions share the same
+     *   computation.
+     *
+     *   Area properties are integrated exactly on the patches. The torsional
+     *   constant, shear center and warping constant are obtained from the
+     *   St. Venant warping function, which is computed with bilinear finite
+     *   elements on a structured mesh of each patch. Patches must meet
+     *   edge to edge, with the same number of divisions on shared edges,
+     *   so that the mesh is conforming. Holes in the section, for example
+     *   in box sections, are modeled by surrounding patches. Thin-walled
+     *   sections are modeled with one patch per wall segment.
+     *
+     *   All coordinates are in the beam cross-section plane, y-z, measured
+     *   from the beam axis. The sensitivities with respect to the
+     *   dimensions are computed by central differences of the section
+     *   solution. Since the mesh topology does not change with the
+     *   dimensions, these are smooth, and the perturbed solutions reuse
+     *   the mesh and the symbolic factorization of the warping operator.
+     *
+     *   The bounding box of the section is also provided, and is used
+     *   by the 1D structural elements to place the stress recovery
+     *   points on the extreme fibers of the section.
+     */
+    class SectionPropertyEngine {
+        
+    public:
+        
+        /*!
+         *   properties computed for the section. All moments are about the
+         *   beam axis.
+         */
+        enum Property {
+            AREA,                // int_A dA
+            AREA_Y_MOMENT,       // int_A z dA
+            AREA_Z_MOMENT,       // int_A y dA
+            AREA_INERTIA_ZZ,     // int_A y^2 dA
+            AREA_INERTIA_YZ,     // int_A y z dA
+            AREA_INERTIA_YY,     // int_A z^2 dA
+            POLAR_INERTIA,       // int_A (y^2 + z^2) dA
+            TORSIONAL_CONSTANT,
+            SHEAR_CENTER_Y,
+            SHEAR_CENTER_Z,
+            WARPING_CONSTANT,
+            SECTION_HY,          // y-width of the bounding box of the section
+            SECTION_HZ,          // z-width of the bounding box of the section
+            SECTION_Y_OFFSET,    // y-coordinate of the bounding box center
+            SECTION_Z_OFFSET,    // z-coordinate of the bounding box center
+            N_PROPERTIES
+        };
+        
+        
+        /*!
+         *   point in the section plane with coordinates
+         *   \f$ y = y_0 + \sum_k dy_k d_k \f$ and
+         *   \f$ z = z_0 + \sum_k dz_k d_k \f$, where \f$ d_k \f$ are the
+         *   section dimensions.
+         */
+        class SectionPoint {
+            
+        public:
+            
+            SectionPoint(Real y = 0., Real z = 0.);
+            
+            /*!
+             *   adds the dependence on dimension \p dim
+             */
+            SectionPoint& add(unsigned int dim, Real dy, Real dz);
+            
+            /*!
+             *   computes the coordinates for the dimension values \p dims
+             */
+            void coordinates(const std::vector<Real>& dims,
+                             Real& y,
+                             Real& z) const;
+            
+        protected:
+            
+            Real _y0, _z0;
+            
+            std::vector<unsigned int> _dims;
+            
+            std::vector<Real> _dy, _dz;
+        };
+        
+        
+        SectionPropertyEngine();
+        
+        
+        virtual ~SectionPropertyEngine();
+        
+        
+        /*!
+         *   adds a section dimension.
+         *   @returns the index of the dimension for use in SectionPoint.
+         */
+        unsigned int add_dimension(const MAST::FieldFunction<Real>& d);
+        
+        
+        /*!
+         *   adds a quadrilateral patch with corners listed counter-clockwise
+         *   in the y-z plane. The patch is meshed with \p n1 divisions along
+         *   the edge p0-p1, and \p n2 divisions along the edge p1-p2.
+         */
+        void add_patch(const MAST::SectionPropertyEngine::SectionPoint& p0,
+                       const MAST::SectionPropertyEngine::SectionPoint& p1,
+                       const MAST::SectionPropertyEngine::SectionPoint& p2,
+                       const MAST::SectionPropertyEngine::SectionPoint& p3,
+                       unsigned int n1,
+                       unsigned int n2);
+        
+        
+        /*!
+         *   adds a rectangular patch of widths \p hy and \p hz, given as
+         *   dimension indices, centered at offsets \p y_off and \p z_off,
+         *   also given as dimension indices. This describes the solid
+         *   rectangular section.
+         */
+        void add_rectangle(unsigned int hy,
+                           unsigned int hz,
+                           unsigned int y_off,
+                           unsigned int z_off,
+                           unsigned int n1,
+                           unsigned int n2);
+        
+        
+        /*!
+         *   relative step used for the finite difference sensitivities.
+         */
+        void set_finite_difference_step(Real delta) {
+            _fd_step = delta;
+        }
+        
+        
+        /*!
+         *   sets the maximum number of sections in the lookup table. The
+         *   oldest entries are removed when this is exceeded. The default
+         *   is 10000.
+         */
+        void set_max_table_entries(unsigned int n);
+        
+        
+        /*!
+         *   clears the lookup table
+         */
+        void clear_table();
+        
+        
+        /*!
+         *   @returns the number of sections in the lookup table
+         */
+        unsigned int n_table_entries() const {
+            return (unsigned int)_table.size();
+        }
+        
+        
+        /*!
+         *   @returns true if any of the section dimensions depends on \p f
+         */
+        bool depends_on(const MAST::FunctionBase& f) const;
+        
+        
+        /*!
+         *   @returns the vector of properties, indexed by Property, for the
+         *   dimensions at point \p p and time \p t.
+         */
+        const RealVectorX& properties(const libMesh::Point& p,
+                                      const Real t);
+        
+        
+        /*!
+         *   computes the derivative of the properties with respect to
+         *   \p f at point \p p and time \p t
+         */
+        void property_derivatives(const MAST::FunctionBase& f,
+                                  const libMesh::Point& p,
+                                  const Real t,
+                                  RealVectorX& dv);
+        
+        
+        /*!
+         *   @returns the properties of the section for dimension values
+         *   \p dims, without using the lookup table.
+         */
+        void compute_properties(const std::vector<Real>& dims,
+                                RealVectorX& v) const;
+        
+        
+        /*!
+         *   @returns a field function that evaluates property \p prop
+         */
+        std::auto_ptr<MAST::FieldFunction<Real> >
+        property_function(MAST::SectionPropertyEngine::Property prop);
+        
+        
+        /*!
+         *   @returns a field function that evaluates the 2x2 area inertia
+         *   matrix in the same format as the solid 1D section property card:
+         *   [int y^2, int y z; int y z, int z^2]
+         */
+        std::auto_ptr<MAST::FieldFunction<RealMatrixX> >
+        area_inertia_function();
+        
+        
+    protected:
+        
+        struct Patch {
+            
+            std::vector<MAST::SectionPropertyEngine::SectionPoint> corners;
+            
+            unsigned int n1, n2;
+        };
+        
+        
+        /*!
+         *   mesh of the section and the factorization of the warping
+         *   operator, which are reused by solutions with different
+         *   dimensions. Defined in the source file.
+         */
+        struct SectionSolveData;
+        
+        
+        /*!
+         *   computes the properties of the section for dimension values
+         *   \p dims. The mesh and symbolic factorization in \p data are
+         *   created by the first call, and reused by later calls.
+         */
+        void _compute_properties(const std::vector<Real>& dims,
+                                 RealVectorX& v,
+                                 MAST::SectionPropertyEngine::SectionSolveData& data) const;
+        
+        
+        /*!
+         *   values and sensitivities for a set of dimension values
+         */
+        struct TableEntry {
+            
+            TableEntry(): if_sensitivity(false) { }
+            
+            RealVectorX value;
+            
+            bool if_sensitivity;
+            
+            /*!
+             *   N_PROPERTIES x n_dims matrix of derivatives with respect to
+             *   the dimensions
+             */
+            RealMatrixX dvalue;
+        };
+        
+        
+        /*!
+         *   evaluates the dimensions at \p p and \p t, and returns the
+         *   table entry, computing the properties if necessary.
+         */
+        TableEntry& _entry(const libMesh::Point& p,
+                           const Real t,
+                           std::vector<Real>& dims);
+        
+        
+        std::vector<const MAST::FieldFunction<Real>*> _dims;
+        
+        std::vector<MAST::SectionPropertyEngine::Patch> _patches;
+        
+        Real _fd_step;
+        
+        std::map<std::vector<Real>, MAST::SectionPropertyEngine::TableEntry> _table;
+        
+        /*!
+         *   keys of the lookup table in the order of insertion
+         */
+        std::deque<std::vector<Real> > _table_order;
+        
+        /*!
+         *   maximum number of entries in the lookup table
+         */
+        unsigned int _max_table_entries;
+    };
+}
+
+
+#endif // __mast__section_property_engine__
@@ -1381,6 +1381,7 @@ bool
 MAST::Solid1DSectionElementPropertyCard::
 depends_on(const MAST::FunctionBase& f) const {
     return _material->depends_on(f) ||            // check if the material property depends on the function
+    (_engine && _engine->depends_on(f))  ||       // check if the section dimensions depend on the function
     MAST::ElementPropertyCardBase::depends_on(f); // check with this property card
 }
 
@@ -1489,11 +1490,52 @@ MAST::Solid1DSectionElementPropertyCard::I() {
 
 
 
+const MAST::FieldFunction<Real>&
+MAST::Solid1DSectionElementPropertyCard::
+stress_recovery_function(const std::string& nm) const {
+    
+    if (!_engine)
+        return this->get<MAST::FieldFunction<Real> >(nm);
+    
+    libmesh_assert(_initialized);
+    
+    if (nm == "hy")
+        return *_stress_hy;
+    else if (nm == "hz")
+        return *_stress_hz;
+    else if (nm == "hy_off")
+        return *_stress_hy_off;
+    else if (nm == "hz_off")
+        return *_stress_hz_off;
+    else
+        libmesh_error_msg("Invalid stress recovery function: " << nm);
+}
+
+
+
 void
 MAST::Solid1DSectionElementPropertyCard::init() {
     
     libmesh_assert(!_initialized);
     
+    if (_engine) {
+        
+        _A  = _engine->property_function(MAST::SectionPropertyEngine::AREA);
+        _Ay = _engine->property_function(MAST::SectionPropertyEngine::AREA_Y_MOMENT);
+        _Az = _engine->property_function(MAST::SectionPropertyEngine::AREA_Z_MOMENT);
+        _J  = _engine->property_function(MAST::SectionPropertyEngine::TORSIONAL_CONSTANT);
+        _Ip = _engine->property_function(MAST::SectionPropertyEngine::POLAR_INERTIA);
+        _AI = _engine->area_inertia_function();
+        
+        _stress_hy     = _engine->property_function(MAST::SectionPropertyEngine::SECTION_HY);
+        _stress_hz     = _engine->property_function(MAST::SectionPropertyEngine::SECTION_HZ);
+        _stress_hy_off = _engine->property_function(MAST::SectionPropertyEngine::SECTION_Y_OFFSET);
+        _stress_hz_off = _engine->property_function(MAST::SectionPropertyEngine::SECTION_Z_OFFSET);
+        
+        _initialized = true;
+        return;
+    }
+    
     MAST::FieldFunction<Real>
     &hy     =  this->get<MAST::FieldFunction<Real> >("hy"),
     &hz     =  this->get<MAST::FieldFunction<Real> >("hz"),
@@ -23,6 +23,7 @@
 
 // MAST includes
 #include "property_cards/element_property_card_1D.h"
+#include "property_cards/section_property_engine.h"
 
 namespace MAST {
     
@@ -35,7 +36,8 @@ namespace MAST {
         Solid1DSectionElementPropertyCard():
         MAST::ElementPropertyCard1D(),
         _initialized(false),
-        _material(nullptr)
+        _material(nullptr),
+        _engine(nullptr)
         { }
         
         
@@ -184,6 +186,29 @@ namespace MAST {
         virtual bool depends_on(const MAST::FunctionBase& f) const;
 
         
+        /*!
+         *   with a section engine, the stress recovery points are placed on
+         *   the bounding box of the engine section. Otherwise, the
+         *   rectangular section dimensions are used.
+         */
+        virtual const MAST::FieldFunction<Real>&
+        stress_recovery_function(const std::string& nm) const;
+        
+        
+        /*!
+         *   sets the engine that computes the section properties. If set
+         *   before init(), the area, moments, inertia and torsional constant
+         *   of the section are obtained from the engine instead of the
+         *   rectangular section dimensions "hy", "hz", "hy_off", "hz_off",
+         *   and the stress is recovered on the bounding box of the section.
+         */
+        void set_section_engine(MAST::SectionPropertyEngine& engine) {
+            
+            libmesh_assert(!_initialized);
+            _engine = &engine;
+        }
+        
+        
         virtual void init();
         
     protected:
@@ -195,6 +220,11 @@ namespace MAST {
          */
         MAST::MaterialPropertyCardBase *_material;
         
+        /*!
+         *   engine for general sections, if provided
+         */
+        MAST::SectionPropertyEngine *_engine;
+        
         std::auto_ptr<MAST::FieldFunction<Real> > _A;
         
         std::auto_ptr<MAST::FieldFunction<Real> > _J;
@@ -207,6 +237,13 @@ namespace MAST {
         
         std::auto_ptr<MAST::FieldFunction<RealMatrixX> > _AI;
         
+        /*!
+         *   bounding box of the engine section for stress recovery, in
+         *   the order "hy", "hz", "hy_off", "hz_off"
+         */
+        std::auto_ptr<MAST::FieldFunction<Real> > _stress_hy, _stress_hz,
+        _stress_hy_off, _stress_hz_off;
+        
         std::auto_ptr<MAST::FieldFunction<RealMatrixX> > _stiff_A;
 
         std::auto_ptr<MAST::FieldFunction<RealMatrixX> > _stiff_B;
@@ -22,6 +22,8 @@
 #include "solver/complex_solver_base.h"
 #include "base/complex_assembly_base.h"
 #include "base/nonlinear_system.h"
+#include "base/performance_log.h"
+#include "solver/single_precision_preconditioner.h"
 
 
 // libMesh includes
@@ -39,7 +41,8 @@
 MAST::ComplexSolverBase::ComplexSolverBase():
 _assembly(nullptr),
 tol(1.0e-3),
-max_iters(20) {
+max_iters(20),
+_if_single_precision_pc(false) {
     
 }
 
@@ -146,6 +149,7 @@ MAST::ComplexSolverBase::imag_solution(bool if_sens) const {
 void
 MAST::ComplexSolverBase::solve() {
     
+    MAST_LOG_SCOPE("ComplexSolverBase::solve");
     
     //  The complex system of equations
     //     (J_R + i J_I) (x_R + i x_I) + (r_R + i r_I) = 0
@@ -234,7 +238,8 @@ MAST::ComplexSolverBase::solve() {
 void
 MAST::ComplexSolverBase::solve_pc_fieldsplit() {
     
-    START_LOG("complex_solve()", "PetscFieldSplitSolver");
+    MAST_LOG_SCOPE("ComplexSolverBase::solve_pc_fieldsplit");
+    LOG_SCOPE("complex_solve()", "PetscFieldSplitSolver");
     
     // get reference to the system
     MAST::NonlinearSystem& sys =
@@ -342,6 +347,10 @@ MAST::ComplexSolverBase::solve_pc_fieldsplit() {
     // now solve
     ierr = KSPSolve(ksp, res, sol);
     
+    PetscInt n_iters = 0;
+    KSPGetIterationNumber(ksp, &n_iters);
+    MAST_LOG_COUNT("ksp_iterations", n_iters);
+    
     
     // assemble the matrices
     _assembly->residual_and_jacobian_field_split(*sol_R,
@@ -372,7 +381,6 @@ MAST::ComplexSolverBase::solve_pc_fieldsplit() {
     ierr = VecDestroy(&res);
     ierr = VecDestroy(&sol);
     
-    STOP_LOG("complex_solve()", "PetscFieldSplitSolver");
 }
 
 
@@ -380,7 +388,8 @@ MAST::ComplexSolverBase::solve_pc_fieldsplit() {
 void
 MAST::ComplexSolverBase::solve_block_matrix(MAST::Parameter* p)  {
     
-    START_LOG("solve_block_matrix()", "ComplexSolve");
+    MAST_LOG_SCOPE("ComplexSolverBase::solve_block_matrix");
+    LOG_SCOPE("solve_block_matrix()", "ComplexSolve");
     
     // get reference to the system
     MAST::NonlinearSystem& sys =
@@ -517,13 +526,24 @@ MAST::ComplexSolverBase::solve_block_matrix(MAST::Parameter* p)  {
     ierr = KSPGetPC(ksp, &pc);                CHKERRABORT(sys.comm().get(), ierr);
     ierr = PCSetFromOptions(pc);              CHKERRABORT(sys.comm().get(), ierr);
     
+    // the single precision preconditioner replaces the one set from the
+    // options
+    MAST::SinglePrecisionPreconditioner  sp_pc;
+    if (_if_single_precision_pc)
+        sp_pc.attach(pc);
     
-    START_LOG("KSPSolve", "ComplexSolve");
     
-    // now solve
-    ierr = KSPSolve(ksp, res_vec, sol_vec);
-
-    STOP_LOG("KSPSolve", "ComplexSolve");
+    {
+        MAST_LOG_SCOPE("ComplexSolverBase::KSPSolve");
+        LOG_SCOPE("KSPSolve", "ComplexSolve");
+        
+        // now solve
+        ierr = KSPSolve(ksp, res_vec, sol_vec);
+        
+        PetscInt n_iters = 0;
+        KSPGetIterationNumber(ksp, &n_iters);
+        MAST_LOG_COUNT("ksp_iterations", n_iters);
+    }
     
     // evaluate the residual again
     //_assembly->residual_and_jacobian_blocked(*sol,
@@ -555,7 +575,6 @@ MAST::ComplexSolverBase::solve_block_matrix(MAST::Parameter* p)  {
     ierr = VecDestroy(&res_vec);              CHKERRABORT(sys.comm().get(), ierr);
     ierr = VecDestroy(&sol_vec);              CHKERRABORT(sys.comm().get(), ierr);
     
-    STOP_LOG("solve_block_matrix()", "ComplexSolve");
 }
 
 
@@ -96,6 +96,18 @@ namespace MAST {
          *  to the parameter p
          */
         virtual void solve_block_matrix(MAST::Parameter* p = nullptr);
+        
+        
+        /*!
+         *  sets the flag to precondition the Krylov iterations of
+         *  solve_block_matrix() with MAST::SinglePrecisionPreconditioner,
+         *  which stores the ILU(0) factors of the block matrix in single
+         *  precision. This replaces the preconditioner chosen through the
+         *  PETSc options.
+         */
+        void set_single_precision_preconditioner(bool flag) {
+            _if_single_precision_pc = flag;
+        }
 
         
         /*!
@@ -147,6 +159,13 @@ namespace MAST {
          */
         MAST::ComplexAssemblyBase* _assembly;
         
+        
+        /*!
+         *   flag to use the single precision preconditioner in
+         *   solve_block_matrix()
+         */
+        bool _if_single_precision_pc;
+        
     };
 }
 
@@ -45,9 +45,17 @@ MAST::FirstOrderNewmarkTransientSolver::solve() {
     // make sure that the system has been specified
     libmesh_assert_msg(_system, "System pointer is nullptr.");
     
+    // the Jacobian from the previous step is valid only if the time
+    // step has not changed
+    _update_jacobian_lagging();
+    
     // ask the Newton solver to solve for the system solution
     _system->solve();
     
+    // the residual evaluations compute the velocity only on the element
+    // dofs. So, update the vector at the converged solution.
+    _update_current_derivatives();
+    
 }
 
 
@@ -67,7 +75,7 @@ _set_element_data(const std::vector<libMesh::dof_id_type>& dof_indices,
                   const std::vector<libMesh::NumericVector<Real>*>& sols,
                   MAST::ElementBase &elem){
     
-    libmesh_assert_equal_to(sols.size(), 2);
+    libmesh_assert_equal_to(sols.size(), 3);
     
     const unsigned int n_dofs = (unsigned int)dof_indices.size();
     
@@ -75,54 +83,68 @@ _set_element_data(const std::vector<libMesh::dof_id_type>& dof_indices,
     // also get the current discrete velocity replacement
     RealVectorX
     sol          = RealVectorX::Zero(n_dofs),
-    vel          = RealVectorX::Zero(n_dofs);
-
-
+    vel          = RealVectorX::Zero(n_dofs),
+    prev_sol     = RealVectorX::Zero(n_dofs),
+    prev_vel     = RealVectorX::Zero(n_dofs);
+    
     const libMesh::NumericVector<Real>
-    &sol_global = *sols[0],
-    &vel_global = *sols[1];
+    &sol_global      = *sols[0],
+    &prev_sol_global = *sols[1],
+    &prev_vel_global = *sols[2];
     
     // get the references to current and previous sol and velocity
-    
     for (unsigned int i=0; i<n_dofs; i++) {
         
         sol(i)          = sol_global(dof_indices[i]);
-        vel(i)          = vel_global(dof_indices[i]);
+        prev_sol(i)     = prev_sol_global(dof_indices[i]);
+        prev_vel(i)     = prev_vel_global(dof_indices[i]);
     }
     
+    if (_if_highest_derivative_solution)
+        // the velocity is provided at the current iteration
+        vel = prev_vel;
+    else
+        // see update_velocity()
+        vel = (1./beta/dt) * (sol - prev_sol) - ((1.-beta)/beta) * prev_vel;
+    
     elem.set_solution(sol);
     elem.set_velocity(vel);
 }
 
 
 
+
 void
 MAST::FirstOrderNewmarkTransientSolver::
 _set_element_perturbed_data(const std::vector<libMesh::dof_id_type>& dof_indices,
                             const std::vector<libMesh::NumericVector<Real>*>& sols,
                             MAST::ElementBase &elem){
     
-    libmesh_assert_equal_to(sols.size(), 2);
+    libmesh_assert_equal_to(sols.size(), 1);
     
     const unsigned int n_dofs = (unsigned int)dof_indices.size();
     
     // get the current state and velocity estimates
     // also get the current discrete velocity replacement
     RealVectorX
+    dsol         = RealVectorX::Zero(n_dofs),
     sol          = RealVectorX::Zero(n_dofs),
     vel          = RealVectorX::Zero(n_dofs);
     
-    
     const libMesh::NumericVector<Real>
-    &sol_global = *sols[0],
-    &vel_global = *sols[1];
+    &dsol_global = *sols[0];
     
-    // get the references to current and previous sol and velocity
+    for (unsigned int i=0; i<n_dofs; i++)
+        dsol(i)         = dsol_global(dof_indices[i]);
     
-    for (unsigned int i=0; i<n_dofs; i++) {
+    if (_if_highest_derivative_solution)
+        // the provided solution is the current velocity increment
+        vel = dsol;
+    else {
         
-        sol(i)          = sol_global(dof_indices[i]);
-        vel(i)          = vel_global(dof_indices[i]);
+        // see update_delta_velocity()
+        sol = dsol;
+        vel = (1./beta/dt) * dsol;
     }
     
     elem.set_perturbed_solution(sol);
@@ -132,7 +154,6 @@ _set_element_perturbed_data(const std::vector<libMesh::dof_id_type>& dof_indices
 
 
 
-
 void
 MAST::FirstOrderNewmarkTransientSolver::
 update_velocity(libMesh::NumericVector<Real>&       vec,
@@ -154,6 +175,76 @@ update_velocity(libMesh::NumericVector<Real>&       vec,
 
 
 
+Real
+MAST::FirstOrderNewmarkTransientSolver::
+_local_truncation_error_estimate(Real& order) {
+    
+    // the error is estimated from the difference between the converged
+    // solution and an explicit predictor of the same order as the
+    // method. Both have the same leading error term up to a constant,
+    // which gives the error of the corrector.
+    const libMesh::NumericVector<Real>
+    &prev_sol = this->solution(1),
+    &prev_vel = this->velocity(1);
+    
+    std::auto_ptr<libMesh::NumericVector<Real> >
+    dx(this->solution().clone().release());
+    dx->add(-1.,     prev_sol);
+    dx->add(-dt,     prev_vel);
+    
+    Real
+    c   = 0.;
+    
+    if (std::fabs(beta - 0.5) > 1.e-8) {
+        
+        // forward Euler predictor:  x_p = x0 + dt x0_dot,
+        // with error -dt^2/2 x_ddot. The corrector error is
+        // (beta-1/2) dt^2 x_ddot, so that
+        // e = (beta-1/2)/beta (x - x_p)
+        c     = std::fabs((beta - 0.5)/beta);
+        order = 2.;
+    }
+    else {
+        
+        // the trapezoidal rule is second-order accurate, and the predictor
+        // needs the velocity from two steps back. This is not available
+        // for the first step after the initial condition.
+        if (_prev_dt == 0.)
+            return -1.;
+        
+        if (_n_history < 3)
+            libmesh_error_msg("Error: beta was set to 1/2 after the assembly was "
+                              "attached. The velocity history needed for the "
+                              "error estimate is not stored.");
+        
+        // second-order Adams-Bashforth predictor for variable steps:
+        // x_p = x0 + dt x0_dot + dt^2/(2 dt0) (x0_dot - x00_dot),
+        // which gives  e = (x - x_p) dt / (3 (dt + dt0))
+        // (Gresho and Sani, Incompressible Flow and the Finite Element
+        // Method, 2000).
+        const Real
+        f = 0.5*dt*dt/_prev_dt;
+        dx->add(-f, prev_vel);
+        dx->add( f, this->velocity(2));
+        
+        c     = dt/3./(dt + _prev_dt);
+        order = 3.;
+    }
+    
+    dx->close();
+    
+    const Real
+    den = std::max(this->solution().l2_norm(), prev_sol.l2_norm());
+    
+    if (den == 0.)
+        return 0.;
+    
+    return c * dx->l2_norm() / den;
+}
+
+
+
+
 void
 MAST::FirstOrderNewmarkTransientSolver::
 update_delta_velocity(libMesh::NumericVector<Real>&       vec,
@@ -20,6 +20,9 @@
 #ifndef __mast__first_order_newmark_transient_solver__
 #define __mast__first_order_newmark_transient_solver__
 
+// C++ includes
+#include <cmath>
+
 // MAST includes
 #include "solver/transient_solver_base.h"
 
@@ -66,7 +69,10 @@ namespace MAST {
         virtual ~FirstOrderNewmarkTransientSolver();
         
         /*!
-         *    \f$ \beta \f$ parameter used by this solver.
+         *    \f$ \beta \f$ parameter used by this solver. This should be
+         *    set before the assembly is attached, since the trapezoidal
+         *    rule, \f$ \beta = 1/2 \f$, stores one more velocity vector
+         *    for the error estimate.
          */
         Real beta;
         
@@ -131,9 +137,24 @@ namespace MAST {
          *    are to be stored.
          */
         virtual unsigned int _n_iters_to_store() const {
-            return 2;
+            // the velocity from two steps back is used by the predictor
+            // for the error estimate of the trapezoidal rule.
+            return (std::fabs(beta - 0.5) > 1.e-8)? 2 : 3;
         }
         
+        /*!
+         *    estimates the local truncation error from the difference
+         *    between the converged solution and an explicit predictor.
+         *    For \f$ \beta \neq 1/2 \f$ the predictor is forward Euler
+         *    and the estimate is \f$ O(\Delta t^2) \f$. For
+         *    \f$ \beta = 1/2 \f$ the predictor is the second-order
+         *    Adams-Bashforth scheme and the estimate is
+         *    \f$ O(\Delta t^3) \f$. In the latter case no estimate is
+         *    available for the first step after the initial condition, and
+         *    a negative value is returned.
+         */
+        virtual Real _local_truncation_error_estimate(Real& order);
+        
         /*!
          *    provides the element with the transient data for calculations
          */
@@ -0,0 +1,122 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2017  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+// MAST includes
+#include "solver/jacobian_lagging_policy.h"
+
+
+MAST::JacobianLaggingPolicy::JacobianLaggingPolicy():
+max_lagged_iterations          (0),
+residual_reduction_threshold   (0.5),
+reuse_across_solves            (false),
+_if_jacobian_available         (false),
+_if_in_solve                   (false),
+_if_new_solve                  (false),
+_n_lagged                      (0),
+_residual_norm                 (0.),
+_residual_norm_at_last_request (0.),
+_n_assemblies                  (0),
+_n_reuses                      (0) {
+    
+}
+
+
+
+MAST::JacobianLaggingPolicy::~JacobianLaggingPolicy() {
+    
+}
+
+
+
+void
+MAST::JacobianLaggingPolicy::init_solve() {
+    
+    _if_in_solve   = true;
+    _if_new_solve  = true;
+    _residual_norm = 0.;
+    _residual_norm_at_last_request = 0.;
+}
+
+
+
+void
+MAST::JacobianLaggingPolicy::end_solve() {
+    
+    _if_in_solve  = false;
+    _if_new_solve = false;
+}
+
+
+
+void
+MAST::JacobianLaggingPolicy::reset() {
+    
+    _if_jacobian_available         = false;
+    _n_lagged                      = 0;
+    _residual_norm                 = 0.;
+    _residual_norm_at_last_request = 0.;
+    _n_assemblies                  = 0;
+    _n_reuses                      = 0;
+}
+
+
+
+void
+MAST::JacobianLaggingPolicy::discard_jacobian() {
+    
+    _if_jacobian_available = false;
+    _n_lagged              = 0;
+}
+
+
+
+bool
+MAST::JacobianLaggingPolicy::if_assemble_jacobian() {
+    
+    bool
+    assemble = false;
+    
+    if (!_if_in_solve || !_if_jacobian_available)
+        assemble = true;
+    else if (_if_new_solve)
+        assemble = !reuse_across_solves;
+    else if (_n_lagged >= max_lagged_iterations)
+        assemble = true;
+    else if (_residual_norm_at_last_request > 0. &&
+             _residual_norm > residual_reduction_threshold * _residual_norm_at_last_request)
+        assemble = true;
+    
+    _if_new_solve                  = false;
+    _residual_norm_at_last_request = _residual_norm;
+    
+    if (assemble) {
+        
+        _if_jacobian_available = true;
+        _n_lagged              = 0;
+        _n_assemblies++;
+    }
+    else {
+        
+        _n_lagged++;
+        _n_reuses++;
+    }
+    
+    return assemble;
+}
+
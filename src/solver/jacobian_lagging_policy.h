@@ -0,0 +1,174 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2017  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef __mast__jacobian_lagging_policy__
+#define __mast__jacobian_lagging_policy__
+
+// MAST includes
+#include "base/mast_data_types.h"
+
+
+namespace MAST {
+    
+    /*!
+     *   This class decides when the Jacobian of a nonlinear system needs to
+     *   be assembled again, and when the matrix from an earlier assembly can
+     *   be reused. When this object is attached to a MAST::NonlinearSystem
+     *   the assembly objects skip the Jacobian computations for requests
+     *   made during MAST::NonlinearSystem::solve() that the policy chooses
+     *   to lag, and compute only the residual. The Jacobian is assembled
+     *   again when
+     *   - no Jacobian is available from a previous assembly,
+     *   - a new solve starts and \p reuse_across_solves is false,
+     *   - it has been reused for \p max_lagged_iterations requests, or
+     *   - the ratio of residual norms at two successive requests exceeds
+     *     \p residual_reduction_threshold.
+     *
+     *   Requests made outside of a solve, for example for sensitivity
+     *   analysis, always assemble the Jacobian. The default values do not
+     *   lag the Jacobian.
+     */
+    class JacobianLaggingPolicy {
+        
+    public:
+        
+        JacobianLaggingPolicy();
+        
+        virtual ~JacobianLaggingPolicy();
+        
+        /*!
+         *   number of successive Jacobian requests for which the last
+         *   assembled Jacobian is reused. A value of 0 assembles the
+         *   Jacobian for every request.
+         */
+        unsigned int max_lagged_iterations;
+        
+        /*!
+         *   the Jacobian is assembled again if the ratio of residual norm at
+         *   this request to that at the previous request is larger than this
+         *   value, which indicates that the lagged Jacobian is not providing
+         *   sufficient reduction of the residual. Default value is 0.5.
+         */
+        Real residual_reduction_threshold;
+        
+        /*!
+         *   if true, the Jacobian assembled in the previous solve is used at
+         *   the first iteration of the next solve, for example the next load
+         *   or continuation step. Default value is false.
+         */
+        bool reuse_across_solves;
+        
+        /*!
+         *   called by MAST::NonlinearSystem at the beginning of a solve.
+         */
+        void init_solve();
+        
+        /*!
+         *   called by MAST::NonlinearSystem at the end of a solve.
+         */
+        void end_solve();
+        
+        /*!
+         *   discards the stored Jacobian so that it is assembled at the next
+         *   request. This should be called if the system matrix was modified
+         *   or reinitialized outside of the assembly, for example after the
+         *   mesh is refined.
+         */
+        void reset();
+        
+        /*!
+         *   marks the stored Jacobian as outdated so that it is assembled
+         *   at the next request. Unlike reset(), the assembly and reuse
+         *   counts are retained. The transient solvers call this when the
+         *   time step changes.
+         */
+        void discard_jacobian();
+        
+        /*!
+         *   called by the assembly object when a Jacobian is requested.
+         *   @returns true if the Jacobian should be assembled, and false if
+         *   the matrix from the previous assembly should be reused.
+         */
+        bool if_assemble_jacobian();
+        
+        /*!
+         *   called by the assembly object with the norm of the latest
+         *   residual vector.
+         */
+        void set_residual_norm(Real r) {
+            _residual_norm = r;
+        }
+        
+        /*!
+         *   @returns the number of Jacobian assemblies since construction or
+         *   the last call to reset()
+         */
+        unsigned int n_jacobian_assemblies() const {
+            return _n_assemblies;
+        }
+        
+        /*!
+         *   @returns the number of Jacobian requests that reused a previously
+         *   assembled matrix since construction or the last call to reset()
+         */
+        unsigned int n_jacobian_reuses() const {
+            return _n_reuses;
+        }
+        
+    protected:
+        
+        /*!
+         *   true if the system matrix holds a Jacobian from a previous
+         *   assembly
+         */
+        bool _if_jacobian_available;
+        
+        /*!
+         *   true between init_solve() and end_solve()
+         */
+        bool _if_in_solve;
+        
+        /*!
+         *   true until the first Jacobian request of a solve
+         */
+        bool _if_new_solve;
+        
+        /*!
+         *   number of requests that have reused the current Jacobian
+         */
+        unsigned int _n_lagged;
+        
+        /*!
+         *   norm of the latest residual vector
+         */
+        Real _residual_norm;
+        
+        /*!
+         *   residual norm at the last Jacobian request
+         */
+        Real _residual_norm_at_last_request;
+        
+        unsigned int _n_assemblies;
+        
+        unsigned int _n_reuses;
+    };
+}
+
+
+#endif // __mast__jacobian_lagging_policy__
@@ -18,14 +18,19 @@
  */
 
 
+// C++ includes
+#include <algorithm>
+
 // MAST includes
 #include "solver/multiphysics_nonlinear_solver.h"
 #include "base/nonlinear_implicit_assembly.h"
 #include "base/system_initialization.h"
 #include "base/nonlinear_system.h"
+#include "base/performance_log.h"
 
 // libMesh includes
 #include "libmesh/dof_map.h"
+#include "libmesh/mesh_base.h"
 #include "libmesh/petsc_matrix.h"
 #include "libmesh/petsc_vector.h"
 
@@ -44,6 +49,7 @@ __mast_multiphysics_petsc_shell_context {
 PetscErrorCode
 __mast_multiphysics_petsc_mat_mult(Mat mat,Vec dx,Vec y) {
 
+    MAST_LOG_SCOPE("MultiphysicsNonlinearSolver::mat_mult");
     LOG_SCOPE("mat_mult()", "PetscNonlinearSolver");
     
     PetscErrorCode ierr=0;
@@ -167,6 +173,7 @@ __mast_multiphysics_petsc_mat_mult(Mat mat,Vec dx,Vec y) {
 PetscErrorCode
 __mast_multiphysics_petsc_snes_residual (SNES snes, Vec x, Vec r, void * ctx) {
     
+    MAST_LOG_SCOPE("MultiphysicsNonlinearSolver::residual");
     LOG_SCOPE("residual()", "PetscMultiphysicsNonlinearSolver");
     
     PetscErrorCode ierr=0;
@@ -286,6 +293,7 @@ __mast_multiphysics_petsc_snes_residual (SNES snes, Vec x, Vec r, void * ctx) {
 PetscErrorCode
 __mast_multiphysics_petsc_snes_jacobian(SNES snes, Vec x, Mat jac, Mat pc, void * ctx)
 {
+    MAST_LOG_SCOPE("MultiphysicsNonlinearSolver::jacobian");
     LOG_SCOPE("jacobian()", "PetscMultiphysicsNonlinearSolver");
     
     PetscErrorCode ierr=0;
@@ -374,6 +382,14 @@ __mast_multiphysics_petsc_snes_jacobian(SNES snes, Vec x, Mat jac, Mat pc, void
         // now restore the subvectors
         ierr = VecRestoreSubVector(x, sys_is, &sol[i]);  CHKERRABORT(solver->comm().get(), ierr);
     }
+    
+    //////////////////////////////////////////////////////////////////
+    // the off-diagonal blocks that are stored as sparse matrices. These
+    // use the shell products, which extract the discipline subvectors
+    // from the solution, so this is done only after the subvectors above
+    // have been restored.
+    //////////////////////////////////////////////////////////////////
+    solver->assemble_coupling_blocks(snes);
 
     
     // call assembly of the global matrix
@@ -399,6 +415,9 @@ _update                       (nullptr),
 _discipline_assembly          (n, nullptr),
 _is                           (_n_disciplines, PETSC_NULL),
 _sub_mats                     (_n_disciplines*_n_disciplines, PETSC_NULL),
+_coupling_shells              (_n_disciplines*_n_disciplines, PETSC_NULL),
+_if_assembled_block           (_n_disciplines*_n_disciplines, false),
+_coupling_data                (_n_disciplines*_n_disciplines),
 _n_dofs                       (0) {
     
 }
@@ -445,6 +464,391 @@ get_system_assembly(unsigned int i) {
 
 
 
+void
+MAST::MultiphysicsNonlinearSolverBase::
+set_assembled_coupling_block
+(unsigned int i,
+ unsigned int j,
+ const std::vector<std::vector<libMesh::dof_id_type> >* sparsity) {
+    
+    // make sure that the indices are within bounds and define an
+    // off-diagonal block
+    libmesh_assert_less(i, _n_disciplines);
+    libmesh_assert_less(j, _n_disciplines);
+    libmesh_assert_not_equal_to(i, j);
+    
+    _if_assembled_block[i*_n_disciplines+j] = true;
+    
+    // the provided sparsity is added to any previous sparsity of the block,
+    // so that entries found earlier are retained
+    if (sparsity)
+        _add_coupling_sparsity(i, j, *sparsity);
+}
+
+
+
+void
+MAST::MultiphysicsNonlinearSolverBase::
+_add_coupling_sparsity
+(unsigned int i,
+ unsigned int j,
+ const std::vector<std::vector<libMesh::dof_id_type> >& sparsity) {
+    
+    MAST::MultiphysicsNonlinearSolverBase::CouplingBlockData
+    &data = _coupling_data[i*_n_disciplines+j];
+    
+    // one entry is needed for each local row
+    libmesh_assert(!_discipline_assembly[i] ||
+                   sparsity.size() == _discipline_assembly[i]->system().n_local_dofs());
+    libmesh_assert(!data.if_sparsity ||
+                   sparsity.size() == data.sparsity.size());
+    
+    data.sparsity.resize(sparsity.size());
+    
+    // the rows are sorted and unique
+    for (unsigned int r=0; r<sparsity.size(); r++) {
+    
+        std::vector<libMesh::dof_id_type>& cols = data.sparsity[r];
+        cols.insert(cols.end(), sparsity[r].begin(), sparsity[r].end());
+        std::sort(cols.begin(), cols.end());
+        cols.erase(std::unique(cols.begin(), cols.end()), cols.end());
+    }
+    
+    // the coloring is computed again for the new sparsity
+    data.if_sparsity = true;
+    data.if_colored  = false;
+}
+
+
+
+void
+MAST::MultiphysicsNonlinearSolverBase::assemble_coupling_blocks(SNES snes) {
+    
+    PetscErrorCode ierr;
+    
+    for (unsigned int i=0; i<_n_disciplines; i++)
+        for (unsigned int j=0; j<_n_disciplines; j++) {
+    
+            if (i == j || !_if_assembled_block[i*_n_disciplines+j])
+                continue;
+    
+            MAST_LOG_SCOPE("MultiphysicsNonlinearSolver::assemble_coupling_block");
+            LOG_SCOPE("assemble_coupling_block()", "PetscMultiphysicsNonlinearSolver");
+    
+            MAST::MultiphysicsNonlinearSolverBase::CouplingBlockData
+            &data = _coupling_data[i*_n_disciplines+j];
+    
+            // the sparsity and coloring are computed once and retained
+            // across solves. The sparse matrix is created once per solve.
+            if (!data.if_sparsity)
+                _build_coupling_sparsity(i, j);
+            if (!data.if_colored)
+                _color_coupling_block(i, j);
+            if (_sub_mats[i*_n_disciplines+j] == _coupling_shells[i*_n_disciplines+j])
+                _create_coupling_block_matrix(i, j);
+    
+            Mat
+            shell = _coupling_shells[i*_n_disciplines+j],
+            mat   = _sub_mats[i*_n_disciplines+j];
+    
+            Vec
+            dx,
+            y;
+    
+            PetscInt
+            row_first = 0,
+            row_last  = 0,
+            col_first = 0,
+            col_last  = 0;
+    
+            PetscScalar
+            *dx_vals  = nullptr;
+    
+            const PetscScalar
+            *vals     = nullptr;
+    
+            // local rows with a nonzero of the current color
+            std::vector<bool>
+            if_row_in_color;
+    
+            ierr = MatCreateVecs(shell, &dx, &y);                  CHKERRABORT(this->comm().get(), ierr);
+            ierr = VecGetOwnershipRange(y, &row_first, &row_last); CHKERRABORT(this->comm().get(), ierr);
+            ierr = VecGetOwnershipRange(dx, &col_first, &col_last);CHKERRABORT(this->comm().get(), ierr);
+    
+            // columns of a color do not share a row, so each nonzero in the
+            // product along the sum of their unit vectors belongs to exactly
+            // one column of the color
+            for (unsigned int c=0; c<data.color_cols.size(); c++) {
+    
+                ierr = VecSet(dx, 0.);                      CHKERRABORT(this->comm().get(), ierr);
+                ierr = VecGetArray(dx, &dx_vals);           CHKERRABORT(this->comm().get(), ierr);
+                for (unsigned int k=0; k<data.color_cols[c].size(); k++)
+                    dx_vals[data.color_cols[c][k]-col_first] = 1.;
+                ierr = VecRestoreArray(dx, &dx_vals);       CHKERRABORT(this->comm().get(), ierr);
+    
+                ierr = MatMult(shell, dx, y);               CHKERRABORT(this->comm().get(), ierr);
+    
+                if_row_in_color.assign(row_last-row_first, false);
+    
+                ierr = VecGetArrayRead(y, &vals);           CHKERRABORT(this->comm().get(), ierr);
+                for (unsigned int k=0; k<data.color_entries[c].size(); k++) {
+    
+                    const std::pair<libMesh::dof_id_type, libMesh::dof_id_type>
+                    &e = data.color_entries[c][k];
+    
+                    if_row_in_color[e.first-row_first] = true;
+    
+                    ierr = MatSetValue(mat,
+                                       e.first,
+                                       e.second,
+                                       vals[e.first-row_first],
+                                       INSERT_VALUES);
+                    CHKERRABORT(this->comm().get(), ierr);
+                }
+    
+                // a nonzero in a row without an entry of this color comes
+                // from a column outside the sparsity, and would be dropped
+                for (PetscInt r=row_first; r<row_last; r++)
+                    if (!if_row_in_color[r-row_first] && vals[r-row_first] != 0.)
+                        libmesh_error_msg("Error: coupling block ("
+                                          << i << ", " << j << ") has a nonzero in row "
+                                          << r << " outside its sparsity pattern.");
+                ierr = VecRestoreArrayRead(y, &vals);       CHKERRABORT(this->comm().get(), ierr);
+            }
+    
+            MAST_LOG_COUNT("coupling_block_products", data.color_cols.size());
+    
+            ierr = MatAssemblyBegin(mat, MAT_FINAL_ASSEMBLY);  CHKERRABORT(this->comm().get(), ierr);
+            ierr = MatAssemblyEnd(mat, MAT_FINAL_ASSEMBLY);    CHKERRABORT(this->comm().get(), ierr);
+    
+            ierr = VecDestroy(&dx);                         CHKERRABORT(this->comm().get(), ierr);
+            ierr = VecDestroy(&y);                          CHKERRABORT(this->comm().get(), ierr);
+        }
+}
+
+
+
+void
+MAST::MultiphysicsNonlinearSolverBase::
+_build_coupling_sparsity(unsigned int i, unsigned int j) {
+    
+    MAST_LOG_SCOPE("MultiphysicsNonlinearSolver::build_coupling_sparsity");
+    
+    const MAST::NonlinearSystem
+    &sys_i = _discipline_assembly[i]->system(),
+    &sys_j = _discipline_assembly[j]->system();
+    
+    // disciplines on different meshes are coupled through quantities that
+    // are not known from their dofs, so the sparsity has to be provided
+    // by the user.
+    if (&sys_i.get_mesh() != &sys_j.get_mesh())
+        libmesh_error_msg("Error: disciplines " << i << " and " << j
+                          << " are on different meshes. The sparsity of "
+                          << "the coupling block must be provided to "
+                          << "set_assembled_coupling_block().");
+    
+    const libMesh::DofMap
+    &dof_map_i = sys_i.get_dof_map(),
+    &dof_map_j = sys_j.get_dof_map();
+    
+    const libMesh::dof_id_type
+    row_first = dof_map_i.first_dof(),
+    row_last  = dof_map_i.end_dof();
+    
+    // the linearized residual of discipline i on an element depends only
+    // on the dofs of discipline j on the same element. The local and ghost
+    // elements include all elements that contribute to the local rows.
+    std::vector<std::vector<libMesh::dof_id_type> >
+    sparsity(dof_map_i.n_local_dofs());
+    
+    std::vector<libMesh::dof_id_type>
+    rows,
+    cols;
+    
+    libMesh::MeshBase::const_element_iterator
+    el     = sys_i.get_mesh().active_elements_begin();
+    const libMesh::MeshBase::const_element_iterator
+    end_el = sys_i.get_mesh().active_elements_end();
+    
+    for ( ; el != end_el; ++el) {
+    
+        dof_map_i.dof_indices(*el, rows);
+        dof_map_j.dof_indices(*el, cols);
+    
+        for (unsigned int r=0; r<rows.size(); r++)
+            if (row_first <= rows[r] && rows[r] < row_last)
+                sparsity[rows[r]-row_first].insert
+                (sparsity[rows[r]-row_first].end(), cols.begin(), cols.end());
+    }
+    
+    _add_coupling_sparsity(i, j, sparsity);
+}
+
+
+
+void
+MAST::MultiphysicsNonlinearSolverBase::
+_color_coupling_block(unsigned int i, unsigned int j) {
+    
+    MAST_LOG_SCOPE("MultiphysicsNonlinearSolver::color_coupling_block");
+    
+    MAST::MultiphysicsNonlinearSolverBase::CouplingBlockData
+    &data = _coupling_data[i*_n_disciplines+j];
+    
+    libmesh_assert(data.if_sparsity);
+    
+    const libMesh::DofMap
+    &dof_map_i = _discipline_assembly[i]->system().get_dof_map(),
+    &dof_map_j = _discipline_assembly[j]->system().get_dof_map();
+    
+    const libMesh::dof_id_type
+    n_cols     = dof_map_j.n_dofs(),
+    row_first  = dof_map_i.first_dof(),
+    col_first  = dof_map_j.first_dof(),
+    col_last   = dof_map_j.end_dof();
+    
+    // the rows from all processors are needed to find the columns that
+    // share a row. Each row is stored as its number of columns, followed
+    // by the columns.
+    std::vector<libMesh::dof_id_type>
+    rows;
+    
+    for (unsigned int r=0; r<data.sparsity.size(); r++) {
+    
+        rows.push_back(data.sparsity[r].size());
+        rows.insert(rows.end(), data.sparsity[r].begin(), data.sparsity[r].end());
+    }
+    
+    this->comm().allgather(rows);
+    
+    // offsets of the rows in the gathered vector, and the rows in which
+    // each column has a nonzero
+    std::vector<libMesh::dof_id_type>
+    row_begin;
+    
+    std::vector<std::vector<libMesh::dof_id_type> >
+    col_rows(n_cols);
+    
+    for (libMesh::dof_id_type p=0; p<rows.size(); p += rows[p]+1) {
+    
+        for (libMesh::dof_id_type k=1; k<=rows[p]; k++)
+            col_rows[rows[p+k]].push_back(row_begin.size());
+        row_begin.push_back(p);
+    }
+    
+    // greedy coloring in the order of the columns, which gives the same
+    // colors on all processors. Columns without nonzeros are not colored.
+    std::vector<int>
+    colors(n_cols, -1),
+    used;
+    
+    int
+    n_colors = 0;
+    
+    for (libMesh::dof_id_type k=0; k<n_cols; k++) {
+    
+        if (col_rows[k].empty())
+            continue;
+    
+        // mark the colors of the columns that share a row with this column
+        used.assign(n_colors+1, 0);
+        for (unsigned int l=0; l<col_rows[k].size(); l++) {
+    
+            const libMesh::dof_id_type
+            p = row_begin[col_rows[k][l]];
+    
+            for (libMesh::dof_id_type m=1; m<=rows[p]; m++)
+                if (colors[rows[p+m]] >= 0)
+                    used[colors[rows[p+m]]] = 1;
+        }
+    
+        int c = 0;
+        while (used[c])
+            c++;
+    
+        colors[k] = c;
+        n_colors  = std::max(n_colors, c+1);
+    }
+    
+    // local columns and nonzeros of each color
+    data.color_cols.clear();
+    data.color_entries.clear();
+    data.color_cols.resize(n_colors);
+    data.color_entries.resize(n_colors);
+    
+    for (libMesh::dof_id_type k=col_first; k<col_last; k++)
+        if (colors[k] >= 0)
+            data.color_cols[colors[k]].push_back(k);
+    
+    for (unsigned int r=0; r<data.sparsity.size(); r++)
+        for (unsigned int l=0; l<data.sparsity[r].size(); l++)
+            data.color_entries[colors[data.sparsity[r][l]]].push_back
+            (std::pair<libMesh::dof_id_type, libMesh::dof_id_type>
+             (row_first+r, data.sparsity[r][l]));
+    
+    data.if_colored = true;
+}
+
+
+
+void
+MAST::MultiphysicsNonlinearSolverBase::
+_create_coupling_block_matrix(unsigned int i, unsigned int j) {
+    
+    PetscErrorCode ierr;
+    
+    MAST::MultiphysicsNonlinearSolverBase::CouplingBlockData
+    &data = _coupling_data[i*_n_disciplines+j];
+    
+    libmesh_assert(data.if_sparsity);
+    
+    const libMesh::DofMap
+    &dof_map_i = _discipline_assembly[i]->system().get_dof_map(),
+    &dof_map_j = _discipline_assembly[j]->system().get_dof_map();
+    
+    const libMesh::dof_id_type
+    col_first  = dof_map_j.first_dof(),
+    col_last   = dof_map_j.end_dof();
+    
+    libmesh_assert_equal_to(data.sparsity.size(), dof_map_i.n_local_dofs());
+    
+    // nonzeros in the diagonal and off-diagonal parts of each local row
+    std::vector<PetscInt>
+    d_nnz(data.sparsity.size(), 0),
+    o_nnz(data.sparsity.size(), 0);
+    
+    for (unsigned int r=0; r<data.sparsity.size(); r++)
+        for (unsigned int l=0; l<data.sparsity[r].size(); l++) {
+    
+            if (col_first <= data.sparsity[r][l] &&
+                data.sparsity[r][l] < col_last)
+                d_nnz[r]++;
+            else
+                o_nnz[r]++;
+        }
+    
+    Mat
+    mat = PETSC_NULL;
+    
+    ierr = MatCreateAIJ(this->comm().get(),
+                        dof_map_i.n_local_dofs(),
+                        dof_map_j.n_local_dofs(),
+                        dof_map_i.n_dofs(),
+                        dof_map_j.n_dofs(),
+                        0, d_nnz.size()?&d_nnz[0]:PETSC_NULL,
+                        0, o_nnz.size()?&o_nnz[0]:PETSC_NULL,
+                        &mat);
+    CHKERRABORT(this->comm().get(), ierr);
+    
+    // the nested matrix keeps its own reference to the new block
+    ierr = MatNestSetSubMat(_mat, i, j, mat);
+    CHKERRABORT(this->comm().get(), ierr);
+    
+    _sub_mats[i*_n_disciplines+j] = mat;
+}
+
+
+
 void
 MAST::MultiphysicsNonlinearSolverBase::solve() {
     
@@ -512,7 +916,7 @@ MAST::MultiphysicsNonlinearSolverBase::solve() {
                                       mat_i_m,
                                       mat_j_m,
                                       PETSC_NULL,
-                                      &_sub_mats[i*_n_disciplines+j]);
+                                      &_coupling_shells[i*_n_disciplines+j]);
                 CHKERRABORT(this->comm().get(), ierr);
                 
                 // initialize the context and tell the matrix about it
@@ -521,16 +925,20 @@ MAST::MultiphysicsNonlinearSolverBase::solve() {
                 mat_ctx[i*_n_disciplines+j].snes   = snes;
                 mat_ctx[i*_n_disciplines+j].solver = this;
                 
-                ierr = MatShellSetContext(_sub_mats[i*_n_disciplines+j],
+                ierr = MatShellSetContext(_coupling_shells[i*_n_disciplines+j],
                                           &mat_ctx[i*_n_disciplines+j]);
                 CHKERRABORT(this->comm().get(), ierr);
                 
                 // set the mat-vec multiplication operation for this
                 // shell matrix
-                ierr = MatShellSetOperation(_sub_mats[i*_n_disciplines+j],
+                ierr = MatShellSetOperation(_coupling_shells[i*_n_disciplines+j],
                                             MATOP_MULT,
                                             (void(*)(void))__mast_multiphysics_petsc_mat_mult);
                 CHKERRABORT(this->comm().get(), ierr);
+                
+                // an assembled block uses the shell until its sparse
+                // matrix is created at the first Jacobian evaluation
+                _sub_mats[i*_n_disciplines+j] = _coupling_shells[i*_n_disciplines+j];
             }
         }
     }
@@ -679,12 +1087,23 @@ MAST::MultiphysicsNonlinearSolverBase::solve() {
     //////////////////////////////////////////////////////////////////////
     // now, solve
     //////////////////////////////////////////////////////////////////////
-    START_LOG("SNESSolve", this->name()+"_MultiphysicsSolve");
-    
-    // now solve
-    ierr = SNESSolve(snes, PETSC_NULL, _sol);
-    
-    STOP_LOG("SNESSolve", this->name()+"_MultiphysicsSolve");
+    {
+        MAST_LOG_SCOPE("MultiphysicsNonlinearSolver::SNESSolve");
+        START_LOG("SNESSolve", this->name()+"_MultiphysicsSolve");
+        
+        // now solve
+        ierr = SNESSolve(snes, PETSC_NULL, _sol);
+        
+        STOP_LOG("SNESSolve", this->name()+"_MultiphysicsSolve");
+        
+        PetscInt
+        n_iters     = 0,
+        n_lin_iters = 0;
+        SNESGetIterationNumber(snes, &n_iters);
+        SNESGetLinearSolveIterations(snes, &n_lin_iters);
+        MAST_LOG_COUNT("nonlinear_iterations", n_iters);
+        MAST_LOG_COUNT("ksp_iterations",       n_lin_iters);
+    }
     
     
     //////////////////////////////////////////////////////////////////////
@@ -732,8 +1151,13 @@ MAST::MultiphysicsNonlinearSolverBase::solve() {
     for (unsigned int i=0; i<_n_disciplines; i++)
         for (unsigned int j=0; j<_n_disciplines; j++)
             if (i != j) {
-                ierr = MatDestroy(&_sub_mats[i*_n_disciplines+j]);
+                if (_sub_mats[i*_n_disciplines+j] != _coupling_shells[i*_n_disciplines+j]) {
+                    ierr = MatDestroy(&_sub_mats[i*_n_disciplines+j]);
+                    CHKERRABORT(this->comm().get(), ierr);
+                }
+                ierr = MatDestroy(&_coupling_shells[i*_n_disciplines+j]);
                 CHKERRABORT(this->comm().get(), ierr);
+                _sub_mats[i*_n_disciplines+j] = PETSC_NULL;
             }
     
     ierr = MatDestroy(&_mat);                          CHKERRABORT(this->comm().get(), ierr);
@@ -801,7 +1225,7 @@ MAST::MultiphysicsNonlinearSolverBase::verify_gateaux_derivatives(SNES snes) {
                     vecx = dynamic_cast<libMesh::PetscVector<Real>*>(dsol_j.get())->vec(),
                     vecy = dynamic_cast<libMesh::PetscVector<Real>*>(dJac_ij_dXj.get())->vec();
                     
-                    __mast_multiphysics_petsc_mat_mult(_sub_mats[i*_n_disciplines+j], vecx, vecy);
+                    __mast_multiphysics_petsc_mat_mult(_coupling_shells[i*_n_disciplines+j], vecx, vecy);
 
                     // now perform the same calculation with the finite differencing
                     // using residual calculation
@@ -23,6 +23,7 @@
 // C++ includes
 #include <vector>
 #include <string>
+#include <utility>
 
 // MAST includes
 #include "base/mast_data_types.h"
@@ -174,6 +175,39 @@ namespace MAST {
         }
 
         
+        /*!
+         *   requests that the off-diagonal block \p (i,j), with \p i != \p j,
+         *   be assembled as a sparse matrix once at each Jacobian evaluation,
+         *   instead of applying the linearized residual of discipline \p i
+         *   at every Krylov iteration. \p sparsity, if provided, lists for
+         *   each local row of discipline \p i the global dofs of discipline
+         *   \p j that it is coupled to, and is added to the sparsity from
+         *   earlier calls. Otherwise, the sparsity is built at the first
+         *   Jacobian evaluation from the dofs of the two disciplines that
+         *   share an element, which requires both disciplines to be on the
+         *   same mesh. The columns are colored so that no two columns of a
+         *   color share a row, and the block is assembled with one
+         *   linearized product per color. A nonzero outside the sparsity
+         *   raises an error. This is beneficial when the coupling is
+         *   limited to a few dofs, for example the wetted-boundary dofs of
+         *   a fluid-structure interface. Must be called before solve().
+         */
+        void
+        set_assembled_coupling_block
+        (unsigned int i,
+         unsigned int j,
+         const std::vector<std::vector<libMesh::dof_id_type> >* sparsity = nullptr);
+        
+        
+        /*!
+         *   assembles the off-diagonal blocks requested through
+         *   set_assembled_coupling_block() at the current solution of
+         *   \p snes. This is called from the Jacobian evaluation after the
+         *   discipline subvectors of the solution have been restored.
+         */
+        void assemble_coupling_blocks(SNES snes);
+        
+        
         void verify_gateaux_derivatives(SNES snes);
         
         
@@ -204,6 +238,95 @@ namespace MAST {
 
         std::vector<IS>  _is;
         std::vector<Mat> _sub_mats; // row-major ordering
+        
+        /*!
+         *   shell matrices for the off-diagonal blocks, which compute the
+         *   product using the linearized residual of the row discipline.
+         *   These are used in the nested matrix unless the block is
+         *   assembled. Row-major ordering.
+         */
+        std::vector<Mat> _coupling_shells;
+        
+        /*!
+         *   flags for off-diagonal blocks that are assembled as sparse
+         *   matrices. Row-major ordering.
+         */
+        std::vector<bool> _if_assembled_block;
+        
+        /*!
+         *   sparsity and column coloring of an assembled off-diagonal block
+         */
+        struct CouplingBlockData {
+            
+            CouplingBlockData(): if_sparsity(false), if_colored(false) { }
+            
+            /*!
+             *   true if \p sparsity has been provided or built
+             */
+            bool if_sparsity;
+            
+            /*!
+             *   true if the columns have been colored for \p sparsity
+             */
+            bool if_colored;
+            
+            /*!
+             *   sorted global column dofs of each local row
+             */
+            std::vector<std::vector<libMesh::dof_id_type> > sparsity;
+            
+            /*!
+             *   local columns that belong to each color
+             */
+            std::vector<std::vector<libMesh::dof_id_type> > color_cols;
+            
+            /*!
+             *   (global row, global column) of the local nonzeros that
+             *   are computed by the product with each color
+             */
+            std::vector<std::vector<std::pair<libMesh::dof_id_type, libMesh::dof_id_type> > >
+            color_entries;
+        };
+        
+        
+        /*!
+         *   builds the sparsity of block \p (i,j) from the dofs of the two
+         *   disciplines on each element of their common mesh
+         */
+        void _build_coupling_sparsity(unsigned int i, unsigned int j);
+        
+        
+        /*!
+         *   adds \p sparsity to the sparsity of block \p (i,j). The
+         *   coloring is computed again at the next assembly.
+         */
+        void
+        _add_coupling_sparsity
+        (unsigned int i,
+         unsigned int j,
+         const std::vector<std::vector<libMesh::dof_id_type> >& sparsity);
+        
+        
+        /*!
+         *   colors the columns of block \p (i,j) such that no two columns
+         *   of a color have a nonzero in the same row
+         */
+        void _color_coupling_block(unsigned int i, unsigned int j);
+        
+        
+        /*!
+         *   creates the sparse matrix for block \p (i,j), preallocated from
+         *   its sparsity, and replaces the shell in the nested matrix
+         */
+        void _create_coupling_block_matrix(unsigned int i, unsigned int j);
+        
+        
+        /*!
+         *   sparsity and coloring of the assembled off-diagonal blocks.
+         *   This is retained across solves. Row-major ordering.
+         */
+        std::vector<CouplingBlockData> _coupling_data;
+        
         unsigned int     _n_dofs;
 
         Mat              _mat;
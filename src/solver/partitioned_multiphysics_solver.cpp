@@ -0,0 +1,325 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2017  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+// C++ includes
+#include <cmath>
+
+// MAST includes
+#include "solver/partitioned_multiphysics_solver.h"
+#include "base/nonlinear_implicit_assembly.h"
+#include "base/system_initialization.h"
+#include "base/nonlinear_system.h"
+#include "base/performance_log.h"
+
+
+
+MAST::PartitionedMultiphysicsSolver::
+PartitionedMultiphysicsSolver(const libMesh::Parallel::Communicator& comm_in,
+                              const std::string& nm,
+                              unsigned int n):
+libMesh::ParallelObject       (comm_in),
+acceleration                  (MAST::AITKEN_RELAXATION),
+relaxed_discipline            (n-1),
+initial_relaxation            (0.5),
+max_iterations                (50),
+absolute_tolerance            (1.e-10),
+relative_tolerance            (1.e-6),
+max_iqn_vectors               (20),
+_name                         (nm),
+_n_disciplines                (n),
+_update                       (nullptr),
+_discipline_assembly          (n, nullptr),
+_n_iterations                 (0) {
+    
+    libmesh_assert_greater(n, 0);
+}
+
+
+
+
+MAST::PartitionedMultiphysicsSolver::~PartitionedMultiphysicsSolver() {
+    
+    _clear_iqn_vectors();
+}
+
+
+
+
+void
+MAST::PartitionedMultiphysicsSolver::
+set_system_assembly(unsigned int i,
+                    MAST::NonlinearImplicitAssembly& assembly) {
+    
+    // make sure that the index is within bounds
+    libmesh_assert_less(i, _n_disciplines);
+    
+    // also make sure that the specific discipline has not been set already
+    libmesh_assert(!_discipline_assembly[i]);
+    
+    _discipline_assembly[i] = &assembly;
+}
+
+
+
+
+MAST::NonlinearImplicitAssembly&
+MAST::PartitionedMultiphysicsSolver::
+get_system_assembly(unsigned int i) {
+    
+    // make sure that the index is within bounds
+    libmesh_assert_less(i, _n_disciplines);
+    
+    // also make sure that the specific discipline has been set
+    libmesh_assert(_discipline_assembly[i]);
+    
+    return *_discipline_assembly[i];
+}
+
+
+
+
+void
+MAST::PartitionedMultiphysicsSolver::solve() {
+    
+    // make sure that all systems have been specified
+    bool p = true;
+    for (unsigned int i=0; i<_n_disciplines; i++)
+        p = ((_discipline_assembly[i] != nullptr) && p);
+    libmesh_assert(p);
+    libmesh_assert_less(relaxed_discipline, _n_disciplines);
+    
+    MAST_LOG_SCOPE("PartitionedMultiphysicsSolver::solve");
+    START_LOG("solve()", this->name()+"_PartitionedSolve");
+    
+    MAST::NonlinearSystem&
+    sys = _discipline_assembly[relaxed_discipline]->system();
+    
+    // x is the current iterate of the relaxed solution, and x_tilde is the
+    // solution obtained from a sweep over all disciplines starting from x.
+    std::auto_ptr<libMesh::NumericVector<Real> >
+    x            (sys.solution->clone().release()),
+    x_tilde      (sys.solution->zero_clone().release()),
+    x_tilde_prev (sys.solution->zero_clone().release()),
+    res          (sys.solution->zero_clone().release()),
+    res_prev     (sys.solution->zero_clone().release()),
+    dres         (sys.solution->zero_clone().release());
+    
+    Real
+    omega     = initial_relaxation,
+    res_norm  = 0.,
+    res0_norm = 0.;
+    
+    bool
+    converged = false;
+    
+    _clear_iqn_vectors();
+    _n_iterations = 0;
+    
+    for (unsigned int k=0; k<max_iterations; k++) {
+        
+        _n_iterations++;
+        
+        // sweep over the disciplines. The relaxed discipline is solved last
+        // so that its solution depends on the latest solution of all others.
+        for (unsigned int i=0; i<_n_disciplines; i++)
+            _update_and_solve((relaxed_discipline+1+i) % _n_disciplines);
+        
+        *x_tilde = *sys.solution;
+        
+        *res = *x_tilde;
+        res->add(-1., *x);
+        res->close();
+        
+        res_norm = res->l2_norm();
+        if (k == 0)
+            res0_norm = res_norm;
+        
+        libMesh::out
+        << "Partitioned iteration: " << k
+        << " : || dX ||_2 = " << res_norm
+        << " : omega = " << omega << std::endl;
+        
+        if (res_norm <= absolute_tolerance ||
+            res_norm <= relative_tolerance * res0_norm) {
+            
+            converged = true;
+            break;
+        }
+        
+        // the next iterate
+        switch (acceleration) {
+                
+            case MAST::CONSTANT_RELAXATION: {
+                
+                x->add(omega, *res);
+            }
+                break;
+                
+            case MAST::AITKEN_RELAXATION: {
+                
+                if (k > 0) {
+                    
+                    *dres = *res;
+                    dres->add(-1., *res_prev);
+                    dres->close();
+                    
+                    const Real
+                    den = dres->dot(*dres);
+                    
+                    if (den > 0.)
+                        omega = -omega * res_prev->dot(*dres) / den;
+                }
+                
+                x->add(omega, *res);
+            }
+                break;
+                
+            case MAST::IQN_ILS: {
+                
+                if (k == 0)
+                    x->add(omega, *res);
+                else {
+                    
+                    // store the latest differences
+                    libMesh::NumericVector<Real>
+                    *v = res->clone().release(),
+                    *w = x_tilde->clone().release();
+                    
+                    v->add(-1., *res_prev);
+                    w->add(-1., *x_tilde_prev);
+                    v->close();
+                    w->close();
+                    
+                    _iqn_V.insert(_iqn_V.begin(), v);
+                    _iqn_W.insert(_iqn_W.begin(), w);
+                    
+                    // remove the oldest vectors beyond the limit
+                    while (_iqn_V.size() > max_iqn_vectors) {
+                        
+                        delete _iqn_V.back();
+                        delete _iqn_W.back();
+                        _iqn_V.pop_back();
+                        _iqn_W.pop_back();
+                    }
+                    
+                    _iqn_ils_update(*x_tilde, *res, *x);
+                }
+            }
+                break;
+                
+            default:
+                libmesh_error();
+        }
+        
+        x->close();
+        
+        *res_prev     = *res;
+        *x_tilde_prev = *x_tilde;
+        
+        // the relaxed solution is used for the next sweep
+        *sys.solution = *x;
+        sys.update();
+    }
+    
+    if (!converged)
+        libMesh::out
+        << "Partitioned iterations did not converge in "
+        << max_iterations << " iterations" << std::endl;
+    
+    _clear_iqn_vectors();
+    
+    STOP_LOG("solve()", this->name()+"_PartitionedSolve");
+}
+
+
+
+
+void
+MAST::PartitionedMultiphysicsSolver::_update_and_solve(unsigned int i) {
+    
+    // initialize the data structures with the latest solutions
+    if (_update) {
+        
+        std::vector<libMesh::NumericVector<Real>*>
+        sols(_n_disciplines, nullptr);
+        
+        for (unsigned int j=0; j<_n_disciplines; j++)
+            sols[j] = _discipline_assembly[j]->system().solution.get();
+        
+        _update->update_at_solution(sols);
+    }
+    
+    _discipline_assembly[i]->system().solve();
+}
+
+
+
+
+void
+MAST::PartitionedMultiphysicsSolver::
+_iqn_ils_update(const libMesh::NumericVector<Real>& x_tilde,
+                const libMesh::NumericVector<Real>& res,
+                libMesh::NumericVector<Real>& x) {
+    
+    const unsigned int
+    q = (unsigned int)_iqn_V.size();
+    
+    // least-squares solution through the normal equations, which are
+    // of size q and are solved on every processor
+    RealMatrixX
+    VtV = RealMatrixX::Zero(q, q);
+    RealVectorX
+    Vtr = RealVectorX::Zero(q),
+    c;
+    
+    for (unsigned int i=0; i<q; i++) {
+        
+        Vtr(i) = -_iqn_V[i]->dot(res);
+        
+        for (unsigned int j=0; j<=i; j++) {
+            
+            VtV(i,j) = _iqn_V[i]->dot(*_iqn_V[j]);
+            VtV(j,i) = VtV(i,j);
+        }
+    }
+    
+    c = VtV.colPivHouseholderQr().solve(Vtr);
+    
+    x = x_tilde;
+    for (unsigned int i=0; i<q; i++)
+        x.add(c(i), *_iqn_W[i]);
+}
+
+
+
+
+void
+MAST::PartitionedMultiphysicsSolver::_clear_iqn_vectors() {
+    
+    for (unsigned int i=0; i<_iqn_V.size(); i++) {
+        
+        delete _iqn_V[i];
+        delete _iqn_W[i];
+    }
+    
+    _iqn_V.clear();
+    _iqn_W.clear();
+}
+
@@ -0,0 +1,244 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2017  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#ifndef __mast_partitioned_multiphysics_solver_h__
+#define __mast_partitioned_multiphysics_solver_h__
+
+// C++ includes
+#include <vector>
+#include <string>
+
+// MAST includes
+#include "base/mast_data_types.h"
+#include "solver/multiphysics_nonlinear_solver.h"
+
+// libMesh includes
+#include "libmesh/parallel_object.h"
+#include "libmesh/numeric_vector.h"
+
+
+namespace MAST {
+    
+    // Forward declerations
+    class NonlinearImplicitAssembly;
+    
+    
+    enum PartitionedCouplingAcceleration {
+        CONSTANT_RELAXATION,
+        AITKEN_RELAXATION,
+        IQN_ILS              // interface quasi-Newton with inverse Jacobian from least-squares
+    };
+    
+    
+    /*!
+     *   This class solves a multiphysics problem by a partitioned approach,
+     *   where the disciplines are solved one after the other with their own
+     *   NonlinearSystem::solve(). Each discipline therefore uses its own
+     *   solver and preconditioner options. Before each discipline solve,
+     *   the PreResidualUpdate object, if provided, is called with the
+     *   latest solutions of all disciplines so that the coupling data can be
+     *   updated.
+     *
+     *   The solution of discipline \p relaxed_discipline is treated as the
+     *   interface variable of a fixed-point iteration, which is solved last
+     *   in each sweep. The fixed-point iterations are accelerated with
+     *   constant relaxation, Aitken's dynamic relaxation, or the interface
+     *   quasi-Newton method with least-squares inverse Jacobian (IQN-ILS).
+     */
+    class PartitionedMultiphysicsSolver:
+    public libMesh::ParallelObject {
+        
+    public:
+        
+        /*!
+         *   default constructor
+         */
+        PartitionedMultiphysicsSolver(const libMesh::Parallel::Communicator& comm_in,
+                                      const std::string& nm,
+                                      unsigned int n);
+        
+        
+        /*!
+         *   destructor
+         */
+        virtual ~PartitionedMultiphysicsSolver();
+        
+        
+        /*!
+         *    @returns the name of this solver
+         */
+        const std::string name() const {
+            
+            return _name;
+        }
+        
+        
+        /*!
+         *   @returns the number of systems
+         */
+        unsigned int n_disciplines() const {
+            
+            return _n_disciplines;
+        }
+        
+        
+        /*!
+         *   method to set the n^th discipline of this multiphysics system
+         *   assembly.
+         */
+        void set_system_assembly(unsigned int i,
+                                 MAST::NonlinearImplicitAssembly& assembly);
+        
+        
+        /*!
+         *   @returns a reference to the n^th discipline of this multiphysics
+         *   system assembly
+         */
+        MAST::NonlinearImplicitAssembly& get_system_assembly(unsigned int i);
+        
+        
+        /*!
+         *   assigns the update object to this solver
+         */
+        void
+        set_pre_residual_update_object
+        (MAST::MultiphysicsNonlinearSolverBase::PreResidualUpdate& update) {
+            
+            _update = &update;
+        }
+        
+        
+        /*!
+         *   solves the coupled system by staggered iterations over the
+         *   disciplines
+         */
+        void solve();
+        
+        
+        /*!
+         *   @returns the number of coupling iterations in the last solve
+         */
+        unsigned int n_iterations() const {
+            
+            return _n_iterations;
+        }
+        
+        
+        /*!
+         *   acceleration of the fixed-point iterations. Default is
+         *   AITKEN_RELAXATION.
+         */
+        MAST::PartitionedCouplingAcceleration acceleration;
+        
+        /*!
+         *   discipline whose solution is relaxed. Default is the last
+         *   discipline.
+         */
+        unsigned int relaxed_discipline;
+        
+        /*!
+         *   relaxation factor used for constant relaxation, and at the first
+         *   iteration of Aitken and IQN-ILS. Default is 0.5.
+         */
+        Real initial_relaxation;
+        
+        /*!
+         *   maximum number of coupling iterations. Default is 50.
+         */
+        unsigned int max_iterations;
+        
+        /*!
+         *   convergence tolerance on the l2 norm of the change in relaxed
+         *   solution over a sweep. Default is 1.e-10.
+         */
+        Real absolute_tolerance;
+        
+        /*!
+         *   convergence tolerance on the change in relaxed solution relative
+         *   to that at the first iteration. Default is 1.e-6.
+         */
+        Real relative_tolerance;
+        
+        /*!
+         *   maximum number of difference vectors retained by IQN-ILS.
+         *   Default is 20.
+         */
+        unsigned int max_iqn_vectors;
+        
+    protected:
+        
+        /*!
+         *   updates the coupling data and solves discipline \p i
+         */
+        void _update_and_solve(unsigned int i);
+        
+        /*!
+         *   computes the IQN-ILS update of the relaxed solution
+         *   \f$ x = \tilde{x} + W c \f$, where \f$ c \f$ minimizes
+         *   \f$ || V c + r ||_2 \f$.
+         */
+        void _iqn_ils_update(const libMesh::NumericVector<Real>& x_tilde,
+                             const libMesh::NumericVector<Real>& res,
+                             libMesh::NumericVector<Real>& x);
+        
+        /*!
+         *   deletes the IQN-ILS difference vectors
+         */
+        void _clear_iqn_vectors();
+        
+        /*!
+         *  name of this multiphysics solution
+         */
+        const std::string  _name;
+        
+        /*!
+         *   number of disciplines
+         */
+        const unsigned int _n_disciplines;
+        
+        /*!
+         *    object, if provided, is called to initialize the system data
+         *    before the solution of each discipline
+         */
+        MAST::MultiphysicsNonlinearSolverBase::PreResidualUpdate  *_update;
+        
+        /*!
+         *   vector of assembly objects for each discipline in this
+         *   multiphysics system
+         */
+        std::vector<MAST::NonlinearImplicitAssembly*>  _discipline_assembly;
+        
+        /*!
+         *   number of coupling iterations in the last solve
+         */
+        unsigned int _n_iterations;
+        
+        /*!
+         *   IQN-ILS differences of residuals and of the relaxed solution
+         *   from successive iterations, with the latest difference first
+         */
+        std::vector<libMesh::NumericVector<Real>*>
+        _iqn_V,
+        _iqn_W;
+    };
+}
+
+
+#endif // __mast_partitioned_multiphysics_solver_h__
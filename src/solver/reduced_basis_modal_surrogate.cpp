@@ -0,0 +1,256 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2017  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+// C++ includes
+#include <algorithm>
+
+// MAST includes
+#include "solver/reduced_basis_modal_surrogate.h"
+#include "base/nonlinear_system.h"
+#include "base/performance_log.h"
+
+// libMesh includes
+#include "libmesh/sparse_matrix.h"
+
+
+MAST::ReducedBasisModalSurrogate::
+ReducedBasisModalSurrogate(MAST::NonlinearSystem& sys):
+MAST::ReducedBasisSurrogate(sys),
+_if_reduced_solution(false),
+_first_snapshot(0) {
+    
+}
+
+
+
+MAST::ReducedBasisModalSurrogate::~ReducedBasisModalSurrogate() {
+    
+}
+
+
+
+bool
+MAST::ReducedBasisModalSurrogate::solve(unsigned int n_modes) {
+    
+    MAST_LOG_SCOPE("ReducedBasisModalSurrogate::solve");
+    
+    libmesh_assert_greater(n_modes, 0);
+    
+    if (!_if_built || _basis.size() < n_modes) {
+        
+        _full_order_solve(n_modes);
+        return false;
+    }
+    
+    const unsigned int
+    n_basis = (unsigned int)_basis.size(),
+    n_prod  = 2 * n_basis,
+    n_terms = (unsigned int)_terms.size();
+    
+    RealVectorX
+    theta;
+    _term_coefficients(theta);
+    
+    RealMatrixX
+    a_r = _reduced_operator(theta,       0, n_basis),
+    b_r = _reduced_operator(theta, n_basis, n_basis);
+    
+    // remove the round-off asymmetry of the projection
+    a_r = 0.5 * (a_r + a_r.transpose()).eval();
+    b_r = 0.5 * (b_r + b_r.transpose()).eval();
+    
+    // the generalized solver needs a positive definite B. Otherwise,
+    // as for buckling problems, the matrices are exchanged and the
+    // eigenvalues inverted, which needs a positive definite A.
+    RealVectorX
+    lambda;
+    RealMatrixX
+    y;
+    
+    if (b_r.llt().info() == Eigen::Success) {
+        
+        Eigen::GeneralizedSelfAdjointEigenSolver<RealMatrixX> eig(a_r, b_r);
+        lambda = eig.eigenvalues();
+        y      = eig.eigenvectors();
+    }
+    else {
+        
+        Eigen::GeneralizedSelfAdjointEigenSolver<RealMatrixX> eig(b_r, a_r);
+        lambda = eig.eigenvalues();
+        y      = eig.eigenvectors();
+        
+        for (unsigned int i=0; i<n_basis; i++)
+            lambda(i) = 1./lambda(i);
+    }
+    
+    // modes sorted by increasing magnitude of the eigenvalue
+    std::vector<std::pair<Real, unsigned int> > order(n_basis);
+    for (unsigned int i=0; i<n_basis; i++)
+        order[i] = std::pair<Real, unsigned int>(std::fabs(lambda(i)), i);
+    std::sort(order.begin(), order.end());
+    
+    _eigenvalues.resize(n_modes);
+    _reduced_eigenvectors.setZero(n_basis, n_modes);
+    _error_estimate = 0.;
+    
+    RealVectorX
+    w    = RealVectorX::Zero(n_terms*n_prod),
+    w_a  = RealVectorX::Zero(n_terms*n_prod);
+    
+    for (unsigned int i=0; i<n_modes; i++) {
+        
+        const unsigned int
+        k = order[i].second;
+        
+        // unit inner product with the B matrix
+        RealVectorX
+        yk = y.col(k);
+        const Real
+        yby = yk.dot(b_r * yk);
+        if (yby != 0.)
+            yk /= sqrt(std::fabs(yby));
+        
+        _eigenvalues[i]               = lambda(k);
+        _reduced_eigenvectors.col(i)  = yk;
+        
+        for (unsigned int t=0; t<n_terms; t++) {
+            
+            w_a.segment(t*n_prod, n_basis)         = theta(t) * yk;
+            w.segment(t*n_prod, n_basis)           = theta(t) * yk;
+            w.segment(t*n_prod+n_basis, n_basis)   = -lambda(k) * theta(t) * yk;
+        }
+        
+        const Real
+        r_a = _norm_sq(w_a);
+        
+        if (r_a > 0.)
+            _error_estimate = std::max(_error_estimate, sqrt(_norm_sq(w)/r_a));
+    }
+    
+    if (_error_estimate <= _error_tol) {
+        
+        _if_reduced_solution = true;
+        MAST_LOG_COUNT("reduced_basis_modal_solves", 1);
+        return true;
+    }
+    
+    _full_order_solve(n_modes);
+    
+    return false;
+}
+
+
+
+void
+MAST::ReducedBasisModalSurrogate::
+eigenvector(unsigned int i,
+            libMesh::NumericVector<Real>& vec) const {
+    
+    libmesh_assert_less(i, _eigenvalues.size());
+    
+    if (_if_reduced_solution)
+        _basis_combination(_reduced_eigenvectors.col(i), vec);
+    else {
+        
+        vec = *_snapshots[_first_snapshot+i];
+        vec.close();
+    }
+}
+
+
+
+void
+MAST::ReducedBasisModalSurrogate::clear() {
+    
+    _eigenvalues.clear();
+    _reduced_eigenvectors.resize(0, 0);
+    _if_reduced_solution = false;
+    _first_snapshot      = 0;
+    
+    MAST::ReducedBasisSurrogate::clear();
+}
+
+
+
+unsigned int
+MAST::ReducedBasisModalSurrogate::_n_products() const {
+    
+    return 2 * (unsigned int)_basis.size();
+}
+
+
+
+void
+MAST::ReducedBasisModalSurrogate::
+_assemble_products(std::vector<libMesh::NumericVector<Real>*>& prod) {
+    
+    const unsigned int
+    n_basis = (unsigned int)_basis.size();
+    
+    libmesh_assert_equal_to(prod.size(), 2 * n_basis);
+    
+    _system.assemble_eigensystem();
+    _system.matrix_A->close();
+    _system.matrix_B->close();
+    
+    // the rows of the condensed dofs are not part of the eigenproblem
+    for (unsigned int i=0; i<n_basis; i++) {
+        
+        _system.matrix_A->vector_mult(*prod[i],         *_basis[i]);
+        _system.matrix_B->vector_mult(*prod[n_basis+i], *_basis[i]);
+        
+        _system.zero_condensed_dofs(*prod[i]);
+        _system.zero_condensed_dofs(*prod[n_basis+i]);
+    }
+}
+
+
+
+void
+MAST::ReducedBasisModalSurrogate::_full_order_solve(unsigned int n_modes) {
+    
+    _system.set_n_requested_eigenvalues(n_modes);
+    _system.eigenproblem_solve();
+    
+    const unsigned int
+    n_conv = std::min(n_modes, _system.get_n_converged_eigenvalues());
+    
+    _eigenvalues.resize(n_conv);
+    _reduced_eigenvectors.resize(0, 0);
+    _if_reduced_solution = false;
+    _first_snapshot      = this->n_snapshots();
+    
+    std::auto_ptr<libMesh::NumericVector<Real> >
+    vec(_system.solution->zero_clone().release());
+    
+    Real
+    re = 0.,
+    im = 0.;
+    
+    for (unsigned int i=0; i<n_conv; i++) {
+        
+        _system.get_eigenpair(i, re, im, *vec);
+        _eigenvalues[i] = re;
+        this->add_snapshot(*vec);
+    }
+    
+    MAST_LOG_COUNT("reduced_basis_full_order_solves", 1);
+}
+
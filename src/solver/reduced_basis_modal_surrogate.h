@@ -0,0 +1,142 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2017  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#ifndef __mast__reduced_basis_modal_surrogate__
+#define __mast__reduced_basis_modal_surrogate__
+
+// MAST includes
+#include "solver/reduced_basis_surrogate.h"
+
+
+namespace MAST {
+    
+    /*!
+     *   Reduced-basis surrogate for the symmetric eigenproblem
+     *   \f$ A x = \lambda B x \f$ of a MAST::NonlinearSystem, for example
+     *   the natural modes with the stiffness and mass matrices. The
+     *   products are those of the two matrices with the basis vectors,
+     *   and the online eigenproblem is
+     *   \f$ \Phi^T A \Phi y = \lambda \Phi^T B \Phi y \f$. The error
+     *   estimate is the largest over the requested modes of the norm of
+     *   the full-order residual \f$ (A - \lambda B) \Phi y \f$ relative to
+     *   that of \f$ A \Phi y \f$.
+     *
+     *   The eigenproblem assembly should be attached to the system
+     *   whenever build() or solve() are called.
+     */
+    class ReducedBasisModalSurrogate:
+    public MAST::ReducedBasisSurrogate {
+        
+    public:
+        
+        ReducedBasisModalSurrogate(MAST::NonlinearSystem& sys);
+        
+        virtual ~ReducedBasisModalSurrogate();
+        
+        
+        /*!
+         *   computes the \p n_modes eigenvalues of smallest magnitude at
+         *   the current values of the parameters. The reduced eigenproblem
+         *   is used if the error estimate is within the tolerance, and true
+         *   is returned. Otherwise, the full-order eigenproblem is solved,
+         *   its eigenvectors are added as snapshots, and false is returned.
+         *   The full-order eigenproblem is also solved if the surrogate has
+         *   not been built, or if the basis has fewer than \p n_modes
+         *   vectors.
+         */
+        bool solve(unsigned int n_modes);
+        
+        
+        /*!
+         *   @returns the number of eigenpairs from the last solve
+         */
+        unsigned int n_eigenpairs() const {
+            return (unsigned int)_eigenvalues.size();
+        }
+        
+        
+        /*!
+         *   @returns the \p i^th eigenvalue from the last solve
+         */
+        Real eigenvalue(unsigned int i) const {
+            
+            libmesh_assert_less(i, _eigenvalues.size());
+            return _eigenvalues[i];
+        }
+        
+        
+        /*!
+         *   copies the \p i^th eigenvector from the last solve to \p vec.
+         *   The eigenvector has a unit inner product with the B matrix.
+         */
+        void eigenvector(unsigned int i,
+                         libMesh::NumericVector<Real>& vec) const;
+        
+        
+        /*!
+         *   clears the basis, decomposition, snapshots and eigenpairs
+         */
+        virtual void clear();
+        
+        
+    protected:
+        
+        virtual unsigned int _n_products() const;
+        
+        virtual void
+        _assemble_products(std::vector<libMesh::NumericVector<Real>*>& prod);
+        
+        
+        /*!
+         *   solves the full-order eigenproblem and adds the eigenvectors
+         *   as snapshots
+         */
+        void _full_order_solve(unsigned int n_modes);
+        
+        
+        /*!
+         *   eigenvalues from the last solve
+         */
+        std::vector<Real> _eigenvalues;
+        
+        
+        /*!
+         *   reduced eigenvectors from the last solve, if it used the
+         *   reduced eigenproblem
+         */
+        RealMatrixX _reduced_eigenvectors;
+        
+        
+        /*!
+         *   true if the last solve used the reduced eigenproblem
+         */
+        bool _if_reduced_solution;
+        
+        
+        /*!
+         *   index of the snapshot of the first eigenvector, if the last
+         *   solve used the full-order eigenproblem
+         */
+        unsigned int _first_snapshot;
+    };
+}
+
+
+#endif // __mast__reduced_basis_modal_surrogate__
@@ -0,0 +1,222 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2017  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+// MAST includes
+#include "solver/reduced_basis_static_surrogate.h"
+#include "base/nonlinear_system.h"
+#include "base/nonlinear_implicit_assembly.h"
+#include "base/performance_log.h"
+
+// libMesh includes
+#include "libmesh/sparse_matrix.h"
+
+
+MAST::ReducedBasisStaticSurrogate::
+ReducedBasisStaticSurrogate(MAST::NonlinearSystem& sys,
+                            MAST::NonlinearImplicitAssembly& assembly):
+MAST::ReducedBasisSurrogate(sys),
+_assembly(assembly),
+_if_reduced_sol(false),
+_sensitivity_error_estimate(0.) {
+    
+}
+
+
+
+MAST::ReducedBasisStaticSurrogate::~ReducedBasisStaticSurrogate() {
+    
+}
+
+
+
+bool
+MAST::ReducedBasisStaticSurrogate::solve(bool full_order) {
+    
+    MAST_LOG_SCOPE("ReducedBasisStaticSurrogate::solve");
+    
+    _if_reduced_sol = false;
+    
+    if (!_if_built || full_order) {
+        
+        _full_order_solve();
+        return false;
+    }
+    
+    const unsigned int
+    n_basis = (unsigned int)_basis.size(),
+    n_prod  = n_basis + 1,
+    n_terms = (unsigned int)_terms.size();
+    
+    _term_coefficients(_theta);
+    
+    const RealVectorX&
+    theta = _theta;
+    
+    _k_r_lu.compute(_reduced_operator(theta, 1, n_basis));
+    
+    const RealVectorX
+    f_r = -_reduced_operator(theta, 0, 1).col(0);
+    
+    _reduced_sol = _k_r_lu.solve(f_r);
+    
+    const RealVectorX&
+    a   = _reduced_sol;
+    
+    // weights of the products in the residual R(Phi a) and in R_0
+    RealVectorX
+    w    = RealVectorX::Zero(n_terms*n_prod),
+    w0   = RealVectorX::Zero(n_terms*n_prod);
+    
+    for (unsigned int t=0; t<n_terms; t++) {
+        
+        w0(t*n_prod)  = theta(t);
+        w(t*n_prod)   = theta(t);
+        w.segment(t*n_prod+1, n_basis) = theta(t) * a;
+    }
+    
+    const Real
+    r0 = _norm_sq(w0);
+    
+    _error_estimate = (r0 > 0.)? sqrt(_norm_sq(w)/r0) : 0.;
+    
+    if (_error_estimate <= _error_tol) {
+        
+        _basis_combination(a, *_system.solution);
+        _if_reduced_sol = true;
+        MAST_LOG_COUNT("reduced_basis_static_solves", 1);
+        return true;
+    }
+    
+    _full_order_solve();
+    
+    return false;
+}
+
+
+
+bool
+MAST::ReducedBasisStaticSurrogate::
+sensitivity_solve(const MAST::Parameter& p,
+                  libMesh::NumericVector<Real>* dsol) {
+    
+    MAST_LOG_SCOPE("ReducedBasisStaticSurrogate::sensitivity_solve");
+    
+    const unsigned int
+    n_basis = (unsigned int)_basis.size(),
+    n_prod  = n_basis + 1,
+    n_terms = (unsigned int)_terms.size();
+    
+    if (!_if_built || !_if_reduced_sol ||
+        _reduced_sol.size() != n_basis)
+        libmesh_error_msg("Error: sensitivity_solve() requires a reduced"
+                          << " solution from the last call to solve().");
+    
+    // the parameters should not have changed since the solution
+    RealVectorX
+    theta;
+    _term_coefficients(theta);
+    libmesh_assert_less_equal((theta - _theta).norm(),
+                              1.e-12 * std::max(_theta.norm(), 1.));
+    
+    RealVectorX
+    dtheta;
+    _term_coefficient_derivatives(p, dtheta);
+    
+    const RealVectorX&
+    a   = _reduced_sol;
+    
+    // derivative of Phi^T (R_0 + J Phi a) with a held constant
+    const RealVectorX
+    rhs = (_reduced_operator(dtheta, 0, 1).col(0) +
+           _reduced_operator(dtheta, 1, n_basis) * a),
+    da  = -_k_r_lu.solve(rhs);
+    
+    // weights of the products in the right-hand side dR/dp at Phi a,
+    // and in the sensitivity residual dR/dp + J Phi da
+    RealVectorX
+    w_rhs = RealVectorX::Zero(n_terms*n_prod),
+    w     = RealVectorX::Zero(n_terms*n_prod);
+    
+    for (unsigned int t=0; t<n_terms; t++) {
+        
+        w_rhs(t*n_prod)                    = dtheta(t);
+        w_rhs.segment(t*n_prod+1, n_basis) = dtheta(t) * a;
+        
+        w(t*n_prod)                        = dtheta(t);
+        w.segment(t*n_prod+1, n_basis)     = dtheta(t) * a + theta(t) * da;
+    }
+    
+    const Real
+    r0 = _norm_sq(w_rhs);
+    
+    _sensitivity_error_estimate = (r0 > 0.)? sqrt(_norm_sq(w)/r0) : 0.;
+    
+    if (_sensitivity_error_estimate > _error_tol)
+        return false;
+    
+    if (dsol)
+        _basis_combination(da, *dsol);
+    
+    MAST_LOG_COUNT("reduced_basis_static_sensitivity_solves", 1);
+    
+    return true;
+}
+
+
+
+unsigned int
+MAST::ReducedBasisStaticSurrogate::_n_products() const {
+    
+    return (unsigned int)_basis.size() + 1;
+}
+
+
+
+void
+MAST::ReducedBasisStaticSurrogate::
+_assemble_products(std::vector<libMesh::NumericVector<Real>*>& prod) {
+    
+    libmesh_assert_equal_to(prod.size(), _basis.size() + 1);
+    
+    // the residual and Jacobian at zero solution
+    std::auto_ptr<libMesh::NumericVector<Real> >
+    x(_system.solution->zero_clone().release());
+    
+    _assembly.residual_and_jacobian(*x, prod[0], _system.matrix, _system);
+    prod[0]->close();
+    _system.matrix->close();
+    
+    for (unsigned int i=0; i<_basis.size(); i++)
+        _system.matrix->vector_mult(*prod[i+1], *_basis[i]);
+}
+
+
+
+void
+MAST::ReducedBasisStaticSurrogate::_full_order_solve() {
+    
+    _system.solution->zero();
+    _system.solve();
+    
+    this->add_snapshot(*_system.solution);
+    
+    MAST_LOG_COUNT("reduced_basis_full_order_solves", 1);
+}
+
@@ -0,0 +1,146 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2017  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#ifndef __mast__reduced_basis_static_surrogate__
+#define __mast__reduced_basis_static_surrogate__
+
+// MAST includes
+#include "solver/reduced_basis_surrogate.h"
+
+
+namespace MAST {
+    
+    // Forward declerations
+    class NonlinearImplicitAssembly;
+    
+    
+    /*!
+     *   Reduced-basis surrogate for the linear static solution of
+     *   \f$ R(X) = R_0 + J X = 0 \f$. The products are the residual at
+     *   zero solution and the products of the Jacobian with the basis
+     *   vectors. The online solution is \f$ X = \Phi a \f$, with the
+     *   reduced system \f$ \Phi^T J \Phi a = -\Phi^T R_0 \f$, and the error
+     *   estimate is the norm of the full-order residual \f$ R(\Phi a) \f$
+     *   relative to that of \f$ R_0 \f$.
+     *
+     *   The sensitivity of the reduced solution with respect to a
+     *   parameter is also computed without any operation on the
+     *   full-order model, from the derivative of the polynomial
+     *   decomposition, as
+     *   \f$ \Phi^T J \Phi \, da/dp = -\Phi^T (dR_0/dp + dJ/dp \, \Phi a) \f$.
+     *   The factorization of the reduced operator of the last solution is
+     *   reused for all parameters.
+     *
+     *   The assembly should be attached to the discipline and system
+     *   whenever build() or solve() are called.
+     */
+    class ReducedBasisStaticSurrogate:
+    public MAST::ReducedBasisSurrogate {
+        
+    public:
+        
+        ReducedBasisStaticSurrogate(MAST::NonlinearSystem& sys,
+                                    MAST::NonlinearImplicitAssembly& assembly);
+        
+        virtual ~ReducedBasisStaticSurrogate();
+        
+        
+        /*!
+         *   computes the solution at the current values of the parameters
+         *   in the solution vector of the system. The reduced solution is
+         *   used if the error estimate is within the tolerance, and true
+         *   is returned. Otherwise, the full-order system is solved from a
+         *   zero solution, its solution is added as a snapshot, and false
+         *   is returned. The full-order system is also solved if the
+         *   surrogate has not been built, or if \p full_order is true. The
+         *   latter should be used when the solution is the base of a
+         *   full-order sensitivity solve, since the reduced solution does
+         *   not satisfy the full-order equations.
+         */
+        bool solve(bool full_order = false);
+        
+        
+        /*!
+         *   computes the sensitivity of the last reduced solution with
+         *   respect to parameter \p p, which must be one of the parameters
+         *   of the surrogate, and returns true if its error estimate is
+         *   within the tolerance. The error estimate is the norm of the
+         *   full-order sensitivity residual relative to that of its
+         *   right-hand side. The sensitivity is written to \p dsol, if
+         *   provided, only if true is returned. This requires that the last
+         *   call to solve() returned true, and that the parameter values
+         *   and basis have not changed since.
+         */
+        bool sensitivity_solve(const MAST::Parameter& p,
+                               libMesh::NumericVector<Real>* dsol);
+        
+        
+        /*!
+         *   @returns the error estimate of the last sensitivity solution
+         */
+        Real sensitivity_error_estimate() const {
+            return _sensitivity_error_estimate;
+        }
+        
+        
+    protected:
+        
+        virtual unsigned int _n_products() const;
+        
+        virtual void
+        _assemble_products(std::vector<libMesh::NumericVector<Real>*>& prod);
+        
+        
+        /*!
+         *   solves the full-order system and adds the solution as snapshot
+         */
+        void _full_order_solve();
+        
+        
+        /*!
+         *   assembly of the residual and Jacobian
+         */
+        MAST::NonlinearImplicitAssembly& _assembly;
+        
+        
+        /*!
+         *   true if the last call to solve() used the reduced solution
+         */
+        bool _if_reduced_sol;
+        
+        
+        /*!
+         *   term coefficients, reduced solution and factored reduced
+         *   operator of the last reduced solution
+         */
+        RealVectorX                       _theta;
+        RealVectorX                       _reduced_sol;
+        Eigen::PartialPivLU<RealMatrixX>  _k_r_lu;
+        
+        
+        /*!
+         *   error estimate of the last sensitivity solution
+         */
+        Real _sensitivity_error_estimate;
+    };
+}
+
+
+#endif // __mast__reduced_basis_static_surrogate__
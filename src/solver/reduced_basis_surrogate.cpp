@@ -0,0 +1,628 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2017  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+// C++ includes
+#include <cmath>
+
+// MAST includes
+#include "solver/reduced_basis_surrogate.h"
+#include "base/nonlinear_system.h"
+#include "base/parameter.h"
+#include "base/performance_log.h"
+
+
+namespace MAST {
+    
+    typedef std::vector<libMesh::NumericVector<Real>*> __rb_vector_set;
+    
+    
+    static void
+    __delete_vector_set(MAST::__rb_vector_set& v) {
+        
+        for (unsigned int i=0; i<v.size(); i++)
+            delete v[i];
+        v.clear();
+    }
+    
+    
+    /*!
+     *   sets \p r to \f$ \sum_j c_j v_j \f$ for each vector in the sets
+     */
+    static void
+    __combine_vector_sets(const RealVectorX& c,
+                          const std::vector<MAST::__rb_vector_set>& v,
+                          MAST::__rb_vector_set& r) {
+        
+        libmesh_assert_equal_to(c.size(), v.size());
+        libmesh_assert(v.size());
+        
+        const unsigned int n = (unsigned int)v[0].size();
+        
+        r.resize(n);
+        for (unsigned int i=0; i<n; i++) {
+            
+            r[i] = v[0][i]->zero_clone().release();
+            for (unsigned int j=0; j<v.size(); j++)
+                if (c(j) != 0.)
+                    r[i]->add(c(j), *v[j][i]);
+            r[i]->close();
+        }
+    }
+    
+    
+    /*!
+     *   @returns the sum of the norms of the vectors in the set
+     */
+    static Real
+    __vector_set_norm(const MAST::__rb_vector_set& v) {
+        
+        Real val = 0.;
+        for (unsigned int i=0; i<v.size(); i++)
+            val += v[i]->l2_norm();
+        
+        return val;
+    }
+}
+
+
+
+MAST::ReducedBasisSurrogate::ReducedBasisSurrogate(MAST::NonlinearSystem& sys):
+_system(sys),
+_order(3),
+_pod_tol(1.e-6),
+_error_tol(1.e-3),
+_error_estimate(0.),
+_if_built(false),
+_n_new_snapshots(0),
+_memory(MAST::MEMORY_REDUCED_BASIS) {
+    
+}
+
+
+
+MAST::ReducedBasisSurrogate::~ReducedBasisSurrogate() {
+    
+    this->clear();
+}
+
+
+
+void
+MAST::ReducedBasisSurrogate::add_parameter(MAST::Parameter& p, Real delta) {
+    
+    libmesh_assert(!_if_built);
+    libmesh_assert_not_equal_to(delta, 0.);
+    
+    _params.push_back(&p);
+    _deltas.push_back(delta);
+}
+
+
+
+void
+MAST::ReducedBasisSurrogate::set_polynomial_order(unsigned int m) {
+    
+    libmesh_assert(!_if_built);
+    libmesh_assert_greater(m, 0);
+    
+    _order = m;
+}
+
+
+
+void
+MAST::ReducedBasisSurrogate::add_snapshot(const libMesh::NumericVector<Real>& v) {
+    
+    _snapshots.push_back(v.clone().release());
+    _n_new_snapshots++;
+    
+    _update_memory();
+}
+
+
+
+void
+MAST::ReducedBasisSurrogate::clear() {
+    
+    MAST::__delete_vector_set(_snapshots);
+    MAST::__delete_vector_set(_basis);
+    
+    _terms.clear();
+    _projected.clear();
+    _gram.resize(0, 0);
+    _ref_vals.clear();
+    
+    _if_built        = false;
+    _n_new_snapshots = 0;
+    _error_estimate  = 0.;
+    
+    _memory.clear();
+}
+
+
+
+void
+MAST::ReducedBasisSurrogate::build() {
+    
+    MAST_LOG_SCOPE("ReducedBasisSurrogate::build");
+    
+    libmesh_assert(_snapshots.size());
+    
+    _if_built        = false;
+    _n_new_snapshots = 0;
+    _terms.clear();
+    _projected.clear();
+    _gram.resize(0, 0);
+    
+    _build_pod_basis();
+    
+    const unsigned int
+    n_params = (unsigned int)_params.size(),
+    n_basis  = (unsigned int)_basis.size(),
+    n_prod   = this->_n_products(),
+    m        = _order;
+    
+    _ref_vals.resize(n_params);
+    for (unsigned int i=0; i<n_params; i++)
+        _ref_vals[i] = (*_params[i])();
+    
+    // product vectors of each term, in the same sequence as _terms
+    std::vector<MAST::__rb_vector_set> term_prods;
+    
+    //////////////////////////////////////////////////////////////////////
+    // reference term
+    //////////////////////////////////////////////////////////////////////
+    MAST::ReducedBasisSurrogate::Term
+    term = {-1, -1, 0, 0};
+    
+    term_prods.push_back(MAST::__rb_vector_set());
+    _new_products(term_prods[0]);
+    _terms.push_back(term);
+    
+    // a copy of the pointers, since term_prods grows below
+    const MAST::__rb_vector_set p_ref = term_prods[0];
+    
+    //////////////////////////////////////////////////////////////////////
+    // terms in a single parameter. diffs[i][j-1] are the differences of
+    // the products from the reference with the i^th parameter at the
+    // sample s_i = j, for j = 1, ..., m. The terms solve the Vandermonde
+    // system diff_j = sum_k j^k P_k.
+    //////////////////////////////////////////////////////////////////////
+    std::vector<std::vector<MAST::__rb_vector_set> >
+    diffs(n_params, std::vector<MAST::__rb_vector_set>(m));
+    
+    RealMatrixX
+    vandermonde = RealMatrixX::Zero(m, m);
+    for (unsigned int j=1; j<=m; j++)
+        for (unsigned int k=1; k<=m; k++)
+            vandermonde(j-1, k-1) = pow(1.*j, 1.*k);
+    
+    const RealMatrixX
+    vandermonde_inv = vandermonde.inverse();
+    
+    for (unsigned int i=0; i<n_params; i++) {
+        
+        for (unsigned int j=1; j<=m; j++) {
+            
+            (*_params[i]) = _ref_vals[i] + j * _deltas[i];
+            _new_products(diffs[i][j-1]);
+            
+            for (unsigned int c=0; c<n_prod; c++) {
+                diffs[i][j-1][c]->add(-1., *p_ref[c]);
+                diffs[i][j-1][c]->close();
+            }
+        }
+        
+        (*_params[i]) = _ref_vals[i];
+        
+        for (unsigned int k=1; k<=m; k++) {
+            
+            term.i1 = i;  term.i2 = -1;
+            term.a1 = k;  term.a2 = 0;
+            
+            term_prods.push_back(MAST::__rb_vector_set());
+            MAST::__combine_vector_sets(vandermonde_inv.row(k-1).transpose(),
+                                        diffs[i],
+                                        term_prods.back());
+            _terms.push_back(term);
+        }
+    }
+    
+    //////////////////////////////////////////////////////////////////////
+    // pairwise terms. The mixed monomials s_i^a s_j^b, with a, b >= 1 and
+    // a+b <= m, are fitted to the samples at (s_i, s_j) = (a, b) after
+    // removal of the single parameter terms. Parameter pairs without
+    // interaction at the first sample are skipped.
+    //////////////////////////////////////////////////////////////////////
+    std::vector<std::pair<unsigned int, unsigned int> > mixed;
+    for (unsigned int a=1; a<m; a++)
+        for (unsigned int b=1; a+b<=m; b++)
+            mixed.push_back(std::pair<unsigned int, unsigned int>(a, b));
+    
+    const unsigned int
+    n_mixed = (unsigned int)mixed.size();
+    
+    RealMatrixX
+    mixed_mat = RealMatrixX::Zero(n_mixed, n_mixed),
+    mixed_inv;
+    for (unsigned int r=0; r<n_mixed; r++)
+        for (unsigned int c=0; c<n_mixed; c++)
+            mixed_mat(r, c) =
+            pow(1.*mixed[r].first,  1.*mixed[c].first) *
+            pow(1.*mixed[r].second, 1.*mixed[c].second);
+    if (n_mixed)
+        mixed_inv = mixed_mat.inverse();
+    
+    const Real
+    ref_norm = MAST::__vector_set_norm(p_ref);
+    
+    for (unsigned int i=0; i<n_params; i++)
+        for (unsigned int j=i+1; j<n_params; j++) {
+            
+            std::vector<MAST::__rb_vector_set> samples(n_mixed);
+            bool if_interacting = n_mixed > 0;
+            
+            for (unsigned int r=0; r<n_mixed; r++) {
+                
+                (*_params[i]) = _ref_vals[i] + mixed[r].first  * _deltas[i];
+                (*_params[j]) = _ref_vals[j] + mixed[r].second * _deltas[j];
+                _new_products(samples[r]);
+                
+                for (unsigned int c=0; c<n_prod; c++) {
+                    samples[r][c]->add(-1., *p_ref[c]);
+                    samples[r][c]->add(-1., *diffs[i][mixed[r].first-1][c]);
+                    samples[r][c]->add(-1., *diffs[j][mixed[r].second-1][c]);
+                    samples[r][c]->close();
+                }
+                
+                // no interaction between the two parameters
+                if (r == 0 &&
+                    MAST::__vector_set_norm(samples[0]) <= 1.e-10 * ref_norm) {
+                    if_interacting = false;
+                    break;
+                }
+            }
+            
+            (*_params[i]) = _ref_vals[i];
+            (*_params[j]) = _ref_vals[j];
+            
+            if (if_interacting) {
+                
+                for (unsigned int c=0; c<n_mixed; c++) {
+                    
+                    term.i1 = i;  term.i2 = j;
+                    term.a1 = mixed[c].first;
+                    term.a2 = mixed[c].second;
+                    
+                    term_prods.push_back(MAST::__rb_vector_set());
+                    MAST::__combine_vector_sets(mixed_inv.row(c).transpose(),
+                                                samples,
+                                                term_prods.back());
+                    _terms.push_back(term);
+                }
+            }
+            
+            for (unsigned int r=0; r<n_mixed; r++)
+                MAST::__delete_vector_set(samples[r]);
+        }
+    
+    for (unsigned int i=0; i<n_params; i++)
+        for (unsigned int j=0; j<m; j++)
+            MAST::__delete_vector_set(diffs[i][j]);
+    
+    const unsigned int
+    n_terms = (unsigned int)_terms.size();
+    
+    //////////////////////////////////////////////////////////////////////
+    // check the decomposition with all parameters perturbed
+    //////////////////////////////////////////////////////////////////////
+    if (n_params) {
+        
+        for (unsigned int i=0; i<n_params; i++)
+            (*_params[i]) = _ref_vals[i] + 0.5 * _deltas[i];
+        
+        RealVectorX theta;
+        _term_coefficients(theta);
+        
+        MAST::__rb_vector_set exact, approx;
+        _new_products(exact);
+        MAST::__combine_vector_sets(theta, term_prods, approx);
+        
+        for (unsigned int i=0; i<n_params; i++)
+            (*_params[i]) = _ref_vals[i];
+        
+        const Real
+        exact_norm = MAST::__vector_set_norm(exact);
+        
+        for (unsigned int c=0; c<n_prod; c++) {
+            approx[c]->add(-1., *exact[c]);
+            approx[c]->close();
+        }
+        
+        const Real
+        err = MAST::__vector_set_norm(approx) / exact_norm;
+        
+        MAST::__delete_vector_set(exact);
+        MAST::__delete_vector_set(approx);
+        
+        if (err > 1.e-8) {
+            
+            for (unsigned int t=0; t<n_terms; t++)
+                MAST::__delete_vector_set(term_prods[t]);
+            
+            libmesh_error_msg("Error: relative error of "
+                              << err
+                              << " in the polynomial decomposition of the"
+                              << " reduced-basis operators. The operators"
+                              << " may depend on more than two parameters"
+                              << " together, or need a higher order.");
+        }
+    }
+    
+    //////////////////////////////////////////////////////////////////////
+    // projection on the basis and Gram matrix of the products
+    //////////////////////////////////////////////////////////////////////
+    _projected.resize(n_terms);
+    _gram.setZero(n_terms*n_prod, n_terms*n_prod);
+    
+    for (unsigned int t=0; t<n_terms; t++) {
+        
+        _projected[t].setZero(n_basis, n_prod);
+        for (unsigned int c=0; c<n_prod; c++) {
+            
+            for (unsigned int k=0; k<n_basis; k++)
+                _projected[t](k, c) = _basis[k]->dot(*term_prods[t][c]);
+            
+            for (unsigned int s=0; s<=t; s++)
+                for (unsigned int d=0; d<n_prod; d++) {
+                    
+                    if (s == t && d > c)
+                        break;
+                    
+                    _gram(t*n_prod+c, s*n_prod+d) =
+                    _gram(s*n_prod+d, t*n_prod+c) =
+                    term_prods[t][c]->dot(*term_prods[s][d]);
+                }
+        }
+    }
+    
+    for (unsigned int t=0; t<n_terms; t++)
+        MAST::__delete_vector_set(term_prods[t]);
+    
+    MAST_LOG_COUNT("reduced_basis_terms", n_terms);
+    
+    _if_built = true;
+    _update_memory();
+}
+
+
+
+void
+MAST::ReducedBasisSurrogate::_term_coefficients(RealVectorX& theta) const {
+    
+    theta.setZero(_terms.size());
+    
+    for (unsigned int t=0; t<_terms.size(); t++) {
+        
+        const MAST::ReducedBasisSurrogate::Term& term = _terms[t];
+        Real val = 1.;
+        
+        if (term.i1 >= 0)
+            val *= pow(((*_params[term.i1])() - _ref_vals[term.i1])/_deltas[term.i1],
+                       1.*term.a1);
+        
+        if (term.i2 >= 0)
+            val *= pow(((*_params[term.i2])() - _ref_vals[term.i2])/_deltas[term.i2],
+                       1.*term.a2);
+        
+        theta(t) = val;
+    }
+}
+
+
+
+void
+MAST::ReducedBasisSurrogate::
+_term_coefficient_derivatives(const MAST::Parameter& p,
+                              RealVectorX& dtheta) const {
+    
+    int
+    i = -1;
+    
+    for (unsigned int j=0; j<_params.size(); j++)
+        if (_params[j] == &p)
+            i = (int)j;
+    
+    if (i < 0)
+        libmesh_error_msg("Error: parameter "
+                          << p.name()
+                          << " is not a parameter of the reduced-basis surrogate.");
+    
+    dtheta.setZero(_terms.size());
+    
+    for (unsigned int t=0; t<_terms.size(); t++) {
+        
+        const MAST::ReducedBasisSurrogate::Term& term = _terms[t];
+        
+        if (term.i1 != i && term.i2 != i)
+            continue;
+        
+        // the term is s_i^a s_j^b, with i the differentiated parameter
+        const unsigned int
+        a   = (term.i1 == i)? term.a1 : term.a2;
+        const int
+        j   = (term.i1 == i)? term.i2 : term.i1;
+        const unsigned int
+        b   = (term.i1 == i)? term.a2 : term.a1;
+        
+        Real val = a/_deltas[i] *
+        pow(((*_params[i])() - _ref_vals[i])/_deltas[i], a-1.);
+        
+        if (j >= 0)
+            val *= pow(((*_params[j])() - _ref_vals[j])/_deltas[j], 1.*b);
+        
+        dtheta(t) = val;
+    }
+}
+
+
+
+RealMatrixX
+MAST::ReducedBasisSurrogate::_reduced_operator(const RealVectorX& theta,
+                                               unsigned int c0,
+                                               unsigned int nc) const {
+    
+    libmesh_assert(_if_built);
+    libmesh_assert_equal_to(theta.size(), _terms.size());
+    
+    const unsigned int
+    n_basis = (unsigned int)_basis.size();
+    
+    RealMatrixX
+    m = RealMatrixX::Zero(n_basis, nc);
+    
+    for (unsigned int t=0; t<_terms.size(); t++)
+        m += theta(t) * _projected[t].block(0, c0, n_basis, nc);
+    
+    return m;
+}
+
+
+
+Real
+MAST::ReducedBasisSurrogate::_norm_sq(const RealVectorX& w) const {
+    
+    libmesh_assert_equal_to(w.size(), _gram.rows());
+    
+    // round-off can make the value slightly negative for small norms
+    return std::max(w.dot(_gram * w), 0.);
+}
+
+
+
+void
+MAST::ReducedBasisSurrogate::_build_pod_basis() {
+    
+    MAST::__delete_vector_set(_basis);
+    
+    const unsigned int
+    n_snap = (unsigned int)_snapshots.size();
+    
+    // correlation matrix of the snapshots
+    RealMatrixX
+    corr = RealMatrixX::Zero(n_snap, n_snap);
+    
+    for (unsigned int i=0; i<n_snap; i++)
+        for (unsigned int j=0; j<=i; j++)
+            corr(i, j) = corr(j, i) = _snapshots[i]->dot(*_snapshots[j]);
+    
+    Eigen::SelfAdjointEigenSolver<RealMatrixX> eig(corr);
+    
+    const RealVectorX&
+    lambda = eig.eigenvalues();
+    
+    if (lambda(n_snap-1) <= 0.)
+        libmesh_error_msg("Error: snapshots for reduced basis are zero.");
+    
+    // the modes are added in decreasing order of the eigenvalues, and
+    // are orthonormalized again to remove the round-off in the modes of
+    // small eigenvalues
+    for (int k=n_snap-1; k>=0; k--) {
+        
+        if (lambda(k) <= _pod_tol * _pod_tol * lambda(n_snap-1))
+            break;
+        
+        libMesh::NumericVector<Real>*
+        v = _snapshots[0]->zero_clone().release();
+        
+        for (unsigned int j=0; j<n_snap; j++)
+            v->add(eig.eigenvectors()(j, k), *_snapshots[j]);
+        v->close();
+        
+        for (unsigned int i=0; i<_basis.size(); i++) {
+            v->add(-_basis[i]->dot(*v), *_basis[i]);
+            v->close();
+        }
+        
+        const Real
+        norm = v->l2_norm();
+        
+        if (norm <= 1.e-8 * sqrt(lambda(k))) {
+            
+            delete v;
+            continue;
+        }
+        
+        v->scale(1./norm);
+        _basis.push_back(v);
+    }
+}
+
+
+
+void
+MAST::ReducedBasisSurrogate::
+_new_products(std::vector<libMesh::NumericVector<Real>*>& prod) {
+    
+    const unsigned int n_prod = this->_n_products();
+    
+    prod.resize(n_prod);
+    for (unsigned int i=0; i<n_prod; i++)
+        prod[i] = _system.solution->zero_clone().release();
+    
+    this->_assemble_products(prod);
+}
+
+
+
+void
+MAST::ReducedBasisSurrogate::_update_memory() {
+    
+    std::size_t
+    bytes = 0;
+    
+    for (unsigned int i=0; i<_snapshots.size(); i++)
+        bytes += MAST::MemoryLog::bytes(*_snapshots[i]);
+    
+    for (unsigned int i=0; i<_basis.size(); i++)
+        bytes += MAST::MemoryLog::bytes(*_basis[i]);
+    
+    for (unsigned int i=0; i<_projected.size(); i++)
+        bytes += MAST::MemoryLog::bytes(_projected[i]);
+    
+    bytes += MAST::MemoryLog::bytes(_gram);
+    
+    _memory.set(bytes);
+}
+
+
+
+void
+MAST::ReducedBasisSurrogate::_basis_combination(const RealVectorX& a,
+                                                libMesh::NumericVector<Real>& v) const {
+    
+    libmesh_assert_equal_to(a.size(), _basis.size());
+    
+    v.zero();
+    for (unsigned int i=0; i<_basis.size(); i++)
+        v.add(a(i), *_basis[i]);
+    v.close();
+}
+
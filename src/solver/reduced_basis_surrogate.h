@@ -0,0 +1,353 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2017  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#ifndef __mast__reduced_basis_surrogate__
+#define __mast__reduced_basis_surrogate__
+
+// C++ includes
+#include <vector>
+
+// MAST includes
+#include "base/mast_data_types.h"
+#include "base/memory_log.h"
+
+// libMesh includes
+#include "libmesh/numeric_vector.h"
+
+
+namespace MAST {
+    
+    // Forward declerations
+    class NonlinearSystem;
+    class Parameter;
+    
+    
+    /*!
+     *   Base class for reduced-basis surrogates of the full-order model of
+     *   a MAST::NonlinearSystem, for repeated analyses at different values
+     *   of a set of parameters.
+     *
+     *   In the offline stage, build() computes an orthonormal basis by
+     *   proper orthogonal decomposition of the snapshots added with
+     *   add_snapshot(), and a decomposition of the products of the
+     *   full-order operators with the basis vectors, which the derived
+     *   classes define through _assemble_products(). The decomposition is
+     *   a polynomial in the scaled parameters
+     *   \f$ s_i = (p_i - p_i^0)/\Delta p_i \f$ about the values
+     *   \f$ p_i^0 \f$ at the time of build(),
+     *   \f[ P(p) = P_0 + \sum_i \sum_{k=1}^{m} s_i^k P_{i,k} +
+     *              \sum_{i<j} \sum_{a,b \geq 1, a+b \leq m}
+     *              s_i^a s_j^b P_{ij,ab}, \f]
+     *   which is obtained by assembling the operators at sample values of
+     *   the parameters. The pairwise terms are included only for
+     *   parameters whose contributions interact, for example through the
+     *   interpolation of a property between two stations. The
+     *   decomposition is exact for operators that depend polynomially on
+     *   the parameters, with order up to \p m, which is the case for the
+     *   dependence of the stiffness, mass and loads on thicknesses,
+     *   moduli and densities through the property cards. build() checks
+     *   the decomposition at one point with all parameters perturbed,
+     *   and stops with an error if it is not reproduced.
+     *
+     *   The decomposition is stored as the projection of the products on
+     *   the basis, and as the Gram matrix of the products. These allow the
+     *   derived classes to compute the reduced operators and the norm of
+     *   the full-order residual of a reduced solution in the online stage
+     *   without any operation on the full-order model.
+     */
+    class ReducedBasisSurrogate {
+        
+    public:
+        
+        ReducedBasisSurrogate(MAST::NonlinearSystem& sys);
+        
+        virtual ~ReducedBasisSurrogate();
+        
+        
+        /*!
+         *   adds \p p to the parameters of the surrogate. \p delta is the
+         *   step in the parameter for the sampling of the decomposition,
+         *   and should be comparable to the range of the parameter in the
+         *   online evaluations.
+         */
+        void add_parameter(MAST::Parameter& p, Real delta);
+        
+        
+        /*!
+         *   sets the order of the polynomial decomposition in the
+         *   parameters. The default value of 3 is exact for the
+         *   dependence of plate and shell stiffness on thickness.
+         */
+        void set_polynomial_order(unsigned int m);
+        
+        
+        /*!
+         *   sets the tolerance on the relative eigenvalues of the snapshot
+         *   correlation matrix below which the POD modes are discarded
+         */
+        void set_pod_tolerance(Real tol) {
+            
+            libmesh_assert_greater(tol, 0.);
+            _pod_tol = tol;
+        }
+        
+        
+        /*!
+         *   sets the tolerance on the error estimate of the online solution
+         *   above which the full-order model is solved instead. The
+         *   estimate is computed from the Gram matrix of the products, so
+         *   that values below about 1.e-7 are dominated by round-off and
+         *   should not be used as tolerance.
+         */
+        void set_error_tolerance(Real tol) {
+            
+            libmesh_assert_greater(tol, 0.);
+            _error_tol = tol;
+        }
+        
+        
+        /*!
+         *   adds a copy of \p v to the snapshots used for the basis
+         */
+        void add_snapshot(const libMesh::NumericVector<Real>& v);
+        
+        
+        /*!
+         *   @returns the number of snapshots
+         */
+        unsigned int n_snapshots() const {
+            return (unsigned int)_snapshots.size();
+        }
+        
+        
+        /*!
+         *   @returns the number of snapshots added since the last call to
+         *   build(). A new call to build() includes them in the basis.
+         */
+        unsigned int n_new_snapshots() const {
+            return _n_new_snapshots;
+        }
+        
+        
+        /*!
+         *   @returns the number of basis vectors
+         */
+        unsigned int n_basis() const {
+            return (unsigned int)_basis.size();
+        }
+        
+        
+        /*!
+         *   computes the basis and the decomposition of the operators at the
+         *   current values of the parameters. The parameter values are
+         *   restored before returning.
+         */
+        void build();
+        
+        
+        /*!
+         *   @returns true if build() has been called after the last
+         *   call to clear()
+         */
+        bool if_built() const {
+            return _if_built;
+        }
+        
+        
+        /*!
+         *   @returns the error estimate of the last online solution
+         */
+        Real error_estimate() const {
+            return _error_estimate;
+        }
+        
+        
+        /*!
+         *   clears the basis, decomposition and snapshots
+         */
+        virtual void clear();
+        
+        
+    protected:
+        
+        /*!
+         *   a term of the polynomial decomposition, with coefficient
+         *   \f$ s_{i_1}^{a_1} s_{i_2}^{a_2} \f$. The index of an absent
+         *   parameter is -1.
+         */
+        struct Term {
+            int          i1, i2;
+            unsigned int a1, a2;
+        };
+        
+        
+        /*!
+         *   @returns the number of product vectors defined by the derived
+         *   class
+         */
+        virtual unsigned int _n_products() const = 0;
+        
+        
+        /*!
+         *   assembles the full-order product vectors at the current values of
+         *   the parameters into \p prod, which has _n_products() vectors
+         *   created by this class.
+         */
+        virtual void
+        _assemble_products(std::vector<libMesh::NumericVector<Real>*>& prod) = 0;
+        
+        
+        /*!
+         *   computes the coefficients of the terms at the current values of
+         *   the parameters
+         */
+        void _term_coefficients(RealVectorX& theta) const;
+        
+        
+        /*!
+         *   computes the derivatives of the coefficients of the terms with
+         *   respect to parameter \p p at the current values of the
+         *   parameters. \p p must be one of the parameters of the
+         *   surrogate.
+         */
+        void _term_coefficient_derivatives(const MAST::Parameter& p,
+                                           RealVectorX& dtheta) const;
+        
+        
+        /*!
+         *   @returns the reduced operator
+         *   \f$ \sum_t \theta_t \Phi^T P_{t,c} \f$ for the products
+         *   \f$ c \f$ in \p [c0, c0+nc)
+         */
+        RealMatrixX _reduced_operator(const RealVectorX& theta,
+                                      unsigned int c0,
+                                      unsigned int nc) const;
+        
+        
+        /*!
+         *   @returns \f$ \| \sum_t \sum_c w_{t,c} P_{t,c} \|^2 \f$, where the
+         *   weights are ordered with the products within each term.
+         */
+        Real _norm_sq(const RealVectorX& w) const;
+        
+        
+        /*!
+         *   computes the orthonormal POD basis from the snapshots
+         */
+        void _build_pod_basis();
+        
+        
+        /*!
+         *   creates the product vectors in \p prod and assembles them at the
+         *   current values of the parameters
+         */
+        void _new_products(std::vector<libMesh::NumericVector<Real>*>& prod);
+        
+        
+        /*!
+         *   updates the memory account with the size of the data
+         */
+        void _update_memory();
+        
+        
+        /*!
+         *   sets \p v to \f$ \Phi a \f$
+         */
+        void _basis_combination(const RealVectorX& a,
+                                libMesh::NumericVector<Real>& v) const;
+        
+        
+        /*!
+         *   system of the full-order model
+         */
+        MAST::NonlinearSystem& _system;
+        
+        
+        /*!
+         *   parameters, their values at build() and sampling steps
+         */
+        std::vector<MAST::Parameter*> _params;
+        std::vector<Real>             _ref_vals;
+        std::vector<Real>             _deltas;
+        
+        
+        /*!
+         *   polynomial order of the decomposition
+         */
+        unsigned int _order;
+        
+        
+        /*!
+         *   tolerances for the POD and the online error estimate
+         */
+        Real _pod_tol, _error_tol;
+        
+        
+        /*!
+         *   error estimate of the last online solution
+         */
+        Real _error_estimate;
+        
+        
+        /*!
+         *   flag for availability of the basis and decomposition
+         */
+        bool _if_built;
+        
+        
+        /*!
+         *   snapshots and orthonormal basis vectors
+         */
+        std::vector<libMesh::NumericVector<Real>*> _snapshots, _basis;
+        
+        
+        /*!
+         *   number of snapshots added since the last build()
+         */
+        unsigned int _n_new_snapshots;
+        
+        
+        /*!
+         *   terms of the decomposition
+         */
+        std::vector<MAST::ReducedBasisSurrogate::Term> _terms;
+        
+        
+        /*!
+         *   projection of the products of each term on the basis
+         */
+        std::vector<RealMatrixX> _projected;
+        
+        
+        /*!
+         *   Gram matrix of the products of all terms
+         */
+        RealMatrixX _gram;
+        
+        
+        /*!
+         *   memory of the snapshots, basis and decomposition
+         */
+        MAST::MemoryAccount _memory;
+    };
+}
+
+
+#endif // __mast__reduced_basis_surrogate__
@@ -46,9 +46,16 @@ MAST::SecondOrderNewmarkTransientSolver::solve() {
     // make sure that the system has been specified
     libmesh_assert_msg(_system, "System pointer is nullptr.");
     
+    // the Jacobian from the previous step is valid only if the time
+    // step has not changed
+    _update_jacobian_lagging();
+    
     // ask the Newton solver to solve for the system solution
     _system->solve();
     
+    // the residual evaluations compute the velocity and acceleration only
+    // on the element dofs. So, update the vectors at the converged solution.
+    _update_current_derivatives();
 }
 
 
@@ -68,7 +75,7 @@ _set_element_data(const std::vector<libMesh::dof_id_type>& dof_indices,
                   const std::vector<libMesh::NumericVector<Real>*>& sols,
                   MAST::ElementBase &elem){
     
-    libmesh_assert_equal_to(sols.size(), 3);
+    libmesh_assert_equal_to(sols.size(), 4);
 
     const unsigned int n_dofs = (unsigned int)dof_indices.size();
     
@@ -77,20 +84,40 @@ _set_element_data(const std::vector<libMesh::dof_id_type>& dof_indices,
     RealVectorX
     sol          = RealVectorX::Zero(n_dofs),
     vel          = RealVectorX::Zero(n_dofs),
-    accel        = RealVectorX::Zero(n_dofs);
+    accel        = RealVectorX::Zero(n_dofs),
+    prev_sol     = RealVectorX::Zero(n_dofs),
+    prev_vel     = RealVectorX::Zero(n_dofs),
+    prev_acc     = RealVectorX::Zero(n_dofs);
     
     
     // get the references to current and previous sol and velocity
     const libMesh::NumericVector<Real>
-    &sol_global     =   *sols[0],
-    &vel_global     =   *sols[1],
-    &acc_global     =   *sols[2];
+    &sol_global      =   *sols[0],
+    &prev_sol_global =   *sols[1],
+    &prev_vel_global =   *sols[2],
+    &prev_acc_global =   *sols[3];
     
     for (unsigned int i=0; i<n_dofs; i++) {
         
         sol(i)          = sol_global(dof_indices[i]);
-        vel(i)          = vel_global(dof_indices[i]);
-        accel(i)        = acc_global(dof_indices[i]);
+        prev_sol(i)     = prev_sol_global(dof_indices[i]);
+        prev_vel(i)     = prev_vel_global(dof_indices[i]);
+        prev_acc(i)     = prev_acc_global(dof_indices[i]);
+    }
+    
+    if (_if_highest_derivative_solution) {
+        
+        // the quantities are provided at the current iteration
+        vel   = prev_vel;
+        accel = prev_acc;
+    }
+    else {
+        
+        // see update_velocity() and update_acceleration()
+        vel   = (gamma/beta/dt) * (sol - prev_sol) +
+        (1.-gamma/beta) * prev_vel + (1.-gamma/2./beta)*dt * prev_acc;
+        accel = (1./beta/dt/dt) * (sol - prev_sol) -
+        (1./beta/dt) * prev_vel - ((.5-beta)/beta) * prev_acc;
     }
     
     elem.set_solution(sol);
@@ -107,29 +134,36 @@ _set_element_perturbed_data(const std::vector<libMesh::dof_id_type>& dof_indices
                             const std::vector<libMesh::NumericVector<Real>*>& sols,
                             MAST::ElementBase &elem){
     
-    libmesh_assert_equal_to(sols.size(), 3);
+    libmesh_assert_equal_to(sols.size(), 1);
     
     const unsigned int n_dofs = (unsigned int)dof_indices.size();
     
     // get the current state and velocity estimates
     // also get the current discrete velocity replacement
     RealVectorX
+    dsol         = RealVectorX::Zero(n_dofs),
     sol          = RealVectorX::Zero(n_dofs),
     vel          = RealVectorX::Zero(n_dofs),
     accel        = RealVectorX::Zero(n_dofs);
     
     
-    // get the references to current and previous sol and velocity
+    // get the references to the perturbed solution
     const libMesh::NumericVector<Real>
-    &sol_global     =   *sols[0],
-    &vel_global     =   *sols[1],
-    &acc_global     =   *sols[2];
+    &dsol_global     =   *sols[0];
     
-    for (unsigned int i=0; i<n_dofs; i++) {
+    for (unsigned int i=0; i<n_dofs; i++)
+        dsol(i)         = dsol_global(dof_indices[i]);
+    
+    if (_if_highest_derivative_solution)
+        // only the highest derivative is perturbed since
+        // all lower derivative quantities are known
+        accel = dsol;
+    else {
         
-        sol(i)          = sol_global(dof_indices[i]);
-        vel(i)          = vel_global(dof_indices[i]);
-        accel(i)        = acc_global(dof_indices[i]);
+        // see update_delta_velocity() and update_delta_acceleration()
+        sol   = dsol;
+        vel   = (gamma/beta/dt) * dsol;
+        accel = (1./beta/dt/dt) * dsol;
     }
     
     elem.set_perturbed_solution(sol);
@@ -186,6 +220,31 @@ update_acceleration(libMesh::NumericVector<Real>& vec,
 
 
 
+Real
+MAST::SecondOrderNewmarkTransientSolver::
+_local_truncation_error_estimate(Real& order) {
+    
+    // the acceleration at the current solution is updated by solve()
+    std::auto_ptr<libMesh::NumericVector<Real> >
+    dacc(_current_acceleration().clone().release());
+    dacc->add(-1., this->acceleration(1));
+    dacc->close();
+    
+    const Real
+    den = std::max(this->solution().l2_norm(), this->solution(1).l2_norm());
+    
+    // the estimate scales as dt^3
+    order = 3.;
+    
+    if (den == 0.)
+        return 0.;
+    
+    return std::fabs(beta-1./6.) * dt * dt * dacc->l2_norm() / den;
+}
+
+
+
+
 void
 MAST::SecondOrderNewmarkTransientSolver::
 update_delta_velocity(libMesh::NumericVector<Real>& vec,
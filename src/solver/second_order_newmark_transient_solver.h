@@ -107,6 +107,13 @@ namespace MAST {
             return 2;
         }
         
+        /*!
+         *    estimates the local truncation error from the change in
+         *    acceleration over the time step as
+         *    \f$ |\beta - 1/6| \Delta t^2 \| \ddot{x}_{n+1} - \ddot{x}_n \| \f$.
+         */
+        virtual Real _local_truncation_error_estimate(Real& order);
+        
         /*!
          *    provides the element with the transient data for calculations
          */
@@ -0,0 +1,253 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2017  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+// C++ includes
+#include <algorithm>
+
+// MAST includes
+#include "solver/single_precision_preconditioner.h"
+#include "base/performance_log.h"
+
+
+
+//---------------------------------------------------------------
+// this function is called by PETSc to set up the shell preconditioner
+// whenever the preconditioning matrix changes
+PetscErrorCode
+__mast_single_precision_pc_setup(PC pc) {
+    
+    PetscErrorCode ierr=0;
+    void * ctx = PETSC_NULL;
+    Mat    A, P;
+    
+    ierr = PCShellGetContext(pc, &ctx);   CHKERRQ(ierr);
+    ierr = PCGetOperators(pc, &A, &P);    CHKERRQ(ierr);
+    
+    libmesh_assert(ctx);
+    
+    static_cast<MAST::SinglePrecisionPreconditioner*>(ctx)->init(P);
+    
+    return ierr;
+}
+
+
+
+//---------------------------------------------------------------
+// this function is called by PETSc to apply the shell preconditioner
+PetscErrorCode
+__mast_single_precision_pc_apply(PC pc, Vec x, Vec y) {
+    
+    PetscErrorCode ierr=0;
+    void * ctx = PETSC_NULL;
+    
+    ierr = PCShellGetContext(pc, &ctx);   CHKERRQ(ierr);
+    
+    libmesh_assert(ctx);
+    
+    static_cast<MAST::SinglePrecisionPreconditioner*>(ctx)->apply(x, y);
+    
+    return ierr;
+}
+
+
+
+MAST::SinglePrecisionPreconditioner::SinglePrecisionPreconditioner():
+_n_rows(0),
+_memory(MAST::MEMORY_PRECONDITIONER) {
+    
+}
+
+
+
+MAST::SinglePrecisionPreconditioner::~SinglePrecisionPreconditioner() {
+    
+}
+
+
+
+void
+MAST::SinglePrecisionPreconditioner::attach(PC pc) {
+    
+    PetscErrorCode ierr;
+    MPI_Comm       comm = PetscObjectComm((PetscObject)pc);
+    
+    ierr = PCSetType(pc, PCSHELL);                                   CHKERRABORT(comm, ierr);
+    ierr = PCShellSetContext(pc, this);                              CHKERRABORT(comm, ierr);
+    ierr = PCShellSetSetUp(pc, __mast_single_precision_pc_setup);    CHKERRABORT(comm, ierr);
+    ierr = PCShellSetApply(pc, __mast_single_precision_pc_apply);    CHKERRABORT(comm, ierr);
+    ierr = PCShellSetName(pc, "MAST single precision ILU(0)");       CHKERRABORT(comm, ierr);
+}
+
+
+
+void
+MAST::SinglePrecisionPreconditioner::clear() {
+    
+    _n_rows = 0;
+    _row_begin.clear();
+    _cols.clear();
+    _diag.clear();
+    _vals.clear();
+    
+    _memory.clear();
+}
+
+
+
+void
+MAST::SinglePrecisionPreconditioner::init(Mat mat) {
+    
+    MAST_LOG_SCOPE("SinglePrecisionPreconditioner::init");
+    
+    this->clear();
+    
+    PetscErrorCode ierr;
+    MPI_Comm       comm = PetscObjectComm((PetscObject)mat);
+    
+    PetscInt
+    first  = 0,
+    last   = 0,
+    n_cols = 0;
+    
+    const PetscInt    *cols = PETSC_NULL;
+    const PetscScalar *vals = PETSC_NULL;
+    
+    ierr = MatGetOwnershipRange(mat, &first, &last);       CHKERRABORT(comm, ierr);
+    
+    _n_rows = last - first;
+    _row_begin.resize(_n_rows+1, 0);
+    _diag.resize(_n_rows, -1);
+    
+    //////////////////////////////////////////////////////////////////////
+    // copy the local diagonal block in single precision
+    //////////////////////////////////////////////////////////////////////
+    std::vector<std::pair<PetscInt, float> > row;
+    
+    for (PetscInt i=0; i<_n_rows; i++) {
+        
+        row.clear();
+        
+        ierr = MatGetRow(mat, first+i, &n_cols, &cols, &vals);     CHKERRABORT(comm, ierr);
+        for (PetscInt j=0; j<n_cols; j++)
+            if (cols[j] >= first && cols[j] < last)
+                row.push_back(std::pair<PetscInt, float>
+                              (cols[j]-first, static_cast<float>(vals[j])));
+        ierr = MatRestoreRow(mat, first+i, &n_cols, &cols, &vals); CHKERRABORT(comm, ierr);
+        
+        std::sort(row.begin(), row.end());
+        
+        for (unsigned int j=0; j<row.size(); j++) {
+            
+            if (row[j].first == i)
+                _diag[i] = (PetscInt) _cols.size();
+            
+            _cols.push_back(row[j].first);
+            _vals.push_back(row[j].second);
+        }
+        
+        _row_begin[i+1] = (PetscInt) _cols.size();
+        
+        if (_diag[i] < 0)
+            libmesh_error_msg("Error: missing diagonal entry in row "
+                              << first+i
+                              << " of the preconditioning matrix.");
+    }
+    
+    //////////////////////////////////////////////////////////////////////
+    // ILU(0) factorization in the sparsity of the matrix. The entries
+    // of the current row are located through their column index in work.
+    //////////////////////////////////////////////////////////////////////
+    std::vector<PetscInt> work(_n_rows, -1);
+    
+    for (PetscInt i=0; i<_n_rows; i++) {
+        
+        for (PetscInt p=_row_begin[i]; p<_row_begin[i+1]; p++)
+            work[_cols[p]] = p;
+        
+        for (PetscInt p=_row_begin[i]; p<_diag[i]; p++) {
+            
+            const PetscInt k = _cols[p];
+            
+            // multiplier for row k of U
+            const Real l_ik = (Real)_vals[p] / (Real)_vals[_diag[k]];
+            _vals[p]        = static_cast<float>(l_ik);
+            
+            for (PetscInt q=_diag[k]+1; q<_row_begin[k+1]; q++)
+                if (work[_cols[q]] >= 0)
+                    _vals[work[_cols[q]]] =
+                    static_cast<float>(_vals[work[_cols[q]]] - l_ik * _vals[q]);
+        }
+        
+        if (_vals[_diag[i]] == 0.)
+            libmesh_error_msg("Error: zero pivot in row "
+                              << first+i
+                              << " of the single precision ILU(0) factorization.");
+        
+        for (PetscInt p=_row_begin[i]; p<_row_begin[i+1]; p++)
+            work[_cols[p]] = -1;
+    }
+    
+    _memory.set(_vals.size()      * sizeof(float) +
+                (_cols.size()     +
+                 _diag.size()     +
+                 _row_begin.size()) * sizeof(PetscInt));
+}
+
+
+
+void
+MAST::SinglePrecisionPreconditioner::apply(Vec x, Vec y) const {
+    
+    MAST_LOG_SCOPE("SinglePrecisionPreconditioner::apply");
+    
+    PetscErrorCode ierr;
+    MPI_Comm       comm = PetscObjectComm((PetscObject)x);
+    
+    const PetscScalar *x_vals = PETSC_NULL;
+    PetscScalar       *y_vals = PETSC_NULL;
+    
+    ierr = VecGetArrayRead(x, &x_vals);                    CHKERRABORT(comm, ierr);
+    ierr = VecGetArray(y, &y_vals);                        CHKERRABORT(comm, ierr);
+    
+    Real
+    v = 0.;
+    
+    // forward substitution with the unit lower triangular factor
+    for (PetscInt i=0; i<_n_rows; i++) {
+        
+        v = x_vals[i];
+        for (PetscInt p=_row_begin[i]; p<_diag[i]; p++)
+            v -= _vals[p] * y_vals[_cols[p]];
+        y_vals[i] = v;
+    }
+    
+    // backward substitution with the upper triangular factor
+    for (PetscInt i=_n_rows-1; i>=0; i--) {
+        
+        v = y_vals[i];
+        for (PetscInt p=_diag[i]+1; p<_row_begin[i+1]; p++)
+            v -= _vals[p] * y_vals[_cols[p]];
+        y_vals[i] = v / _vals[_diag[i]];
+    }
+    
+    ierr = VecRestoreArray(y, &y_vals);                    CHKERRABORT(comm, ierr);
+    ierr = VecRestoreArrayRead(x, &x_vals);                CHKERRABORT(comm, ierr);
+}
+
@@ -0,0 +1,134 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2017  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#ifndef __mast__single_precision_preconditioner__
+#define __mast__single_precision_preconditioner__
+
+// C++ includes
+#include <vector>
+
+// MAST includes
+#include "base/mast_data_types.h"
+#include "base/memory_log.h"
+
+// PETSc includes
+#include <petscksp.h>
+
+
+namespace MAST {
+    
+    /*!
+     *   Incomplete LU preconditioner with zero fill, ILU(0), whose factors
+     *   are stored in single precision. The factors are computed from the
+     *   rows of the preconditioning matrix that are local to this rank,
+     *   using only the columns local to this rank, which is the same
+     *   block-Jacobi ILU(0) preconditioner that PETSc uses by default.
+     *   The object is attached to a double precision Krylov solver as a
+     *   PETSc shell preconditioner, so that the Krylov vectors and the
+     *   operator products are computed in double precision, while the
+     *   application of the preconditioner reads half the bytes for the
+     *   matrix coefficients. The preconditioner is applied with double
+     *   precision arithmetic.
+     *
+     *   The preconditioning matrix continues to be assembled in double
+     *   precision by the assembly objects, and is converted to single
+     *   precision whenever the preconditioner is set up by PETSc.
+     */
+    class SinglePrecisionPreconditioner {
+        
+    public:
+        
+        SinglePrecisionPreconditioner();
+        
+        virtual ~SinglePrecisionPreconditioner();
+        
+        
+        /*!
+         *   sets \p pc to be a shell preconditioner that uses this object.
+         *   The factorization is computed from the preconditioning matrix
+         *   of \p pc during its setup. This object must remain alive
+         *   until \p pc is destroyed.
+         */
+        void attach(PC pc);
+        
+        
+        /*!
+         *   computes the single precision factorization of the local
+         *   diagonal block of \p mat
+         */
+        void init(Mat mat);
+        
+        
+        /*!
+         *   clears the factorization
+         */
+        void clear();
+        
+        
+        /*!
+         *   applies the preconditioner to \p x and returns the result
+         *   in \p y
+         */
+        void apply(Vec x, Vec y) const;
+        
+        
+    protected:
+        
+        /*!
+         *   number of local rows in the factorization
+         */
+        PetscInt _n_rows;
+        
+        
+        /*!
+         *   beginning of each row in \p _cols and \p _vals, with
+         *   \p _n_rows+1 entries
+         */
+        std::vector<PetscInt> _row_begin;
+        
+        
+        /*!
+         *   local column indices of the entries, sorted within each row
+         */
+        std::vector<PetscInt> _cols;
+        
+        
+        /*!
+         *   index of the diagonal entry in \p _cols for each row
+         */
+        std::vector<PetscInt> _diag;
+        
+        
+        /*!
+         *   L and U factors in the sparsity of the local matrix. The unit
+         *   diagonal of L is not stored.
+         */
+        std::vector<float> _vals;
+        
+        
+        /*!
+         *   memory held by the factorization
+         */
+        MAST::MemoryAccount _memory;
+    };
+}
+
+
+#endif // __mast__single_precision_preconditioner__
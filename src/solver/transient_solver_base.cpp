@@ -17,10 +17,15 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
+// C++ includes
+#include <limits>
+#include <cmath>
+
 // MAST includes
 #include "solver/transient_solver_base.h"
 #include "base/transient_assembly.h"
 #include "base/nonlinear_system.h"
+#include "solver/jacobian_lagging_policy.h"
 
 
 // libMesh includes
@@ -33,10 +38,28 @@
 
 MAST::TransientSolverBase::TransientSolverBase():
 dt(0.),
+error_tolerance(1.e-3),
+min_dt(0.),
+max_dt(std::numeric_limits<Real>::max()),
+dt_safety_factor(0.9),
+max_dt_growth(2.),
+min_dt_reduction(0.2),
+dt_hysteresis(0.2),
+max_rejected_steps(10),
 _first_step(true),
 _assembly(nullptr),
 _system(nullptr),
-_if_highest_derivative_solution(false) {
+_if_highest_derivative_solution(false),
+_n_rejected_steps(0),
+_prev_dt(0.),
+_jacobian_dt(0.),
+_n_history(0),
+_history_offset(0),
+_solution_history_offset(0),
+_if_current_derivatives_outdated(false),
+_local_solution(nullptr),
+_local_perturbed_solution(nullptr),
+_if_local_history_outdated(true) {
 
 }
 
@@ -58,8 +81,10 @@ MAST::TransientSolverBase::set_assembly(MAST::TransientAssembly& assembly) {
     _assembly = &assembly;
     _system   = &assembly.system();
     
-    // number of time steps to store
-    unsigned int n_iters = _n_iters_to_store();
+    // number of time steps to store. This is fixed until the assembly is
+    // cleared, since the history vectors are added to the system here.
+    _n_history = _n_iters_to_store();
+    unsigned int n_iters = _n_history;
     
     // now, add the vectors
     std::string nm;
@@ -89,7 +114,13 @@ MAST::TransientSolverBase::set_assembly(MAST::TransientAssembly& assembly) {
         }
     }
     
-    _first_step = true;
+    _first_step                      = true;
+    _prev_dt                         = 0.;
+    _jacobian_dt                     = 0.;
+    _if_local_history_outdated       = true;
+    _history_offset                  = 0;
+    _solution_history_offset         = 0;
+    _if_current_derivatives_outdated = false;
 }
 
 
@@ -103,7 +134,7 @@ MAST::TransientSolverBase::clear_assembly() {
     
     // clear the transient solutions stored in system for solution
     // number of time steps to store
-    unsigned int n_iters = _n_iters_to_store();
+    unsigned int n_iters = _n_history;
     
     // now localize the vectors
     // add the vectors
@@ -134,9 +165,17 @@ MAST::TransientSolverBase::clear_assembly() {
         }
     }
     
+    _clear_local_quantities();
+    
     _assembly   = nullptr;
     _system     = nullptr;
     _first_step = true;
+    _prev_dt    = 0.;
+    _jacobian_dt = 0.;
+    _n_history  = 0;
+    _history_offset                  = 0;
+    _solution_history_offset         = 0;
+    _if_current_derivatives_outdated = false;
 }
 
 
@@ -146,13 +185,19 @@ libMesh::NumericVector<Real>&
 MAST::TransientSolverBase::solution(unsigned int prev_iter) const {
     
     // make sura that prev_iter is within acceptable bounds
-    libmesh_assert_less(prev_iter, _n_iters_to_store());
-    
-    // make sure that the vectors have been initialized
-    std::ostringstream oss;
-    oss << prev_iter;
+    libmesh_assert_less(prev_iter, _n_history);
     
     if (prev_iter) {
+        
+        // the previous solutions are stored in a ring buffer of
+        // n_iters-1 vectors, with names starting from index 1.
+        const unsigned int
+        n_iters = _n_history,
+        slot    = (prev_iter - 1 + _solution_history_offset) % (n_iters - 1) + 1;
+        
+        std::ostringstream oss;
+        oss << slot;
+        
         // get references to the solution
         std::string
         nm = "transient_solution_" + oss.str();
@@ -169,17 +214,14 @@ libMesh::NumericVector<Real>&
 MAST::TransientSolverBase::velocity(unsigned int prev_iter) const {
     
     // make sura that prev_iter is within acceptable bounds
-    libmesh_assert_less(prev_iter, _n_iters_to_store());
+    libmesh_assert_less(prev_iter, _n_history);
     
-    // make sure that the vectors have been initialized
-    std::ostringstream oss;
-    oss << prev_iter;
-    
-    // get references to the solution
-    std::string
-    nm = "transient_velocity_" + oss.str();
+    // after the time step has been advanced the current velocity is
+    // the same as the one at the previous iteration
+    if (!prev_iter && _if_current_derivatives_outdated)
+        prev_iter = 1;
     
-    return _system->get_vector(nm);
+    return _history_vector("transient_velocity_", prev_iter);
 }
 
 
@@ -188,17 +230,78 @@ libMesh::NumericVector<Real>&
 MAST::TransientSolverBase::acceleration(unsigned int prev_iter) const {
     
     // make sura that prev_iter is within acceptable bounds
-    libmesh_assert_less(prev_iter, _n_iters_to_store());
+    libmesh_assert_less(prev_iter, _n_history);
+    
+    // after the time step has been advanced the current acceleration is
+    // the same as the one at the previous iteration
+    if (!prev_iter && _if_current_derivatives_outdated)
+        prev_iter = 1;
+    
+    return _history_vector("transient_acceleration_", prev_iter);
+}
+
+
+
+libMesh::NumericVector<Real>&
+MAST::TransientSolverBase::_history_vector(const std::string& prefix,
+                                           unsigned int prev_iter) const {
+    
+    // make sure that the system has been specified
+    libmesh_assert(_system);
+    
+    const unsigned int
+    slot = (prev_iter + _history_offset) % _n_history;
     
-    // make sure that the vectors have been initialized
     std::ostringstream oss;
-    oss << prev_iter;
+    oss << slot;
+    
+    return _system->get_vector(prefix + oss.str());
+}
+
+
+
+libMesh::NumericVector<Real>&
+MAST::TransientSolverBase::_current_velocity() {
     
-    // get references to the solution
-    std::string
-    nm = "transient_acceleration_" + oss.str();
+    return _history_vector("transient_velocity_", 0);
+}
+
+
+
+libMesh::NumericVector<Real>&
+MAST::TransientSolverBase::_current_acceleration() {
     
-    return _system->get_vector(nm);
+    return _history_vector("transient_acceleration_", 0);
+}
+
+
+
+void
+MAST::TransientSolverBase::_rotate_history() {
+    
+    const unsigned int
+    n_iters = _n_history;
+    
+    // the velocity and acceleration vectors are stored in a ring buffer.
+    // Moving the offset back by one makes the current quantity the
+    // previous one, and the oldest vector is reused for the current
+    // time step. No data is copied.
+    _history_offset = (_history_offset + n_iters - 1) % n_iters;
+    
+    // the current solution is stored in the system solution, which is
+    // also the initial guess for the next time step. So, the older
+    // solutions are rotated and the current solution is copied to the
+    // most recent slot. This is a local copy without communication.
+    if (n_iters > 2)
+        _solution_history_offset =
+        (_solution_history_offset + n_iters - 2) % (n_iters - 1);
+    
+    this->solution(1) = *_system->solution;
+    
+    // until the next assembly the current derivatives are the same as
+    // the ones from the previous iteration
+    _if_current_derivatives_outdated = true;
+    _if_local_history_outdated       = true;
 }
 
 
@@ -219,6 +322,10 @@ MAST::TransientSolverBase::solve_highest_derivative_and_advance_time_step() {
     // reset the solution flag
     _if_highest_derivative_solution = false;
     
+    // the system matrix now holds the Jacobian for the highest
+    // derivative, which cannot be reused for the time steps
+    _jacobian_dt = 0.;
+    
     // The sensitivity problem is linear
     libMesh::LinearSolver<Real> * linear_solver = _system->get_linear_solver();
     
@@ -244,11 +351,11 @@ MAST::TransientSolverBase::solve_highest_derivative_and_advance_time_step() {
     switch (this->ode_order()) {
             
         case 1:
-            vec = &velocity();
+            vec = &_current_velocity();
             break;
             
         case 2:
-            vec = &acceleration();
+            vec = &_current_acceleration();
             break;
             
         default:
@@ -268,26 +375,13 @@ MAST::TransientSolverBase::solve_highest_derivative_and_advance_time_step() {
     
     // next, move all the solutions and velocities into older
     // time step locations
-    for (unsigned int i=_n_iters_to_store()-1; i>0; i--) {
-        this->solution(i).zero();
-        this->solution(i).add(1., this->solution(i-1));
-        this->solution(i).close();
-        
-        this->velocity(i).zero();
-        this->velocity(i).add(1., this->velocity(i-1));
-        this->velocity(i).close();
-        
-        if (this->ode_order() > 1) {
-            
-            this->acceleration(i).zero();
-            this->acceleration(i).add(1., this->acceleration(i-1));
-            this->acceleration(i).close();
-        }
-    }
+    _rotate_history();
     
-    // finally, update the system time
+    // finally, update the system time. This is not a time step, so
+    // there is no previous time step in the history.
     _system->time     += dt;
     _first_step        = false;
+    _prev_dt           = 0.;
 }
 
 
@@ -303,66 +397,60 @@ build_local_quantities(const libMesh::NumericVector<Real>& current_sol,
     // make sure there are no solutions in sol
     libmesh_assert(!sol.size());
 
-    // resize the vector to store the quantities
-    sol.resize(this->ode_order()+1);
+    _init_local_quantities();
     
     const std::vector<libMesh::dof_id_type>&
     send_list = _system->get_dof_map().get_send_list();
     
+    // the current solution is the only quantity that changes between
+    // residual evaluations in a time step, and is the only quantity
+    // exchanged here. The velocity and acceleration are computed by the
+    // solver on the element dofs from this and the previous iteration.
+    if (!_if_highest_derivative_solution)
+        current_sol.localize(*_local_solution, send_list);
+    else
+        solution().localize(*_local_solution, send_list);
 
-    for ( unsigned int i=0; i<=this->ode_order(); i++) {
+    // the quantities from the previous iteration are localized once per
+    // time step. For the highest derivative solution the quantities at
+    // the current iteration are used instead.
+    if (_if_local_history_outdated || _if_highest_derivative_solution) {
         
-        sol[i] = libMesh::NumericVector<Real>::build(_system->comm()).release();
-        sol[i]->init(_system->n_dofs(),
-                     _system->n_local_dofs(),
-                     send_list,
-                     false,
-                     libMesh::GHOSTED);
-
-        switch (i) {
-                
-            case 0: {
-                
-                if (!_if_highest_derivative_solution)
-                    // copy the solution to this
-                    current_sol.localize(*sol[i], send_list);
-                else
-                    solution().localize(*sol[i], send_list);
-            }
-                break;
-
-            case 1: {
-                
-                // update the current local velocity vector
-                libMesh::NumericVector<Real>& vel = this->velocity();
-
-                if (!_if_highest_derivative_solution)
-                    // calculate the velocity and localize it
-                    update_velocity(vel, current_sol);
-                
-                vel.localize(*sol[i], send_list);
-            }
-                break;
-
-            case 2: {
-                
-                // update the current local acceleration vector
-                libMesh::NumericVector<Real>& acc = this->acceleration();
-                
-                if (!_if_highest_derivative_solution)
-                    // calculate the acceleration and localize it
-                    update_acceleration(acc, current_sol);
-                
-                acc.localize(*sol[i], send_list);
+        const unsigned int
+        iter = _if_highest_derivative_solution?0:1;
+        
+        for ( unsigned int i=0; i<=this->ode_order(); i++) {
+            
+            switch (i) {
+                    
+                case 0:
+                    solution(iter).localize(*_local_history[i], send_list);
+                    break;
+                    
+                case 1:
+                    _history_vector("transient_velocity_", iter).localize
+                    (*_local_history[i], send_list);
+                    break;
+                    
+                case 2:
+                    _history_vector("transient_acceleration_", iter).localize
+                    (*_local_history[i], send_list);
+                    break;
+                    
+                default:
+                    // should not get here
+                    libmesh_error();
+                    break;
             }
-                break;
-
-            default:
-                // should not get here
-                libmesh_error();
-                break;
         }
+        
+        _if_local_history_outdated = _if_highest_derivative_solution;
     }
+    
+    sol.resize(this->ode_order()+2);
+    sol[0] = _local_solution;
+    for ( unsigned int i=0; i<=this->ode_order(); i++)
+        sol[i+1] = _local_history[i];
 }
 
 
@@ -379,112 +467,196 @@ build_perturbed_local_quantities(const libMesh::NumericVector<Real>& current_dso
     // make sure there are no solutions in sol
     libmesh_assert(!sol.size());
     
-    // resize the vector to store the quantities
-    sol.resize(this->ode_order()+1);
+    _init_local_quantities();
     
     const std::vector<libMesh::dof_id_type>&
     send_list = _system->get_dof_map().get_send_list();
     
+    // the perturbation in velocity and acceleration are linear in the
+    // perturbation in solution, and are computed by the solver on the
+    // element dofs.
+    current_dsol.localize(*_local_perturbed_solution, send_list);
     
-    std::auto_ptr<libMesh::NumericVector<Real> >
-    tmp(this->solution().zero_clone().release());
+    sol.resize(1);
+    sol[0] = _local_perturbed_solution;
+}
+
+
+
+
+void
+MAST::TransientSolverBase::_init_local_quantities() {
+    
+    // nothing to be done if the vectors are consistent with the system
+    if (_local_solution &&
+        _local_solution->size()       == _system->n_dofs() &&
+        _local_solution->local_size() == _system->n_local_dofs())
+        return;
+    
+    _clear_local_quantities();
     
-    for ( unsigned int i=0; i<=this->ode_order(); i++) {
+    const std::vector<libMesh::dof_id_type>&
+    send_list = _system->get_dof_map().get_send_list();
+    
+    _local_history.resize(this->ode_order()+1, nullptr);
+    
+    for ( unsigned int i=0; i<this->ode_order()+3; i++) {
         
-        sol[i] = libMesh::NumericVector<Real>::build(_system->comm()).release();
-        sol[i]->init(_system->n_dofs(),
-                     _system->n_local_dofs(),
-                     send_list,
-                     false,
-                     libMesh::GHOSTED);
+        libMesh::NumericVector<Real>*
+        vec = libMesh::NumericVector<Real>::build(_system->comm()).release();
+        vec->init(_system->n_dofs(),
+                  _system->n_local_dofs(),
+                  send_list,
+                  false,
+                  libMesh::GHOSTED);
         
-        switch (i) {
-                
-            case 0: {
-                
-                current_dsol.localize(*sol[i], send_list);
-                if (_if_highest_derivative_solution)
-                    // only the highest derivative is perturbed since
-                    // all lower derivative quantities are known
-                    sol[i]->zero();
-            }
-                break;
-                
-            case 1: {
-                
-                if (ode_order() == 1 && _if_highest_derivative_solution)
-                    // the provided solution is the current velocity increment
-                    current_dsol.localize(*sol[i], send_list);
-                else if (_if_highest_derivative_solution)
-                    sol[i]->zero();
-                else {
-                    update_delta_velocity(*tmp, current_dsol);
-                    tmp->localize(*sol[i], send_list);
-                }
-            }
-                break;
-                
-            case 2: {
-                
-                if (ode_order() == 2 && _if_highest_derivative_solution)
-                    // the provided solution is the current velocity increment
-                    current_dsol.localize(*sol[i], send_list);
-                else if (_if_highest_derivative_solution)
-                    sol[i]->zero();
-                else {
-                    update_delta_acceleration(*tmp, current_dsol);
-                    tmp->localize(*sol[i], send_list);
-                }
-            }
-                break;
-                
-            default:
-                // should not get here
-                libmesh_error();
-                break;
-        }
+        if (i == 0)
+            _local_solution           = vec;
+        else if (i == 1)
+            _local_perturbed_solution = vec;
+        else
+            _local_history[i-2]       = vec;
     }
+    
+    _if_local_history_outdated = true;
 }
 
 
 
+void
+MAST::TransientSolverBase::_clear_local_quantities() {
+    
+    if (_local_solution)           delete _local_solution;
+    if (_local_perturbed_solution) delete _local_perturbed_solution;
+    
+    for (unsigned int i=0; i<_local_history.size(); i++)
+        delete _local_history[i];
+    
+    _local_solution            = nullptr;
+    _local_perturbed_solution  = nullptr;
+    _local_history.clear();
+    _if_local_history_outdated = true;
+}
+
+
+
+void
+MAST::TransientSolverBase::_update_current_derivatives() {
+    
+    update_velocity(_current_velocity(), *_system->solution);
+
+    if (this->ode_order() > 1)
+        update_acceleration(_current_acceleration(), *_system->solution);
+    
+    _if_current_derivatives_outdated = false;
+}
+
+
+
+
+void
+MAST::TransientSolverBase::_update_jacobian_lagging() {
+    
+    MAST::JacobianLaggingPolicy*
+    lagging = _system->jacobian_lagging_policy();
+    
+    // the effective Jacobian is scaled by the time step, so the matrix
+    // from an earlier step can be reused only if the time step is the same
+    if (lagging && dt != _jacobian_dt)
+        lagging->discard_jacobian();
+    
+    _jacobian_dt = dt;
+}
+
+
 
 void
 MAST::TransientSolverBase::advance_time_step() {
 
     // first ask the solver to update the velocity and acceleration vector
-    update_velocity(this->velocity(), *_system->solution);
-
-    if (this->ode_order() > 1)
-        update_acceleration(this->acceleration(), *_system->solution);
+    _update_current_derivatives();
 
     // next, move all the solutions and velocities into older
     // time step locations
-    for (unsigned int i=_n_iters_to_store()-1; i>0; i--) {
-        this->solution(i).zero();
-        this->solution(i).add(1., this->solution(i-1));
-        this->solution(i).close();
-        
-        this->velocity(i).zero();
-        this->velocity(i).add(1., this->velocity(i-1));
-        this->velocity(i).close();
-        
-        if (this->ode_order() > 1) {
-            
-            this->acceleration(i).zero();
-            this->acceleration(i).add(1., this->acceleration(i-1));
-            this->acceleration(i).close();
-        }
-    }
+    _rotate_history();
 
-    // and localize solution so that if the user calls the solution and
-    // velocity routines,
-    
     // finally, update the system time
     _system->time     += dt;
     _first_step        = false;
+    _prev_dt           = dt;
 }
 
 
 
+Real
+MAST::TransientSolverBase::solve_and_advance_adaptive_time_step() {
+    
+    // make sure that the system has been specified
+    libmesh_assert_msg(_system, "System pointer is nullptr.");
+    
+    // the highest derivative at the initial time should have been
+    // computed before the adaptive stepping is used, since the error
+    // estimates use the derivative history.
+    libmesh_assert(!_first_step);
+    
+    unsigned int
+    n_rejected = 0;
+    
+    Real
+    order      = 0.,
+    err        = 0.,
+    fac        = 1.;
+    
+    while (true) {
+        
+        this->solve();
+        
+        err = this->_local_truncation_error_estimate(order);
+        
+        // no estimate is available for this step, so it is accepted
+        // without changing the time step
+        if (err < 0.) {
+            
+            fac = 1.;
+            break;
+        }
+        
+        // factor by which the time step should be changed to bring the
+        // error estimate to the tolerance
+        if (err > 0.)
+            fac = dt_safety_factor * std::pow(error_tolerance/err, 1./order);
+        else
+            fac = max_dt_growth;
+        
+        fac = std::max(min_dt_reduction, std::min(max_dt_growth, fac));
+        
+        if (err <= error_tolerance         ||
+            dt  <= min_dt                  ||
+            n_rejected >= max_rejected_steps)
+            break;
+        
+        // reject the step and repeat from the previous solution with a
+        // smaller time step
+        n_rejected++;
+        _n_rejected_steps++;
+        dt = std::max(min_dt, fac*dt);
+        
+        *_system->solution = this->solution(1);
+        _system->solution->close();
+        _system->update();
+    }
+    
+    const Real
+    dt_accepted = dt;
+    
+    this->advance_time_step();
+    
+    // update the time step for the next step. Small changes are ignored
+    // to avoid oscillations in the time step when the error is close to
+    // the tolerance.
+    if (std::fabs(fac - 1.) > dt_hysteresis)
+        dt = std::max(min_dt, std::min(max_dt, fac*dt));
+    
+    return dt_accepted;
+}
 
@@ -59,6 +59,49 @@ namespace MAST {
          */
         Real dt;
 
+        /*!
+         *   tolerance on the local truncation error estimate, relative to
+         *   the norm of the solution, used by the adaptive time step
+         *   controller in solve_and_advance_adaptive_time_step().
+         */
+        Real error_tolerance;
+
+        /*!
+         *   lower and upper bounds on the time step chosen by the adaptive
+         *   controller.
+         */
+        Real min_dt, max_dt;
+
+        /*!
+         *   safety factor applied to the time step predicted from the
+         *   local truncation error estimate.
+         */
+        Real dt_safety_factor;
+
+        /*!
+         *   bounds on the factor by which the adaptive controller can
+         *   change the time step in a single step.
+         */
+        Real max_dt_growth, min_dt_reduction;
+
+        /*!
+         *   relative changes in the time step smaller than this value are
+         *   ignored after an accepted step. This avoids small oscillations
+         *   in the time step when the error is close to the tolerance.
+         *   The effective Jacobian depends on the time step. If a
+         *   MAST::JacobianLaggingPolicy with \p reuse_across_solves is
+         *   attached to the system, the Jacobian assembled in an earlier
+         *   step is reused while the time step is unchanged, and is
+         *   assembled again when the time step changes.
+         */
+        Real dt_hysteresis;
+
+        /*!
+         *   maximum number of times a single step will be rejected and
+         *   repeated with a smaller time step.
+         */
+        unsigned int max_rejected_steps;
+
         /*!
          *    @returns the highest order time derivative that the solver 
          *    will handle
@@ -149,10 +192,36 @@ namespace MAST {
          */
         virtual void advance_time_step();
 
+
+        /*!
+         *   solves the current time step and estimates its local truncation
+         *   error. If the error is larger than \p error_tolerance the step
+         *   is rejected and repeated with a smaller \p dt. Once a step is
+         *   accepted the time step is advanced, and \p dt is updated for
+         *   the next step based on the error estimate.
+         *   @returns the time step used for the accepted step.
+         */
+        Real solve_and_advance_adaptive_time_step();
+
+
+        /*!
+         *   @returns the total number of steps rejected by the adaptive
+         *   time step controller.
+         */
+        unsigned int n_rejected_steps() const {
+            return _n_rejected_steps;
+        }
+
         
         /*!
-         *    localizes the relevant solutions for system assembly. The
-         *    calling function has to delete the pointers to these vectors
+         *    localizes the relevant solutions for system assembly. Upon
+         *    return, \p qtys contains the localized current solution,
+         *    followed by the localized solution, velocity and acceleration
+         *    (for second order) from the previous iteration. Only the
+         *    current solution is communicated in each call, and the
+         *    solver computes the time derivatives on the element dofs
+         *    from these quantities. The vectors are owned by this solver
+         *    and must not be deleted by the calling function.
          */
         virtual void
         build_local_quantities(const libMesh::NumericVector<Real>& current_sol,
@@ -163,8 +232,11 @@ namespace MAST {
          *    assembly. 
          *    \param current_sol  the perturbation in current displacement 
          *    \f$ \Delta X \f$
-         *    \param qtys upon returning, this vector is populated such that the
-         *    ith element of the vector is \f$ (d (d^iX/dt^i)/ dX) dX \Delta X$
+         *    \param qtys upon returning, this vector contains the localized
+         *    \f$ \Delta X \f$. The perturbations in the time derivatives,
+         *    \f$ (d (d^iX/dt^i)/ dX) \Delta X \f$, are computed by the
+         *    solver on the element dofs. The vector is owned by this solver
+         *    and must not be deleted by the calling function.
          */
         virtual void
         build_perturbed_local_quantities
@@ -191,6 +263,18 @@ namespace MAST {
          */
         virtual unsigned int _n_iters_to_store() const = 0;
         
+        /*!
+         *    @returns the norm of the local truncation error estimate for
+         *    the current time step, relative to the norm of the solution.
+         *    This is computed from the stored velocity/acceleration history
+         *    after the current solution has been obtained. \p order is set
+         *    to the power of \p dt with which the estimate scales. A
+         *    negative value is returned if the history does not allow an
+         *    estimate, in which case the step is accepted without changing
+         *    \p dt.
+         */
+        virtual Real _local_truncation_error_estimate(Real& order) = 0;
+        
         /*!
          *    provides the element with the transient data for calculations
          */
@@ -263,6 +347,128 @@ namespace MAST {
          */
         bool   _if_highest_derivative_solution;
 
+        /*!
+         *    number of steps rejected by the adaptive time step controller
+         */
+        unsigned int _n_rejected_steps;
+
+        /*!
+         *    time step used for the last step advanced by
+         *    advance_time_step(). This is zero if no step has been taken
+         *    since the initial condition.
+         */
+        Real _prev_dt;
+        
+        /*!
+         *    time step for which the Jacobian in the system matrix was
+         *    assembled. This is zero if the matrix does not hold the
+         *    Jacobian of a time step.
+         */
+        Real _jacobian_dt;
+        
+        /*!
+         *    number of time steps in the history, set from
+         *    _n_iters_to_store() when the assembly is attached.
+         */
+        unsigned int _n_history;
+        
+        /*!
+         *    asks the Jacobian lagging policy of the system, if one is
+         *    attached, to assemble the Jacobian again if the time step has
+         *    changed since the last assembly. This is called by solve()
+         *    before the system is solved.
+         */
+        void _update_jacobian_lagging();
+        
+        /*!
+         *    @returns a reference to the vector stored in the system with
+         *    name \p prefix followed by the ring buffer index of
+         *    \p prev_iter.
+         */
+        libMesh::NumericVector<Real>&
+        _history_vector(const std::string& prefix,
+                        unsigned int prev_iter) const;
+        
+        /*!
+         *    @returns a reference to the vector used to store the velocity
+         *    at the current time step. Unlike velocity(), this does not
+         *    return the previous velocity after the time step has been
+         *    advanced, and should be used to update the current velocity.
+         */
+        libMesh::NumericVector<Real>& _current_velocity();
+        
+        /*!
+         *    @returns a reference to the vector used to store the
+         *    acceleration at the current time step.
+         */
+        libMesh::NumericVector<Real>& _current_acceleration();
+        
+        /*!
+         *    moves the current solution, velocity and acceleration to the
+         *    previous iteration locations by rotating the ring buffer
+         *    indices.
+         */
+        void _rotate_history();
+        
+        /*!
+         *    offset of the ring buffer index of the current iteration for
+         *    velocity and acceleration vectors.
+         */
+        unsigned int _history_offset;
+        
+        /*!
+         *    offset of the ring buffer index for the previous solutions.
+         */
+        unsigned int _solution_history_offset;
+        
+        /*!
+         *    flag is true after the time step has been advanced and before
+         *    the velocity and acceleration for the new time step have been
+         *    computed.
+         */
+        bool _if_current_derivatives_outdated;
+        
+        /*!
+         *    updates the current velocity and acceleration vectors from
+         *    the current system solution.
+         */
+        void _update_current_derivatives();
+        
+        /*!
+         *    initializes the ghosted vectors used to store the localized
+         *    quantities for assembly, if they have not been initialized or
+         *    are inconsistent with the system.
+         */
+        void _init_local_quantities();
+        
+        /*!
+         *    deletes the ghosted vectors used to store the localized
+         *    quantities for assembly.
+         */
+        void _clear_local_quantities();
+        
+        /*!
+         *    ghosted vector used to store the localized current solution
+         */
+        libMesh::NumericVector<Real>* _local_solution;
+        
+        /*!
+         *    ghosted vector used to store the localized perturbation in
+         *    the current solution
+         */
+        libMesh::NumericVector<Real>* _local_perturbed_solution;
+        
+        /*!
+         *    ghosted vectors used to store the localized solution, velocity
+         *    and acceleration from the previous iteration
+         */
+        std::vector<libMesh::NumericVector<Real>*> _local_history;
+        
+        /*!
+         *    flag is true if \p _local_history needs to be localized from
+         *    the system vectors before the next assembly.
+         */
+        bool _if_local_history_outdated;
     };
 
 }
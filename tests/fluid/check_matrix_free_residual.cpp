@@ -0,0 +1,112 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2017  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+// BOOST includes
+#include <boost/test/unit_test.hpp>
+
+// MAST includes
+#include "tests/fluid/build_conservative_fluid_elem.h"
+#include "tests/base/test_comparisons.h"
+#include "fluid/conservative_fluid_element_base.h"
+#include "fluid/conservative_fluid_discipline.h"
+#include "fluid/conservative_fluid_system_initialization.h"
+#include "fluid/flight_condition.h"
+
+
+BOOST_FIXTURE_TEST_SUITE  (MatrixFreeResidualEvaluation, MAST::BuildConservativeFluidElem)
+
+
+BOOST_AUTO_TEST_CASE   (MatrixFreeInternalResidual) {
+    
+    // make sure there is only one element in the mesh.
+    libmesh_assert_equal_to(_mesh->n_elem(), 1);
+    libMesh::Elem& e = **_mesh->local_elements_begin();
+    
+    const MAST::FlightCondition& p =
+    dynamic_cast<MAST::ConservativeFluidDiscipline*>(_discipline)->flight_condition();
+    
+    std::auto_ptr<MAST::ConservativeFluidElementBase>
+    elem(new MAST::ConservativeFluidElementBase(*_fluid_sys, e, p));
+    
+    const Real
+    tol      = 1.e-8;
+    
+    // number of dofs in this element
+    const unsigned int ndofs = 16;
+    
+    RealVectorX
+    x_base      = RealVectorX::Zero(ndofs),
+    dx          = RealVectorX::Zero(ndofs),
+    res0        = RealVectorX::Zero(ndofs),
+    res         = RealVectorX::Zero(ndofs),
+    jac_dx      = RealVectorX::Zero(ndofs);
+    
+    RealMatrixX
+    jac_x       = RealMatrixX::Zero(ndofs, ndofs),
+    dummy;
+    
+    // initialize the base solution vector with a perturbation, so that
+    // the stabilization and discontinuity capturing terms are nonzero.
+    // The 2D elem has 4 variables
+    for (unsigned int i=0; i<4; i++) {
+        for (unsigned int j=0; j<4; j++) {
+            x_base(i*4+j) = _base_sol(i) * (1. + 0.05 * j);
+            dx(i*4+j)     = 1.e-2 * _base_sol(i) * (1. + i + 0.5 * j);
+        }
+    }
+    elem->set_solution(x_base);
+    elem->set_perturbed_solution(dx);
+    elem->set_velocity(RealVectorX::Zero(ndofs));
+    
+    // residual and Jacobian from the dense evaluation
+    elem->internal_residual(true, res0, jac_x);
+    
+    // residual from the matrix-free evaluation
+    elem->internal_residual(false, res, dummy);
+    
+    BOOST_TEST_MESSAGE("** Checking matrix-free residual **");
+    BOOST_CHECK(MAST::compare_vector(res0, res, tol));
+    
+    // Jacobian-vector product from the matrix-free evaluation
+    elem->linearized_internal_residual(false, jac_dx, dummy);
+    
+    BOOST_TEST_MESSAGE("** Checking matrix-free Jacobian-vector product **");
+    BOOST_CHECK(MAST::compare_vector(jac_x * dx, jac_dx, tol));
+    
+    // the frozen-coefficient Jacobian does not change the residual or the
+    // Jacobian-vector product
+    elem->set_frozen_coefficient_jacobian(true);
+    
+    res0.setZero();
+    jac_x.setZero();
+    elem->internal_residual(true, res0, jac_x);
+    
+    BOOST_TEST_MESSAGE("** Checking residual with frozen-coefficient Jacobian **");
+    BOOST_CHECK(MAST::compare_vector(res, res0, tol));
+    
+    res0.setZero();
+    elem->linearized_internal_residual(false, res0, dummy);
+    
+    BOOST_TEST_MESSAGE("** Checking Jacobian-vector product with frozen-coefficient Jacobian **");
+    BOOST_CHECK(MAST::compare_vector(jac_dx, res0, tol));
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
+
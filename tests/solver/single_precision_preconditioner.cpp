@@ -0,0 +1,159 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2017  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+
+// BOOST includes
+#include <boost/test/unit_test.hpp>
+
+
+// MAST includes
+#include "tests/base/test_comparisons.h"
+#include "solver/single_precision_preconditioner.h"
+
+
+
+struct BuildSinglePrecisionPreconditioner {
+    
+    BuildSinglePrecisionPreconditioner():
+    n  (6) {
+        
+        // a dense symmetric positive definite matrix
+        RealMatrixX
+        m   = RealMatrixX::Zero(n, n);
+        for (unsigned int i=0; i<n; i++)
+            for (unsigned int j=0; j<n; j++)
+                m(i,j) = sin(1.+i+2.*j);
+        
+        dense = m.transpose() * m + n * RealMatrixX::Identity(n, n);
+        
+        // a tridiagonal symmetric positive definite matrix
+        tridiagonal = 4. * RealMatrixX::Identity(n, n);
+        for (unsigned int i=0; i<n-1; i++) {
+            tridiagonal(i, i+1) = -1.;
+            tridiagonal(i+1, i) = -1.;
+        }
+        
+        rhs = RealVectorX::Zero(n);
+        for (unsigned int i=0; i<n; i++)
+            rhs(i) = cos(1.+i);
+    }
+    
+    
+    /*!
+     *   factors the nonzero entries of \p a with the preconditioner and
+     *   returns the application of the preconditioner to \p rhs in \p y
+     */
+    void apply(const RealMatrixX& a, RealVectorX& y) {
+        
+        PetscErrorCode ierr;
+        Mat            mat;
+        Vec            x, z;
+        PetscScalar   *vals = PETSC_NULL;
+        
+        ierr = MatCreateSeqAIJ(PETSC_COMM_SELF, n, n, n, PETSC_NULL, &mat);
+        CHKERRABORT(PETSC_COMM_SELF, ierr);
+        
+        for (unsigned int i=0; i<n; i++)
+            for (unsigned int j=0; j<n; j++)
+                if (a(i,j) != 0.) {
+                    ierr = MatSetValue(mat, i, j, a(i,j), INSERT_VALUES);
+                    CHKERRABORT(PETSC_COMM_SELF, ierr);
+                }
+        
+        ierr = MatAssemblyBegin(mat, MAT_FINAL_ASSEMBLY);  CHKERRABORT(PETSC_COMM_SELF, ierr);
+        ierr = MatAssemblyEnd(mat, MAT_FINAL_ASSEMBLY);    CHKERRABORT(PETSC_COMM_SELF, ierr);
+        
+        ierr = VecCreateSeq(PETSC_COMM_SELF, n, &x);       CHKERRABORT(PETSC_COMM_SELF, ierr);
+        ierr = VecDuplicate(x, &z);                        CHKERRABORT(PETSC_COMM_SELF, ierr);
+        
+        ierr = VecGetArray(x, &vals);                      CHKERRABORT(PETSC_COMM_SELF, ierr);
+        for (unsigned int i=0; i<n; i++)
+            vals[i] = rhs(i);
+        ierr = VecRestoreArray(x, &vals);                  CHKERRABORT(PETSC_COMM_SELF, ierr);
+        
+        MAST::SinglePrecisionPreconditioner pc;
+        pc.init(mat);
+        pc.apply(x, z);
+        
+        y = RealVectorX::Zero(n);
+        ierr = VecGetArray(z, &vals);                      CHKERRABORT(PETSC_COMM_SELF, ierr);
+        for (unsigned int i=0; i<n; i++)
+            y(i) = vals[i];
+        ierr = VecRestoreArray(z, &vals);                  CHKERRABORT(PETSC_COMM_SELF, ierr);
+        
+        ierr = VecDestroy(&x);                             CHKERRABORT(PETSC_COMM_SELF, ierr);
+        ierr = VecDestroy(&z);                             CHKERRABORT(PETSC_COMM_SELF, ierr);
+        ierr = MatDestroy(&mat);                           CHKERRABORT(PETSC_COMM_SELF, ierr);
+    }
+    
+    
+    const unsigned int n;
+    
+    RealMatrixX
+    dense,
+    tridiagonal;
+    
+    RealVectorX
+    rhs;
+};
+
+
+
+BOOST_FIXTURE_TEST_SUITE  (SinglePrecisionILU0,
+                           BuildSinglePrecisionPreconditioner)
+
+
+BOOST_AUTO_TEST_CASE   (DenseMatrixSolve) {
+    
+    // ILU(0) of a matrix without zero entries is the complete LU
+    // factorization, so that the preconditioner is the inverse of the
+    // matrix up to the precision of the factors.
+    const Real
+    tol  = 1.e-4;
+    
+    RealVectorX
+    y,
+    y0   = dense.partialPivLu().solve(rhs);
+    
+    apply(dense, y);
+    
+    BOOST_CHECK(MAST::compare_vector(y0, y, tol));
+}
+
+
+
+BOOST_AUTO_TEST_CASE   (TridiagonalMatrixSolve) {
+    
+    // the LU factors of a tridiagonal matrix have no fill, so that
+    // ILU(0) is again exact in the sparsity of the matrix
+    const Real
+    tol  = 1.e-4;
+    
+    RealVectorX
+    y,
+    y0   = tridiagonal.partialPivLu().solve(rhs);
+    
+    apply(tridiagonal, y);
+    
+    BOOST_CHECK(MAST::compare_vector(y0, y, tol));
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
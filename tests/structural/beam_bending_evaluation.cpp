@@ -26,6 +26,14 @@
 #include "examples/structural/beam_bending/beam_bending.h"
 #include "tests/base/check_sensitivity.h"
 #include "base/nonlinear_system.h"
+#include "solver/jacobian_lagging_policy.h"
+#include "solver/reduced_basis_static_surrogate.h"
+#include "elasticity/structural_nonlinear_assembly.h"
+#include "base/parameter.h"
+
+
+// libMesh includes
+#include "libmesh/numeric_vector.h"
 
 
 BOOST_FIXTURE_TEST_SUITE  (Structural1DBeamBending,
@@ -143,5 +151,90 @@ BOOST_AUTO_TEST_CASE   (BeamBendingSensitivity) {
 }
 
 
+BOOST_AUTO_TEST_CASE   (BeamBendingLaggedJacobianSolution) {
+    
+    // the von Karman strain makes this problem nonlinear
+    this->init(libMesh::EDGE2, true);
+    
+    // reference solution with the Jacobian assembled at every iteration
+    this->solve();
+    
+    std::auto_ptr<libMesh::NumericVector<Real> >
+    sol0(_sys->solution->clone().release());
+    
+    // solve again with the Jacobian reused for up to two iterations. The
+    // Jacobian is assembled again only if the residual grows.
+    MAST::JacobianLaggingPolicy lagging;
+    lagging.max_lagged_iterations         = 2;
+    lagging.residual_reduction_threshold  = 1.;
+    _sys->set_jacobian_lagging_policy(&lagging);
+    
+    this->solve();
+    
+    _sys->set_jacobian_lagging_policy(nullptr);
+    
+    BOOST_CHECK_GT(lagging.n_jacobian_reuses(),    0);
+    BOOST_CHECK_GT(lagging.n_jacobian_assemblies(), 0);
+    
+    // the lagged Newton iterations should converge to the same solution
+    std::auto_ptr<libMesh::NumericVector<Real> >
+    dsol(_sys->solution->clone().release());
+    dsol->add(-1., *sol0);
+    dsol->close();
+    
+    BOOST_CHECK_LE(dsol->l2_norm(), 1.e-5 * sol0->l2_norm());
+}
+
+
+BOOST_AUTO_TEST_CASE   (BeamBendingReducedBasisSensitivity) {
+    
+    this->init(libMesh::EDGE2, false);
+    
+    const Real
+    th0      = (*_thy)();
+    
+    MAST::StructuralNonlinearAssembly   assembly;
+    assembly.attach_discipline_and_system(*_discipline, *_structural_sys);
+    
+    // the thickness enters the bending stiffness cubically and the
+    // torsional constant with a quartic term
+    MAST::ReducedBasisStaticSurrogate rb(*_sys, assembly);
+    rb.add_parameter(*_thy, 0.1*th0);
+    rb.set_polynomial_order(4);
+    rb.set_error_tolerance(1.e-4);
+    
+    BOOST_CHECK(!rb.solve());
+    (*_thy)() = 1.1*th0;
+    BOOST_CHECK(!rb.solve());
+    (*_thy)() = th0;
+    
+    rb.build();
+    
+    // reduced solution and sensitivity at a new thickness
+    (*_thy)() = 1.05*th0;
+    BOOST_REQUIRE(rb.solve());
+    
+    std::auto_ptr<libMesh::NumericVector<Real> >
+    dsol_rb(_sys->solution->zero_clone().release());
+    
+    BOOST_REQUIRE(rb.sensitivity_solve(*_thy, dsol_rb.get()));
+    BOOST_CHECK_LE(rb.sensitivity_error_estimate(), 1.e-4);
+    
+    assembly.clear_discipline_and_system();
+    
+    // full-order sensitivity about the full-order solution
+    this->solve();
+    this->sensitivity_solve(*_thy);
+    
+    const libMesh::NumericVector<Real>&
+    dsol = _sys->get_sensitivity_solution(0);
+    
+    dsol_rb->add(-1., dsol);
+    dsol_rb->close();
+    
+    BOOST_CHECK_LE(dsol_rb->l2_norm(), 1.e-3 * dsol.l2_norm());
+}
+
+
 BOOST_AUTO_TEST_SUITE_END()
 
@@ -33,6 +33,8 @@
 #include "property_cards/isotropic_material_property_card.h"
 #include "elasticity/structural_element_base.h"
 #include "base/nonlinear_system.h"
+#include "elasticity/structural_modal_eigenproblem_assembly.h"
+#include "solver/reduced_basis_modal_surrogate.h"
 
 
 BOOST_FIXTURE_TEST_SUITE  (Structural1DBeamModalAnalysis,
@@ -155,6 +157,121 @@ BOOST_AUTO_TEST_CASE    (BeamModalSolutionSensitivity) {
     }
 }
 
+BOOST_AUTO_TEST_CASE    (BeamModalReducedBasis) {
+    
+    this->init(libMesh::EDGE2, false);
+    
+    const Real
+    tol      = 1.e-6;
+    
+    const unsigned int
+    n_modes  = _sys->get_n_requested_eigenvalues();
+    
+    MAST::StructuralModalEigenproblemAssembly   assembly;
+    _sys->initialize_condensed_dofs(*_discipline);
+    assembly.attach_discipline_and_system(*_discipline, *_structural_sys);
+    
+    MAST::ReducedBasisModalSurrogate rb(*_sys);
+    rb.add_parameter(*_E,   0.2*(*_E)());
+    rb.add_parameter(*_rho, 0.2*(*_rho)());
+    rb.set_error_tolerance(1.e-4);
+    
+    // the surrogate solves the full-order eigenproblem before it is
+    // built, and keeps the eigenvectors as snapshots
+    BOOST_CHECK(!rb.solve(n_modes));
+    BOOST_CHECK_EQUAL(rb.n_new_snapshots(), n_modes);
+    
+    rb.build();
+    BOOST_CHECK_EQUAL(rb.n_basis(), n_modes);
+    
+    // the modes do not change with the modulus and density, so that the
+    // reduced eigenproblem gives the full-order eigenvalues
+    (*_E)()   *= 1.3;
+    (*_rho)() *= 0.9;
+    
+    BOOST_CHECK(rb.solve(n_modes));
+    BOOST_CHECK_LE(rb.error_estimate(), 1.e-4);
+    
+    RealVectorX
+    eig_rb   = RealVectorX::Zero(n_modes),
+    eig      = RealVectorX::Zero(n_modes);
+    for (unsigned int i=0; i<n_modes; i++) eig_rb(i) = rb.eigenvalue(i);
+    
+    assembly.clear_discipline_and_system();
+    
+    std::vector<Real>
+    eig_vec;
+    this->solve(false, &eig_vec);
+    
+    BOOST_REQUIRE_EQUAL(eig_vec.size(), n_modes);
+    for (unsigned int i=0; i<n_modes; i++) eig(i) = eig_vec[i];
+    
+    BOOST_CHECK(MAST::compare_vector(eig, eig_rb, tol));
+}
+
+
+
+BOOST_AUTO_TEST_CASE    (BeamModalReducedBasisThickness) {
+    
+    this->init(libMesh::EDGE2, false);
+    
+    const Real
+    tol      = 1.e-4;
+    
+    const unsigned int
+    n_modes  = _sys->get_n_requested_eigenvalues();
+    
+    MAST::StructuralModalEigenproblemAssembly   assembly;
+    _sys->initialize_condensed_dofs(*_discipline);
+    assembly.attach_discipline_and_system(*_discipline, *_structural_sys);
+    
+    // the section thickness enters the stiffness through the area, the
+    // cubic moment of inertia and the torsional constant, which has a
+    // quartic term in the thickness and a negligible term of eighth
+    // order, and the mass through the area and polar inertia. The
+    // decomposition of fourth order reproduces these within the
+    // tolerance of the check in build().
+    MAST::ReducedBasisModalSurrogate rb(*_sys);
+    rb.add_parameter(*_thy, 0.1*(*_thy)());
+    rb.set_polynomial_order(4);
+    rb.set_error_tolerance(1.e-4);
+    
+    BOOST_CHECK(!rb.solve(n_modes));
+    
+    // a second snapshot at a different thickness, so that the basis is
+    // not made only of the modes at the reference thickness
+    const Real
+    th0      = (*_thy)();
+    
+    (*_thy)() = 1.1*th0;
+    BOOST_CHECK(!rb.solve(n_modes));
+    (*_thy)() = th0;
+    
+    rb.build();
+    
+    (*_thy)() = 1.05*th0;
+    
+    BOOST_CHECK(rb.solve(n_modes));
+    BOOST_CHECK_LE(rb.error_estimate(), 1.e-4);
+    
+    RealVectorX
+    eig_rb   = RealVectorX::Zero(n_modes),
+    eig      = RealVectorX::Zero(n_modes);
+    for (unsigned int i=0; i<n_modes; i++) eig_rb(i) = rb.eigenvalue(i);
+    
+    assembly.clear_discipline_and_system();
+    
+    std::vector<Real>
+    eig_vec;
+    this->solve(false, &eig_vec);
+    
+    BOOST_REQUIRE_EQUAL(eig_vec.size(), n_modes);
+    for (unsigned int i=0; i<n_modes; i++) eig(i) = eig_vec[i];
+    
+    BOOST_CHECK(MAST::compare_vector(eig, eig_rb, tol));
+}
+
+
 BOOST_AUTO_TEST_SUITE_END()
 
 
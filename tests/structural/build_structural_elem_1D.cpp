@@ -44,6 +44,7 @@ _discipline(nullptr),
 _thy(nullptr),
 _thz(nullptr),
 _E(nullptr),
+_rho(nullptr),
 _nu(nullptr),
 _hy_off(nullptr),
 _hz_off(nullptr),
@@ -53,6 +54,7 @@ _alpha(nullptr),
 _thy_f(nullptr),
 _thz_f(nullptr),
 _E_f(nullptr),
+_rho_f(nullptr),
 _nu_f(nullptr),
 _hyoff_f(nullptr),
 _hzoff_f(nullptr),
@@ -69,7 +71,8 @@ _thermal_load(nullptr) {
 
 void
 MAST::BuildStructural1DElem::init(bool if_link_offset_to_th,
-                                  bool if_nonlinear) {
+                                  bool if_nonlinear,
+                                  libMesh::ElemType e_type) {
 
     // make sure that this has not already been initialized
     libmesh_assert(!_initialized);
@@ -78,7 +81,7 @@ MAST::BuildStructural1DElem::init(bool if_link_offset_to_th,
     _mesh       = new libMesh::SerialMesh(__init->comm());
     
     // initialize the mesh with one element
-    libMesh::MeshTools::Generation::build_line(*_mesh, 1, 0, 2);
+    libMesh::MeshTools::Generation::build_line(*_mesh, 1, 0, 2, e_type);
     
     // create the equation system
     _eq_sys    = new  libMesh::EquationSystems(*_mesh);
@@ -86,8 +89,11 @@ MAST::BuildStructural1DElem::init(bool if_link_offset_to_th,
     // create the libmesh system
     _sys       = &(_eq_sys->add_system<MAST::NonlinearSystem>("structural"));
     
-    // FEType to initialize the system
-    libMesh::FEType fetype (libMesh::FIRST, libMesh::LAGRANGE);
+    // FEType to initialize the system. The order follows the element
+    // type, so that the higher-order elements are not run with
+    // linear shape functions.
+    libMesh::FEType fetype ((*_mesh->elements_begin())->default_order(),
+                            libMesh::LAGRANGE);
     
     // initialize the system to the right set of variables
     _structural_sys = new MAST::StructuralSystemInitialization(*_sys,
@@ -103,6 +109,7 @@ MAST::BuildStructural1DElem::init(bool if_link_offset_to_th,
     _thy             = new MAST::Parameter("thy",      0.06);
     _thz             = new MAST::Parameter("thz",      0.02);
     _E               = new MAST::Parameter("E",       72.e9);
+    _rho             = new MAST::Parameter("rho",     2.7e3);
     _nu              = new MAST::Parameter("nu",       0.33);
     _hy_off          = new MAST::Parameter("hyoff",      0.);
     _hz_off          = new MAST::Parameter("hzoff",      0.);
@@ -132,6 +139,7 @@ MAST::BuildStructural1DElem::init(bool if_link_offset_to_th,
     _thy_f           = new MAST::ConstantFieldFunction("hy",     *_thy);
     _thz_f           = new MAST::ConstantFieldFunction("hz",     *_thz);
     _E_f             = new MAST::ConstantFieldFunction("E",      *_E);
+    _rho_f           = new MAST::ConstantFieldFunction("rho",    *_rho);
     _nu_f            = new MAST::ConstantFieldFunction("nu",     *_nu);
     _temp_f          = new MAST::ConstantFieldFunction("temperature", *_temp);
     _ref_temp_f      = new MAST::ConstantFieldFunction("ref_temperature", *_zero);
@@ -157,6 +165,7 @@ MAST::BuildStructural1DElem::init(bool if_link_offset_to_th,
     
     // add the material properties to the card
     _m_card->add(*_E_f);
+    _m_card->add(*_rho_f);
     _m_card->add(*_nu_f);
     _m_card->add(*_alpha_f);
     
@@ -176,7 +185,7 @@ MAST::BuildStructural1DElem::init(bool if_link_offset_to_th,
     
     // tell the section property about the material property
     _p_card->set_material(*_m_card);
-    if (if_nonlinear) _p_card->set_strain(MAST::VON_KARMAN_STRAIN);
+    if (if_nonlinear) _p_card->set_strain(MAST::NONLINEAR_STRAIN);
     
     _p_card->init();
     
@@ -216,6 +225,7 @@ MAST::BuildStructural1DElem::~BuildStructural1DElem() {
     delete _thy_f;
     delete _thz_f;
     delete _E_f;
+    delete _rho_f;
     delete _nu_f;
     delete _hyoff_f;
     delete _hzoff_f;
@@ -234,6 +244,7 @@ MAST::BuildStructural1DElem::~BuildStructural1DElem() {
     delete _hy_off;
     delete _hz_off;
     delete _E;
+    delete _rho;
     delete _nu;
     delete _zero;
     delete _temp;
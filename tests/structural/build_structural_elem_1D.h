@@ -59,7 +59,8 @@ namespace MAST {
 
         
         void init(bool if_link_offset_to_th,
-                  bool if_nonlinear);
+                  bool if_nonlinear,
+                  libMesh::ElemType e_type = libMesh::EDGE2);
         
         
         bool _initialized;
@@ -83,6 +84,7 @@ namespace MAST {
         *_thy,
         *_thz,
         *_E,
+        *_rho,
         *_nu,
         *_hy_off,
         *_hz_off,
@@ -101,6 +103,7 @@ namespace MAST {
         *_thy_f,
         *_thz_f,
         *_E_f,
+        *_rho_f,
         *_nu_f,
         *_hyoff_f,
         *_hzoff_f,
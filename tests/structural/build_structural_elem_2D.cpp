@@ -45,6 +45,7 @@ _structural_sys(nullptr),
 _discipline(nullptr),
 _thz(nullptr),
 _E(nullptr),
+_rho(nullptr),
 _nu(nullptr),
 _kappa(nullptr),
 _hzoff(nullptr),
@@ -57,6 +58,7 @@ _dwdx(nullptr),
 _dwdt(nullptr),
 _thz_f(nullptr),
 _E_f(nullptr),
+_rho_f(nullptr),
 _nu_f(nullptr),
 _kappa_f(nullptr),
 _hzoff_f(nullptr),
@@ -99,8 +101,11 @@ MAST::BuildStructural2DElem::init(bool if_link_offset_to_th,
     // create the libmesh system
     _sys       = &(_eq_sys->add_system<MAST::NonlinearSystem>("structural"));
     
-    // FEType to initialize the system
-    libMesh::FEType fetype (libMesh::FIRST, libMesh::LAGRANGE);
+    // FEType to initialize the system. The order follows the element
+    // type, so that the higher-order elements are not run with
+    // linear shape functions.
+    libMesh::FEType fetype ((*_mesh->elements_begin())->default_order(),
+                            libMesh::LAGRANGE);
     
     // initialize the system to the right set of variables
     _structural_sys = new MAST::StructuralSystemInitialization(*_sys,
@@ -115,6 +120,7 @@ MAST::BuildStructural2DElem::init(bool if_link_offset_to_th,
     
     _thz             = new MAST::Parameter(  "thz",    0.002);
     _E               = new MAST::Parameter(    "E",    72.e9);
+    _rho             = new MAST::Parameter(  "rho",    2.7e3);
     _nu              = new MAST::Parameter(   "nu",     0.33);
     _kappa           = new MAST::Parameter("kappa",    5./6.);
     _zero            = new MAST::Parameter( "zero",       0.);
@@ -140,6 +146,7 @@ MAST::BuildStructural2DElem::init(bool if_link_offset_to_th,
     
     _thz_f           = new MAST::ConstantFieldFunction(    "h",     *_thz);
     _E_f             = new MAST::ConstantFieldFunction(    "E",       *_E);
+    _rho_f           = new MAST::ConstantFieldFunction(  "rho",     *_rho);
     _nu_f            = new MAST::ConstantFieldFunction(   "nu",      *_nu);
     _kappa_f         = new MAST::ConstantFieldFunction("kappa",   *_kappa);
     _temp_f          = new MAST::ConstantFieldFunction("temperature", *_temp);
@@ -161,6 +168,7 @@ MAST::BuildStructural2DElem::init(bool if_link_offset_to_th,
     
     // add the material properties to the card
     _m_card->add(    *_E_f);
+    _m_card->add(  *_rho_f);
     _m_card->add(   *_nu_f);
     _m_card->add(*_kappa_f);
     _m_card->add(*_alpha_f);
@@ -174,7 +182,7 @@ MAST::BuildStructural2DElem::init(bool if_link_offset_to_th,
     
     // tell the section property about the material property
     _p_card->set_material(*_m_card);
-    if (if_nonlinear) _p_card->set_strain(MAST::VON_KARMAN_STRAIN);
+    if (if_nonlinear) _p_card->set_strain(MAST::NONLINEAR_STRAIN);
     
     const unsigned int order = 1;
     
@@ -214,6 +222,7 @@ MAST::BuildStructural2DElem::~BuildStructural2DElem() {
     
     delete _thz_f;
     delete _E_f;
+    delete _rho_f;
     delete _nu_f;
     delete _hzoff_f;
     delete _temp_f;
@@ -229,6 +238,7 @@ MAST::BuildStructural2DElem::~BuildStructural2DElem() {
     delete _thz;
     delete _hzoff;
     delete _E;
+    delete _rho;
     delete _nu;
     delete _zero;
     delete _temp;
@@ -84,6 +84,7 @@ namespace MAST {
         MAST::Parameter
         *_thz,
         *_E,
+        *_rho,
         *_nu,
         *_kappa,
         *_hzoff,
@@ -100,6 +101,7 @@ namespace MAST {
         MAST::ConstantFieldFunction
         *_thz_f,
         *_E_f,
+        *_rho_f,
         *_nu_f,
         *_kappa_f,
         *_hzoff_f,
@@ -0,0 +1,168 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2017  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+
+// BOOST includes
+#include <boost/test/unit_test.hpp>
+
+
+// MAST includes
+#include "tests/base/test_comparisons.h"
+#include "property_cards/section_property_engine.h"
+#include "base/parameter.h"
+#include "base/constant_field_function.h"
+
+
+
+struct BuildRectangularSection {
+    
+    BuildRectangularSection():
+    hy      ("hy",     2.0),
+    hz      ("hz",     1.0),
+    off     ("off",    0.0),
+    hy_f    ("hy",     hy),
+    hz_f    ("hz",     hz),
+    off_f   ("off",    off) {
+        
+        unsigned int
+        i_hy  = engine.add_dimension(hy_f),
+        i_hz  = engine.add_dimension(hz_f),
+        i_off = engine.add_dimension(off_f);
+        
+        engine.add_rectangle(i_hy, i_hz, i_off, i_off, 40, 20);
+    }
+    
+    MAST::Parameter
+    hy,
+    hz,
+    off;
+    
+    MAST::ConstantFieldFunction
+    hy_f,
+    hz_f,
+    off_f;
+    
+    MAST::SectionPropertyEngine engine;
+};
+
+
+
+BOOST_FIXTURE_TEST_SUITE  (SectionPropertyEngineEvaluation,
+                           BuildRectangularSection)
+
+
+BOOST_AUTO_TEST_CASE   (RectangularSectionProperties) {
+    
+    const Real
+    tol  = 1.e-3,
+    a    = hy(),
+    b    = hz();
+    
+    libMesh::Point pt;
+    const RealVectorX& v = engine.properties(pt, 0.);
+    
+    BOOST_CHECK(MAST::compare_value(a*b,                v(MAST::SectionPropertyEngine::AREA),            tol));
+    BOOST_CHECK(MAST::compare_value(b*pow(a,3)/12.,     v(MAST::SectionPropertyEngine::AREA_INERTIA_ZZ), tol));
+    BOOST_CHECK(MAST::compare_value(a*pow(b,3)/12.,     v(MAST::SectionPropertyEngine::AREA_INERTIA_YY), tol));
+    BOOST_CHECK(MAST::compare_value(0.,                 v(MAST::SectionPropertyEngine::SHEAR_CENTER_Y),  tol));
+    BOOST_CHECK(MAST::compare_value(0.,                 v(MAST::SectionPropertyEngine::SHEAR_CENTER_Z),  tol));
+    
+    // series solution for the torsional constant of a rectangle
+    const Real
+    J    = a*pow(b,3)*(1./3.-0.21*b/a*(1.-pow(b/a,4)/12.));
+    BOOST_CHECK(MAST::compare_value(J,  v(MAST::SectionPropertyEngine::TORSIONAL_CONSTANT), tol));
+    
+    // the bounding box places the stress recovery points of the
+    // rectangle on its corners
+    BOOST_CHECK(MAST::compare_value(a,  v(MAST::SectionPropertyEngine::SECTION_HY),       tol));
+    BOOST_CHECK(MAST::compare_value(b,  v(MAST::SectionPropertyEngine::SECTION_HZ),       tol));
+    BOOST_CHECK(MAST::compare_value(0., v(MAST::SectionPropertyEngine::SECTION_Y_OFFSET), tol));
+    BOOST_CHECK(MAST::compare_value(0., v(MAST::SectionPropertyEngine::SECTION_Z_OFFSET), tol));
+}
+
+
+
+BOOST_AUTO_TEST_CASE   (BoundedLookupTable) {
+    
+    const Real
+    tol  = 1.e-3,
+    a    = hy();
+    
+    libMesh::Point pt;
+    
+    engine.set_max_table_entries(2);
+    
+    // three distinct sections, of which only the latest two are kept
+    for (unsigned int i=0; i<3; i++) {
+        
+        hy() = a*(1.+0.1*i);
+        engine.properties(pt, 0.);
+    }
+    
+    BOOST_CHECK_EQUAL(engine.n_table_entries(), 2);
+    
+    // an evicted section is recomputed with the same result
+    hy() = a;
+    const RealVectorX& v = engine.properties(pt, 0.);
+    
+    BOOST_CHECK(MAST::compare_value(a*hz(), v(MAST::SectionPropertyEngine::AREA), tol));
+    BOOST_CHECK_EQUAL(engine.n_table_entries(), 2);
+}
+
+
+
+BOOST_AUTO_TEST_CASE   (RectangularSectionSensitivity) {
+    
+    const Real
+    delta    = 1.e-6,
+    tol      = 1.e-3;
+    
+    libMesh::Point pt;
+    
+    MAST::Parameter* params[] = {&hy, &hz};
+    
+    for (unsigned int i=0; i<2; i++) {
+        
+        MAST::Parameter& f = *params[i];
+        
+        RealVectorX
+        v0,
+        v1,
+        dv;
+        
+        v0 = engine.properties(pt, 0.);
+        engine.property_derivatives(f, pt, 0., dv);
+        
+        const Real p0 = f();
+        f()  += delta*p0;
+        v1    = engine.properties(pt, 0.);
+        f()   = p0;
+        
+        v1   -= v0;
+        v1   /= delta*p0;
+        
+        BOOST_TEST_MESSAGE("  ** dprop/dp  wrt : " << f.name() << " **");
+        BOOST_CHECK(MAST::compare_vector(v1, dv, tol));
+    }
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
+
@@ -0,0 +1,186 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2017  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+// BOOST includes
+#include <boost/test/unit_test.hpp>
+
+
+// MAST includes
+#include "examples/thermal/bar_transient/bar_transient.h"
+#include "tests/base/test_comparisons.h"
+#include "heat_conduction/heat_conduction_system_initialization.h"
+#include "heat_conduction/heat_conduction_discipline.h"
+#include "heat_conduction/heat_conduction_transient_assembly.h"
+#include "solver/first_order_newmark_transient_solver.h"
+#include "solver/jacobian_lagging_policy.h"
+#include "base/parameter.h"
+#include "base/nonlinear_system.h"
+
+
+// libMesh includes
+#include "libmesh/numeric_vector.h"
+
+
+BOOST_FIXTURE_TEST_SUITE  (ThermalBarTransientAdaptiveTimeStep,
+                           MAST::BarTransient)
+
+BOOST_AUTO_TEST_CASE   (TrapezoidalAdaptiveTimeStep) {
+    
+    this->init(libMesh::EDGE2, false);
+    
+    MAST::HeatConductionTransientAssembly   assembly;
+    MAST::FirstOrderNewmarkTransientSolver  solver;
+    
+    // beta is set before the assembly is attached, so that the
+    // velocity history for the error estimate is stored
+    solver.beta            = 0.5;
+    
+    assembly.attach_discipline_and_system(*_discipline,
+                                          solver,
+                                          *_thermal_sys);
+    
+    _sys->solution->zero();
+    
+    solver.dt              = 1.e2;
+    solver.min_dt          = 1.;
+    solver.max_dt          = 1.e5;
+    solver.error_tolerance = 1.e-5;
+    
+    Real
+    tval     = 0.,
+    t_final  = 3.e6,
+    dt       = 0.;
+    
+    solver.solve_highest_derivative_and_advance_time_step();
+    
+    // no error estimate is available for the first step, since the
+    // predictor needs the velocity from two steps back. The step is
+    // accepted and the time step is not changed.
+    tval += solver.solve_and_advance_adaptive_time_step();
+    BOOST_CHECK_EQUAL(solver.n_rejected_steps(), 0);
+    BOOST_CHECK_EQUAL(solver.dt, 1.e2);
+    
+    // a large time step with a tolerance that cannot be satisfied is
+    // rejected until the limit on rejections is reached, and the step
+    // is then accepted with a reduced time step.
+    solver.dt                 = 1.e4;
+    solver.error_tolerance    = 1.e-12;
+    solver.max_rejected_steps = 2;
+    
+    dt    = solver.solve_and_advance_adaptive_time_step();
+    tval += dt;
+    BOOST_CHECK_EQUAL(solver.n_rejected_steps(), 2);
+    BOOST_CHECK_LT(dt, 1.e4);
+    
+    // march to steady state. The time step grows as the transient
+    // decays.
+    solver.error_tolerance    = 1.e-5;
+    solver.max_rejected_steps = 10;
+    
+    while (tval < t_final)
+        tval += solver.solve_and_advance_adaptive_time_step();
+    
+    BOOST_CHECK_GT(solver.dt, 1.e3);
+    
+    // compare with the steady state solution of the bar with a uniform
+    // heat source and zero temperature at both ends:
+    //   T = q x (L-x) / (2 k A)
+    const Real
+    tol      = 1.e-2,
+    length   = 10.,
+    q        = (*_q_source)(),
+    k        = (*_k)(),
+    area     = (*_thy)() * (*_thz)();
+    
+    unsigned int
+    dof_num = 0;
+    
+    libMesh::MeshBase::const_node_iterator
+    it     =  _mesh->local_nodes_begin(),
+    end    =  _mesh->local_nodes_end();
+    
+    Real
+    x           = 0.,
+    analytical  = 0.,
+    numerical   = 0.;
+    
+    for ( ; it!=end; it++) {
+        const libMesh::Node* node = *it;
+        dof_num      = node->dof_number(_sys->number(), _thermal_sys->vars()[0],  0);
+        x            = (*node)(0);
+        analytical   = q * x * (length - x) / (2. * k * area);
+        numerical    = _sys->solution->el(dof_num);
+        BOOST_CHECK(MAST::compare_value(analytical, numerical, tol));
+    }
+    
+    assembly.clear_discipline_and_system();
+}
+
+
+BOOST_AUTO_TEST_CASE   (JacobianReuseAtFixedTimeStep) {
+    
+    this->init(libMesh::EDGE2, false);
+    
+    MAST::HeatConductionTransientAssembly   assembly;
+    MAST::FirstOrderNewmarkTransientSolver  solver;
+    MAST::JacobianLaggingPolicy             lagging;
+    
+    lagging.reuse_across_solves = true;
+    _sys->set_jacobian_lagging_policy(&lagging);
+    
+    assembly.attach_discipline_and_system(*_discipline,
+                                          solver,
+                                          *_thermal_sys);
+    
+    _sys->solution->zero();
+    
+    solver.dt = 1.e2;
+    solver.solve_highest_derivative_and_advance_time_step();
+    
+    // the Jacobian assembled for the first step is reused by the
+    // following steps with the same time step
+    const unsigned int
+    n_steps = 5;
+    
+    for (unsigned int i=0; i<n_steps; i++) {
+        
+        solver.solve();
+        solver.advance_time_step();
+    }
+    
+    BOOST_CHECK_GE(lagging.n_jacobian_reuses(), n_steps-1);
+    
+    // a change in the time step assembles the Jacobian again
+    const unsigned int
+    n_assemblies = lagging.n_jacobian_assemblies();
+    
+    solver.dt = 2.e2;
+    solver.solve();
+    solver.advance_time_step();
+    
+    BOOST_CHECK_GT(lagging.n_jacobian_assemblies(), n_assemblies);
+    
+    assembly.clear_discipline_and_system();
+    _sys->set_jacobian_lagging_policy(nullptr);
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
+